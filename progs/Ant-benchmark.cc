@@ -0,0 +1,382 @@
+/**
+  * @file Ant-benchmark.cc
+  * @brief Generate a synthetic Acqu Mk2 raw stream and time the full processing chain
+  *
+  * The raw file is generated from the hit and scaler mappings of the chosen setup,
+  * the hit multiplicity, scaler block frequency and compression are configurable.
+  * Each stage (unpack, reconstruct with its sub-stages, physics, write)
+  * is timed separately and the number of heap allocations is counted.
+  * Use --results to append a single line per run to a file,
+  * which makes the numbers comparable across commits.
+  */
+
+#include "expconfig/ExpConfig.h"
+#include "unpacker/Unpacker.h"
+#include "unpacker/UnpackerAcqu.h"
+#include "unpacker/detail/UnpackerAcqu_legacy.h"
+#include "unpacker/RawFileReader.h"
+
+#include "reconstruct/Reconstruct.h"
+
+#include "analysis/physics/Physics.h"
+#include "analysis/input/treeEvents_t.h"
+#include "analysis/utils/ParticleID.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+#include "base/WrapTFile.h"
+#include "base/GitInfo.h"
+#include "base/Paths.h"
+#include "base/tmpfile_t.h"
+#include "base/std_ext/system.h"
+#include "base/std_ext/string.h"
+#include "base/std_ext/memory.h"
+#include "tclap/CmdLine.h"
+#include "tclap/ValuesConstraintExtra.h"
+#include "base/Logger.h"
+
+#include "TTree.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <random>
+
+using namespace std;
+using namespace ant;
+using namespace ant::unpacker;
+
+// count every heap allocation of this program,
+// which includes all allocations made by the Ant libraries
+namespace {
+atomic<size_t> nAllocations{0};
+}
+
+void* operator new(size_t size) {
+    ++nAllocations;
+    if(void* p = malloc(size == 0 ? 1 : size))
+        return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+namespace {
+
+using clock_type = chrono::steady_clock;
+
+struct stage_t {
+    string Name;
+    bool SubStage = false;
+    unsigned nEvents = 0;
+    double Seconds = 0;
+    size_t Allocations = 0;
+
+    stage_t(const string& name) : Name(name) {}
+
+    double EventsPerSecond() const {
+        return Seconds > 0 ? nEvents/Seconds : 0;
+    }
+    double AllocationsPerEvent() const {
+        return nEvents > 0 ? double(Allocations)/nEvents : 0;
+    }
+};
+
+template<typename F>
+stage_t measure(const string& name, unsigned nEvents, F f) {
+    stage_t stage(name);
+    stage.nEvents = nEvents;
+    const auto allocs_before = nAllocations.load();
+    const auto start = clock_type::now();
+    f();
+    stage.Seconds = chrono::duration<double>(clock_type::now() - start).count();
+    stage.Allocations = nAllocations.load() - allocs_before;
+    return stage;
+}
+
+/**
+ * @brief The mk2_writer_t class writes events into Acqu Mk2 data buffers
+ *
+ * The record length is taken from the size of the given header,
+ * as the unpacker determines it from the position of the first data buffer
+ */
+class mk2_writer_t {
+    ostream& output;
+    const size_t recordLength;
+    vector<uint32_t> databuffer{acqu::EMk2DataBuff};
+    unsigned nEvents = 0;
+
+    void flush() {
+        databuffer.emplace_back(acqu::EBufferEnd);
+        databuffer.resize(recordLength);
+        output.write(reinterpret_cast<const char*>(databuffer.data()),
+                     databuffer.size()*sizeof(uint32_t));
+        databuffer.clear();
+    }
+
+public:
+    mk2_writer_t(ostream& output_, const vector<uint32_t>& header) :
+        output(output_),
+        recordLength(header.size())
+    {
+        output.write(reinterpret_cast<const char*>(header.data()),
+                     header.size()*sizeof(uint32_t));
+    }
+
+    // eventbuffer must end with EEndEvent
+    void AddEvent(const vector<uint32_t>& eventbuffer) {
+        // eventID, eventlength and end-of-databuffer marker need 3 extra words
+        if(databuffer.size()+eventbuffer.size()+3 > recordLength) {
+            flush();
+            databuffer.emplace_back(acqu::EMk2DataBuff);
+        }
+        if(databuffer.size()+eventbuffer.size()+3 > recordLength)
+            throw runtime_error("Event does not fit into data buffer, reduce multiplicity");
+
+        databuffer.emplace_back(nEvents);
+        databuffer.emplace_back(eventbuffer.size()*sizeof(uint32_t));
+        databuffer.insert(databuffer.end(), eventbuffer.begin(), eventbuffer.end());
+        nEvents++;
+    }
+
+    void Finish() {
+        flush();
+        databuffer.emplace_back(acqu::EEndBuff);
+        flush();
+    }
+};
+
+vector<uint32_t> read_header(const string& filename) {
+    RawFileReader r;
+    r.open(filename);
+    if(!r)
+        throw runtime_error("Cannot open headerfile "+filename);
+
+    // read the complete file, it should only contain the header
+    vector<uint32_t> header;
+    constexpr size_t chunk = 0x8000/sizeof(uint32_t);
+    while(true) {
+        const auto offset = header.size();
+        header.resize(offset+chunk);
+        r.read(addressof(header[offset]), chunk);
+        if(r.gcount() != chunk*sizeof(uint32_t)) {
+            header.resize(offset+r.gcount()/sizeof(uint32_t));
+            break;
+        }
+    }
+
+    // unpacker only finds the data buffers at those positions
+    const auto size = header.size()*sizeof(uint32_t);
+    if(size != 0x8000 && size != 10*0x8000 && size != 16*0x8000)
+        throw runtime_error(std_ext::formatter() << "Headerfile has unexpected size " << size
+                            << ", must be a header-only Acqu Mk2 file");
+    return header;
+}
+
+}
+
+int main(int argc, char** argv) {
+    SetupLogger();
+
+    TCLAP::CmdLine cmd("Ant-benchmark - time the processing chain with synthetic raw data", ' ', "0.1");
+
+    auto cmd_verbose = cmd.add<TCLAP::ValueArg<int>>("v","verbose","Verbosity level (0..9)", false, 0,"int");
+    TCLAP::ValuesConstraintExtra<decltype(ExpConfig::Setup::GetNames())> allowedsetupnames(ExpConfig::Setup::GetNames());
+    auto cmd_setup  = cmd.add<TCLAP::ValueArg<string>>("s","setup","Setup providing the mappings and the reconstruction",true,"", &allowedsetupnames);
+    auto cmd_headerfile = cmd.add<TCLAP::ValueArg<string>>("","header","Header-only Acqu Mk2 file, determines the record length",false,
+                                                          string(ANT_PATH_GITREPO)+"/test/_blobs/Acqu_headeronly-big.dat.xz","acqufile");
+    auto cmd_events = cmd.add<TCLAP::ValueArg<unsigned>>("n","events","Number of events to generate",false,20000,"n");
+    auto cmd_multiplicity = cmd.add<TCLAP::ValueArg<double>>("m","multiplicity","Mean number of raw hits per event (Poisson distributed)",false,100,"mean");
+    auto cmd_scalerevery = cmd.add<TCLAP::ValueArg<unsigned>>("","scaler-every","Add scaler block every n-th event (0 disables)",false,1000,"n");
+    TCLAP::ValuesConstraintExtra<vector<string>> allowedcompressions({"none", "gz", "xz"});
+    auto cmd_compress = cmd.add<TCLAP::ValueArg<string>>("","compress","Compression of the generated raw file",false,"none",&allowedcompressions);
+    auto cmd_physics = cmd.add<TCLAP::ValueArg<string>>("p","physics","Reference physics class",false,"CandidatesAnalysis","physics");
+    auto cmd_seed = cmd.add<TCLAP::ValueArg<unsigned>>("","seed","Random seed for the generator",false,0,"seed");
+    auto cmd_results = cmd.add<TCLAP::ValueArg<string>>("","results","Append one line with the results to this file",false,"","filename");
+
+    cmd.parse(argc, argv);
+    if(cmd_verbose->isSet()) {
+        el::Loggers::setVerboseLevel(cmd_verbose->getValue());
+    }
+
+    ExpConfig::Setup::SetByName(cmd_setup->getValue());
+
+    vector<UnpackerAcquConfig::hit_mapping_t> hit_mappings;
+    vector<UnpackerAcquConfig::scaler_mapping_t> scaler_mappings;
+    ExpConfig::Setup::GetByType<UnpackerAcquConfig>().BuildMappings(hit_mappings, scaler_mappings);
+
+    // only simple mappings can be generated easily
+    vector<uint16_t> rawchannels;
+    for(const auto& m : hit_mappings) {
+        if(m.RawChannels.size() != 1)
+            continue;
+        const auto& rawchannel = m.RawChannels.front();
+        if(rawchannel.Mask != rawchannel.NoMask())
+            continue;
+        rawchannels.push_back(rawchannel.RawChannel);
+    }
+    if(rawchannels.empty()) {
+        LOG(ERROR) << "Setup does not provide any simple hit mappings";
+        return EXIT_FAILURE;
+    }
+
+    vector<uint32_t> scalerchannels;
+    for(const auto& m : scaler_mappings)
+        for(const auto& e : m.Entries)
+            scalerchannels.push_back(e.RawChannel.RawChannel);
+
+    LOG(INFO) << "Generating from " << rawchannels.size() << " hit mappings and "
+              << scalerchannels.size() << " scaler channels";
+
+    tmpfolder_t tmpfolder;
+    string rawfilename = tmpfolder.foldername+"/synthetic.dat";
+    const auto nEvents = cmd_events->getValue();
+
+    vector<stage_t> stages;
+
+    try {
+        const auto header = read_header(cmd_headerfile->getValue());
+
+        stages.emplace_back(measure("generate", nEvents, [&] () {
+            ofstream output(rawfilename);
+            mk2_writer_t writer(output, header);
+
+            mt19937 rng(cmd_seed->getValue());
+            poisson_distribution<unsigned> multiplicity(cmd_multiplicity->getValue());
+            uniform_int_distribution<size_t> rawchannel(0, rawchannels.size()-1);
+            uniform_int_distribution<uint16_t> adc(0, 0xfff);
+            uniform_int_distribution<uint32_t> scalervalue(0, 1u << 24);
+
+            const auto scaler_every = cmd_scalerevery->getValue();
+            vector<uint32_t> eventbuffer;
+            for(unsigned i=0;i<nEvents;i++) {
+                eventbuffer.clear();
+                const auto nHits = multiplicity(rng);
+                for(unsigned j=0;j<nHits;j++) {
+                    eventbuffer.emplace_back();
+                    auto acquhit = reinterpret_cast<acqu::AcquBlock_t*>(addressof(eventbuffer.back()));
+                    acquhit->id = rawchannels[rawchannel(rng)];
+                    acquhit->adc = adc(rng);
+                }
+                if(scaler_every>0 && !scalerchannels.empty() && i % scaler_every == 0) {
+                    eventbuffer.emplace_back(acqu::EScalerBuffer);
+                    // length is counted from length word up to end marker, in bytes
+                    eventbuffer.emplace_back((1+2*scalerchannels.size())*sizeof(uint32_t));
+                    for(auto ch : scalerchannels) {
+                        eventbuffer.emplace_back(ch);
+                        eventbuffer.emplace_back(scalervalue(rng));
+                    }
+                    eventbuffer.emplace_back(acqu::EScalerBuffer);
+                }
+                eventbuffer.emplace_back(acqu::EEndEvent);
+                writer.AddEvent(eventbuffer);
+            }
+            writer.Finish();
+        }));
+
+        const auto& compress = cmd_compress->getValue();
+        if(compress != "none") {
+            const string compressor = compress == "xz" ? "xz -f " : "gzip -f ";
+            if(std::system((compressor+rawfilename).c_str()) != 0)
+                throw runtime_error("Compressing generated raw file failed");
+            rawfilename += "." + compress;
+        }
+
+        vector<TEvent> events;
+        events.reserve(nEvents);
+        stages.emplace_back(measure("unpack", nEvents, [&] () {
+            auto unpacker = Unpacker::Get(rawfilename);
+            while(auto event = unpacker->NextEvent())
+                events.emplace_back(move(event));
+        }));
+        if(events.size() != nEvents)
+            LOG(WARNING) << "Unpacked " << events.size() << " events, but generated " << nEvents;
+
+        Reconstruct reconstruct;
+        reconstruct.EnableStageTimings();
+        stages.emplace_back(measure("reconstruct", events.size(), [&] () {
+            for(auto& event : events)
+                reconstruct.DoReconstruct(event.Reconstructed());
+        }));
+        {
+            const auto& timings = *reconstruct.GetStageTimings();
+            auto add_substage = [&stages, &events] (const string& name, const Reconstruct::StageTimings_t::duration_t& d) {
+                stage_t substage(name);
+                substage.SubStage = true;
+                substage.nEvents = events.size();
+                substage.Seconds = d.count();
+                stages.emplace_back(substage);
+            };
+            add_substage("calibrate", timings.Calibrate);
+            add_substage("hits", timings.Hits);
+            add_substage("clustering", timings.Clustering);
+            add_substage("candidates", timings.Candidates);
+        }
+
+        tmpfile_t outputfile;
+        WrapTFileOutput output(outputfile.filename, true);
+
+        analysis::utils::ParticleID::SetDefault(std_ext::make_unique<analysis::utils::SimpleParticleID>());
+        auto physics = analysis::PhysicsRegistry::Create(cmd_physics->getValue());
+        stages.emplace_back(measure("physics", events.size(), [&] () {
+            analysis::physics::manager_t manager;
+            for(const auto& event : events)
+                physics->ProcessEvent(event, manager);
+            physics->Finish();
+        }));
+
+        stages.emplace_back(measure("write", events.size(), [&] () {
+            analysis::input::treeEvents_t treeEvents;
+            treeEvents.CreateBranches(new TTree("treeEvents","TEvent data"));
+            for(auto& event : events) {
+                treeEvents.data = move(event);
+                treeEvents.Tree->Fill();
+            }
+            treeEvents.Tree->Write();
+        }));
+    }
+    catch(const exception& e) {
+        LOG(ERROR) << "Benchmark failed: " << e.what();
+        return EXIT_FAILURE;
+    }
+
+    cout << left << setw(14) << "stage"
+         << right << setw(14) << "events/s"
+         << setw(14) << "allocs/event" << endl;
+    for(const auto& stage : stages) {
+        cout << left << setw(14) << (stage.SubStage ? " "+stage.Name : stage.Name) << right << fixed << setprecision(1)
+             << setw(14) << stage.EventsPerSecond();
+        if(stage.Allocations>0)
+            cout << setw(14) << stage.AllocationsPerEvent();
+        cout << endl;
+    }
+
+    if(cmd_results->isSet()) {
+        ofstream results(cmd_results->getValue(), ios::app);
+        results << GitInfo().GetDescription() << '\t'
+                << cmd_setup->getValue() << '\t'
+                << "events=" << nEvents << '\t'
+                << "multiplicity=" << cmd_multiplicity->getValue() << '\t'
+                << "compress=" << cmd_compress->getValue() << '\t'
+                << "seed=" << cmd_seed->getValue();
+        for(const auto& stage : stages) {
+            results << '\t' << stage.Name << '='
+                    << fixed << setprecision(1) << stage.EventsPerSecond();
+        }
+        results << endl;
+        LOG(INFO) << "Results appended to " << cmd_results->getValue();
+    }
+
+    return EXIT_SUCCESS;
+}
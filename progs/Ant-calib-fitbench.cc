@@ -0,0 +1,203 @@
+/**
+  * @file Ant-calib-fitbench.cc
+  * @brief Compare the cost of the calibration fits with different start values and gradients
+  *
+  * Each channel of a stored 2D calibration histogram (channel on the y axis) is fitted
+  * with the chosen fit function, as the calibration modules do in their automatic mode.
+  * The fit is done in three ways:
+  *   previous: start values from the channel before and numerical derivatives (old behaviour)
+  *   estimate: analytic start values from SetDefaults, numerical derivatives
+  *   gradient: analytic start values and analytic gradient, if the function provides one
+  * For each, the number of function calls of the minimizer, the wall time and the
+  * fit quality are reported. Use --results to append a single line per run to a file,
+  * which makes the numbers comparable across commits.
+  */
+
+#include "calibration/fitfunctions/FitGausPol0.h"
+#include "calibration/fitfunctions/FitGausPol1.h"
+#include "calibration/fitfunctions/FitGausPol3.h"
+#include "calibration/fitfunctions/FitLandauExpo.h"
+#include "calibration/fitfunctions/FitWeibullLandauPol1.h"
+#include "calibration/fitfunctions/FitTimewalk.h"
+#include "calibration/fitfunctions/FitVetoBand.h"
+
+#include "base/WrapTFile.h"
+#include "base/GitInfo.h"
+#include "base/std_ext/math.h"
+#include "base/std_ext/memory.h"
+#include "base/std_ext/string.h"
+#include "tclap/CmdLine.h"
+#include "tclap/ValuesConstraintExtra.h"
+#include "base/Logger.h"
+
+#include "TH2.h"
+#include "TH1.h"
+#include "TError.h"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+
+using namespace std;
+using namespace ant;
+using namespace ant::calibration;
+
+namespace {
+
+using clock_type = chrono::steady_clock;
+
+using factory_t = function<unique_ptr<gui::FitFunction>()>;
+
+const map<string, factory_t> functions = {
+    {"GausPol0",          [] () { return std_ext::make_unique<gui::FitGausPol0>(); }},
+    {"GausPol1",          [] () { return std_ext::make_unique<gui::FitGausPol1>(); }},
+    {"GausPol3",          [] () { return std_ext::make_unique<gui::FitGausPol3>(); }},
+    {"LandauExpo",        [] () { return std_ext::make_unique<gui::FitLandauExpo>(); }},
+    {"WeibullLandauPol1", [] () { return std_ext::make_unique<gui::FitWeibullLandauPol1>(); }},
+    {"Timewalk",          [] () { return std_ext::make_unique<gui::FitTimewalk>(); }},
+    {"VetoBand",          [] () { return std_ext::make_unique<gui::FitVetoBand>(); }},
+};
+
+struct run_t {
+    string Name;
+    bool FromPrevious;
+    bool Gradient;
+
+    unsigned long NCalls = 0;
+    double Seconds = 0;
+    unsigned nFits = 0;
+    unsigned nBad = 0;
+    double SumChi2NDF = 0;
+
+    run_t(const string& name, bool fromPrevious, bool gradient) :
+        Name(name), FromPrevious(fromPrevious), Gradient(gradient) {}
+};
+
+}
+
+int main(int argc, char** argv)
+{
+    SetupLogger();
+
+    TCLAP::CmdLine cmd("Ant-calib-fitbench - compare start values and gradients of the calibration fits", ' ', "0.1");
+
+    auto cmd_verbose = cmd.add<TCLAP::ValueArg<int>>("v","verbose","Verbosity level (0..9)", false, 0,"int");
+    auto cmd_input = cmd.add<TCLAP::ValueArg<string>>("i","input","ROOT file with the calibration histograms",true,"","filename");
+    auto cmd_hist = cmd.add<TCLAP::ValueArg<string>>("","hist","Path of the 2D histogram, one channel per y bin",true,"","path");
+    vector<string> allowedfunctions;
+    for(auto& f : functions)
+        allowedfunctions.emplace_back(f.first);
+    TCLAP::ValuesConstraintExtra<vector<string>> allowedfunctionnames(allowedfunctions);
+    auto cmd_function = cmd.add<TCLAP::ValueArg<string>>("f","function","Fit function",true,"",&allowedfunctionnames);
+    auto cmd_rangemin = cmd.add<TCLAP::ValueArg<double>>("","range-min","Lower end of the fit range",false,std_ext::NaN,"x");
+    auto cmd_rangemax = cmd.add<TCLAP::ValueArg<double>>("","range-max","Upper end of the fit range",false,std_ext::NaN,"x");
+    auto cmd_minentries = cmd.add<TCLAP::ValueArg<double>>("","min-entries","Skip channels with less entries",false,100,"n");
+    auto cmd_maxchi2ndf = cmd.add<TCLAP::ValueArg<double>>("","max-chi2ndf","Count fits with higher chi2/ndf as bad",false,10,"value");
+    auto cmd_results = cmd.add<TCLAP::ValueArg<string>>("","results","Append one line with the results to this file",false,"","filename");
+
+    cmd.parse(argc, argv);
+
+    if(cmd_verbose->isSet())
+        el::Loggers::setVerboseLevel(cmd_verbose->getValue());
+
+    // the fit functions are silent, the timing should not include printing errors of failed fits
+    gErrorIgnoreLevel = kError;
+
+    WrapTFileInput input(cmd_input->getValue());
+    TH2* hist2 = nullptr;
+    if(!input.GetObject(cmd_hist->getValue(), hist2)) {
+        LOG(ERROR) << "Cannot find 2D histogram " << cmd_hist->getValue();
+        return EXIT_FAILURE;
+    }
+
+    // project all channels once, so the fits are timed only
+    vector<unique_ptr<TH1D>> projections;
+    for(int bin=1;bin<=hist2->GetNbinsY();bin++) {
+        const string name = std_ext::formatter() << "fitbench_ch" << bin-1;
+        auto proj = unique_ptr<TH1D>(hist2->ProjectionX(name.c_str(), bin, bin));
+        proj->SetDirectory(nullptr);
+        if(proj->GetEntries() < cmd_minentries->getValue())
+            continue;
+        projections.emplace_back(move(proj));
+    }
+    if(projections.empty()) {
+        LOG(ERROR) << "No channel with at least " << cmd_minentries->getValue() << " entries";
+        return EXIT_FAILURE;
+    }
+    LOG(INFO) << "Fitting " << projections.size() << " channels with " << cmd_function->getValue();
+
+    const auto& factory = functions.at(cmd_function->getValue());
+
+    vector<run_t> modes{
+        {"previous", true,  false},
+        {"estimate", false, false},
+        {"gradient", false, true}
+    };
+
+    for(auto& mode : modes) {
+        auto func = factory();
+        func->SetAnalyticGradient(mode.Gradient);
+
+        // defaults from the first channel, as in the calibration modules
+        func->SetDefaults(projections.front().get());
+        const auto setRange = [&func, &cmd_rangemin, &cmd_rangemax] () {
+            if(cmd_rangemin->isSet() || cmd_rangemax->isSet()) {
+                auto range = func->GetRange();
+                if(cmd_rangemin->isSet())
+                    range.Start() = cmd_rangemin->getValue();
+                if(cmd_rangemax->isSet())
+                    range.Stop() = cmd_rangemax->getValue();
+                func->SetRange(range);
+            }
+        };
+        setRange();
+
+        const auto start = clock_type::now();
+        for(auto& proj : projections) {
+            // otherwise start from the result of the channel before
+            if(!mode.FromPrevious) {
+                func->SetDefaults(proj.get());
+                setRange();
+            }
+            func->Fit(proj.get());
+
+            const auto chi2ndf = func->Chi2NDF();
+            mode.nFits++;
+            if(!isfinite(chi2ndf) || chi2ndf > cmd_maxchi2ndf->getValue())
+                mode.nBad++;
+            else
+                mode.SumChi2NDF += chi2ndf;
+        }
+        mode.Seconds = chrono::duration<double>(clock_type::now() - start).count();
+        mode.NCalls = func->NCalls();
+
+        LOG(INFO) << setw(8) << mode.Name
+                  << ": calls=" << setw(8) << mode.NCalls
+                  << " calls/fit=" << setw(8) << fixed << setprecision(1) << double(mode.NCalls)/mode.nFits
+                  << " time=" << setprecision(3) << mode.Seconds << "s"
+                  << " bad=" << mode.nBad << "/" << mode.nFits
+                  << " <chi2/ndf>=" << setprecision(3) << mode.SumChi2NDF/max(1u, mode.nFits-mode.nBad);
+    }
+
+    if(cmd_results->isSet()) {
+        ofstream results(cmd_results->getValue(), ios::app);
+        results << GitInfo().GetDescription() << '\t'
+                << cmd_function->getValue() << '\t'
+                << cmd_hist->getValue() << '\t'
+                << "channels=" << projections.size();
+        for(auto& mode : modes) {
+            results << '\t' << mode.Name
+                    << "=" << mode.NCalls
+                    << "/" << fixed << setprecision(3) << mode.Seconds
+                    << "/" << mode.nBad;
+        }
+        results << endl;
+        LOG(INFO) << "Results appended to " << cmd_results->getValue();
+    }
+
+    return EXIT_SUCCESS;
+}
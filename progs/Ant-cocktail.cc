@@ -2,6 +2,7 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <algorithm>
 
 
 #include "mc/pluto/PlutoGenerator.h"
@@ -9,16 +10,22 @@
 
 #include "expconfig/ExpConfig.h"
 
+#include "mc/pluto/utils/PlutoShards.h"
+
 #include "tclap/CmdLine.h"
 #include "base/std_ext/string.h"
 #include "base/Logger.h"
+#include "base/tmpfile_t.h"
 #include "tclap/ValuesConstraintExtra.h"
 
 #include "detail/McAction.h"
 
+#include "TRandom.h"
+
 using namespace std;
 using namespace ant;
 using namespace ant::mc::pluto;
+using namespace ant::mc::pluto::utils;
 
 int main( int argc, char** argv )
 {
@@ -45,6 +52,11 @@ int main( int argc, char** argv )
     auto cmd_flatEbeam  = cmd.add<TCLAP::SwitchArg>        ("",  "flatEbeam", "Make tagger spectrum flat (no 1/Ebeam weighting)", false);
 
     auto cmd_noTID      = cmd.add<TCLAP::SwitchArg>        ("",  "noTID",   "Don't add TID tree for the events",   false);
+
+    auto cmd_shards     = cmd.add<TCLAP::ValueArg<unsigned>>("",  "shards",   "Split generation into independent shards, each with own reactions, seed and output tree", false, 1, "n");
+    auto cmd_jobs       = cmd.add<TCLAP::ValueArg<unsigned>>("j", "jobs",     "Number of shards generated concurrently as forked processes (default: all)", false, 0, "n");
+    auto cmd_seed       = cmd.add<TCLAP::ValueArg<unsigned>>("",  "seed",     "Random seed, shard seeds are derived from it and the shard index (0: random if not sharded)", false, 0, "seed");
+    auto cmd_noMerge    = cmd.add<TCLAP::SwitchArg>        ("",  "no-merge", "Keep the shard files <outfile>_shard<i>.root for chaining instead of merging them", false);
     auto cmd_verbose    = cmd.add<TCLAP::ValueArg<int>>    ("v", "verbose", "Verbosity level (0..9)",              false, 0, "int");
 
     cmd.parse(argc, argv);
@@ -96,27 +108,93 @@ int main( int argc, char** argv )
         return 1;
     }
 
-    // scope that the Cocktail output file is properly closed before adding TID tree
-    {
-        auto selector = mc::data::Query::GetSelector(allowedTargets.at(cmd_target->getValue()));
-        Cocktail cocktail(outfile,
+    const auto selector = mc::data::Query::GetSelector(allowedTargets.at(cmd_target->getValue()));
+
+    auto generate = [&] (const string& filename, unsigned long nEvents, unsigned seed) {
+        // scope that the Cocktail output file is properly closed before adding TID tree
+        Cocktail cocktail(filename,
                           energies,
                           !cmd_noUnstable->isSet(),
                           !cmd_noBulk->isSet(),
                           cmd_verbose->getValue(),
                           cmd_flatEbeam->getValue() ? "1.0" : "1.0 / x",
-                          selector);
+                          selector,
+                          seed);
 
-        auto nErrors = cocktail.Sample(cmd_numEvents->getValue());
+        auto nErrors = cocktail.Sample(nEvents);
 
         if(nErrors>0)
-            LOG(WARNING) << "Events with error: " <<  nErrors;
+            LOG(WARNING) << "Events with error in " << filename << ": " <<  nErrors;
+    };
+
+    const unsigned long numEvents = cmd_numEvents->getValue();
+    const unsigned nShards = max(cmd_shards->getValue(), 1u);
+    vector<string> outfiles;
+
+    if(nShards == 1) {
+        const auto seed = cmd_seed->getValue();
+        // Pluto itself uses gRandom
+        if(seed != 0)
+            gRandom->SetSeed(seed);
+        generate(outfile, numEvents, seed);
+        outfiles.push_back(outfile);
     }
+    else {
+        // Pluto and ROOT keep global state (gRandom, particle database),
+        // so each shard runs in its own forked process
+        const unsigned jobs = cmd_jobs->getValue() > 0 ? cmd_jobs->getValue() : nShards;
+
+        tmpfolder_t tmpfolder;
+        vector<string> shardfiles;
+        for(unsigned shard=0;shard<nShards;shard++) {
+            if(cmd_noMerge->isSet()) {
+                const auto basename = std_ext::string_ends_with(outfile, ".root")
+                                      ? outfile.substr(0, outfile.size()-5) : outfile;
+                shardfiles.emplace_back(std_ext::formatter() << basename << "_shard" << shard << ".root");
+            }
+            else {
+                shardfiles.emplace_back(std_ext::formatter() << tmpfolder.foldername << "/shard" << shard << ".root");
+            }
+        }
+
+        LOG(INFO) << "Generating " << numEvents << " events in " << nShards
+                  << " shards with " << jobs << " concurrent jobs";
+
+        const auto generate_shard = [&generate] (const string& filename, unsigned long nEvents, unsigned seed) {
+            gRandom->SetSeed(seed);
+            generate(filename, nEvents, seed);
+        };
 
-    // add TID tree for the generated events
+        if(!PlutoShards::Generate(generate_shard, shardfiles, numEvents, jobs, cmd_seed->getValue())) {
+            LOG(ERROR) << "At least one shard failed";
+            return EXIT_FAILURE;
+        }
+
+        if(cmd_noMerge->isSet()) {
+            LOG(INFO) << "Shards written to " << shardfiles.front() << " ... " << shardfiles.back();
+            outfiles = shardfiles;
+        }
+        else {
+            LOG(INFO) << "Merge shards into " << outfile;
+            try {
+                PlutoShards::Merge(outfile, shardfiles);
+            }
+            catch(const std::exception& e) {
+                LOG(ERROR) << "Merging shards failed: " << e.what();
+                return EXIT_FAILURE;
+            }
+            outfiles.push_back(outfile);
+        }
+    }
+
+    // add TID tree for the generated events,
+    // unmerged shards get consecutive ranges to stay unique when chained
     if(!cmd_noTID->isSet()) {
-        LOG(INFO) << "Add TID tree to the output file";
-        mc::pluto::utils::PlutoTID::AddTID(outfile);
+        unsigned long firstIndex = 0;
+        for(const auto& f : outfiles) {
+            LOG(INFO) << "Add TID tree to the output file " << f;
+            firstIndex += PlutoTID::AddTID(f, firstIndex);
+        }
     }
 
     return EXIT_SUCCESS;
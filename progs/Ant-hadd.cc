@@ -17,6 +17,7 @@
 #include <list>
 #include <string>
 #include <map>
+#include <vector>
 
 using namespace std;
 using namespace ant;
@@ -88,6 +89,9 @@ int main( int argc, char **argv )
    TCLAP::CmdLine cmd("Ant-hadd - Merge ROOT objects in files", ' ', "0.1");
    auto cmd_verbose = cmd.add<TCLAP::ValueArg<int>>("v","verbose","Verbosity level (0..9)", false, 0,"int");
    auto cmd_nativemode = cmd.add<TCLAP::MultiSwitchArg>("","native","Run native TFileMerger, is slow on large trees",false);
+   auto cmd_jobs = cmd.add<TCLAP::ValueArg<unsigned>>("j","jobs","Merge in a tree of partial merges using this many worker processes", false, 0,"int");
+   auto cmd_maxopen = cmd.add<TCLAP::ValueArg<unsigned>>("","max-open","Maximum number of files opened per partial merge, used with --jobs", false, 32,"int");
+   auto cmd_skipbroken = cmd.add<TCLAP::SwitchArg>("","skip-broken","Skip input files which cannot be opened, the result is then incomplete",false);
    auto cmd_filenames  = cmd.add<TCLAP::UnlabeledMultiArg<string>>("files","ROOT files, first one is output",true,"ROOT files");
    cmd.parse(argc, argv);
    if(cmd_verbose->isSet()) {
@@ -118,12 +122,6 @@ int main( int argc, char **argv )
        exit(EXIT_SUCCESS);
    }
 
-   auto outputfile = std_ext::make_unique<TFile>(outputfilename.c_str(), "RECREATE");
-   hadd::sources_t sources;
-   for(const auto& filename : filenames) {
-       sources.emplace_back(std_ext::make_unique<TFile>(filename.c_str(), "READ"));
-   }
-
    // progress updates only when running interactively
    if(std_ext::system::isInteractive())
        ProgressCounter::Interval = 3;
@@ -134,11 +132,25 @@ int main( int argc, char **argv )
        nPaths = 0;
    });
 
-   hadd::MergeRecursive(*outputfile, sources, nPaths);
+   const vector<string> inputfilenames(filenames.begin(), filenames.end());
 
-   LOG(INFO) << "Finished, writing file " << outputfile->GetName();
+   try {
+       if(cmd_jobs->isSet()) {
+           LOG(INFO) << "Merging " << inputfilenames.size() << " files with " << cmd_jobs->getValue() << " jobs";
+           hadd::MergeParallel(outputfilename, inputfilenames,
+                               cmd_jobs->getValue(), cmd_maxopen->getValue(), nPaths,
+                               cmd_skipbroken->isSet());
+       }
+       else {
+           hadd::MergeFiles(outputfilename, inputfilenames, nPaths, cmd_skipbroken->isSet());
+       }
+   }
+   catch(const std::exception& e) {
+       LOG(ERROR) << "Merging failed: " << e.what();
+       exit(EXIT_FAILURE);
+   }
 
-   outputfile->Write();
+   LOG(INFO) << "Finished, written file " << outputfilename;
 
    exit(EXIT_SUCCESS);
 }
@@ -20,6 +20,7 @@
 #include "calibration/fitfunctions/FitFunction.h"
 #include "calibration/fitfunctions/BaseFunctions.h"
 #include "analysis/plot/HistogramFactory.h"
+#include "analysis/utils/CoherentBremsstrahlung.h"
 
 #include "TFile.h"
 #include "TH1.h"
@@ -36,6 +37,9 @@
 #include "Math/Functor.h"
 #include "TRandom2.h"
 
+#include <sys/wait.h>
+#include <thread>
+
 using namespace ant;
 using namespace std;
 using namespace ant::analysis;
@@ -46,6 +50,7 @@ using namespace ant::calibration;
 static volatile bool interrupt = false;
 static bool noStore = false;
 static bool histOut = false;
+static bool quiet = false;
 
 // global histograms
 HistogramFactory *histfac;
@@ -53,30 +58,28 @@ TH1D *hDataEnh = NULL;
 TH1D *hDataRawEnh = NULL;
 TH1D *hCalcEnh = NULL;
 TH1D *hPol = NULL;
-//these are really just convenient arrays - they don't ever get plotted.
-TH1F *weightHist  = NULL;
-TH2F *thetaWeight = NULL;
-TH2F *thetaPol    = NULL;
-TH2F *thetaTtot   = NULL;
-TH2F *thetaItot   = NULL;
+
+// the model, evaluated for all bins of hCalcEnh at once
+unique_ptr<utils::CoherentBremsstrahlung> cbrem;
+vector<double> calcEnh;
+vector<double> calcPol;
 
 // functions
 Double_t efit(const Double_t *);
-void enhFromHuman(Double_t beamMeV = 883.0, Double_t edgeMeV = 145.0, Double_t spreadMeV = 10.0, Double_t colliDist_m = 2.5, Double_t colliRad_mm = 1.0, Int_t nVec = 4);
-void parFromHuman(Double_t beamMeV = 883.0, Double_t edgeMeV = 145.0, Double_t spreadMeV = 10.0, Double_t colliDist_m = 2.5, Double_t colliRad_mm = 1.0, Int_t nVec = 4, Double_t *par=NULL);
-void enhFromParams(Double_t *par=NULL);
+void enhFromParams(const Double_t *par);
 void init();
+void processRuns(const string& polFile, const string& unpolFile, double colliDist_m, double colliRad_mm, int nVec);
 
 
-//Some enumerators and names
+//Some enumerators and names, see utils::CoherentBremsstrahlung
 enum {
-  THETA,  // [0] theta      main angle responsible for coherent edge cutoffs
-  SIGMA,  // [1] sigma      smearing of theta
-  THETAR, // [2] thetar     relative angle resonsible for colli cutoffs
-  SIGMAR, // [3] sigmar     smearing of colli cutoff angle
-  E0MEV,  // [4] beam energy
-  NVEC,   // [5] nvec       no of vectors contributing
-  IVEC};  // [6] ivec[]     array of intensities of vectors up to nvec.
+  THETA  = utils::CoherentBremsstrahlung::Theta,
+  SIGMA  = utils::CoherentBremsstrahlung::Sigma,
+  THETAR = utils::CoherentBremsstrahlung::ThetaR,
+  SIGMAR = utils::CoherentBremsstrahlung::SigmaR,
+  E0MEV  = utils::CoherentBremsstrahlung::E0MeV,
+  NVEC   = utils::CoherentBremsstrahlung::NVec,
+  IVEC   = utils::CoherentBremsstrahlung::IVec};
 
 
 // Some basic consts etc first
@@ -85,9 +88,8 @@ enum {
 //Where b= 111 x Z^(-1/3) (x 925 to get into units of crystal lattice)
 const Double_t B = 0.247892436;  //where did I get that ? Timm ?
 const Double_t A=0.03;           //made up for now, need to get the actual no for this later
-const Double_t k=26.5601;        //put in formula for k later (my own stonehenge paper)
 
-const Int_t VECTORS[]={2,4,6,8,10};    //list of the vectors to be included (022,044);
+const auto& VECTORS = utils::CoherentBremsstrahlung::Vectors;    //list of the vectors to be included (022,044);
 
 //THESE NEED TO BE CHANGED FOR EACH SETTING (ie comment in/out)
 Int_t THETASTEPS = 201;          //no of steps in convoluting with gaussian
@@ -103,7 +105,7 @@ Int_t fitMinBin;
 Double_t fitMaxEnergy;
 Int_t fitMaxBin;
 Int_t verbose=0;
-Double_t bestPar[10];
+vector<Double_t> bestPar;
 Double_t bestChisq;
 TF1 *gausFit;
 Bool_t isInit=kFALSE;
@@ -124,17 +126,18 @@ int main( int argc, char** argv )
     });
 
     //-- Read from the command line
-    TCLAP::CmdLine cmd("Ant-makeLinPol - Create LinPol tables from tagging efficiency runs - one polarised and one unpolarised run", ' ', "0.1");
+    TCLAP::CmdLine cmd("Ant-makeLinPol - Create LinPol tables from tagging efficiency runs - pairs of one polarised and one unpolarised run", ' ', "0.1");
     //--- other settings:
     auto cmd_output    = cmd.add<TCLAP::ValueArg<string>>("o", "output", "Output file", false, "", "filename");
     auto cmd_colliDist = cmd.add<TCLAP::ValueArg<double>>("", "colliDist", "Distance to collimeter? (m)",false,3.0,"colliDist");
     auto cmd_colliRad  = cmd.add<TCLAP::ValueArg<double>>("", "colliRad", "Radius of collimeter? (mm)",false,1.0,"colliRad");
     auto cmd_nVec      = cmd.add<TCLAP::ValueArg<int>>("", "nVec", "Number of harmonics????",false,3,"nVec");
+    auto cmd_jobs      = cmd.add<TCLAP::ValueArg<unsigned>>("j", "jobs", "Number of run pairs fitted concurrently as forked processes (default: number of cores)", false, 0, "n");
     //--- switches
     auto cmd_batchmode = cmd.add<TCLAP::SwitchArg>("b", "batch",   "Run in batch mode (no ROOT shell afterwards)");
     auto cmd_nostore   = cmd.add<TCLAP::SwitchArg>("n", "nostore", "Don't store polarisation tables in the calibration database, only show results");
     //--- files
-    auto cmd_filelist  = cmd.add<TCLAP::UnlabeledMultiArg<string>>("inputfiles", "Input files to read from", true, "Pol-inputfile UnPol-inputfile");
+    auto cmd_filelist  = cmd.add<TCLAP::UnlabeledMultiArg<string>>("inputfiles", "Input files to read from", true, "Pol-inputfile UnPol-inputfile [Pol-inputfile UnPol-inputfile ...]");
     cmd.parse(argc, argv);
     auto fileList = cmd_filelist->getValue();
     auto colliDist_m = cmd_colliDist->getValue();
@@ -142,19 +145,115 @@ int main( int argc, char** argv )
     auto nVec = cmd_nVec->getValue();
     noStore = cmd_nostore->isSet();
     histOut = cmd_output->isSet();
+    if(fileList.size() % 2 != 0)
+        failExit("Need pairs of polarised and unpolarised input files");
+    const unsigned nRuns = fileList.size()/2;
 
     //-- what the heck does this do?
     argc=0; // prevent TRint to parse any cmdline (?)
     TRint app("Ant-makeLinPol",&argc,argv,nullptr,0,true);
+
+    if(nRuns > 1) {
+        // the fits are independent, but ROOT and Minuit keep global state,
+        // so each run pair is fitted in its own forked process with its own output file
+        const unsigned jobs = min(nRuns, cmd_jobs->getValue() > 0 ? cmd_jobs->getValue() : max(1u, thread::hardware_concurrency()));
+        if(!cmd_batchmode->isSet())
+            LOG(INFO) << "Several run pairs given, running in batch mode";
+
+        // waits for one worker, returns false if it failed
+        auto wait_for_worker = [] () {
+            int status = 0;
+            if(::wait(addressof(status)) < 0)
+                throw std::runtime_error("Waiting for worker process failed");
+            return WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+        };
+
+        LOG(INFO) << "Fitting " << nRuns << " run pairs with " << jobs << " concurrent jobs";
+
+        unsigned nRunning = 0;
+        bool failed = false;
+        for(unsigned run=0;run<nRuns;run++) {
+            while(nRunning >= jobs) {
+                failed |= !wait_for_worker();
+                nRunning--;
+            }
+
+            const auto pid = fork();
+            if(pid < 0)
+                throw std::runtime_error("Cannot fork worker process");
+            if(pid == 0) {
+                // in worker process, never return
+                try {
+                    quiet = true;
+                    unique_ptr<WrapTFileOutput> masterFile;
+                    if(cmd_output->isSet()) {
+                        const auto& outfile = cmd_output->getValue();
+                        const auto basename = std_ext::string_ends_with(outfile, ".root")
+                                              ? outfile.substr(0, outfile.size()-5) : outfile;
+                        masterFile = std_ext::make_unique<WrapTFileOutput>(std_ext::formatter() << basename << "_" << run << ".root", true);
+                    }
+                    processRuns(fileList.at(2*run), fileList.at(2*run+1), colliDist_m, colliRad_mm, nVec);
+                    masterFile = nullptr;
+                }
+                catch(const std::exception& e) {
+                    LOG(ERROR) << "Fitting " << fileList.at(2*run) << " failed: " << e.what();
+                    _exit(EXIT_FAILURE);
+                }
+                _exit(EXIT_SUCCESS);
+            }
+            nRunning++;
+        }
+
+        while(nRunning > 0) {
+            failed |= !wait_for_worker();
+            nRunning--;
+        }
+
+        if(failed) {
+            LOG(ERROR) << "At least one run pair failed";
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     unique_ptr<WrapTFileOutput> masterFile;
     if(cmd_output->isSet()) {
         // cd into masterFile upon creation
         masterFile = std_ext::make_unique<WrapTFileOutput>(cmd_output->getValue(), true);
     }
 
+    processRuns(fileList.at(0), fileList.at(1), colliDist_m, colliRad_mm, nVec);
+
+    TCanvas *c = new TCanvas("c","c",800,800); c->Divide(2,2);
+    c->cd(1); hDataEnh->Draw(); gausFit->Draw("same");
+    c->cd(2); hDataRawEnh->Draw();
+    c->cd(3); hCalcEnh->Draw();
+    c->cd(4); hPol->Draw();
+
+
+    if(!cmd_batchmode->isSet()) {
+        if(!std_ext::system::isInteractive()) {
+            LOG(INFO) << "No TTY attached. Not starting ROOT shell.";
+        }
+        else {
+            if(masterFile)
+                LOG(INFO) << "Close ROOT properly to write data to disk.";
+
+            app.Run(kTRUE); // really important to return...
+            if(masterFile)
+                LOG(INFO) << "Writing output file...";
+            masterFile = nullptr;   // and to destroy the master WrapTFile before TRint is destroyed
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void processRuns(const string& polFile, const string& unpolFile, double colliDist_m, double colliRad_mm, int nVec)
+{
     //-- Open the inputfiles, fetch the scalar distributions and create the enhancement spectrum
-    TFile *fPol = new TFile((TString)fileList.at(0),"read");
-    TFile *fUnpol = new TFile((TString)fileList.at(1),"read");
+    TFile *fPol = new TFile((TString)polFile,"read");
+    TFile *fUnpol = new TFile((TString)unpolFile,"read");
     TH1D *hPolScaler_in = (TH1D*)fPol->Get("ProcessTaggEff/scalerHits");
     TH1D *hUnpolScaler_in = (TH1D*)fUnpol->Get("ProcessTaggEff/scalerHits");
     //--- Get the setup name from the first root-file
@@ -217,9 +316,6 @@ int main( int argc, char** argv )
         hDataRawEnh->SetBinError(i,enherr);
     }
 
-    //-- Some stuff needed later on
-    Double_t par[10];
-
     //-- In cbremFit_R there would here be some loops to get rid of zeros and spikes (aka THE SMOOTHY BIT)
 
     //-- Find a reasonable minumum spot to set to 1 for the baseline.
@@ -255,7 +351,7 @@ int main( int argc, char** argv )
     cout << "edge = " << fitedge << " MeV" << endl;
 
     //Now we have enough information to set the basic parameters
-    parFromHuman(beamMeV,fitedge,gausFit->GetParameter(2),colliDist_m,colliRad_mm,nVec,par);
+    auto par = utils::CoherentBremsstrahlung::ParametersFromHuman(beamMeV,fitedge,gausFit->GetParameter(2),colliDist_m,colliRad_mm,nVec);
 
     //set the intensities
     for(int v=0;v<par[NVEC];v++){                                               //give the vectors intensities
@@ -263,14 +359,14 @@ int main( int argc, char** argv )
       //cout << IVEC+v << "  v   " << par[IVEC+v] << endl;
     }
 
-    enhFromParams(par);
+    enhFromParams(par.data());
 
     //Redo the intensities according to a the calc / data ration
     double scalefac=hDataEnh->GetMaximum()/hCalcEnh->GetMaximum();
     for(int v=0;v<par[NVEC];v++){                                               //give the vectors intensities
       par[IVEC+v]*=scalefac;
     }
-    enhFromParams(par);
+    enhFromParams(par.data());
 
     //-- ?? DRAW SOMETHING HERE? ??
 
@@ -285,7 +381,7 @@ int main( int argc, char** argv )
     min->SetMaxFunctionCalls(1000000); // for Minuit/Minuit2
     min->SetMaxIterations(10000);  // for GSL
     min->SetTolerance(0.001);
-    min->SetPrintLevel(1);
+    min->SetPrintLevel(quiet ? 0 : 1);
     ROOT::Math::Functor ft(&efit,IVEC+nVec);
     min->SetFunction(ft);
     //---- set the variables
@@ -302,34 +398,15 @@ int main( int argc, char** argv )
     }
     //--- do the fit
     bestChisq=100000.00;
+    bestPar=par;
     min->Minimize();
 
     //--- use the resulting parameters
-    enhFromParams(bestPar);
-
-    TCanvas *c = new TCanvas("c","c",800,800); c->Divide(2,2);
-    c->cd(1); hDataEnh->Draw(); gausFit->Draw("same");
-    c->cd(2); hDataRawEnh->Draw();
-    c->cd(3); hCalcEnh->Draw();
-    c->cd(4); hPol->Draw();
-
-
-    if(!cmd_batchmode->isSet()) {
-        if(!std_ext::system::isInteractive()) {
-            LOG(INFO) << "No TTY attached. Not starting ROOT shell.";
-        }
-        else {
-            if(masterFile)
-                LOG(INFO) << "Close ROOT properly to write data to disk.";
-
-            app.Run(kTRUE); // really important to return...
-            if(masterFile)
-                LOG(INFO) << "Writing output file...";
-            masterFile = nullptr;   // and to destroy the master WrapTFile before TRint is destroyed
-        }
-    }
+    enhFromParams(bestPar.data());
+    LOG(INFO) << "Fitted " << polFile << ": Chisq=" << bestChisq
+              << " Theta=" << bestPar[THETA] << " Sigma=" << bestPar[SIGMA]
+              << " Thetar=" << bestPar[THETAR] << " Sigmar=" << bestPar[SIGMAR];
 
-    return EXIT_SUCCESS;
 }
 
 //The main customized fitting function which gets called by MINUIT
@@ -339,10 +416,7 @@ Double_t efit(const Double_t *parms){
     Double_t delta;
     Double_t b1,b2;
     Double_t err;
-    Double_t *par = (Double_t*)parms;
-
-    hCalcEnh->Reset("ICE"); //reset the histogram
-    //  cout << "par[0]= " << par[0] << endl;
+    const Double_t *par = parms;
 
     //call the function to make the enhancement and polarization
     enhFromParams(par);
@@ -358,74 +432,21 @@ Double_t efit(const Double_t *parms){
         //note - not a proper chisq because its an enhancement
     }
 
-    fprintf(stderr,"Chisq: \t%6.2f\t\r",chisq);
+    if(!quiet)
+        fprintf(stderr,"Chisq: \t%6.2f\t\r",chisq);
 
     if(chisq<bestChisq){
         bestChisq=chisq;
-        for(int n=0;n<10;n++){
-            bestPar[n]=par[n];
-        }
+        bestPar.assign(par, par+IVEC+(int)par[NVEC]);
     }
     return chisq;
 }
 
-void parFromHuman(Double_t beamMeV, Double_t edgeMeV, Double_t spreadMeV, Double_t colliDist_m, Double_t colliRad_mm, Int_t nVec, Double_t *par){
-
-  //takes some physical quantities and makes them into parameters, then calls the
-  //enhFromParams function.
-
-  //  Double_t par[10];                                                           //array of parameters
-  Int_t g = 2;                                                                //variables used in CLAS note
-  Double_t E0 = beamMeV;
-  Double_t Eg = edgeMeV;
-
-
-  par[THETA]  = k/(g*E0*E0*((1/Eg)-(1/E0)));                                  //theta from edge and beam energy
-  par[SIGMA]  = (par[THETA]-(k/(g*E0*E0*((1/(Eg-spreadMeV))-(1/E0)))))/3.0;   //spread in theta from spread in edge
-  par[THETAR] = E0*0.001*5.0*colliRad_mm/colliDist_m;                         //cut from collimator
-  par[SIGMAR] = par[THETAR]*par[SIGMA]/par[THETA];                            //smear in above same fractional sigma as above
-  par[E0MEV]  = E0;                                                           //beam energy
-  par[NVEC]   = (Double_t)nVec;                                                         //no of harmonics
-
-  for(int v=0;v<par[NVEC];v++){                                               //give the vectors intensities
-    par[IVEC+v] = 2.0/(Double_t)VECTORS[v];                                   //tailing off as 1/VECTORS[v]
-    //cout << IVEC+v << "  v   " << par[IVEC+v] << endl;
-  }
-}
-
-void enhFromParams(Double_t *par){
+void enhFromParams(const Double_t *par){
   //make an enhancement and corresponding polarization from some the parameters as defined in the CLAS note.
   //this function is can be called stand alone, but will also ba called many times from the fitting function
 
-  Double_t xd[10];
-  Double_t xc[10];
-  Double_t Q[10];
-  Double_t cohContrib;
-  Double_t cohTotal;
-  Double_t phiTotal;
-  Double_t etotal;
-  Double_t ptotal;
-  Double_t x=0.0;
-  Int_t    g=0;
-  Double_t weight=0.0;
-  Double_t weightSum=0.0;
-  Double_t polSum=0.0;
-  Double_t phi,chi,cd;
-  Double_t amo;
-  Int_t jbin=0;
-
-  //loop over sigma
-  // for(int p=0;p<10;p++){
-  //  cout << p << ": " << par[p] << ", ";
-  //}
-  //cout << endl;
-
   // if needed, make some hists
-  int nchannelsused = energy_bin_edges.size() - 1;
-  double energy_bins[nchannelsused+1];
-  for(int i=0; i<nchannelsused+1;i++){
-      energy_bins[i] = energy_bin_edges.at(i);
-  }
   if(!hCalcEnh){
       hCalcEnh = histfac->makeTH1D("CalculatedEnhancement",energy_bin_edges,"Photon energy","","hCalcEnh",true);
       hPol = histfac->makeTH1D("Polarisation",energy_bin_edges,"Photon energy","","hPol",true);
@@ -433,101 +454,22 @@ void enhFromParams(Double_t *par){
       hPol->SetMinimum(0);
       hPol->SetMaximum(1);
   }
-  //-- make some useful arrays/histograms not plotted
-  if(!thetaPol){
-      weightHist   = new TH1F("weightHist",  "weightHist", THETASTEPS+1, 0, THETASTEPS+1 );
-      thetaWeight  = new TH2F("thetaWeight", "thetaWeight",nchannelsused,energy_bins, THETASTEPS+1,0, THETASTEPS+1);
-      thetaPol     = new TH2F("thetaPol",    "thetaPol",   nchannelsused,energy_bins, THETASTEPS+1,0, THETASTEPS+1);
-      thetaItot    = new TH2F("thetaItot",   "thetaItot",  nchannelsused,energy_bins, THETASTEPS+1,0, THETASTEPS+1);
+  //-- the model only depends on the bin centers
+  if(!cbrem){
+      vector<double> energies;
+      for(int bin=1;bin<=hCalcEnh->GetNbinsX();bin++)
+          energies.push_back(hCalcEnh->GetBinCenter(bin));
+      cbrem = std_ext::make_unique<utils::CoherentBremsstrahlung>(energies, THETASTEPS);
   }
 
-  //reset them all for fresh filling
+  cbrem->Calculate(par, calcEnh, calcPol);
+
+  //reset them for fresh filling
   hCalcEnh->Reset("ICE");
   hPol->Reset("ICE");
-  thetaPol->Reset("ICE");
-  thetaItot->Reset("ICE");
-  weightHist->Reset("ICE");
-  thetaWeight->Reset("ICE");
-
-  for(Double_t j=par[THETA]-3.0*par[SIGMA];j<=par[THETA]+3.001*par[SIGMA];j+=(6.0*par[SIGMA])/THETASTEPS){
-      weight=TMath::Gaus(j,par[THETA],par[SIGMA]);   //get the weight from the gaussian
-      weightSum+=weight;                             //add to sum
-      //find the discontinuity for each vector
-      for(int v=0;v<par[NVEC];v++){
-          g=VECTORS[v];
-          xd[v]=1.0/((k/(g*par[E0MEV]*j))+1.0);
-          Q[v]=(1.0-xd[v])/xd[v];
-          xc[v]=xd[v]/(1+((par[THETAR]*par[THETAR])*(1-xd[v])));
-      }
-
-      //loop over all bins in the histogram
-      for(int bin=1;bin<=hCalcEnh->GetNbinsX();bin++){
-          x=hCalcEnh->GetBinCenter(bin)/par[E0MEV];            //find the value of the bin
-          amo=1/x;                                    //assume amo = inc = 1/x over regio of interest
-          cohTotal=0.0;
-          phiTotal=0.0;
-
-          //loop over all the vectors
-          for(int v=0;v<par[NVEC];v++){
-              if(x>xd[v]) continue;           //only do up to x_dg
-
-              //work out chi and phi
-              phi=(2*Q[v]*Q[v]*x*x)/((1-x)*(1+((1-x)*(1-x))-((4*Q[v]*Q[v]*x*x/(1-x))*(((1-x)/(Q[v]*x))-1))));
-              chi=((Q[v]*Q[v]*x)/(1-x))*(1+((1-x)*(1-x))-((4*Q[v]*Q[v]*x*x/(1-x))*(((1-x)/(Q[v]*x))-1)));
-              //	cout << j  << "  " << chi << endl;
-              cd=0.5*(1+TMath::Erf((x-xc[v])/(TMath::Sqrt(2)*par[SIGMAR])));
-
-              //get coherent contrib for the vector
-              cohContrib=cd*par[IVEC+v]*chi;
-
-              //add to the total and update the phi total
-              cohTotal+=cohContrib;
-              phiTotal+=cohContrib*phi;
-          }
-          //MINEcout<<cohTotal<<" "<<phiTotal<<endl;
-          if(cohTotal>0.0) {
-              phiTotal/=cohTotal;   //divide by the cohTotal to get the weighted dmean phi
-              //cout << x << " " << phiTotal << " " << cohTotal << " " << weight << endl;
-          }
-
-          //enhancement = coherent total + inc (or amo).
-          etotal=(amo+cohTotal)/amo;
-          //and pol like this
-          //      ptotal=phiTotal*cohTotal/(cohTotal + amo);
-          ptotal=phiTotal*cohTotal;
-
-          //add the weighted contribution to the enhancement
-          hCalcEnh->Fill(x*par[E0MEV],weight*etotal);
-
-          //keep the pol for this x,theta coord
-          thetaPol->Fill(x*par[E0MEV],jbin,ptotal);
-
-          //keep the total intensity for this x,theta coord
-          thetaItot->Fill(x*par[E0MEV],jbin,cohTotal+amo);
-      }
-
-      //save the weight for this theta point
-      weightHist->Fill(jbin,weight);
-      jbin++;
-  }
-  //normalize the sum of the weighted enhancements
-  hCalcEnh->Scale(1.0/weightSum);
-
-  //loop over each x bin, adding the weighted contribs from each theta pos
-  for(int bin=1; bin<=hPol->GetNbinsX(); bin++){
-      weightSum=0.0;
-      polSum=0.0;
-
-      for(int jb=1;jb<=weightHist->GetNbinsX();jb++){
-          weight=weightHist->GetBinContent(jb);
-          //      polSum+=thetaPol->GetBinContent(bin,jb)*thetaItot->GetBinContent(bin,jb)*weight;
-          polSum+=thetaPol->GetBinContent(bin,jb)*weight;
-          weightSum+=thetaItot->GetBinContent(bin,jb)*weight;
-          //polSum+=thetaPol->GetBinContent(bin,jb)*weight;
-          //weightSum+=weight;
-      }
-      polSum/=weightSum;
-      hPol->Fill(hPol->GetBinCenter(bin),polSum);
+  for(int bin=1;bin<=hCalcEnh->GetNbinsX();bin++){
+      hCalcEnh->SetBinContent(bin, calcEnh[bin-1]);
+      hPol->SetBinContent(bin, calcPol[bin-1]);
   }
 }
 
@@ -10,6 +10,7 @@
 #include "base/ProgressCounter.h"
 #include "base/std_ext/string.h"
 #include "base/Array2D.h"
+#include "base/tmpfile_t.h"
 
 #include "analysis/plot/RootDraw.h"
 #include "base/BinSettings.h"
@@ -23,6 +24,11 @@
 #include "TFitResult.h"
 #include "TCanvas.h"
 
+#include <atomic>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
 using namespace ant;
 using namespace std;
 using namespace ant::analysis;
@@ -180,17 +186,87 @@ struct FitSlices1DHists {
     TH2D* Entries = nullptr;
 };
 
+struct SliceStats_t {
+    double Integral = 0;
+    double Mean = 0;
+    double RMS = 0;
+};
+
+/**
+ * @brief calcSliceStats calculates integral, mean and RMS of all z-projections
+ *        as projectZ would give them, concurrently in the given number of threads
+ * @param hist
+ * @param jobs
+ * @return stats for bin (x,y) at index (x-1)+(y-1)*nBinsX
+ */
+vector<SliceStats_t> calcSliceStats(const TH3D* hist, const unsigned jobs) {
+
+    const int nx = hist->GetNbinsX();
+    const int ny = hist->GetNbinsY();
+    const int nz = hist->GetNbinsZ();
+    const auto axis = hist->GetZaxis();
+
+    // copy the ROOT histogram first, the threads below only do arithmetic
+    // bin z=0 is underflow of the projection, so skip it right away
+    vector<double> centers;
+    for(int z=1;z<nz;z++)
+        centers.push_back(axis->GetBinCenter(z));
+    vector<double> contents;
+    contents.reserve(nx*ny*centers.size());
+    for(int y=1;y<=ny;y++)
+        for(int x=1;x<=nx;x++)
+            for(int z=1;z<nz;z++)
+                contents.push_back(hist->GetBinContent(x,y,z));
+
+    vector<SliceStats_t> stats(nx*ny);
+    atomic<int> next_slice{0};
+    auto worker = [&] () {
+        for(int i=next_slice++; i<int(stats.size()); i=next_slice++) {
+            // accumulate in same order as TH1::Fill does for the projection
+            double sumw = 0, sumwx = 0, sumwx2 = 0;
+            auto it_content = contents.begin() + i*centers.size();
+            for(const auto& c : centers) {
+                const auto v = *it_content++;
+                if(v == .0)
+                    continue;
+                sumw   += v;
+                sumwx  += v*c;
+                sumwx2 += v*c*c;
+            }
+            auto& s = stats[i];
+            s.Integral = sumw;
+            if(sumw == 0)
+                continue;
+            // as TH1::GetMean and TH1::GetRMS
+            s.Mean = sumwx/sumw;
+            s.RMS = std::sqrt(std::abs(sumwx2/sumw - s.Mean*s.Mean));
+        }
+    };
+
+    vector<thread> threads;
+    for(unsigned j=1;j<jobs;j++)
+        threads.emplace_back(worker);
+    worker();
+    for(auto& t : threads)
+        t.join();
+
+    return stats;
+}
+
 FitSlices1DHists FitSlicesZ(const TH3D* hist,
                             const HistogramFactory& HistFac,
                             const string& title="",
                             const double integral_cut=1000.0,
-                            bool show_plots = false) {
+                            bool show_plots = false,
+                            const unsigned jobs = 1) {
 
     HistogramFactory hf(formatter() << hist->GetName() << "_FitZ", HistFac);
 
     const auto xbins = TH_ext::getBins(hist->GetXaxis());
     const auto ybins = TH_ext::getBins(hist->GetYaxis());
 
+    const auto sliceStats = calcSliceStats(hist, jobs);
+
     FitSlices1DHists result;
 
     result.RMS  = hf.makeTH2D(
@@ -229,15 +305,13 @@ FitSlices1DHists FitSlicesZ(const TH3D* hist,
 
             auto slice = projectZ(hist, x+1, y+1, hf);
 
-            const auto integral = slice->Integral();
+            const auto& stats = sliceStats.at(x+y*xbins.Bins());
+            const auto integral = stats.Integral;
             result.Entries->SetBinContent(x+1,y+1, integral);
 
             if(integral > integral_cut) {
-                const auto rms = slice->GetRMS();
-                const auto mean = slice->GetMean();
-
-                result.RMS->SetBinContent(x+1,y+1, rms);
-                result.Mean->SetBinContent(x+1,y+1, mean);
+                result.RMS->SetBinContent(x+1,y+1, stats.RMS);
+                result.Mean->SetBinContent(x+1,y+1, stats.Mean);
 
             } else {
                 c << padoption::SetFillColor(kGray);
@@ -263,11 +337,12 @@ struct NewSigmas_t {
 
 NewSigmas_t makeNewSigmas(const TH3D* pulls, const TH3D* sigmas,
                           const HistogramFactory& HistFac, const string& label,
-                          const string& treename, const double integral_cut, const bool show_plots) {
+                          const string& treename, const double integral_cut, const bool show_plots,
+                          const unsigned jobs) {
     const string newTitle = formatter() << "New " << sigmas->GetTitle();
 
-    auto pull_values  = FitSlicesZ(pulls,  HistFac, treename, integral_cut, show_plots);
-    auto sigma_values = FitSlicesZ(sigmas, HistFac, treename, integral_cut, show_plots);
+    auto pull_values  = FitSlicesZ(pulls,  HistFac, treename, integral_cut, show_plots, jobs);
+    auto sigma_values = FitSlicesZ(sigmas, HistFac, treename, integral_cut, show_plots, jobs);
 
     NewSigmas_t result;
 
@@ -311,6 +386,7 @@ int main( int argc, char** argv )
     auto cmd_fitprob_cut  = cmd.add<TCLAP::ValueArg<double>>("", "fitprob_cut" ,"Min. required Fit Probability",                 false, 0.01,"probability");
     auto cmd_integral_cut = cmd.add<TCLAP::ValueArg<double>>("", "integral_cut","Min. required integral in Bins",                false, 100.0,"integral");
     auto cmd_show_plots   = cmd.add<TCLAP::MultiSwitchArg>  ("", "show_plots"  ,"Show detail plots for each parameter",          false);
+    auto cmd_jobs         = cmd.add<TCLAP::ValueArg<unsigned>>("j","jobs",     "Number of processes filling and threads evaluating hists", false, 0, "jobs");
 
     cmd.parse(argc, argv);
 
@@ -318,6 +394,7 @@ int main( int argc, char** argv )
     const auto integral_cut = cmd_integral_cut->getValue();
     const auto treename = cmd_tree->getValue();
     const auto show_plots = cmd_show_plots->isSet();
+    const unsigned jobs = cmd_jobs->getValue() > 0 ? cmd_jobs->getValue() : max(1u, thread::hardware_concurrency());
 
     WrapTFileInput input(cmd_input->getValue());
 
@@ -453,35 +530,115 @@ int main( int argc, char** argv )
     }
 
     long long entry = 0;
+    long long progress_end = max_entries;
     ProgressCounter::Interval = 3;
     ProgressCounter progress(
-                [&entry, entries] (std::chrono::duration<double>) {
-        LOG(INFO) << "Processed " << 100.0*entry/entries << " %";
+                [&entry, &progress_end] (std::chrono::duration<double>) {
+        LOG(INFO) << "Processed " << 100.0*entry/progress_end << " %";
     });
 
-    for(entry=0;entry<max_entries;entry++) {
-        if(interrupt)
-            break;
+    auto fill_hists = [&] (utils::PullsWriter<>::PullTree_t& pulltree,
+                           const long long begin, const long long end, const bool tick) {
+        for(entry=begin;entry<end;entry++) {
+            if(interrupt)
+                break;
+
+            if(tick)
+                progress.Tick();
+            pulltree.Tree->GetEntry(entry);
+
+            if(pulltree.FitProb > fitprob_cut ) {
 
-        progress.Tick();
-        pulltree.Tree->GetEntry(entry);
+                for(auto n=0u;n<pulltree.Pulls().size();n++) {
+                    h_pulls.at(n)->Fill(cos(pulltree.Theta), pulltree.E,
+                                        pulltree.Pulls().at(n), pulltree.TaggW);
+                }
 
-        if(pulltree.FitProb > fitprob_cut ) {
+                for(auto n=0u;n<pulltree.Sigmas().size();n++) {
+                    h_sigmas.at(n)->Fill(cos(pulltree.Theta), pulltree.E,
+                                         pulltree.Sigmas().at(n), pulltree.TaggW);
+                }
 
-            for(auto n=0u;n<pulltree.Pulls().size();n++) {
-                h_pulls.at(n)->Fill(cos(pulltree.Theta), pulltree.E,
-                                    pulltree.Pulls().at(n), pulltree.TaggW);
+                h_CB_R_TAPS_L->Fill(cos(pulltree.Theta), pulltree.E,
+                                    pulltree.Values().at(nParamShowerDepth), pulltree.TaggW);
+                h_OldShowerDepth->Fill(cos(pulltree.Theta), pulltree.E,
+                                       pulltree.ShowerDepth, pulltree.TaggW);
             }
+        }
+    };
 
-            for(auto n=0u;n<pulltree.Sigmas().size();n++) {
-                h_sigmas.at(n)->Fill(cos(pulltree.Theta), pulltree.E,
-                                     pulltree.Sigmas().at(n), pulltree.TaggW);
+    if(jobs == 1 || max_entries < jobs) {
+        fill_hists(pulltree, 0, max_entries, true);
+    }
+    else {
+        // fill entry ranges in forked processes, as ROOT trees and hists are not thread-safe,
+        // each writes its hists to a file which are added up afterwards
+        std::vector<TH3D*> h_all = h_pulls;
+        h_all.insert(h_all.end(), h_sigmas.begin(), h_sigmas.end());
+        h_all.push_back(h_CB_R_TAPS_L);
+        h_all.push_back(h_OldShowerDepth);
+
+        tmpfolder_t tmpfolder;
+        vector<string> workerfiles;
+
+        LOG(INFO) << "Filling hists in " << jobs << " processes";
+        for(unsigned job=0;job<jobs;job++) {
+            workerfiles.emplace_back(std_ext::formatter() << tmpfolder.foldername << "/job" << job << ".root");
+            const auto pid = fork();
+            if(pid < 0)
+                throw std::runtime_error("Cannot fork worker process");
+            if(pid > 0)
+                continue;
+
+            // in worker process, never return
+            try {
+                const long long begin = max_entries*job/jobs;
+                const long long end = max_entries*(job+1)/jobs;
+                progress_end = end;
+
+                // open input again, file offsets are shared with parent
+                WrapTFileInput job_input(cmd_input->getValue());
+                utils::PullsWriter<>::PullTree_t job_pulltree;
+                if(!job_input.GetObject(treename, job_pulltree.Tree))
+                    throw std::runtime_error("Cannot find tree "+treename);
+                job_pulltree.LinkBranches();
+
+                // only the first job reports progress
+                fill_hists(job_pulltree, begin, end, job == 0);
+
+                WrapTFileOutput job_output(workerfiles.back());
+                for(auto h : h_all)
+                    job_output.WriteObject(h, h->GetName());
+            }
+            catch(const std::exception& e) {
+                LOG(ERROR) << "Job " << job << " failed: " << e.what();
+                _exit(EXIT_FAILURE);
             }
+            _exit(EXIT_SUCCESS);
+        }
+
+        bool failed = false;
+        for(unsigned job=0;job<jobs;job++) {
+            int status = 0;
+            if(::wait(addressof(status)) < 0)
+                throw std::runtime_error("Waiting for worker process failed");
+            failed |= !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS;
+        }
+        if(failed) {
+            LOG(ERROR) << "At least one job failed";
+            exit(EXIT_FAILURE);
+        }
 
-            h_CB_R_TAPS_L->Fill(cos(pulltree.Theta), pulltree.E,
-                                pulltree.Values().at(nParamShowerDepth), pulltree.TaggW);
-            h_OldShowerDepth->Fill(cos(pulltree.Theta), pulltree.E,
-                                   pulltree.ShowerDepth, pulltree.TaggW);
+        for(const auto& workerfile : workerfiles) {
+            WrapTFileInput job_hists(workerfile);
+            for(auto h : h_all) {
+                TH3D* h_job = nullptr;
+                if(!job_hists.GetObject(h->GetName(), h_job)) {
+                    LOG(ERROR) << "Cannot find " << h->GetName() << " in " << workerfile;
+                    exit(EXIT_FAILURE);
+                }
+                h->Add(h_job);
+            }
         }
     }
 
@@ -497,7 +654,7 @@ int main( int argc, char** argv )
                             h_sigmas.at(n),
                             HistFac,
                             label,
-                            treename,  integral_cut, show_plots);
+                            treename,  integral_cut, show_plots, jobs);
         results.emplace_back(r);
     }
 
@@ -511,8 +668,8 @@ int main( int argc, char** argv )
 
     ShowerDepthResult_t showerDepthResult;
     {
-        auto slices_OldShowerDepth  = FitSlicesZ(h_OldShowerDepth,  HistFac, treename, integral_cut, show_plots);
-        auto slices_CB_R_TAPS_L     = FitSlicesZ(h_CB_R_TAPS_L,   HistFac, treename, integral_cut, show_plots);
+        auto slices_OldShowerDepth  = FitSlicesZ(h_OldShowerDepth,  HistFac, treename, integral_cut, show_plots, jobs);
+        auto slices_CB_R_TAPS_L     = FitSlicesZ(h_CB_R_TAPS_L,   HistFac, treename, integral_cut, show_plots, jobs);
 
         showerDepthResult.CB_R_TAPS_L     = slices_CB_R_TAPS_L.Mean;
         showerDepthResult.OldShowerDepths = slices_OldShowerDepth.Mean;
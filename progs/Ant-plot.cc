@@ -5,6 +5,7 @@
 #include "base/std_ext/string.h"
 #include "base/std_ext/system.h"
 #include "base/ProgressCounter.h"
+#include "base/WrapTTree.h"
 #include "analysis/physics/Plotter.h"
 
 #include "tree/TAntHeader.h"
@@ -14,6 +15,8 @@
 #include "TRint.h"
 
 #include <list>
+#include <set>
+#include <cctype>
 
 using namespace ant;
 using namespace ant::analysis;
@@ -50,10 +53,12 @@ int main(int argc, char** argv) {
     auto cmd_verbose = cmd.add<TCLAP::ValueArg<int>>("v","verbose","Verbosity level (0..9)", false, 0,"int");
 
     TCLAP::ValuesConstraintExtra<decltype(analysis::PlotterRegistry::GetList())> allowedPlotters(PlotterRegistry::GetList());
-    auto cmd_plotters = cmd.add<TCLAP::MultiArg<string>>("p","Plotter","Plotter classes to run", true, &allowedPlotters);
+    auto cmd_plotters = cmd.add<TCLAP::MultiArg<string>>("p","Plotter","Plotter classes to run", false, &allowedPlotters);
+    auto cmd_plotters_opt = cmd.add<TCLAP::MultiArg<string>>("P","plotter-opt","Plotter class to run, with options: Plotter:key=val,key=val", false, "");
 
     auto cmd_batchmode = cmd.add<TCLAP::MultiSwitchArg>("b","batch","Run in batch mode (no ROOT shell afterwards)",false);
     auto cmd_maxevents = cmd.add<TCLAP::ValueArg<int>>("m","maxevents","Process only max events",false,0,"maxevents");
+    auto cmd_prefetch  = cmd.add<TCLAP::SwitchArg>("","prefetch","Prefetch the tree data asynchronously on a separate thread",false);
 
     auto cmd_options = cmd.add<TCLAP::MultiArg<string>>("O","options","Options for all physics classes, key=value",false,"");
 
@@ -62,6 +67,10 @@ int main(int argc, char** argv) {
         el::Loggers::setVerboseLevel(cmd_verbose->getValue());
     }
 
+    // plotters use WrapTTree::EnableReadAhead, prefetch already from opening the file on
+    if(cmd_prefetch->isSet())
+        WrapTTree::EnableAsyncPrefetching();
+
     WrapTFileInput inputfile(cmd_input->getValue());
 
     // check if there's a previous AntHeader present,
@@ -110,12 +119,60 @@ int main(int argc, char** argv) {
             }
         }
 
+        // several variants of the same plotter may run in one pass over the input,
+        // each one gets its own instance name and thus its own output directory.
+        // Plotters on the same tree share the branch reading, see WrapTTree
+        set<string> instancenames;
+        for(const auto& plotter : plotters)
+            instancenames.insert(plotter.plotter->GetName());
+
+        for(const auto& line : cmd_plotters_opt->getValue()) {
+
+            const auto colpos = line.find(":");
+            const auto plotter_name = line.substr(0,colpos);
+            const auto optstr = colpos == line.npos ? string() : line.substr(colpos+1);
+
+            string instancename = plotter_name;
+            if(!optstr.empty()) {
+                instancename += "_";
+                for(auto c : optstr)
+                    instancename += isalnum(c) ? c : '_';
+            }
+            for(unsigned i=2; instancenames.count(instancename)>0; i++)
+                instancename = plotter_name + "_" + to_string(i);
+            instancenames.insert(instancename);
+
+            auto options = make_shared<OptionsList>(popts);
+            options->SetOptions(optstr);
+            try {
+                plotters.emplace_back(PlotterRegistry::Create(plotter_name, inputfile, options, instancename));
+                maxEntries = max(maxEntries, plotters.back().entries);
+                LOG(INFO) << "Activated plotter '" << plotter_name << "' as instance '" << instancename << "' with options " << optstr;
+            } catch(const exception& e) {
+                LOG(ERROR) << "Could not create plotter \"" << line << "\": " << e.what();
+                return EXIT_FAILURE;
+            }
+
+            auto unused_opts = options->GetUnused();
+            if(!unused_opts.empty()) {
+                LOG(ERROR) << "Plotter '" << plotter_name << "' did not use the options: " << unused_opts;
+                LOG(INFO)  << "Did you mean: " << options->GetNotFound();
+                return EXIT_FAILURE;
+            }
+        }
+
+        if(plotters.empty()) {
+            LOG(ERROR) << "No plotter specified, use -p or -P";
+            return EXIT_FAILURE;
+        }
+
         auto unused_popts = popts->GetUnused();
         if(!unused_popts.empty()) {
             LOG(ERROR) << "These plotter options where not recognized: " << unused_popts;
             LOG(INFO)  << "Did you mean: " << popts->GetNotFound();
             return EXIT_FAILURE;
         }
+
     }
 
 
@@ -171,6 +228,16 @@ int main(int argc, char** argv) {
     LOG(INFO) << "Analyzed " << entry << " records"
               << ", speed " << entry/progress.GetTotalSecs() << " event/s";
 
+    const auto readStats = WrapTTree::GetReadStats();
+    if(readStats.Entries>0)
+        LOG(INFO) << "Reading trees took " << readStats.Seconds << " s ("
+                  << readStats.Bytes/1024.0/1024.0 << " MB), I/O wait fraction "
+                  << readStats.Seconds/progress.GetTotalSecs();
+    if(readStats.SharedEntries>0)
+        LOG(INFO) << readStats.SharedEntries << " tree entries were shared between plotters";
+
+    HistogramFactory::FlushBuffers();
+
     for(auto& plotter : plotters) {
         plotter.plotter->Finish();
     }
@@ -0,0 +1,148 @@
+/**
+  * @file Ant-setupbench.cc
+  * @brief Time the construction of the experimental setups
+  *
+  * Every Ant program constructs the setup with its detectors and calibration modules
+  * at startup. For each setup, the construction including detectors
+  * and calibrations is timed, repeated several times to get the best time.
+  * Then all setups are constructed at once, as ExpConfig::Setup::SetByTID did before it
+  * skipped the setups not matching by their registered time range,
+  * and SetByTID is timed with a TID within the time range of each setup.
+  * Use --results to append a single line per run to a file,
+  * which makes the numbers comparable across commits.
+  */
+
+#include "expconfig/ExpConfig.h"
+#include "expconfig/setups/SetupRegistry.h"
+#include "expconfig/setups/Setup.h"
+
+#include "tree/TID.h"
+#include "base/GitInfo.h"
+#include "base/std_ext/time.h"
+#include "tclap/CmdLine.h"
+#include "tclap/ValuesConstraintExtra.h"
+#include "base/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <list>
+#include <memory>
+
+using namespace std;
+using namespace ant;
+
+namespace {
+
+using clock_type = chrono::steady_clock;
+
+struct result_t {
+    string Name;
+    double Seconds = numeric_limits<double>::infinity(); // best of all repetitions
+    double SecondsByTID = numeric_limits<double>::infinity(); // same for SetByTID
+    size_t nDetectors = 0;
+    size_t nCalibrations = 0;
+};
+
+double seconds_since(const clock_type::time_point& start) {
+    return chrono::duration<double>(clock_type::now() - start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    SetupLogger();
+
+    TCLAP::CmdLine cmd("Ant-setupbench - time the construction of the setups", ' ', "0.1");
+
+    auto cmd_verbose = cmd.add<TCLAP::ValueArg<int>>("v","verbose","Verbosity level (0..9)", false, 0,"int");
+    auto setupnames = ExpConfig::Setup::GetNames();
+    TCLAP::ValuesConstraintExtra<decltype(setupnames)> allowedsetupnames(setupnames);
+    auto cmd_setups = cmd.add<TCLAP::MultiArg<string>>("s","setup","Setups to time, default all",false,&allowedsetupnames);
+    auto cmd_repeat = cmd.add<TCLAP::ValueArg<unsigned>>("","repeat","Construct each setup that often",false,5,"n");
+    auto cmd_results = cmd.add<TCLAP::ValueArg<string>>("","results","Append one line with the results to this file",false,"","filename");
+
+    cmd.parse(argc, argv);
+
+    if(cmd_verbose->isSet())
+        el::Loggers::setVerboseLevel(cmd_verbose->getValue());
+
+    if(cmd_setups->isSet()) {
+        setupnames.clear();
+        for(auto& name : cmd_setups->getValue())
+            setupnames.emplace_back(name);
+    }
+    const auto nRepeat = max(1u, cmd_repeat->getValue());
+
+    vector<result_t> results;
+    for(auto& setupname : setupnames) {
+        result_t result;
+        result.Name = setupname;
+        for(unsigned i=0;i<nRepeat;i++) {
+            const auto start = clock_type::now();
+            ExpConfig::Setup::SetByName(setupname);
+            auto& setup = ExpConfig::Setup::Get();
+            result.nDetectors = setup.GetDetectors().size();
+            result.nCalibrations = setup.GetCalibrations().size();
+            ExpConfig::Setup::Cleanup();
+            result.Seconds = min(result.Seconds, seconds_since(start));
+        }
+        LOG(INFO) << setw(40) << left << result.Name << right
+                  << " time=" << fixed << setprecision(2) << setw(8) << 1e3*result.Seconds << "ms"
+                  << " detectors=" << result.nDetectors
+                  << " calibrations=" << result.nCalibrations;
+        results.emplace_back(move(result));
+    }
+
+    // as done by ExpConfig::Setup::SetByTID, all setups exist at the same time
+    double seconds_all = numeric_limits<double>::infinity();
+    for(unsigned i=0;i<nRepeat;i++) {
+        const auto start = clock_type::now();
+        {
+            list<shared_ptr<expconfig::Setup>> setups;
+            for(auto& setupname : setupnames)
+                setups.emplace_back(expconfig::SetupRegistry::GetSetup(setupname));
+            ExpConfig::Setup::Cleanup();
+        }
+        seconds_all = min(seconds_all, seconds_since(start));
+    }
+
+    double seconds_sum = 0;
+    for(auto& result : results)
+        seconds_sum += result.Seconds;
+    LOG(INFO) << "All " << results.size() << " setups at once: " << fixed << setprecision(2)
+              << 1e3*seconds_all << "ms, sum of single setups: " << 1e3*seconds_sum << "ms";
+
+    // SetByTID as used by the unpacker, with a timestamp in the middle of the first day
+    for(auto& result : results) {
+        const auto timerange = expconfig::SetupRegistry::GetTimeRange(result.Name);
+        if(timerange.first.empty())
+            continue;
+        const TID tid(std_ext::to_time_t(timerange.first, false) + 12*3600, 0u);
+        for(unsigned i=0;i<nRepeat;i++) {
+            const auto start = clock_type::now();
+            ExpConfig::Setup::SetByTID(tid);
+            ExpConfig::Setup::Cleanup();
+            result.SecondsByTID = min(result.SecondsByTID, seconds_since(start));
+        }
+        LOG(INFO) << setw(40) << left << result.Name << right
+                  << " SetByTID time=" << fixed << setprecision(2) << setw(8) << 1e3*result.SecondsByTID << "ms";
+    }
+
+    if(cmd_results->isSet()) {
+        ofstream resultsfile(cmd_results->getValue(), ios::app);
+        resultsfile << GitInfo().GetDescription() << '\t'
+                    << "repeat=" << nRepeat << '\t'
+                    << "all=" << fixed << setprecision(3) << 1e3*seconds_all;
+        for(auto& result : results)
+            resultsfile << '\t' << result.Name << "=" << 1e3*result.Seconds
+                        << '/' << 1e3*result.SecondsByTID;
+        resultsfile << endl;
+        LOG(INFO) << "Results appended to " << cmd_results->getValue();
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -5,7 +5,9 @@
   */
 
 #include "analysis/input/DataReader.h"
+#include "analysis/input/ReadAheadReader.h"
 #include "analysis/input/ant/AntReader.h"
+#include "analysis/input/ant/RecoCache.h"
 #include "analysis/input/goat/GoatReader.h"
 #include "analysis/input/pluto/PlutoReader.h"
 #include "analysis/utils/ParticleID.h"
@@ -23,8 +25,10 @@
 #include "reconstruct/Reconstruct.h"
 
 #include "tree/TAntHeader.h"
+#include "tree/TID.h"
 
 #include "base/WrapTFile.h"
+#include "base/WrapTTree.h"
 #include "base/Logger.h"
 #include "tclap/CmdLine.h"
 #include "tclap/ValuesConstraintExtra.h"
@@ -37,6 +41,7 @@
 #include "TSystem.h"
 #include "TROOT.h"
 
+#include <fstream>
 #include <sstream>
 #include <string>
 #include <csignal>
@@ -47,6 +52,34 @@ using namespace ant;
 volatile bool interrupt = false;
 volatile bool terminated = false;
 
+// lines with "timestamp lower" or "flags timestamp lower",
+// numbers may be given in hex with 0x prefix, # starts a comment
+vector<TID> ReadTIDs(const string& filename) {
+    ifstream file(filename);
+    if(!file)
+        throw runtime_error("Cannot open TID list "+filename);
+    vector<TID> tids;
+    string line;
+    while(getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        istringstream ss(line);
+        vector<uint32_t> numbers;
+        string token;
+        while(ss >> token)
+            numbers.push_back(stoul(token, nullptr, 0));
+        if(numbers.empty())
+            continue;
+        if(numbers.size() == 2)
+            numbers.insert(numbers.begin(), 0);
+        if(numbers.size() != 3)
+            throw runtime_error("Cannot parse line '"+line+"' in TID list "+filename);
+        TID tid(numbers[1], numbers[2]);
+        tid.Flags = numbers[0];
+        tids.push_back(tid);
+    }
+    return tids;
+}
+
 
 int main(int argc, char** argv) {
     SetupLogger();
@@ -86,6 +119,12 @@ int main(int argc, char** argv) {
     auto cmd_calibrations  = cmd.add<TCLAP::MultiArg<string>>("c","calibration","Calibration to run",false,"calibration");
 
     auto cmd_u_disablerecon  = cmd.add<TCLAP::SwitchArg>("","u_disablereconstruct","Unpacker: Disable Reconstruct (disables also all analysis)",false);
+    auto cmd_u_recocache  = cmd.add<TCLAP::SwitchArg>("","u_recocache","Unpacker: Reuse reconstructed events from <inputfile>.reco.root if setup, calibration database and setup options match, write it otherwise",false);
+    auto cmd_u_writetidindex  = cmd.add<TCLAP::SwitchArg>("","u_writetidindex","Unpacker: Write TID index next to raw input file, used by --tids",false);
+
+    auto cmd_readahead = cmd.add<TCLAP::ValueArg<unsigned>>("","readahead","Let the Pluto reader and the Ant tree reader (without unpacker and reconstruction) read up to n events ahead on their own thread (needs ROOT 6, default: 0 = synchronous)",false,0,"n");
+
+    auto cmd_tids = cmd.add<TCLAP::ValueArg<string>>("","tids","Read only events with TIDs from file (lines 'timestamp lower'), seeks directly if TID index present",false,"","filename");
 
     auto cmd_p_disableParticleID  = cmd.add<TCLAP::SwitchArg>("","p_disableParticleID","Physics: Disable ParticleID",false);
     auto cmd_p_simpleParticleID  = cmd.add<TCLAP::SwitchArg>("","p_simpleParticleID","Physics: Use simple ParticleID (just protons/photons)",false);
@@ -123,6 +162,14 @@ int main(int argc, char** argv) {
     }
 
 
+    if(cmd_readahead->getValue() > 0) {
+        // ROOT's thread safety must be enabled before any TFile is opened,
+        // the PhysicsManager warns later if reading ahead is not available
+        analysis::input::ReadAheadReader::Available();
+        // readers use WrapTTree::EnableReadAhead, prefetch already from opening the files on
+        WrapTTree::EnableAsyncPrefetching();
+    }
+
     // build the list of ROOT files first
     auto rootfiles = make_shared<WrapTFileInput>();
     for(const auto& inputfile : cmd_input->getValue()) {
@@ -157,6 +204,7 @@ int main(int argc, char** argv) {
 
     // now we can try to open the files with an unpacker
     std::unique_ptr<Unpacker::Module> unpacker = nullptr;
+    string rawfile;
     for(const auto& inputfile : cmd_input->getValue()) {
         VLOG(5) << "Unpacker: Looking at file " << inputfile;
         try {
@@ -167,6 +215,7 @@ int main(int argc, char** argv) {
             }
             LOG(INFO) << "Found unpacker for file " << inputfile;
             unpacker = move(unpacker_);
+            rawfile = inputfile;
         }
         catch(Unpacker::Exception& e) {
             VLOG(5) << "Unpacker: " << e.what();
@@ -182,6 +231,14 @@ int main(int argc, char** argv) {
     }
 
 
+    if(cmd_u_writetidindex->isSet()) {
+        if(!unpacker)
+            LOG(WARNING) << "No raw input file found to write TID index for";
+        else if(!unpacker->WriteTIDIndex())
+            LOG(WARNING) << "Unpacker does not support writing a TID index";
+    }
+
+
     // we can finally we can create the available input readers
     // for the analysis
 
@@ -198,12 +255,47 @@ int main(int argc, char** argv) {
                 LOG(WARNING) << "Cannot activate reconstruct without setup";
             }
         }
-        readers.push_back(std_ext::make_unique<analysis::input::AntReader>(
-                              rootfiles,
-                              move(unpacker),
-                              move(reconstruct)
-                              )
-                          );
+
+        // a matching reconstruction cache replaces unpacker and reconstruct
+        using analysis::input::RecoCache;
+        auto antreader_files = rootfiles;
+        unique_ptr<RecoCache> recocache;
+        if(cmd_u_recocache->isSet() && unpacker && reconstruct) {
+            string options;
+            for(const auto& opt : cmd_setupOptions->getValue())
+                options += opt + ";";
+            const auto key = RecoCache::MakeKey(rawfile, options);
+            const auto cachefile = RecoCache::GetFilename(rawfile);
+            if(key.empty()) {
+                LOG(WARNING) << "Reconstruction cache disabled";
+            }
+            else if(auto cachefiles = RecoCache::Open(cachefile, key)) {
+                antreader_files = cachefiles;
+                unpacker = nullptr;
+                reconstruct = nullptr;
+            }
+            else if(!cmd_tids->isSet()) {
+                // selecting TIDs would make the cache incomplete
+                try {
+                    recocache = std_ext::make_unique<RecoCache>(cachefile, key);
+                }
+                catch(WrapTFile::Exception& e) {
+                    // for example, the raw data directory is read-only
+                    LOG(WARNING) << "Cannot write reconstruction cache, continue without: " << e.what();
+                }
+            }
+        }
+
+        auto antreader = std_ext::make_unique<analysis::input::AntReader>(
+                             antreader_files,
+                             move(unpacker),
+                             move(reconstruct)
+                             );
+        if(recocache)
+            antreader->WriteRecoCache(move(recocache));
+        if(cmd_tids->isSet())
+            antreader->SelectTIDs(ReadTIDs(cmd_tids->getValue()));
+        readers.push_back(move(antreader));
     }
     readers.push_back(std_ext::make_unique<analysis::input::PlutoReader>(rootfiles));
     readers.push_back(std_ext::make_unique<analysis::input::GoatReader>(rootfiles));
@@ -365,6 +457,7 @@ int main(int argc, char** argv) {
 
 
     // this method does the hard work...
+    pm.SetReadAhead(cmd_readahead->getValue());
     pm.ReadFrom(move(readers), maxevents);
     rootfiles = nullptr; // cleanup opened ROOT files for reading
 
@@ -37,6 +37,7 @@
 #include "TPaveStats.h"
 #include "TGraphErrors.h"
 #include "TMultiGraph.h"
+#include "TVectorD.h"
 
 #include "TSystem.h"
 #include "TRint.h"
@@ -57,6 +58,7 @@
 #include "RooDataHist.h"
 #include "RooPlot.h"
 #include "RooHist.h"
+#include "RooCurve.h"
 #include "RooDataHist.h"
 #include "RooAddition.h"
 #include "RooProduct.h"
@@ -67,6 +69,7 @@
 
 #include "detail/tools.h"
 #include "detail/Corrections.h"
+#include "detail/ForkedFits.h"
 
 
 namespace fs = std::filesystem;
@@ -145,6 +148,7 @@ struct settings_t final
     bool debug;
     bool corrections;
     int rebin;
+    unsigned jobs;
     fs::path out_dir;
 
 private:
@@ -433,13 +437,16 @@ void reference_fit(const WrapTFileInput& input, const string& cuts, const vector
 
     canvas c_N("Number eta' based on Reference");
 
-    // loop over the provided EPT channels
-    for (const auto taggCh : EPTrange) {
-        if (interrupt)
-            break;
+    // fit the provided EPT channels, independent of each other
+    // a result without curves marks a channel skipped due to an interrupt
+    progs::tools::ForkedFits forkedFits(settings.jobs);
+    const auto fit_results = forkedFits.Run(unsigned(EPTrange.size()), [&] (unsigned i) {
+        const auto taggCh = EPTrange[i];
 
         fit_result_t res;
         res.taggCh = taggCh;
+        if (interrupt)
+            return res;
 
         const double taggE = EPT->GetPhotonEnergy(unsigned(taggCh));
         const int taggBin = taggCh+1;
@@ -583,8 +590,6 @@ void reference_fit(const WrapTFileInput& input, const string& cuts, const vector
         const double eff_corr = h_true ? h_mc->GetEntries()/h_true->GetEntries() : 35034360./1e8;
         const double n_tot_corr = nsig.getValV()/eff_corr/BR2g;
         const double n_error = nsig.getError()/eff_corr/BR2g;
-        total_number_etap += n_tot_corr;
-        total_n_err += n_error*n_error;
         res.n_etap = n_tot_corr;
         res.n_error = n_error;
         res.eff_corr = eff_corr;
@@ -596,6 +601,46 @@ void reference_fit(const WrapTFileInput& input, const string& cuts, const vector
 
         save_pad(c, settings.out_dir, "ref_fit_channel" + to_string(taggCh) + ".pdf");
 
+        return res;
+    },
+    [] (const fit_result_t& res, WrapTFileOutput& output) {
+        if (!res.signal)
+            return;
+        TVectorD values(4);
+        values[0] = res.chi2ndf;
+        values[1] = res.n_etap;
+        values[2] = res.n_error;
+        values[3] = res.eff_corr;
+        output.WriteObject(addressof(values), "values");
+        output.WriteObject(res.signal, "signal");
+        output.WriteObject(res.bkg, "bkg");
+    },
+    [&EPTrange] (unsigned i, const WrapTFileInput& input) {
+        fit_result_t res;
+        res.taggCh = EPTrange[i];
+        TVectorD* values = nullptr;
+        if (!input.GetObject("values", values))
+            return res;
+        res.chi2ndf  = (*values)[0];
+        res.n_etap   = (*values)[1];
+        res.n_error  = (*values)[2];
+        res.eff_corr = (*values)[3];
+        res.signal = progs::tools::ForkedFits::Get<RooCurve>(input, "signal");
+        res.bkg    = progs::tools::ForkedFits::Get<RooCurve>(input, "bkg");
+        return res;
+    });
+
+    for (const auto& res : fit_results) {
+        if (!res.signal)
+            break;
+
+        const auto taggCh = res.taggCh;
+        const double taggE = EPT->GetPhotonEnergy(unsigned(taggCh));
+        const double n_tot_corr = res.n_etap;
+        const double n_error = res.n_error;
+        total_number_etap += n_tot_corr;
+        total_n_err += n_error*n_error;
+
         // add the number of eta' for the current EPT channel to the corresponding graph
         // clear the canvas to update the plotted graph for each fit within the loop
         {
@@ -606,7 +651,7 @@ void reference_fit(const WrapTFileInput& input, const string& cuts, const vector
             c_N << drawoption("AP") << draw_TGraph(g_n, "E_{#gamma} [MeV]", "##eta' / EPT Ch.", interval<double>{0,21e4}) << endc;
         }
 
-        results.emplace_back(move(res));
+        results.emplace_back(res);
     }
 
     result = {total_number_etap, sqrt(total_n_err)};
@@ -1363,6 +1408,7 @@ int main(int argc, char** argv) {
     auto cmd_EPTrange = cmd.add<TCLAP::ValueArg<string>>("c","EPTrange","EPT channel range for reference fits, e.g. 0-40 or 0-10,35-40",
                                                          false,"0-40","channels");
     auto cmd_rebin = cmd.add<TCLAP::ValueArg<int>>("","rebin","Number of bins to rebin for some to-be-fitted histograms",false,0,"int");
+    auto cmd_jobs = cmd.add<TCLAP::ValueArg<unsigned>>("j","jobs","Number of processes fitting EPT channels of the reference concurrently, output as in a serial run up to the order of keys",false,1,"jobs");
 
     cmd.parse(argc, argv);
 
@@ -1373,6 +1419,7 @@ int main(int argc, char** argv) {
 
     // retrieve settings_t singleton and set values (defaults defined via TCLAP)
     settings_t& settings = settings_t::get();
+    settings.jobs = cmd_jobs->getValue();
     settings.rebin = cmd_rebin->getValue();
     if (settings.rebin < 0) {
         LOG(WARNING) << "Provided rebin value is negative! rebin will be ignored.";
@@ -55,6 +55,8 @@
 
 #include "APLCON.hpp"
 
+#include "detail/ForkedFits.h"
+
 #include <fstream>
 
 auto debug = false;
@@ -534,12 +536,46 @@ fit_return_t doReferenceFit(const fit_params_t& p) {
     return r;
 }
 
+void saveReferenceFit(const fit_return_t& r, WrapTFileOutput& output) {
+    output.WriteObject(r.fitresult, "fitresult");
+    output.WriteObject(r.fitplot, "fitplot");
+    output.WriteObject(r.residual, "residual");
+    TVectorD values(5);
+    values[0] = r.chi2ndf;
+    values[1] = r.peakpos;
+    values[2] = r.threshold;
+    values[3] = r.N_effcorr.Value;
+    values[4] = r.N_effcorr.Sigma;
+    output.WriteObject(addressof(values), "values");
+}
+
+fit_return_t loadReferenceFit(const fit_params_t& p, const WrapTFileInput& input) {
+    using progs::tools::ForkedFits;
+    fit_return_t r;
+    r.p = p;
+    r.fitresult = ForkedFits::Get<RooFitResult>(input, "fitresult");
+    r.fitplot = ForkedFits::Get<RooPlot>(input, "fitplot");
+    r.residual = ForkedFits::Get<RooHist>(input, "residual");
+    // same order as plotted in doReferenceFit
+    r.h_data = dynamic_cast<RooHist*>(r.fitplot->getObject(0));
+    r.f_sum = dynamic_cast<RooCurve*>(r.fitplot->getObject(1));
+    r.f_bkg = dynamic_cast<RooCurve*>(r.fitplot->getObject(2));
+    r.f_sig = dynamic_cast<RooCurve*>(r.fitplot->getObject(3));
+    const auto& values = *ForkedFits::Get<TVectorD>(input, "values");
+    r.chi2ndf = values[0];
+    r.peakpos = values[1];
+    r.threshold = values[2];
+    r.N_effcorr = N_t(values[3], values[4]);
+    return r;
+}
+
 N_t doReference(const WrapTFileInput& input,
                 const WrapTFileInput& mctestinput,
                 const unique_ptr<ofstream>& textout,
                 const std::string& imgdir,
                 vector<string> cutchoice,
-                const interval<int>& taggChRange) {
+                const interval<int>& taggChRange,
+                progs::tools::ForkedFits& forkedFits) {
     analysis::HistogramFactory::DirStackPush HistFacDir(analysis::HistogramFactory("Ref"));
 
     auto Tagger = ExpConfig::Setup::GetDetector<TaggerDetector_t>();
@@ -590,27 +626,34 @@ N_t doReference(const WrapTFileInput& input,
     c_overview << drawoption("colz")
                << ref_mc << ref_data;
 
-    std::vector<fit_return_t> fit_results;
-
     if(textout) {
         *textout << formatCutString(pickedCut) << '\n';
     }
 
-    for(auto taggch=taggChRange.Stop();taggch>=taggChRange.Start();taggch--) {
-        LOG(INFO) << "Fitting TaggCh=" << taggch;
+    // tagger channels are fitted starting from the highest one
+    const auto makeParams = [Tagger, taggChRange] (unsigned i) {
         fit_params_t p;
-        p.TaggCh = taggch;
-        p.Eg = Tagger->GetPhotonEnergy(taggch);
-
-        // fit MC lineshape to data
-        const auto taggbin = taggch+1;
-        p.h_mc   = ref_mc->ProjectionX("h_mc",taggbin,taggbin);
-        p.h_data = ref_data->ProjectionX("h_data",taggbin,taggbin);
+        p.TaggCh = taggChRange.Stop()-int(i);
+        p.Eg = Tagger->GetPhotonEnergy(unsigned(p.TaggCh));
 
         // higher tagger channels have quite low number of signal events
         // provide better starting value in this case
         if(p.TaggCh>=38)
             p.start_Nsig = 1e2;
+        return p;
+    };
+
+    // the fits of the tagger channels are independent,
+    // the projections are made in the (possibly forked) fit as they share their names
+    auto fit_results = forkedFits.Run(unsigned(taggChRange.Length()+1),
+                                      [&] (unsigned i) {
+        auto p = makeParams(i);
+        LOG(INFO) << "Fitting TaggCh=" << p.TaggCh;
+
+        // fit MC lineshape to data
+        const auto taggbin = p.TaggCh+1;
+        p.h_mc   = ref_mc->ProjectionX("h_mc",taggbin,taggbin);
+        p.h_data = ref_data->ProjectionX("h_data",taggbin,taggbin);
 
         auto r = doReferenceFit(p);
 
@@ -619,9 +662,15 @@ N_t doReference(const WrapTFileInput& input,
                      N_t::fromBin(*ref_mctrue_generated, taggbin), // N_mcgen
                      r.N_effcorr // output
                      );
+        return r;
+    },
+    saveReferenceFit,
+    [makeParams] (unsigned i, const WrapTFileInput& input) {
+        return loadReferenceFit(makeParams(i), input);
+    });
 
-        // save/plot values
-        fit_results.emplace_back(r);
+    // save/plot values
+    for(const auto& r : fit_results) {
 
         if(debug) {
             LOG(INFO) << r;
@@ -629,7 +678,7 @@ N_t doReference(const WrapTFileInput& input,
 
         if(textout) {
             const auto Eg_err = Tagger-> GetPhotonEnergyWidth(r.p.TaggCh)/2;
-            *textout << p.Eg << " " << Eg_err << " "
+            *textout << r.p.Eg << " " << Eg_err << " "
                      << r.getPar_N().Value << " " << r.getPar_N().Sigma << " "
                      << r.N_effcorr.Value << " " << r.N_effcorr.Sigma
                      << '\n';
@@ -795,10 +844,15 @@ N_t doReference(const WrapTFileInput& input,
 
 const string sig_prefix   = "EtapOmegaG_plot_Sig";
 
-N_t doSignal(const string& sig_histpath,
-              const WrapTFileInput& input,
-              const WrapTFileInput& mctestinput,
-              N_t& N_fit, bool showcanvas)
+struct sig_hists_t {
+    TH1D* sig_data;
+    TH1D* sig_mc;
+    TH1D* sig_mctrue_generated;
+};
+
+sig_hists_t getSignalHists(const string& sig_histpath,
+                           const WrapTFileInput& input,
+                           const WrapTFileInput& mctestinput)
 {
     TH1D* sig_data;
     TH1D* sig_mc;
@@ -836,6 +890,16 @@ N_t doSignal(const string& sig_histpath,
 
     }
 
+    return {sig_data, sig_mc, sig_mctrue_generated};
+}
+
+N_t doSignal(const sig_hists_t& hists,
+             N_t& N_fit, bool showcanvas)
+{
+    TH1D* sig_data = hists.sig_data;
+    TH1D* sig_mc = hists.sig_mc;
+    TH1D* sig_mctrue_generated = hists.sig_mctrue_generated;
+
     analysis::HistogramFactory::DirStackPush HistFacDir(analysis::HistogramFactory("Sig"));
 
 
@@ -980,6 +1044,7 @@ int main(int argc, char** argv) {
     auto cmd_cut = cmd.add<TCLAP::MultiArg<string>>("c","cut","Select cuts instead of default provided", false, "");
     auto cmd_textout = cmd.add<TCLAP::ValueArg<string>>("","textout","Dump numbers to file as text (gnuplot compatible)",false,"", "");
     auto cmd_imgdir = cmd.add<TCLAP::ValueArg<string>>("","imgdir","Output folder for SaveMultiImages calls",false,"", "");
+    auto cmd_jobs = cmd.add<TCLAP::ValueArg<unsigned>>("j","jobs","Number of processes fitting tagger channels and cut selections concurrently, output as in a serial run up to the order of keys",false,1,"jobs");
 
     cmd.parse(argc, argv);
 
@@ -1033,6 +1098,9 @@ int main(int argc, char** argv) {
         masterFile = std_ext::make_unique<WrapTFileOutput>(cmd_output->getValue(), true);
     }
 
+    // keeps results of forked fits valid
+    progs::tools::ForkedFits forkedFits(cmd_jobs->getValue());
+
     // get total number of reference events (effcorr), thus produced eta primes...
     N_t N_etap(0,0);
     if(skipRef) {
@@ -1046,7 +1114,7 @@ int main(int argc, char** argv) {
         N_t BR_etap_2g(2.20/100.0,0.08/100.0); // branching ratio eta'->2g is about 2.2 % (PDG)
         auto N_ref_events = doReference(input, mctestinput, textout_stream,
                                         cmd_imgdir->getValue(),
-                                        cmd_cut->getValue(), taggChRange);
+                                        cmd_cut->getValue(), taggChRange, forkedFits);
         LOG(INFO) << "Number of eta' -> 2g events (effcorr): " << N_ref_events;
         APLCON::Fit_Settings_t fit_settings;
         fit_settings.ConstraintAccuracy = 1e-2;
@@ -1116,11 +1184,40 @@ int main(int argc, char** argv) {
                                  "/IM_Pi0g[1]");
         }
 
-        for(const auto& sig_histpath : sig_histpaths) {
-            LOG(INFO) << "Cut selection: " << sig_histpath;
+        // read all hists before, as forked fits must not read from the shared input files
+        vector<sig_hists_t> sig_hists;
+        for(const auto& sig_histpath : sig_histpaths)
+            sig_hists.emplace_back(getSignalHists(sig_histpath, input, mctestinput));
 
+        // the fits for the cut selections are independent
+        struct sig_result_t {
             N_t N_fit;
-            const auto N_sig_events = doSignal(sig_histpath, input, mctestinput, N_fit, sig_histpaths.size()==1);
+            N_t N_sig_events;
+        };
+        const auto sig_results = forkedFits.Run(unsigned(sig_histpaths.size()),
+                                                [&] (unsigned i) {
+            LOG(INFO) << "Cut selection: " << sig_histpaths[i];
+            sig_result_t r;
+            r.N_sig_events = doSignal(sig_hists[i], r.N_fit, sig_histpaths.size()==1);
+            return r;
+        },
+        [] (const sig_result_t& r, WrapTFileOutput& output) {
+            TVectorD values(4);
+            values[0] = r.N_fit.Value;
+            values[1] = r.N_fit.Sigma;
+            values[2] = r.N_sig_events.Value;
+            values[3] = r.N_sig_events.Sigma;
+            output.WriteObject(addressof(values), "values");
+        },
+        [] (unsigned, const WrapTFileInput& input) {
+            const auto& values = *progs::tools::ForkedFits::Get<TVectorD>(input, "values");
+            return sig_result_t{N_t(values[0], values[1]), N_t(values[2], values[3])};
+        });
+
+        for(size_t i=0;i<sig_histpaths.size();i++) {
+            const auto& sig_histpath = sig_histpaths[i];
+            const auto& N_fit = sig_results[i].N_fit;
+            const auto& N_sig_events = sig_results[i].N_sig_events;
 
             const auto BR_etap_omega_g = calcBranchingRatio(N_sig_events, N_etap);
             if(BR_etap_omega_g.Sigma/BR_etap_omega_g.Value>0.5)
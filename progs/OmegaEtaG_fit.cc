@@ -47,6 +47,9 @@
 #include "TGraphErrors.h"
 #include "base/PhysicsMath.h"
 #include "TPavesText.h"
+#include "TVectorD.h"
+
+#include "detail/ForkedFits.h"
 
 using namespace ant;
 using namespace ant::std_ext;
@@ -118,6 +121,10 @@ struct FitOmegaPeak {
     FitOmegaPeak& operator=(FitOmegaPeak&&) = default;
 
     friend ostream& operator<<(ostream& s, const FitOmegaPeak& argus_f);
+
+    /// @brief store/restore the fitted values, used for forked fits
+    void Save(WrapTFileOutput& output) const;
+    static FitOmegaPeak Load(const WrapTFileInput& input);
 };
 
 TH2D* extrudeX(const TH1* slice, const BinSettings& xbins, const string& newname="") {
@@ -165,6 +172,7 @@ int main(int argc, char** argv) {
     auto cmd_Taggslice = cmd.add<TCLAP::ValueArg<int>>("", "Taggslice","",false,-1,"slice");
     auto cmd_range_min = cmd.add<TCLAP::ValueArg<double>>("","range_min","Fitrange [MeV]",false,670.0,"double [MeV]");
     auto cmd_range_max = cmd.add<TCLAP::ValueArg<double>>("","range_max","Fitrange [MeV]",false,900.0,"double [MeV]");
+    auto cmd_jobs      = cmd.add<TCLAP::ValueArg<unsigned>>("j","jobs","Number of processes fitting the bins concurrently, output as in a serial run up to the order of keys",false,1,"jobs");
   //  auto cmd_range     = cmd.add<TCLAP::ValueArg<interval<double>>>("","range","Fit range",false,"","range");
 
     cmd.parse(argc, argv);
@@ -205,6 +213,8 @@ int main(int argc, char** argv) {
         masterFile = std_ext::make_unique<WrapTFileOutput>(cmd_output->getValue(), true);
     }
 
+    // the bins are fitted independently, keeps the canvases of forked fits valid
+    progs::tools::ForkedFits forkedFits(cmd_jobs->getValue());
 
     auto lumi = getHist<TH1D>(input_lumi, "PhotonFlux/intlumicor");
 
@@ -250,18 +260,39 @@ int main(int argc, char** argv) {
             g.SetPointError(i,x.e,y.e);
         };
 
+        // read all hists before, as forked fits must not read from the shared input files
+        vector<pair<TH1D*,TH1D*>> hists;
         for(size_t i=0;i<unsigned(nbins);++i) {
-            const auto cosT = n_mc->GetBinCenter(int(i+1));
             const string basepath = std_ext::formatter() << cmd_histpath->getValue() << "/cosT_" << i;
-            const auto h_data = getHist<TH1D>(input_data,std_ext::formatter() << basepath << datahist << cmd_histname->getValue());
-            const auto h_mc = getHist<TH1D>(input_mc,  std_ext::formatter() << basepath << refhist  << cmd_histname->getValue());
-            ctbins.push_back({n_mc->GetBinCenter(int(i+1)),{NaN,NaN},
-                    {
-                        h_data,
-                        h_mc,
-                        n_mc->GetBinContent(int(1+i)),
-                           total_lumi, n_mc->GetBinWidth(int(1+i)),TH_ext::getBins(h_data->GetXaxis())
-                    }});
+            hists.emplace_back(getHist<TH1D>(input_data,std_ext::formatter() << basepath << datahist << cmd_histname->getValue()),
+                               getHist<TH1D>(input_mc,  std_ext::formatter() << basepath << refhist  << cmd_histname->getValue()));
+        }
+
+        TCanvas* pad = nullptr; // of the last fit
+        const auto fits = forkedFits.Run(unsigned(nbins), [&] (unsigned i) {
+            const auto h_data = hists[i].first;
+            const auto h_mc = hists[i].second;
+            pad = new TCanvas();
+            pad->SetCanvasSize(600,600);
+            return FitOmegaPeak(h_data,
+                                h_mc,
+                                n_mc->GetBinContent(int(1+i)),
+                                total_lumi, n_mc->GetBinWidth(int(1+i)),TH_ext::getBins(h_data->GetXaxis()),
+                                pad);
+        },
+        [&pad] (const FitOmegaPeak& fit, WrapTFileOutput& output) {
+            fit.Save(output);
+            output.WriteObject(pad, "canvas");
+        },
+        [] (unsigned, const WrapTFileInput& input) {
+            // show the canvas of the forked fit as in a serial run
+            progs::tools::ForkedFits::Get<TCanvas>(input, "canvas")->Draw();
+            return FitOmegaPeak::Load(input);
+        });
+
+        for(size_t i=0;i<unsigned(nbins);++i) {
+            const auto cosT = n_mc->GetBinCenter(int(i+1));
+            ctbins.push_back({cosT,{NaN,NaN},fits[i]});
 
             const auto& fitres = ctbins.at(i);
             SetPoint(*g,    int(i), {cosT, 0.}, get<2>(fitres).vn_corr);
@@ -327,7 +358,20 @@ int main(int argc, char** argv) {
 
         const auto cosTslicelimit = cmd_cosTslice->getValue();
         const auto Taggslicelimit = cmd_Taggslice->getValue();
-        TCanvas* canvas = nullptr;
+        // collect the bins first, as forked fits must not read from the shared input files
+        struct cosTE_bin_t {
+            double cosT;
+            double cosT_binwidth;
+            TH2D* h_data2d;
+            TH2D* h_mc2d;
+            int tagger_bin;
+            double n_mc_input;
+            interval<double> Eg;
+            ValError lumi_slice;
+            string title;
+            string fname;
+        };
+        vector<cosTE_bin_t> bins;
 
         for(int c=1;c<=nc; ++c) {
 
@@ -350,12 +394,6 @@ int main(int argc, char** argv) {
 
                 const auto tagger_bin = tagger_group * ntaggergroup;
 
-                auto h_data_slice = h_data2d->ProjectionX("data_slice",tagger_bin,tagger_bin+ntaggergroup-1);
-                auto h_mc_slice   = h_mc2d->ProjectionX(  "mc_slice",  tagger_bin,tagger_bin+ntaggergroup-1);
-
-                h_data_slice->GetXaxis()->SetRangeUser(fitrange.Start(), fitrange.Stop());
-                h_mc_slice->GetXaxis()->SetRangeUser(fitrange.Start(), fitrange.Stop());
-
                 const auto Eg = EWindow(tagger_group);
 
                 const auto lumi_slice = Integrate(lumi,tagger_bin,tagger_bin+ntaggergroup-1);
@@ -363,29 +401,52 @@ int main(int argc, char** argv) {
                 //auto pad = canvas->cd(1 + tagger_group + (c-1)*n_tagger_bins);
                 const string title = formatter() << "W=" << round(math::W(Eg.Center(), ParticleTypeDatabase::Proton)*100.0)/100.0 << " MeV cos(#theta)_{cm}=" << cosT;
 
-                delete canvas;
-                canvas = new TCanvas();
-                canvas->SetCanvasSize(600,600);
-
-                ctbins.push_back({cosT,Eg,
-                                     {
-                                         h_data_slice,
-                                         h_mc_slice,
-                                         n_mc_input->Integral(int(tagger_bin),int(tagger_bin)+ntaggergroup-1),
-                                         lumi_slice,
-                                         cosT_binwidth,
-                                         TH_ext::getBins(h_data_slice->GetXaxis()),
-                                         canvas,
-                                        title
-                                     }});
-
                 const string fname = formatter() << (c-1)*n_tagger_groups+tagger_group << "_W=" << round(math::W(Eg.Center(), ParticleTypeDatabase::Proton)) << "cosTbin=" << c-1;
-                canvas->SaveMultiImages(fname.c_str());
+
+                bins.push_back({cosT, cosT_binwidth, h_data2d, h_mc2d, tagger_bin,
+                                n_mc_input->Integral(int(tagger_bin),int(tagger_bin)+ntaggergroup-1),
+                                Eg, lumi_slice, title, fname});
             }
 
 
         }
 
+        TCanvas* canvas = nullptr;
+        const auto fits = forkedFits.Run(unsigned(bins.size()), [&] (unsigned i) {
+            const auto& bin = bins[i];
+
+            auto h_data_slice = bin.h_data2d->ProjectionX("data_slice",bin.tagger_bin,bin.tagger_bin+ntaggergroup-1);
+            auto h_mc_slice   = bin.h_mc2d->ProjectionX(  "mc_slice",  bin.tagger_bin,bin.tagger_bin+ntaggergroup-1);
+
+            h_data_slice->GetXaxis()->SetRangeUser(fitrange.Start(), fitrange.Stop());
+            h_mc_slice->GetXaxis()->SetRangeUser(fitrange.Start(), fitrange.Stop());
+
+            delete canvas;
+            canvas = new TCanvas();
+            canvas->SetCanvasSize(600,600);
+
+            FitOmegaPeak fit(h_data_slice,
+                             h_mc_slice,
+                             bin.n_mc_input,
+                             bin.lumi_slice,
+                             bin.cosT_binwidth,
+                             TH_ext::getBins(h_data_slice->GetXaxis()),
+                             canvas,
+                             bin.title);
+
+            canvas->SaveMultiImages(bin.fname.c_str());
+            return fit;
+        },
+        [] (const FitOmegaPeak& fit, WrapTFileOutput& output) {
+            fit.Save(output);
+        },
+        [] (unsigned, const WrapTFileInput& input) {
+            return FitOmegaPeak::Load(input);
+        });
+
+        for(size_t i=0;i<bins.size();++i)
+            ctbins.push_back({bins[i].cosT, bins[i].Eg, fits[i]});
+
     } else {
         LOG(FATAL) << "invalid mode: " << cmd_mode->getValue();
     }
@@ -656,6 +717,41 @@ FitOmegaPeak::FitOmegaPeak(const TH1 *h_data, const TH1 *h_mc, const double n_mc
 
 }
 
+void FitOmegaPeak::Save(WrapTFileOutput& output) const
+{
+    TVectorD values(2*10+5); // 10 ValErrors and 5 numbers
+    int i = 0;
+    for(const ValError* v : {&vnsig, &vnbkg, &rec_eff, &vn_corr, &sigmaOmega,
+                             &sigma, &argus_c, &argus_p, &argus_f, &mshift}) {
+        values[i++] = v->v;
+        values[i++] = v->e;
+    }
+    values[i++] = numParams;
+    values[i++] = ndf;
+    values[i++] = chi2ndf;
+    values[i++] = nMC;
+    values[i++] = nMCInput;
+    output.WriteObject(addressof(values), "FitOmegaPeak");
+}
+
+FitOmegaPeak FitOmegaPeak::Load(const WrapTFileInput& input)
+{
+    const auto& values = *progs::tools::ForkedFits::Get<TVectorD>(input, "FitOmegaPeak");
+    FitOmegaPeak f;
+    int i = 0;
+    for(ValError* v : {&f.vnsig, &f.vnbkg, &f.rec_eff, &f.vn_corr, &f.sigmaOmega,
+                       &f.sigma, &f.argus_c, &f.argus_p, &f.argus_f, &f.mshift}) {
+        v->v = values[i++];
+        v->e = values[i++];
+    }
+    f.numParams = int(values[i++]);
+    f.ndf       = int(values[i++]);
+    f.chi2ndf   = values[i++];
+    f.nMC       = values[i++];
+    f.nMCInput  = values[i++];
+    return f;
+}
+
 ostream& operator<<(ostream &s, const FitOmegaPeak &f)
 {
     s << "[NSig="    << f.vnsig
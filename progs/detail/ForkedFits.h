@@ -0,0 +1,219 @@
+#pragma once
+
+#include "base/WrapTFile.h"
+#include "base/tmpfile_t.h"
+#include "base/Logger.h"
+#include "base/std_ext/string.h"
+#include "base/std_ext/memory.h"
+
+#include "TClass.h"
+#include "TDirectory.h"
+#include "TKey.h"
+#include "TROOT.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ant {
+namespace progs {
+namespace tools {
+
+/**
+ * @brief The ForkedFits class fits independent bins concurrently in forked processes
+ *
+ * RooFit is not thread-safe, so each bin is fitted in its own worker process with its
+ * own RooFit objects, forked from the same state a serial run would fit the bin in.
+ * The worker stores what the parent needs via save(result, output) in a ROOT file,
+ * the parent reads the results back via load(bin, input) in bin order.
+ * The files stay open as long as this object lives, so objects read from them stay valid.
+ * Workers run in batch mode, so canvases they draw into are not shown.
+ * Objects a worker attaches to the current directory (for example projections in the
+ * output file) are moved to the parent's current directory in bin order. As in a serial run,
+ * where the next bin reuses or replaces an object of the same name, the object of the last
+ * bin remains under each name. Only the position of a reused object within the directory,
+ * and so the order of the keys written, may differ from a serial run.
+ * With one job, the bins are just fitted in sequence.
+ */
+class ForkedFits {
+public:
+    explicit ForkedFits(unsigned jobs_) : jobs(jobs_ > 0 ? jobs_ : 1) {}
+
+    unsigned Jobs() const { return jobs; }
+
+    /**
+     * @brief Run fits all bins
+     * @param nBins number of bins
+     * @param fit called as fit(bin), returns the result of this bin
+     * @param save called as save(result, WrapTFileOutput&) in the worker
+     * @param load called as load(bin, WrapTFileInput&) in the parent, returns the result
+     * @return the results in bin order
+     */
+    template<typename Fit, typename Save, typename Load>
+    auto Run(unsigned nBins, Fit fit, Save save, Load load) -> std::vector<decltype(fit(0u))>
+    {
+        std::vector<decltype(fit(0u))> results;
+        results.reserve(nBins);
+
+        if(jobs == 1 || nBins < 2) {
+            for(unsigned bin=0;bin<nBins;bin++)
+                results.emplace_back(fit(bin));
+            return results;
+        }
+
+        if(!tmpfolder)
+            tmpfolder = std_ext::make_unique<tmpfolder_t>();
+        const std::string prefix = std_ext::formatter() << tmpfolder->foldername << "/run" << nRuns++ << "_bin";
+        const auto filename = [&prefix] (unsigned bin) {
+            return prefix + std::to_string(bin) + ".root";
+        };
+
+        // waits for one worker, returns false if it failed
+        auto wait_for_fit = [] () {
+            int status = 0;
+            if(::wait(std::addressof(status)) < 0)
+                throw std::runtime_error("Waiting for fit process failed");
+            return WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+        };
+
+        LOG(INFO) << "Fitting " << nBins << " bins in up to " << jobs << " processes";
+
+        TDirectory* const directory = gDirectory;
+
+        unsigned nRunning = 0;
+        bool failed = false;
+        for(unsigned bin=0;bin<nBins;bin++) {
+            while(nRunning >= jobs) {
+                failed |= !wait_for_fit();
+                nRunning--;
+            }
+
+            // buffered output would be written again by the worker
+            std::fflush(nullptr);
+
+            const auto pid = fork();
+            if(pid < 0)
+                throw std::runtime_error("Cannot fork fit process");
+            if(pid == 0) {
+                // in worker process, never return
+                // there's no display connection to share with the parent
+                gROOT->SetBatch(true);
+                // objects of the same name are then created anew instead of being reused,
+                // so everything attached afterwards goes to the parent
+                directory->GetList()->Clear("nodelete");
+                try {
+                    const auto result = fit(bin);
+                    WrapTFileOutput output(filename(bin));
+                    save(result, output);
+                    saveAttached(directory, output);
+                }
+                catch(const std::exception& e) {
+                    LOG(ERROR) << "Fit of bin " << bin << " failed: " << e.what();
+                    _exit(EXIT_FAILURE);
+                }
+                _exit(EXIT_SUCCESS);
+            }
+            nRunning++;
+        }
+
+        while(nRunning > 0) {
+            failed |= !wait_for_fit();
+            nRunning--;
+        }
+
+        if(failed)
+            throw std::runtime_error("At least one fit process failed");
+
+        std::set<const TObject*> loaded;
+        for(unsigned bin=0;bin<nBins;bin++) {
+            inputs.emplace_back(std_ext::make_unique<WrapTFileInput>(filename(bin)));
+            results.emplace_back(load(bin, *inputs.back()));
+            loadAttached(*inputs.back(), directory, loaded);
+        }
+
+        return results;
+    }
+
+    /// @brief GetObject from input, throws if not found
+    template<typename T>
+    static T* Get(const WrapTFileInput& input, const std::string& name) {
+        T* ptr = nullptr;
+        if(!input.GetObject(name, ptr))
+            throw std::runtime_error("Cannot find " + name + " in fit result");
+        return ptr;
+    }
+
+protected:
+    const unsigned jobs;
+    unsigned nRuns = 0;
+
+    static std::string attachedPrefix() { return "ForkedFits_attached_"; }
+
+    static void saveAttached(TDirectory* directory, WrapTFileOutput& output)
+    {
+        unsigned n = 0;
+        TIter next(directory->GetList());
+        while(auto obj = next())
+            output.WriteObject(obj, attachedPrefix() + std::to_string(n++));
+    }
+
+    /**
+     * @brief loadAttached moves the objects a worker attached to directory
+     * @param loaded objects moved by previous bins, owned by this class until replaced
+     */
+    static void loadAttached(const WrapTFileInput& input, TDirectory* directory,
+                             std::set<const TObject*>& loaded)
+    {
+        const auto prefix = attachedPrefix();
+        std::map<unsigned, TKey*> keys; // sorted as attached in the worker
+        input.Traverse([&keys, &prefix] (TKey* key) {
+            const std::string name(key->GetName());
+            if(name.compare(0, prefix.size(), prefix) == 0)
+                keys.emplace(std::stoul(name.substr(prefix.size())), key);
+        });
+
+        // objects of this bin may share a name, as they did in the worker
+        std::set<const TObject*> current;
+        const auto findReplaced = [directory, &current] (const char* name) -> TObject* {
+            TIter next(directory->GetList());
+            while(auto obj = next()) {
+                if(current.count(obj) == 0 && std::string(obj->GetName()) == name)
+                    return obj;
+            }
+            return nullptr;
+        };
+
+        for(const auto& it_key : keys) {
+            auto obj = it_key.second->ReadObj();
+            // the last bin wins, as in a serial run
+            if(auto replaced = findReplaced(obj->GetName())) {
+                directory->GetList()->Remove(replaced);
+                // objects existing before the fits may still be referred to, so only detach them
+                if(loaded.erase(replaced))
+                    delete replaced;
+            }
+            // moves histograms and the like from the input file
+            if(auto addfunc = obj->IsA()->GetDirectoryAutoAdd())
+                addfunc(obj, directory);
+            else
+                directory->Append(obj);
+            current.insert(obj);
+        }
+        loaded.insert(current.begin(), current.end());
+    }
+
+    // declared before the inputs, so the files are closed before their folder is deleted
+    std::unique_ptr<tmpfolder_t> tmpfolder;
+    std::list<std::unique_ptr<WrapTFileInput>> inputs;
+};
+
+}}} // namespace ant::progs::tools
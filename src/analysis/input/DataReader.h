@@ -30,6 +30,26 @@ public:
     virtual bool ReadNextEvent(event_t& event) =0;
 
     virtual double PercentDone() const =0;
+
+    /**
+     * @brief ReadsIndependently tells if ReadNextEvent may run ahead on its own thread
+     *
+     * The reader then reads into empty events, which are combined with the
+     * event read by the preceding readers via AmendEvent afterwards.
+     * The reader must not share any state with the physics classes.
+     */
+    virtual bool ReadsIndependently() const { return false; }
+
+    /**
+     * @brief AmendEvent combines an independently read event into the given event
+     * @param event read so far by the preceding readers
+     * @param read as obtained from ReadNextEvent on an empty event
+     */
+    virtual void AmendEvent(event_t& event, event_t&& read) const {
+        if(event)
+            throw Exception("Reader cannot amend independently read events");
+        event = std::move(read);
+    }
 };
 
 }}} // namespace ant::analysis::input
@@ -0,0 +1,90 @@
+#include "ReadAheadReader.h"
+
+#include "RVersion.h"
+#include "TROOT.h"
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis::input;
+
+ReadAheadReader::ReadAheadReader(unique_ptr<DataReader> reader_, unsigned bufferSize_) :
+    reader(move(reader_)),
+    flags(reader->GetFlags()),
+    bufferSize(max(1u, bufferSize_)),
+    percentDone(reader->PercentDone())
+{
+    if(!reader->ReadsIndependently())
+        throw Exception("Reader cannot read ahead independently");
+    producer = thread([this] () { produce(); });
+}
+
+ReadAheadReader::~ReadAheadReader()
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cond.notify_all();
+    producer.join();
+}
+
+bool ReadAheadReader::Available()
+{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    ROOT::EnableThreadSafety();
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ReadAheadReader::produce()
+{
+    try {
+        while(true) {
+            event_t event;
+            if(!reader->ReadNextEvent(event))
+                break;
+            percentDone = reader->PercentDone();
+
+            unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] () { return buffer.size() < bufferSize || stop; });
+            if(stop)
+                return;
+            buffer.emplace_back(move(event));
+            lock.unlock();
+            cond.notify_all();
+        }
+    }
+    catch(...) {
+        // rethrown by ReadNextEvent after the already buffered events
+        lock_guard<std::mutex> lock(mutex);
+        exception = current_exception();
+    }
+
+    {
+        lock_guard<std::mutex> lock(mutex);
+        finished = true;
+    }
+    cond.notify_all();
+}
+
+bool ReadAheadReader::ReadNextEvent(event_t& event)
+{
+    unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this] () { return !buffer.empty() || finished; });
+
+    if(buffer.empty()) {
+        if(exception)
+            rethrow_exception(exception);
+        return false;
+    }
+
+    event_t read(move(buffer.front()));
+    buffer.pop_front();
+    lock.unlock();
+    cond.notify_all();
+
+    reader->AmendEvent(event, move(read));
+    return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "DataReader.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace ant {
+namespace analysis {
+namespace input {
+
+/**
+ * @brief The ReadAheadReader class runs another reader on a producer thread
+ *
+ * The wrapped reader reads up to bufferSize events ahead into empty events,
+ * ReadNextEvent just takes the next ready one and combines it via
+ * DataReader::AmendEvent. Only readers which ReadsIndependently can be wrapped.
+ */
+class ReadAheadReader : public DataReader {
+public:
+    ReadAheadReader(std::unique_ptr<DataReader> reader_, unsigned bufferSize_);
+    virtual ~ReadAheadReader();
+    ReadAheadReader(const ReadAheadReader&) = delete;
+    ReadAheadReader& operator= (const ReadAheadReader&) = delete;
+
+    virtual reader_flags_t GetFlags() const override { return flags; }
+    virtual bool ReadNextEvent(event_t& event) override;
+
+    virtual double PercentDone() const override { return percentDone; }
+
+    /**
+     * @brief Available checks if ROOT allows reading on several threads, and enables that
+     * @note call it before any TFile is opened, ROOT does not make already open files thread safe
+     * @return false if readers must run synchronously
+     */
+    static bool Available();
+
+protected:
+    const std::unique_ptr<DataReader> reader;
+    const reader_flags_t flags;
+    const unsigned bufferSize;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<event_t> buffer;
+    bool finished = false;  // producer has read all events
+    bool stop = false;      // tells producer to stop early
+    std::exception_ptr exception;
+    std::atomic<double> percentDone;
+
+    std::thread producer;
+    void produce();
+};
+
+}}} // namespace ant::analysis::input
@@ -1,4 +1,5 @@
 #include "AntReader.h"
+#include "RecoCache.h"
 
 #include "tree/TEvent.h"
 #include "tree/TEventData.h"
@@ -9,6 +10,7 @@
 
 #include "TTree.h"
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 
@@ -25,6 +27,7 @@ struct AntReaderInternal {
     virtual double PercentDone() const = 0;
     virtual event_t NextEvent() = 0;
     virtual bool ProvidesSlowControl() const = 0;
+    virtual bool SelectTIDs(const vector<TID>& tids) = 0;
     virtual ~AntReaderInternal() = default;
 };
 
@@ -44,24 +47,31 @@ struct UnpackerReader : AntReaderInternal {
     virtual bool ProvidesSlowControl() const override {
         return unpacker->ProvidesSlowControl();
     }
+    virtual bool SelectTIDs(const vector<TID>& tids) override {
+        return unpacker->SelectTIDs(tids);
+    }
 private:
     unique_ptr<Unpacker::Module> unpacker;
 }; // UnpackerReader
 
 
 struct TreeReader : AntReaderInternal {
-    TreeReader(const std::shared_ptr<WrapTFileInput>& rootfiles)
+    TreeReader(const std::shared_ptr<WrapTFileInput>& rootfiles_) :
+        rootfiles(rootfiles_)
     {
         if(!rootfiles->GetObject("treeEvents", tree.Tree))
             return;
 
         VLOG(5) << "Found Ant Events Tree";
         tree.LinkBranches();
+        tree.EnableReadAhead();
     }
 
     virtual ~TreeReader() = default;
 
     virtual double PercentDone() const override {
+        if(tree && selected)
+            return double(current_entry)/double(entries.size());
         if(tree)
             return double(current_entry)/double(tree.Tree->GetEntries());
         return numeric_limits<double>::quiet_NaN();
@@ -71,15 +81,46 @@ struct TreeReader : AntReaderInternal {
         if(!tree)
             return {};
 
-        if(current_entry==tree.Tree->GetEntries())
-            return {};
-
-        tree.Tree->GetEntry(current_entry);
+        if(selected) {
+            if(current_entry == Long64_t(entries.size()))
+                return {};
+            tree.GetEntry(entries[current_entry]);
+        }
+        else {
+            if(current_entry==tree.Tree->GetEntries())
+                return {};
+            tree.GetEntry(current_entry);
+        }
         current_entry++;
         return event_t{move(tree.data())};
     }
 
+    virtual bool SelectTIDs(const vector<TID>& tids) override {
+        // the small TID tree is much faster to scan than treeEvents
+        treeEventsTIDs_t treeTIDs;
+        if(!tree || !rootfiles->GetObject("treeEventsTIDs", treeTIDs.Tree))
+            return false;
+        if(treeTIDs.Tree->GetEntries() != tree.Tree->GetEntries()) {
+            LOG(WARNING) << "Number of entries in treeEventsTIDs does not match treeEvents";
+            return false;
+        }
+        treeTIDs.LinkBranches();
+
+        entries.clear();
+        for(Long64_t entry=0;entry<treeTIDs.Tree->GetEntries();entry++) {
+            treeTIDs.GetEntry(entry);
+            if(binary_search(tids.begin(), tids.end(), treeTIDs.ID()))
+                entries.push_back(entry);
+        }
+        LOG(INFO) << "Selected " << entries.size() << " entries from treeEvents";
+        current_entry = 0;
+        selected = true;
+        return true;
+    }
+
     virtual bool ProvidesSlowControl() const override {
+        if(selected)
+            return false;
         /// \todo the current implementation of reader flags and slow control providers looks non-optimal,
         /// improve this...
         LOG(WARNING) << "Reading from Ant trees assumes slow control present, this might fail if reading from MC-based trees.";
@@ -87,9 +128,13 @@ struct TreeReader : AntReaderInternal {
     }
 
 private:
+    const std::shared_ptr<WrapTFileInput> rootfiles;
     Long64_t current_entry = 0;
 
     treeEvents_t tree;
+
+    bool selected = false;
+    vector<Long64_t> entries;
 }; // TreeReader
 
 }}}} // namespace ant::analysis::input::detail
@@ -118,10 +163,27 @@ AntReader::AntReader(const std::shared_ptr<WrapTFileInput>& rootfiles,
 
 AntReader::~AntReader() {}
 
+void AntReader::SelectTIDs(std::vector<TID> tids)
+{
+    if(!reader)
+        return;
+    sort(tids.begin(), tids.end());
+    if(reader->SelectTIDs(tids))
+        return;
+    LOG(WARNING) << "No TID index available for input, reading all events to select TIDs";
+    filter_tids = move(tids);
+}
+
+void AntReader::WriteRecoCache(std::unique_ptr<RecoCache> cache)
+{
+    recocache = move(cache);
+}
+
 reader_flags_t AntReader::GetFlags() const {
     if(reader) {
         reader_flags_t flags(reader_flag_t::IsSource);
-        if(reader->ProvidesSlowControl())
+        // slowcontrol needs all events
+        if(reader->ProvidesSlowControl() && filter_tids.empty())
             flags |= reader_flag_t::ProvidesSlowControl;
         return flags;
     }
@@ -129,6 +191,11 @@ reader_flags_t AntReader::GetFlags() const {
         return {};
 }
 
+bool AntReader::ReadsIndependently() const
+{
+    return !reconstruct && !dynamic_cast<const detail::UnpackerReader*>(reader.get());
+}
+
 double AntReader::PercentDone() const
 {
     if(reader)
@@ -144,6 +211,12 @@ bool AntReader::ReadNextEvent(event_t& event)
     // we expect Reconstructed branch to be filled always
     auto nextevent = reader->NextEvent();
 
+    if(!filter_tids.empty()) {
+        while(nextevent && !binary_search(filter_tids.begin(), filter_tids.end(),
+                                          nextevent.Reconstructed().ID))
+            nextevent = reader->NextEvent();
+    }
+
     if(nextevent) {
         if(reconstruct) {
             TEventData& recon = nextevent.Reconstructed();
@@ -153,12 +226,20 @@ bool AntReader::ReadNextEvent(event_t& event)
                 reconstruct->DoReconstruct(recon);
         }
 
+        if(recocache)
+            recocache->Fill(nextevent);
+
         // pay attention that Geant unpacker might also set MCTrue branch partly
         event = move(nextevent);
 
         return true;
     }
 
+    if(recocache) {
+        recocache->Finish();
+        recocache = nullptr;
+    }
+
     reader = nullptr;
     return false;
 }
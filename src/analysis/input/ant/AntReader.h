@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ant {
 namespace analysis {
@@ -17,12 +18,19 @@ namespace detail {
 struct AntReaderInternal;
 }
 
+class RecoCache;
+
 class AntReader : public DataReader {
 
 protected:
     std::unique_ptr<detail::AntReaderInternal> reader;
     std::unique_ptr<Reconstruct_traits>        reconstruct;
 
+    // sorted, used if reader cannot select TIDs itself
+    std::vector<TID> filter_tids;
+
+    std::unique_ptr<RecoCache> recocache;
+
 public:
     AntReader(const std::shared_ptr<WrapTFileInput>& rootfiles,
               std::unique_ptr<Unpacker::Module> unpacker,
@@ -31,10 +39,31 @@ public:
     AntReader(const AntReader&) = delete;
     AntReader& operator= (const AntReader&) = delete;
 
+    /**
+     * @brief SelectTIDs reads only events with the given TIDs
+     * @param tids
+     *
+     * Seeks directly to the events if the input provides an index,
+     * see Unpacker::Module::SelectTIDs, otherwise all events are read and filtered
+     */
+    void SelectTIDs(std::vector<TID> tids);
+
+    /**
+     * @brief WriteRecoCache fills all reconstructed events into the given cache
+     * @param cache
+     *
+     * The cache is only finished if all events were read
+     */
+    void WriteRecoCache(std::unique_ptr<RecoCache> cache);
+
     // DataReader interface
     virtual reader_flags_t GetFlags() const override;
     virtual bool ReadNextEvent(event_t& event) override;
 
+    // only without unpacker and reconstruction, which load calibrations
+    // into the shared setup and smear with gRandom
+    virtual bool ReadsIndependently() const override;
+
     double PercentDone() const override;
 };
 
@@ -0,0 +1,141 @@
+#include "RecoCache.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+#include "expconfig/ExpConfig.h"
+#include "calibration/DataManager.h"
+
+#include "base/WrapTFile.h"
+#include "base/GitInfo.h"
+#include "base/Logger.h"
+#include "base/std_ext/string.h"
+#include "base/std_ext/system.h"
+
+#include "TNamed.h"
+#include "TTree.h"
+
+#include <cstdio>
+
+#include <sys/stat.h>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis::input;
+
+namespace {
+const string keyname = "RecoCacheKey";
+}
+
+string RecoCache::MakeKey(const string& rawfile, const string& options)
+{
+    const auto filekey = MakeFileKey(rawfile);
+    if(filekey.empty()) {
+        LOG(WARNING) << "Cannot identify raw file " << rawfile << ", reconstruction cannot be cached";
+        return "";
+    }
+    auto& setup = ExpConfig::Setup::Get();
+    auto calmgr = setup.GetCalibrationDataManager();
+    if(!calmgr)
+        return "";
+    // status also reports untracked files, such as new calibration data
+    const GitInfo gitinfo_db(calmgr->GetCalibrationDataFolder());
+    const string database = gitinfo_db.GetDescription();
+    if(database.empty() || gitinfo_db.IsDirty()) {
+        LOG(WARNING) << "Calibration database has uncommitted changes or no git description, reconstruction cannot be cached";
+        return "";
+    }
+    // reconstruction and calibration modules are part of Ant itself
+    const GitInfo gitinfo_ant;
+    const string ant = gitinfo_ant.GetDescription();
+    if(ant.empty() || gitinfo_ant.IsDirty()) {
+        LOG(WARNING) << "Ant has uncommitted changes or no git description, reconstruction cannot be cached";
+        return "";
+    }
+    return std_ext::formatter()
+            << filekey
+            << " Ant=" << ant
+            << " Setup=" << setup.GetName()
+            << " Database=" << database
+            << " Options=" << options
+            << " TEventVersion=" << ANT_TEVENT_VERSION;
+}
+
+string RecoCache::MakeFileKey(const string& rawfile)
+{
+    struct stat buf;
+    if(stat(rawfile.c_str(), &buf) != 0)
+        return "";
+    return std_ext::formatter()
+            << "Raw=" << std_ext::system::absolutePath(rawfile)
+            << " Inode=" << buf.st_ino
+            << " Size=" << buf.st_size
+            << " MTime=" << buf.st_mtime;
+}
+
+shared_ptr<WrapTFileInput> RecoCache::Open(const string& filename, const string& key)
+{
+    shared_ptr<WrapTFileInput> input;
+    try {
+        input = make_shared<WrapTFileInput>(filename);
+    }
+    catch(WrapTFile::Exception&) {
+        VLOG(5) << "No reconstruction cache " << filename << " found";
+        return nullptr;
+    }
+
+    TNamed* cachekey = nullptr;
+    if(!input->GetObject(keyname, cachekey) || key != cachekey->GetTitle()) {
+        LOG(INFO) << "Reconstruction cache " << filename << " outdated";
+        return nullptr;
+    }
+
+    LOG(INFO) << "Reading reconstructed events from cache " << filename;
+    return input;
+}
+
+RecoCache::RecoCache(const string& filename_, const string& key_) :
+    filename(filename_),
+    tmpfilename(filename_ + ".tmp"),
+    key(key_),
+    file(std_ext::make_unique<WrapTFileOutput>(tmpfilename))
+{
+    treeEvents.CreateBranches(file->CreateInside<TTree>("treeEvents","TEvent data"));
+    treeEventsTIDs.CreateBranches(file->CreateInside<TTree>("treeEventsTIDs","TIDs of treeEvents"));
+    LOG(INFO) << "Writing reconstructed events to cache " << filename;
+}
+
+RecoCache::~RecoCache()
+{
+    // not finished means incomplete, so discard it
+    if(file) {
+        file = nullptr;
+        remove(tmpfilename.c_str());
+    }
+}
+
+void RecoCache::Fill(TEvent& event)
+{
+    // the read hits are kept, calibration physics and the trigger simulation need them
+    // (the latter recalculates the not serialized TriggerSums from them)
+    treeEventsTIDs.ID = event.Reconstructed().ID;
+    treeEventsTIDs.Tree->Fill();
+
+    // move the event through the branch to avoid a copy
+    treeEvents.data = move(event);
+    treeEvents.Tree->Fill();
+    event = move(treeEvents.data());
+}
+
+void RecoCache::Finish()
+{
+    if(!file)
+        return;
+    TNamed cachekey(keyname.c_str(), key.c_str());
+    file->WriteObject(&cachekey, keyname);
+    LOG(INFO) << "Wrote " << treeEvents.Tree->GetEntries() << " events to reconstruction cache";
+    // writes the trees
+    file = nullptr;
+    if(rename(tmpfilename.c_str(), filename.c_str()) != 0)
+        LOG(WARNING) << "Could not move reconstruction cache to " << filename;
+}
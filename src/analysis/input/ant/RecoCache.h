@@ -0,0 +1,89 @@
+#pragma once
+
+#include "analysis/input/treeEvents_t.h"
+
+#include <memory>
+#include <string>
+
+namespace ant {
+
+struct TEvent;
+class WrapTFileInput;
+class WrapTFileOutput;
+
+namespace analysis {
+namespace input {
+
+/**
+ * @brief The RecoCache class stores reconstructed events next to a raw file
+ *
+ * The cache contains the reconstructed TEvents including their DetectorReadHits
+ * of a complete pass over the raw file.
+ * It is keyed on the raw file, Ant version, setup name, calibration database state and the
+ * setup options, and only reused if that key matches. Use with AntReader, see Ant's --u_recocache
+ */
+class RecoCache {
+public:
+
+    static std::string GetFilename(const std::string& rawfile) {
+        return rawfile + ".reco.root";
+    }
+
+    /**
+     * @brief MakeKey describes the current reconstruction state of the raw file
+     * @param rawfile the file to be reconstructed, see MakeFileKey
+     * @param options reconstruction options, such as setup options
+     * @return key, or empty string if the state cannot be described reliably
+     *
+     * Ant or calibration databases with uncommitted changes (including untracked files) cannot be cached
+     */
+    static std::string MakeKey(const std::string& rawfile, const std::string& options);
+
+    /**
+     * @brief MakeFileKey identifies the raw file by absolute path, inode, size and modification time
+     * @return key, or empty string if the file cannot be found
+     *
+     * A replaced or re-acquired raw file with the same name gets a different key
+     */
+    static std::string MakeFileKey(const std::string& rawfile);
+
+    /**
+     * @brief Open the cache for reading
+     * @return files to be read by AntReader, or nullptr if no cache with matching key exists
+     */
+    static std::shared_ptr<WrapTFileInput> Open(const std::string& filename, const std::string& key);
+
+    /**
+     * @brief RecoCache creates a new cache for writing
+     * @param filename
+     * @param key
+     *
+     * The cache is written to a temporary file first, and only moved to filename by Finish()
+     */
+    RecoCache(const std::string& filename, const std::string& key);
+    ~RecoCache();
+
+    /**
+     * @brief Fill adds the event to the cache
+     * @param event is unchanged afterwards
+     */
+    void Fill(TEvent& event);
+
+    /**
+     * @brief Finish is to be called when all events of the raw file were filled
+     */
+    void Finish();
+
+    RecoCache(const RecoCache&) = delete;
+    RecoCache& operator=(const RecoCache&) = delete;
+
+protected:
+    const std::string filename;
+    const std::string tmpfilename;
+    const std::string key;
+    std::unique_ptr<WrapTFileOutput> file;
+    treeEvents_t treeEvents;
+    treeEventsTIDs_t treeEventsTIDs;
+};
+
+}}} // namespace ant::analysis::input
@@ -19,11 +19,6 @@ using namespace ant;
 using namespace ant::analysis::input;
 using namespace std;
 
-// for GoatReader::trees std::set
-bool operator<(const reference_wrapper<TTree>& t1, const reference_wrapper<TTree>& t2) {
-    return addressof(t1.get()) < addressof(t2.get());
-}
-
 GoatReader::GoatReader(const std::shared_ptr<const WrapTFileInput>& rootfiles) :
     current_entry(0),
     max_entries(0),
@@ -52,8 +47,8 @@ GoatReader::GoatReader(const std::shared_ptr<const WrapTFileInput>& rootfiles) :
         auto it = trees.begin();
         auto it_next = std::next(it);
         for( ; it_next != trees.end() ; ++it, ++it_next) {
-            auto& t1 = it->get();
-            auto& t2 = it_next->get();
+            auto& t1 = *it->first;
+            auto& t2 = *it_next->first;
             if(t1.GetEntries() != t2.GetEntries())
                 throw Exception("Tree "+string(t1.GetName())+ " and tree "+
                                 string(t2.GetName())+" do not have equal entries");
@@ -61,7 +56,7 @@ GoatReader::GoatReader(const std::shared_ptr<const WrapTFileInput>& rootfiles) :
     }
 
     // as all trees have same number of entries, max_entries is given by front element
-    max_entries = trees.begin()->get().GetEntries();
+    max_entries = trees.begin()->first->GetEntries();
 
     LOG(INFO) << "Successfully opened GoAT file with " << max_entries << " entries";
 }
@@ -82,7 +77,7 @@ bool GoatReader::ReadNextEvent(event_t& event)
         return false;
 
     for(auto& t : trees) {
-        t.get().GetEntry(current_entry);
+        t.second->GetEntry(current_entry);
     }
 
     if(!event.HasReconstructed()) {
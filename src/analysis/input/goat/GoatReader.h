@@ -6,7 +6,7 @@
 #include "base/types.h"
 
 #include <string>
-#include <set>
+#include <map>
 
 namespace ant {
 
@@ -27,7 +27,8 @@ protected:
     std::shared_ptr<const WrapTFileInput> inputfiles;
     std::shared_ptr<const expconfig::detector::Trigger> trigger;
 
-    using trees_t = std::set<std::reference_wrapper<TTree>>;
+    // the first WrapTTree linked to a TTree reads the entry for all others
+    using trees_t = std::map<TTree*, WrapTTree*>;
 
     struct treeDetectorHitInput_t {
         struct treeHits_t : WrapTTree {
@@ -129,9 +130,12 @@ protected:
     treeTriggerInput_t     treeTriggerInput;
     treeTrackInput_t       treeTrackInput;
 
-    template<typename... Args>
-    static void insert_trees(trees_t& trees, const Args&... args) {
-        trees.insert({std::ref(static_cast<TTree&>(*args.Tree))...});
+    static void insert_trees(trees_t&) {}
+    template<typename T, typename... Args>
+    static void insert_trees(trees_t& trees, T& tree, Args&... args) {
+        tree.EnableReadAhead();
+        trees.emplace(tree.Tree, std::addressof(tree));
+        insert_trees(trees, args...);
     }
 
     trees_t trees;
@@ -1,7 +1,9 @@
 #include "PlutoReader.h"
 
+#include <functional>
 #include <string>
 #include <iostream>
+#include <map>
 #include <memory>
 
 #include "utils/ParticleTools.h"
@@ -35,12 +37,14 @@ PlutoReader::PlutoReader(const std::shared_ptr<WrapTFileInput>& rootfiles) :
     VLOG(5) << "Found Pluto 'data' tree";
 
     plutoTree.LinkBranches();
+    plutoTree.EnableReadAhead();
 
     if(files->GetObject("data_tid", tidTree.Tree)) {
         if(tidTree.Tree->GetEntries() != plutoTree.Tree->GetEntries()) {
             throw Exception("Pluto Tree / TID Tree size mismatch:");
         }
         tidTree.LinkBranches();
+        tidTree.EnableReadAhead();
     }
     else {
         // think of some better timestamp here?
@@ -61,9 +65,16 @@ PlutoReader::PlutoReader(const std::shared_ptr<WrapTFileInput>& rootfiles) :
     }
 
     pluto_database = makeStaticData();
+    // lookup by name is slow, so do it once
+    plutoID_dilepton = pluto_database->GetParticleID("dilepton");
+    plutoID_dimuon   = pluto_database->GetParticleID("dimuon");
 }
 
-PlutoReader::~PlutoReader() {}
+PlutoReader::~PlutoReader()
+{
+    VLOG_IF(current_entry>0, 5) << "Built " << nTemplateBuilt << " of " << current_entry
+                                << " MCTrue trees from cached decay template";
+}
 
 /**
  * @brief Find a PParticle in a vector by its ID. ID has to be unique in the vector.
@@ -105,6 +116,13 @@ std::string PlutoTable(const std::vector<const PParticle*> particles) {
 
 using PlutoParticles_t = std::vector<const PParticle*>;
 
+TParticlePtr MakeParticleGunHead() {
+    // make sure really uses that as some "true" particle...
+    return make_shared<TParticle>(
+                ParticleTypeDatabase::ParticleGun,
+                LorentzVec({std_ext::NaN,std_ext::NaN,std_ext::NaN}, std_ext::NaN));
+}
+
 bool BuildParticleGunTree(
         TParticleTree_t& mctrueTree,
         const PlutoParticles_t& plutoParticles,
@@ -128,11 +146,7 @@ bool BuildParticleGunTree(
     // build a tree with all particles as leaves and
     // "pseudo" GunParticle as headnode
 
-    mctrueTree = Tree<TParticlePtr>::MakeNode(
-                     make_shared<TParticle>(
-                         ParticleTypeDatabase::ParticleGun,
-                         // make sure really uses that as some "true" particle...
-                         LorentzVec({std_ext::NaN,std_ext::NaN,std_ext::NaN}, std_ext::NaN)));
+    mctrueTree = Tree<TParticlePtr>::MakeNode(MakeParticleGunHead());
 
     for(auto& treeNode : flatTree) {
         treeNode->SetParent(mctrueTree);
@@ -215,6 +229,65 @@ bool BuildDecayTree(
     return true;
 }
 
+bool PlutoReader::decay_template_t::Matches(const PlutoParticles_t& plutoParticles) const
+{
+    if(Keys.size() != plutoParticles.size())
+        return false;
+    for(size_t i=0; i<plutoParticles.size(); ++i) {
+        auto& p = plutoParticles[i];
+        if(!(Keys[i] == key_t{p->ID(), p->GetParentIndex(), p->GetDaughterIndex(), p->GetParentId()}))
+            return false;
+    }
+    return true;
+}
+
+void PlutoReader::decay_template_t::Learn(const PlutoParticles_t& plutoParticles,
+                                          const TParticleList& particles,
+                                          const TParticleTree_t& tree)
+{
+    Keys.clear();
+    Types.clear();
+    Nodes.clear();
+
+    std::map<TParticlePtr, int> indices;
+    for(size_t i=0; i<plutoParticles.size(); ++i) {
+        auto& p = plutoParticles[i];
+        Keys.emplace_back(key_t{p->ID(), p->GetParentIndex(), p->GetDaughterIndex(), p->GetParentId()});
+        Types.emplace_back(particles[i] ? addressof(particles[i]->Type()) : nullptr);
+        if(particles[i])
+            indices[particles[i]] = int(i);
+    }
+
+    // parents are visited before their daughters,
+    // and daughters in the order of the (sorted) tree
+    std::function<void(const TParticleTree_t&, int)> visit = [this, &indices, &visit] (const TParticleTree_t& node, int parent) {
+        auto it_index = indices.find(node->Get());
+        Nodes.emplace_back(node_t{it_index == indices.end() ? -1 : it_index->second, parent});
+        const int self = int(Nodes.size())-1;
+        for(auto& d : node->Daughters())
+            visit(d, self);
+    };
+    visit(tree, -1);
+
+    Sorted = tree->Get()->Type() != ParticleTypeDatabase::ParticleGun;
+}
+
+TParticleTree_t PlutoReader::decay_template_t::Build(const TParticleList& particles) const
+{
+    vector<TParticleTree_t> nodes;
+    nodes.reserve(Nodes.size());
+    for(auto& n : Nodes) {
+        nodes.emplace_back(Tree<TParticlePtr>::MakeNode(
+                               n.PlutoIndex < 0 ? MakeParticleGunHead() : particles[n.PlutoIndex]));
+        if(n.Parent >= 0)
+            nodes[n.Parent]->AddDaughter(nodes.back());
+    }
+    // same as sorting like BuildDecayTree does
+    if(Sorted)
+        nodes.front()->SetSorted();
+    return nodes.front();
+}
+
 void PlutoReader::CopyPluto(TEventData& mctrue)
 {
     const auto nParticles = plutoTree.Particles().GetEntries();
@@ -226,14 +299,18 @@ void PlutoReader::CopyPluto(TEventData& mctrue)
     for(auto i=0;i<nParticles;++i) {
         auto particle = dynamic_cast<const PParticle*>(plutoTree.Particles()[i]);
         // remember positions of those weird dilepton/dimuon particles
-        if(particle->ID() == pluto_database->GetParticleID("dilepton") ||
-           particle->ID() == pluto_database->GetParticleID("dimuon"))
+        if(particle->ID() == plutoID_dilepton ||
+           particle->ID() == plutoID_dimuon)
             dileptonIndices.push_back(i);
         plutoParticles.push_back(particle);
     }
 
+    // same topology as before, then types and tree structure are known
+    const bool useTemplate = decayTemplate.Matches(plutoParticles);
 
     vector<TParticleTree_t> flatTree;
+    TParticleList particles;
+    particles.reserve(plutoParticles.size());
     TParticleList finalstateParticles;
     // convert pluto particles to ant particles and place in buffer list
     for(size_t i=0; i<plutoParticles.size(); ++i) {
@@ -241,7 +318,8 @@ void PlutoReader::CopyPluto(TEventData& mctrue)
         auto& plutoParticle = plutoParticles[i];
 
         // find pluto type in database
-        auto type = ParticleTypeDatabase::GetTypeFromPlutoID( plutoParticle->ID() );
+        auto type = useTemplate ? decayTemplate.Types[i]
+                                : ParticleTypeDatabase::GetTypeFromPlutoID( plutoParticle->ID() );
 
         // note that type might be nullptr (in particular for those dileptons...)
         // then just add some "empty" tree node
@@ -251,7 +329,9 @@ void PlutoReader::CopyPluto(TEventData& mctrue)
                 throw Exception(std_ext::formatter() << "Unknown pluto particle found: ID="
                                 << plutoParticle->ID());
 
-            flatTree.emplace_back(Tree<TParticlePtr>::MakeNode(nullptr));
+            particles.emplace_back(nullptr);
+            if(!useTemplate)
+                flatTree.emplace_back(Tree<TParticlePtr>::MakeNode(nullptr));
             continue;
         }
 
@@ -276,19 +356,28 @@ void PlutoReader::CopyPluto(TEventData& mctrue)
         }
 
         // save it in list with same order as in PlutoParticles
-        flatTree.emplace_back(Tree<TParticlePtr>::MakeNode(antParticle));
+        particles.emplace_back(antParticle);
+        if(!useTemplate)
+            flatTree.emplace_back(Tree<TParticlePtr>::MakeNode(antParticle));
 
     }
 
+    if(useTemplate) {
+        mctrue.ParticleTree = decayTemplate.Build(particles);
+        nTemplateBuilt++;
+    }
     // try building the particle tree
     // first check if it's a particle gun event
     // then try building the usual decay tree
-    if(!BuildParticleGunTree(mctrue.ParticleTree, plutoParticles, flatTree)) {
-        if(!BuildDecayTree(mctrue.ParticleTree, plutoParticles, flatTree, dileptonIndices)) {
-            LOG_N_TIMES(10, WARNING) << "Missing decay tree info for event " << mctrue.ID
-                                     << " (max 10 times reported)";
-            VLOG(5)      << "Dumping Pluto particles:\n" << PlutoTable(plutoParticles);
-        }
+    else if(BuildParticleGunTree(mctrue.ParticleTree, plutoParticles, flatTree) ||
+            BuildDecayTree(mctrue.ParticleTree, plutoParticles, flatTree, dileptonIndices)) {
+        VLOG_IF(!decayTemplate.Keys.empty(), 7) << "Decay topology changed, learning new template";
+        decayTemplate.Learn(plutoParticles, particles, mctrue.ParticleTree);
+    }
+    else {
+        LOG_N_TIMES(10, WARNING) << "Missing decay tree info for event " << mctrue.ID
+                                 << " (max 10 times reported)";
+        VLOG(5)      << "Dumping Pluto particles:\n" << PlutoTable(plutoParticles);
     }
 
     // some diagnostics
@@ -321,27 +410,13 @@ bool PlutoReader::ReadNextEvent(event_t& event)
     if(current_entry >= plutoTree.Tree->GetEntries())
         return false;
 
-    plutoTree.Tree->GetEntry(current_entry);
+    plutoTree.GetEntry(current_entry);
 
     // use eventID from file if available
-    // also check if it matches with reconstructed TID
-    if(tidTree) {
-        tidTree.Tree->GetEntry(current_entry);
-        if(event.HasReconstructed() &&
-           event.Reconstructed().ID != tidTree.tid) {
-            throw Exception(std_ext::formatter()
-                            << "TID mismatch: Reconstructed=" << event.Reconstructed().ID
-                            << " not equal to MCTrue=" << tidTree.tid);
-        }
-    }
+    if(tidTree)
+        tidTree.GetEntry(current_entry);
 
-    // ensure MCTrue branch is there, potentially add TID if invalid so far
-    if(!event.HasMCTrue()) {
-        event.MakeMCTrue(tidTree.tid);
-    }
-    else if(event.MCTrue().ID.IsInvalid()) {
-        event.MCTrue().ID = tidTree.tid;
-    }
+    PrepareMCTrue(event, tidTree.tid);
 
     CopyPluto(event.MCTrue());
 
@@ -353,6 +428,40 @@ bool PlutoReader::ReadNextEvent(event_t& event)
     return true;
 }
 
+void PlutoReader::PrepareMCTrue(event_t& event, const TID& tid) const
+{
+    // check if eventID from file matches with reconstructed TID
+    if(tidTree &&
+       event.HasReconstructed() &&
+       event.Reconstructed().ID != tid) {
+        throw Exception(std_ext::formatter()
+                        << "TID mismatch: Reconstructed=" << event.Reconstructed().ID
+                        << " not equal to MCTrue=" << tid);
+    }
+
+    // ensure MCTrue branch is there, potentially add TID if invalid so far
+    if(!event.HasMCTrue()) {
+        event.MakeMCTrue(tid);
+    }
+    else if(event.MCTrue().ID.IsInvalid()) {
+        event.MCTrue().ID = tid;
+    }
+}
+
+void PlutoReader::AmendEvent(event_t& event, event_t&& read) const
+{
+    auto& src = read.MCTrue();
+    PrepareMCTrue(event, src.ID);
+
+    // take over what CopyPluto has filled
+    auto& mctrue = event.MCTrue();
+    std_ext::concatenate(mctrue.TaggerHits, src.TaggerHits);
+    mctrue.ParticleTree = move(src.ParticleTree);
+    mctrue.Trigger.ClusterMultiplicity = src.Trigger.ClusterMultiplicity;
+    mctrue.Trigger.CBTiming = src.Trigger.CBTiming;
+    mctrue.Trigger.CBEnergySum = src.Trigger.CBEnergySum;
+}
+
 double PlutoReader::PercentDone() const
 {
     return double(current_entry) / double(plutoTree.Tree->GetEntries());
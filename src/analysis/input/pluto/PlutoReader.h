@@ -4,12 +4,15 @@
 
 #include "analysis/utils/A2GeoAcceptance.h"
 
+#include "tree/TParticle.h"
+
 #include "base/ParticleType.h"
 #include "base/WrapTTree.h"
 
 #include <memory>
 #include <string>
 #include <list>
+#include <vector>
 
 #include "TClonesArray.h"
 
@@ -49,9 +52,52 @@ protected:
 
     long long current_entry = 0;
 
+    /**
+     * @brief The decay_template_t struct caches the MCTrue tree topology of the last event
+     *
+     * Single-channel MC files have the same decay topology in every event,
+     * so the tree is built by just linking the new particles according to the
+     * template instead of searching parents, removing dileptons and sorting.
+     */
+    struct decay_template_t {
+        // key: pluto ID, parent/daughter index and parent ID of each pluto particle
+        struct key_t {
+            int ID;
+            int ParentIndex;
+            int DaughterIndex;
+            int ParentID;
+            bool operator==(const key_t& o) const {
+                return ID == o.ID && ParentIndex == o.ParentIndex &&
+                       DaughterIndex == o.DaughterIndex && ParentID == o.ParentID;
+            }
+        };
+        std::vector<key_t> Keys;
+        // ant type of each pluto particle, nullptr for dileptons
+        std::vector<const ParticleTypeDatabase::Type*> Types;
+
+        // nodes of the finished tree depth-first (parents first), in sorted order
+        struct node_t {
+            int PlutoIndex; // -1 for particle gun headnode
+            int Parent;     // index in Nodes, -1 for headnode
+        };
+        std::vector<node_t> Nodes;
+        bool Sorted = false;
+
+        bool Matches(const std::vector<const PParticle*>& plutoParticles) const;
+        void Learn(const std::vector<const PParticle*>& plutoParticles,
+                   const TParticleList& particles, const TParticleTree_t& tree);
+        TParticleTree_t Build(const TParticleList& particles) const;
+    };
+
+    decay_template_t decayTemplate;
+    long long nTemplateBuilt = 0;
+
     void CopyPluto(TEventData& mctrue);
+    void PrepareMCTrue(event_t& event, const TID& tid) const;
 
     PStaticData* pluto_database;
+    int plutoID_dilepton = -1;
+    int plutoID_dimuon = -1;
 
 public:
     PlutoReader(const std::shared_ptr<ant::WrapTFileInput>& rootfiles);
@@ -62,6 +108,9 @@ public:
     virtual reader_flags_t GetFlags() const override { return {}; }
     virtual bool ReadNextEvent(input::event_t& event) override;
 
+    virtual bool ReadsIndependently() const override { return true; }
+    virtual void AmendEvent(event_t& event, event_t&& read) const override;
+
     double PercentDone() const override;
 };
 
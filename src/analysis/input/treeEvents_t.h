@@ -1,6 +1,7 @@
 #pragma once
 
 #include "tree/TEvent.h"
+#include "tree/TID.h"
 #include "base/WrapTTree.h"
 
 namespace ant {
@@ -11,4 +12,10 @@ struct treeEvents_t : WrapTTree {
     ADD_BRANCH_T(TEvent, data)
 };
 
+// entry-wise TIDs of treeEvents,
+// cheap to read for selecting entries by TID
+struct treeEventsTIDs_t : WrapTTree {
+    ADD_BRANCH_T(TID, ID)
+};
+
 }}}
\ No newline at end of file
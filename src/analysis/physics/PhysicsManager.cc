@@ -2,6 +2,7 @@
 
 #include "utils/ParticleID.h"
 #include "input/DataReader.h"
+#include "input/ReadAheadReader.h"
 
 #include "tree/TSlowControl.h"
 #include "base/Logger.h"
@@ -54,6 +55,28 @@ void PhysicsManager::InitReaders(readers_t readers_)
             ++it_amender;
         }
     }
+
+    if(readAhead == 0)
+        return;
+
+    if(!input::ReadAheadReader::Available()) {
+        LOG(WARNING) << "Reading ahead requires ROOT 6, reading synchronously";
+        return;
+    }
+
+    // each reader which can do so runs ahead on its own thread,
+    // TryReadEvent then only combines the ready events
+    unsigned nWrapped = 0;
+    auto wrap = [this, &nWrapped] (unique_ptr<input::DataReader>& reader) {
+        if(!reader || !reader->ReadsIndependently())
+            return;
+        reader = std_ext::make_unique<input::ReadAheadReader>(move(reader), readAhead);
+        nWrapped++;
+    };
+    wrap(source);
+    for(auto& amender : amenders)
+        wrap(amender);
+    VLOG(5) << nWrapped << " readers reading up to " << readAhead << " events ahead";
 }
 
 
@@ -73,6 +96,7 @@ void PhysicsManager::ReadFrom(
 
     // prepare output of TEvents
     treeEvents.CreateBranches(new TTree("treeEvents","TEvent data"));
+    treeEventsTIDs.CreateBranches(new TTree("treeEventsTIDs","TIDs of treeEvents"));
 
     long long nEventsRead = 0;
     long long nEventsProcessed = 0;
@@ -179,6 +203,9 @@ void PhysicsManager::ReadFrom(
         ProgressCounter::Tick();
     }
 
+    // histograms filled via per-thread buffers are complete before Finish
+    HistogramFactory::FlushBuffers();
+
     for(auto& pclass : physics) {
         pclass->Finish();
     }
@@ -196,14 +223,22 @@ void PhysicsManager::ReadFrom(
               << processed_str << ", speed "
               << nEventsProcessed/progress.GetTotalSecs() << " event/s";
 
+    const auto readStats = WrapTTree::GetReadStats();
+    if(readStats.Entries>0)
+        LOG(INFO) << "Reading trees took " << readStats.Seconds << " s ("
+                  << readStats.Bytes/1024.0/1024.0 << " MB), I/O wait fraction "
+                  << readStats.Seconds/progress.GetTotalSecs();
+
     const auto nEventsSavedTotal = treeEvents.Tree->GetEntries();
     if(nEventsSaved==0) {
         if(nEventsSavedTotal>0)
             VLOG(5) << "Deleting " << nEventsSavedTotal << " treeEvents from slowcontrol only";
         delete treeEvents.Tree;
+        delete treeEventsTIDs.Tree;
     }
     else if(treeEvents.Tree->GetCurrentFile() != nullptr) {
         treeEvents.Tree->Write();
+        treeEventsTIDs.Tree->Write();
         const auto n_sc = nEventsSavedTotal - nEventsSaved;
         LOG(INFO) << "Wrote " << nEventsSaved  << " treeEvents"
                   << (n_sc>0 ? string(std_ext::formatter() << " (+slowcontrol: " << n_sc << ")") : "")
@@ -269,6 +304,9 @@ void PhysicsManager::SaveEvent(input::event_t event, const physics::manager_t& m
         if(!manager.keepReadHits && !event.SavedForSlowControls)
             event.ClearDetectorReadHits();
 
+        treeEventsTIDs.ID = event.HasReconstructed() ? event.Reconstructed().ID : event.MCTrue().ID;
+        treeEventsTIDs.Tree->Fill();
+
         treeEvents.data = move(event);
         treeEvents.Tree->Fill();
     }
@@ -36,6 +36,7 @@ protected:
     using readers_t = std::list< std::unique_ptr<input::DataReader> >;
     readers_t amenders;
     input::reader_flags_t reader_flags;
+    unsigned readAhead = 0;
 
     void InitReaders(readers_t readers_);
     bool TryReadEvent(input::event_t& event);
@@ -61,6 +62,7 @@ protected:
 
     // for output of TEvents to TTree
     input::treeEvents_t treeEvents;
+    input::treeEventsTIDs_t treeEventsTIDs;
 
 public:
 
@@ -85,6 +87,12 @@ public:
 
     const interval<TID>& GetProcessedTIDRange() const { return processedTIDrange; }
 
+    /**
+     * @brief SetReadAhead lets readers which support it read up to nEvents ahead on their own thread
+     * @param nEvents buffered per reader, 0 reads synchronously (default)
+     */
+    void SetReadAhead(unsigned nEvents) { readAhead = nEvents; }
+
     void ReadFrom(std::list<std::unique_ptr<input::DataReader> > readers_,
                   long long maxevents
                   );
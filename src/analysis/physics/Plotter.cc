@@ -10,7 +10,8 @@ PlotterRegistry& PlotterRegistry::get_instance()
     return instance;
 }
 
-std::unique_ptr<Plotter> PlotterRegistry::Create(const string &name, const WrapTFileInput& input, OptionsPtr opts)
+std::unique_ptr<Plotter> PlotterRegistry::Create(const string &name, const WrapTFileInput& input, OptionsPtr opts,
+                                                 const string& instancename)
 {
     auto& creators = PlotterRegistry::get_instance().plotter_creators;
 
@@ -19,7 +20,7 @@ std::unique_ptr<Plotter> PlotterRegistry::Create(const string &name, const WrapT
         throw std::runtime_error("Plotter class " + name + " not found");
 
     // this may throw an exception
-    auto plotter = creator->second(name, input, opts);
+    auto plotter = creator->second(instancename.empty() ? name : instancename, input, opts);
 
     return plotter;
 }
@@ -39,10 +40,13 @@ PlotterRegistration::PlotterRegistration(plotter_creator c, const string& name)
     PlotterRegistry::get_instance().RegisterPlotter(c,name);
 }
 
-Plotter::Plotter(const string &name, const WrapTFileInput&, OptionsPtr):
+Plotter::Plotter(const string &name, const WrapTFileInput&, OptionsPtr opts):
     name_(name),
     HistFac(name)
-{}
+{
+    if(opts)
+        HistFac.SetDirDescription(opts->Flatten());
+}
 
 void Plotter::Finish() {}
 
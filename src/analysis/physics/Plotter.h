@@ -53,7 +53,17 @@ private:
     }
 public:
 
-    static std::unique_ptr<Plotter> Create(const std::string& name, const WrapTFileInput &input, OptionsPtr opts = std::make_shared<OptionsList>());
+    /**
+     * @brief Create constructs the registered plotter class
+     * @param name registered class name
+     * @param input file with the trees to plot
+     * @param opts options for the plotter
+     * @param instancename name of the instance and its histogram directory, defaults to name
+     * @return the plotter
+     */
+    static std::unique_ptr<Plotter> Create(const std::string& name, const WrapTFileInput &input,
+                                           OptionsPtr opts = std::make_shared<OptionsList>(),
+                                           const std::string& instancename = "");
 
     static std::vector<std::string> GetList();
 
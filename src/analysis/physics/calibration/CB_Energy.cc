@@ -1,6 +1,6 @@
 #include "CB_Energy.h"
 
-#include "utils/Combinatorics.h"
+#include "utils/CalibrationContext.h"
 
 #include "expconfig/ExpConfig.h"
 #include "expconfig/detectors/CB.h"
@@ -32,31 +32,25 @@ CB_Energy::CB_Energy(const string& name, OptionsPtr opts) :
     h_cbdisplay = HistFac.make<TH2CB>("h_cbdisplay","Number of entries");
 }
 
-void CB_Energy::ProcessEvent(const TEvent& event, manager_t&)
+void CB_Energy::ProcessEvent(const TEvent& event, manager_t& manager)
 {
-    const auto& cands = event.Reconstructed().Candidates;
+    auto& context = utils::CalibrationContext::Get(event, manager);
+    const auto& photons = context.Photons();
 
-    for( auto comb = analysis::utils::makeCombination(cands.get_ptr_list(),2); !comb.done(); ++comb ) {
-        const TCandidatePtr& p1 = comb.at(0);
-        const TCandidatePtr& p2 = comb.at(1);
+    for(const auto& photon_pair : context.PhotonPairs()) {
+        const auto& p1 = photons[photon_pair.I];
+        const auto& p2 = photons[photon_pair.J];
 
-        if(   (!RequireVetoEZero || p1->VetoEnergy==0)
-           && (!RequireVetoEZero || p2->VetoEnergy==0)
-           && (p1->Detector & Detector_t::Type_t::CB)
-           && (p2->Detector & Detector_t::Type_t::CB)
-           && (vec3(*p1).Angle(*p2) > MinOpeningAngle)
+        if(   (!RequireVetoEZero || p1.Candidate->VetoEnergy==0)
+           && (!RequireVetoEZero || p2.Candidate->VetoEnergy==0)
+           && (p1.Candidate->Detector & Detector_t::Type_t::CB)
+           && (p2.Candidate->Detector & Detector_t::Type_t::CB)
+           && (photon_pair.OpeningAngle > MinOpeningAngle)
            )
         {
-            const TParticle g1(ParticleTypeDatabase::Photon,p1);
-            const TParticle g2(ParticleTypeDatabase::Photon,p2);
-            const auto ggmass = (g1 + g2).M();
-
-            const auto cl1 = p1->FindCaloCluster();
-            const auto cl2 = p2->FindCaloCluster();
-
-            if(cl1 && cl2) {
-                FillggIM(*cl1, *cl2, ggmass);
-                FillggIM(*cl2, *cl1, ggmass);
+            if(p1.CaloCluster && p2.CaloCluster) {
+                FillggIM(*p1.CaloCluster, *p2.CaloCluster, photon_pair.IM);
+                FillggIM(*p2.CaloCluster, *p1.CaloCluster, photon_pair.IM);
             }
         }
     }
@@ -1,5 +1,7 @@
 #include "CB_TimeWalk.h"
 
+#include "utils/CalibrationContext.h"
+
 #include "expconfig/ExpConfig.h"
 #include "expconfig/detectors/CB.h"
 #include "calibration/converters/CATCH_TDC.h"
@@ -40,34 +42,16 @@ CB_TimeWalk::CB_TimeWalk(const string& name, OptionsPtr opts) :
                 );
 }
 
-void CB_TimeWalk::ProcessEvent(const TEvent& event, manager_t&)
+void CB_TimeWalk::ProcessEvent(const TEvent& event, manager_t& manager)
 {
 
-    struct hitmapping_t {
-        vector<TDetectorReadHit::Value_t> Integrals;
-        vector<TDetectorReadHit::Value_t> Timings;
-    };
-
-    std::map<unsigned, hitmapping_t> hits;
-
-    for(const TDetectorReadHit& readhit : event.Reconstructed().DetectorReadHits) {
-        if(readhit.DetectorType != Detector_t::Type_t::CB)
-            continue;
-
-        auto& item = hits[readhit.Channel];
-
-        if(readhit.ChannelType == Channel_t::Type_t::Integral) {
-            std_ext::concatenate(item.Integrals, readhit.Values);
-        }
-        else if(readhit.ChannelType == Channel_t::Type_t::Timing) {
-            std_ext::concatenate(item.Timings, readhit.Values); // passed the timing window!
-        }
-    }
+    auto& context = utils::CalibrationContext::Get(event, manager);
+    const auto& hits = context.ReadHits(Detector_t::Type_t::CB);
 
     for(const auto& it_hit : hits) {
 
         const auto channel = it_hit.first;
-        const hitmapping_t& item = it_hit.second;
+        const auto& item = it_hit.second;
 
         for(auto& integral : item.Integrals) {
             for(auto& time : item.Timings) {
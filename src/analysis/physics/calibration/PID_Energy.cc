@@ -1,5 +1,7 @@
 #include "PID_Energy.h"
 
+#include "utils/CalibrationContext.h"
+
 #include "expconfig/ExpConfig.h"
 
 #include "base/std_ext/container.h"
@@ -159,37 +161,19 @@ PID_Energy::PerChannel_t::PerChannel_t(HistogramFactory HistFac)
     QDCMultiplicity = HistFac.makeTH1D("PID QDC Multiplicity", "nHits", "#", BinSettings(10), "QDCMultiplicity");
 }
 
-void PID_Energy::ProcessEvent(const TEvent& event, manager_t&)
+void PID_Energy::ProcessEvent(const TEvent& event, manager_t& manager)
 {
     triggersimu.ProcessEvent(event);
 
-    // pedestals, best determined from clusters with energy information only
-
-    struct hitmapping_t {
-        vector<TDetectorReadHit::Value_t> Integrals;
-        vector<TDetectorReadHit::Value_t> Timings;
-    };
-
-    std::map<unsigned, hitmapping_t> hits;
-
-    for(const TDetectorReadHit& readhit : event.Reconstructed().DetectorReadHits) {
-        if(readhit.DetectorType != Detector_t::Type_t::PID)
-            continue;
-
-        auto& item = hits[readhit.Channel];
+    auto& context = utils::CalibrationContext::Get(event, manager);
 
-        if(readhit.ChannelType == Channel_t::Type_t::Integral) {
-            std_ext::concatenate(item.Integrals, readhit.Values);
-        }
-        else if(readhit.ChannelType == Channel_t::Type_t::Timing) {
-            std_ext::concatenate(item.Timings, readhit.Values); // passed the timing window!
-        }
-    }
+    // pedestals, best determined from clusters with energy information only
+    const auto& hits = context.ReadHits(Detector_t::Type_t::PID);
 
     for(const auto& it_hit : hits) {
 
         const auto channel = it_hit.first;
-        const hitmapping_t& item = it_hit.second;
+        const auto& item = it_hit.second;
 
         PerChannel_t& h = h_perChannel[channel];
 
@@ -215,15 +199,8 @@ void PID_Energy::ProcessEvent(const TEvent& event, manager_t&)
 
     // get some CandidateMatcher independent bananas
     {
-        TClusterPtrList cbClusters;
-        TClusterPtrList pidClusters;
-        for(auto cl : event.Reconstructed().Clusters.get_iter()) {
-            if(cl->DetectorType == Detector_t::Type_t::CB)
-                cbClusters.emplace_back(cl);
-            else if(cl->DetectorType == Detector_t::Type_t::PID)
-                pidClusters.emplace_back(cl);
-
-        }
+        const auto& cbClusters = context.Clusters(Detector_t::Type_t::CB);
+        const auto& pidClusters = context.Clusters(Detector_t::Type_t::PID);
 
         if(pidClusters.size() == 1) {
             const auto& pid_cluster = *pidClusters.front();
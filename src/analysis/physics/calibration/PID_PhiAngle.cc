@@ -1,5 +1,7 @@
 #include "PID_PhiAngle.h"
 
+#include "utils/CalibrationContext.h"
+
 #include "expconfig/ExpConfig.h"
 
 using namespace std;
@@ -19,33 +21,24 @@ PID_PhiAngle::PID_PhiAngle(const string& name, OptionsPtr opts) :
 }
 
 
-void PID_PhiAngle::ProcessEvent(const TEvent& event, manager_t&)
+void PID_PhiAngle::ProcessEvent(const TEvent& event, manager_t& manager)
 {
 
     // search for events with
     // one cluster in CB, one cluster in PID
 
-    TClusterPtr cluster_pid;
-    TClusterPtr cluster_cb;
-    auto& clusters = event.Reconstructed().Clusters;
-    for(auto it_cl = clusters.begin(); it_cl != clusters.end(); ++it_cl) {
-        if(it_cl->DetectorType == Detector_t::Type_t::PID) {
-            if(cluster_pid)
-                return;
-            cluster_pid = it_cl.get_ptr();
-        }
-        else if(it_cl->DetectorType == Detector_t::Type_t::CB) {
-            if(cluster_cb)
-                return;
-            cluster_cb = it_cl.get_ptr();
-        }
-    }
+    auto& context = utils::CalibrationContext::Get(event, manager);
+    const auto& clusters_pid = context.Clusters(Detector_t::Type_t::PID);
+    const auto& clusters_cb = context.Clusters(Detector_t::Type_t::CB);
+
+    if(clusters_pid.size() == 1 && clusters_cb.size() == 1) {
+        const TCluster& cluster_pid = *clusters_pid.front();
+        const TCluster& cluster_cb = *clusters_cb.front();
 
-    if(cluster_pid && cluster_cb) {
-        const double phi_cb_degrees = std_ext::radian_to_degree(cluster_cb->Position.Phi());
+        const double phi_cb_degrees = std_ext::radian_to_degree(cluster_cb.Position.Phi());
 
-        pid_cb_phi_corr->Fill(phi_cb_degrees,     cluster_pid->CentralElement);
-        pid_cb_phi_corr->Fill(phi_cb_degrees+360, cluster_pid->CentralElement);
+        pid_cb_phi_corr->Fill(phi_cb_degrees,     cluster_pid.CentralElement);
+        pid_cb_phi_corr->Fill(phi_cb_degrees+360, cluster_pid.CentralElement);
     }
 }
 
@@ -3,6 +3,7 @@
 #include "analysis/physics/Physics.h"
 #include "analysis/plot/PromptRandomHist.h"
 #include "analysis/utils/fitter/TreeFitter.h"
+#include "analysis/utils/Matcher.h"
 #include "base/ParticleTypeTree.h"
 #include "TLorentzVector.h"
 #include "TVector2.h"
@@ -97,6 +98,7 @@ public:
         TH3* TAPSVeto_banana = nullptr;
 
         utils::TreeFitter treefitter;
+        utils::Matcher1to1 matcher;
 
         static ParticleTypeTree getParticleTree(const unsigned nPi0);
 
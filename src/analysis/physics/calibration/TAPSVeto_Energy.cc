@@ -1,5 +1,7 @@
 #include "TAPSVeto_Energy.h"
 
+#include "utils/CalibrationContext.h"
+
 #include "expconfig/ExpConfig.h"
 
 using namespace std;
@@ -34,20 +36,17 @@ TAPSVeto_Energy::TAPSVeto_Energy(const string& name, OptionsPtr opts) :
                 );
 }
 
-void TAPSVeto_Energy::ProcessEvent(const TEvent& event, manager_t&)
+void TAPSVeto_Energy::ProcessEvent(const TEvent& event, manager_t& manager)
 {
+    auto& context = utils::CalibrationContext::Get(event, manager);
     const auto& cands = event.Reconstructed().Candidates;
 
     // pedestals
-    for(const TDetectorReadHit& readhit : event.Reconstructed().DetectorReadHits) {
-        if(readhit.DetectorType != Detector_t::Type_t::TAPSVeto)
-            continue;
-        if(readhit.ChannelType != Channel_t::Type_t::Integral)
-            continue;
-        /// \todo check for timing hit?
-        /// \todo check for trigger pattern?
-        for(const auto& value : readhit.Values)
-            h_pedestals->Fill(value.Uncalibrated, readhit.Channel);
+    /// \todo check for timing hit?
+    /// \todo check for trigger pattern?
+    for(const auto& it_hit : context.ReadHits(Detector_t::Type_t::TAPSVeto)) {
+        for(const auto& value : it_hit.second.Integrals)
+            h_pedestals->Fill(value.Uncalibrated, it_hit.first);
     }
 
     // bananas
@@ -1,6 +1,6 @@
 #include "TAPS_Energy.h"
 
-#include "utils/Combinatorics.h"
+#include "utils/CalibrationContext.h"
 
 #include "base/std_ext/container.h"
 
@@ -62,69 +62,62 @@ TAPS_Energy::TAPS_Energy(const string& name, OptionsPtr opts) :
     cands_TAPS.Setup("TAPS", cands_tree);
 }
 
-void TAPS_Energy::ProcessEvent(const TEvent& event, manager_t&)
+void TAPS_Energy::ProcessEvent(const TEvent& event, manager_t& manager)
 {
-    const auto& cands = event.Reconstructed().Candidates;
+    auto& context = utils::CalibrationContext::Get(event, manager);
 
     // pedestals
-    for(const TDetectorReadHit& readhit : event.Reconstructed().DetectorReadHits) {
-        if(readhit.DetectorType != Detector_t::Type_t::TAPS)
-            continue;
-        if(readhit.ChannelType != Channel_t::Type_t::Integral)
-            continue;
-        /// \todo check for timing hit?
-        /// \todo check for trigger pattern?
-        for(const auto& value : readhit.Values)
-            h_pedestals->Fill(value.Uncalibrated, readhit.Channel);
+    /// \todo check for timing hit?
+    /// \todo check for trigger pattern?
+    for(const auto& it_hit : context.ReadHits(Detector_t::Type_t::TAPS)) {
+        for(const auto& value : it_hit.second.Integrals)
+            h_pedestals->Fill(value.Uncalibrated, it_hit.first);
     }
 
-    // invariant mass of two photons
-    for( auto comb = analysis::utils::makeCombination(cands.get_ptr_list(),2); !comb.done(); ++comb ) {
-        const TCandidatePtr& p1 = comb.at(0);
-        const TCandidatePtr& p2 = comb.at(1);
-
-        // Use PID for CB, but not Vetos for TAPS
-        const auto checkVetoCB = [] (const TCandidate& c) {
-            return (c.Detector & Detector_t::Type_t::TAPS) || (c.VetoEnergy < 0.5);
-        };
-
-        const auto checkVetoAny = [] (const TCandidate& c) {
-            return (c.VetoEnergy < 0.5);
-        };
-
-        const auto Fill_h = [this] (TH2* h, const TClusterPtr& cluster, const double gg) {
-            const unsigned ch = cluster->CentralElement;
-            const unsigned ring = taps_detector->GetRing(ch);
-            if(ring > 4 || fabs(cluster->Time) < 5) {
-                h->Fill(gg,ch);
-            }
-        };
+    // Use PID for CB, but not Vetos for TAPS
+    const auto checkVetoCB = [] (const TCandidate& c) {
+        return (c.Detector & Detector_t::Type_t::TAPS) || (c.VetoEnergy < 0.5);
+    };
 
-        const TParticle g1(ParticleTypeDatabase::Photon,comb.at(0));
-        const TParticle g2(ParticleTypeDatabase::Photon,comb.at(1));
-        const auto& gg = (g1 + g2).M();
+    const auto checkVetoAny = [] (const TCandidate& c) {
+        return (c.VetoEnergy < 0.5);
+    };
+
+    const auto Fill_h = [this] (TH2* h, const TClusterPtr& cluster, const double gg) {
+        const unsigned ch = cluster->CentralElement;
+        const unsigned ring = taps_detector->GetRing(ch);
+        if(ring > 4 || fabs(cluster->Time) < 5) {
+            h->Fill(gg,ch);
+        }
+    };
 
-        const auto CBTAPS = [] (const TCandidatePtr& p1, const TCandidatePtr& p2) {
-            return p1->Detector & Detector_t::Type_t::CB && p2->Detector & Detector_t::Type_t::TAPS;
-        };
+    const auto CBTAPS = [] (const TCandidatePtr& p1, const TCandidatePtr& p2) {
+        return p1->Detector & Detector_t::Type_t::CB && p2->Detector & Detector_t::Type_t::TAPS;
+    };
+
+    // invariant mass of two photons
+    const auto& photons = context.Photons();
+    for(const auto& photon_pair : context.PhotonPairs()) {
+        const TCandidatePtr& p1 = photons[photon_pair.I].Candidate;
+        const TCandidatePtr& p2 = photons[photon_pair.J].Candidate;
+        const auto& cl1 = photons[photon_pair.I].CaloCluster;
+        const auto& cl2 = photons[photon_pair.J].CaloCluster;
+        const auto gg = photon_pair.IM;
 
         // 1CB 1TAPS
         if(CBTAPS(p1,p2) || CBTAPS(p2,p1))
             {
                 // Find the one that was in TAPS
-                auto cand_taps = p1->Detector & Detector_t::Type_t::TAPS ? p1 : p2;
-                auto cl_taps = cand_taps->FindCaloCluster();
-
-                auto cand_cb   = p1->Detector & Detector_t::Type_t::CB ? p1 : p2;
-                auto cl_cb = cand_cb->FindCaloCluster();
+                const auto& cl_taps = p1->Detector & Detector_t::Type_t::TAPS ? cl1 : cl2;
+                const auto& cl_cb   = p1->Detector & Detector_t::Type_t::CB ? cl1 : cl2;
 
                 if(cl_cb && cl_taps && !cl_cb->HasFlag(TCluster::Flags_t::TouchesHoleCentral)) {
 
                     if(checkVetoCB(*p1) && checkVetoCB(*p2)) {
                         // 1CB 1TAPS, PID Only
                         Fill_h(ggIM_CBTAPS_PID, cl_taps, gg);
-
                     }
+
                     if(checkVetoAny(*p1) && checkVetoAny(*p2)) {
                         //1CB 1TAPS, PID and Vetos
                         Fill_h(ggIM_CBTAPS_PIDVetos, cl_taps, gg);
@@ -133,35 +126,36 @@ void TAPS_Energy::ProcessEvent(const TEvent& event, manager_t&)
         }
 
         // Any combination 1CB 1TAPS + 2TAPS
-        {
-            auto cl1 = p1->FindCaloCluster();
-            auto cl2 = p2->FindCaloCluster();
-
-            if(cl1 && cl2) {
-                if(checkVetoCB(*p1) && checkVetoCB(*p2)) {
-                    if((p1->Detector & Detector_t::Type_t::TAPS)
-                            && !cl2->HasFlag(TCluster::Flags_t::TouchesHoleCentral)) {
-                        Fill_h(ggIM_Any_PID, cl1, gg);
-                    }
-                    if((p2->Detector & Detector_t::Type_t::TAPS)
-                            && !cl1->HasFlag(TCluster::Flags_t::TouchesHoleCentral)) {
-                        Fill_h(ggIM_Any_PID, cl2, gg);
-                    }
+        if(cl1 && cl2) {
+
+            if(checkVetoCB(*p1) && checkVetoCB(*p2)) {
+
+                if((p1->Detector & Detector_t::Type_t::TAPS)
+                        && !cl2->HasFlag(TCluster::Flags_t::TouchesHoleCentral)) {
+                    Fill_h(ggIM_Any_PID, cl1, gg);
                 }
 
-                if(checkVetoAny(*p1) && checkVetoAny(*p2)) {
-                    if((p1->Detector & Detector_t::Type_t::TAPS)
-                            && !cl2->HasFlag(TCluster::Flags_t::TouchesHoleCentral)) {
-                        Fill_h(ggIM_Any_PIDVetos, cl1, gg);
-                    }
-                    if((p2->Detector & Detector_t::Type_t::TAPS)
-                            && !cl1->HasFlag(TCluster::Flags_t::TouchesHoleCentral)) {
-                        Fill_h(ggIM_Any_PIDVetos, cl2, gg);
-                    }
+                if((p2->Detector & Detector_t::Type_t::TAPS)
+                        && !cl1->HasFlag(TCluster::Flags_t::TouchesHoleCentral)) {
+                    Fill_h(ggIM_Any_PID, cl2, gg);
                 }
+
             }
-        }
 
+            if(checkVetoAny(*p1) && checkVetoAny(*p2)) {
+
+                if((p1->Detector & Detector_t::Type_t::TAPS)
+                        && !cl2->HasFlag(TCluster::Flags_t::TouchesHoleCentral)) {
+                    Fill_h(ggIM_Any_PIDVetos, cl1, gg);
+                }
+
+                if((p2->Detector & Detector_t::Type_t::TAPS)
+                        && !cl1->HasFlag(TCluster::Flags_t::TouchesHoleCentral)) {
+                    Fill_h(ggIM_Any_PIDVetos, cl2, gg);
+                }
+
+            }
+        }
     }
 
     if(ggIM_mult != nullptr) {
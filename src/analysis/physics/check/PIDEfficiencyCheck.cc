@@ -263,6 +263,7 @@ struct PIDEfficiencyCheck_plot : Plotter {
         if(!input.GetObject("PIDEfficiencyCheck/t", tree.Tree))
             throw Exception("Cannot find tree PIDEfficiencyCheck/t");
         tree.LinkBranches();
+        tree.EnableReadAhead();
 
         mycuttree = cuttree::Make<Hist_t>(HistFac);
     }
@@ -274,7 +275,7 @@ struct PIDEfficiencyCheck_plot : Plotter {
 
     virtual void ProcessEntry(const long long entry) override
     {
-        tree.Tree->GetEntry(entry);
+        tree.GetEntry(entry);
         cuttree::Fill<Hist_t>(mycuttree, tree);
     }
 
@@ -42,15 +42,17 @@ void IMPlots::ProcessEvent(const TEvent& event, manager_t&)
     auto recon_particles = utils::ParticleTypeList::Make(event.Reconstructed().Candidates);
     const auto& photons = recon_particles.Get(ParticleTypeDatabase::Photon);
 
+    // the invariant mass does not depend on the tagger hit
+    prs.Classify(event.Reconstructed().TaggerHits,
+                 [this] (const TTaggerHit& h) { return triggersimu.GetCorrectedTaggerTime(h); },
+                 taggerhits);
+
     for(unsigned n = MinNGamma(); n<MaxNGamma(); ++n) {
         for( auto comb = utils::makeCombination(photons,n); !comb.done(); ++comb) {
             const LorentzVec sum = sumlv(comb.begin(), comb.end());
-                for(const auto& h : event.Reconstructed().TaggerHits) {
-                    prs.SetTaggerTime(triggersimu.GetCorrectedTaggerTime(h));
-                    m.at(n - MinNGamma()).Fill(sum.M());
-                }
-            }
-       }
+            m.at(n - MinNGamma()).Fill(taggerhits, sum.M());
+        }
+    }
 }
 
 void IMPlots::ShowResult()
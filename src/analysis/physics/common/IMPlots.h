@@ -16,6 +16,7 @@ class IMPlots : public Physics {
 public:
     utils::TriggerSimulation triggersimu;
     PromptRandom::Switch prs;
+    PromptRandom::Batch taggerhits;
     std::vector<PromptRandom::Hist1> m;
     unsigned MinNGamma() const noexcept { return 2;}
     unsigned MaxNGamma() const noexcept { return unsigned(m.size())+2; }
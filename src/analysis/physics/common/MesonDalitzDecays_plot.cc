@@ -374,6 +374,8 @@ struct MesonDalitzDecays_plot : Plotter {
             throw Exception("Cannot find tree "+name);
 
         tree.LinkBranches();
+        tree.EnableLazyLoading();
+        tree.EnableReadAhead();
     }
 
     virtual long long GetNumEntries() const override
@@ -383,7 +385,7 @@ struct MesonDalitzDecays_plot : Plotter {
 
     virtual void ProcessEntry(const long long entry) override
     {
-        Tree.Tree->GetEntry(entry);
+        Tree.GetEntry(entry);
         cuttree::Fill<MCHist_t>(hists, {Tree});
     }
 
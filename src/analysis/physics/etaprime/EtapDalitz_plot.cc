@@ -1332,6 +1332,8 @@ struct EtapDalitz_plot : Plotter {
             throw Exception("Can't find tree " + name);
 
         tree.LinkBranches();
+        tree.EnableLazyLoading();
+        tree.EnableReadAhead();
     }
 
     virtual long long GetNumEntries() const override
@@ -1341,7 +1343,7 @@ struct EtapDalitz_plot : Plotter {
 
     virtual void ProcessEntry(const long long entry) override
     {
-        Tree.Tree->GetEntry(entry);
+        Tree.GetEntry(entry);
         cuttree::Fill<MCHist_t>(cuttree_hists, {Tree});
     }
 
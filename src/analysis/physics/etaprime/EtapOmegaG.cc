@@ -75,6 +75,13 @@ EtapOmegaG::EtapOmegaG(const string& name, OptionsPtr opts) :
 
     t_MCWeighting.CreateBranches(HistFac.makeTTree(utils::MCWeighting::treeName+"_extra"));
 
+    // skip rewriting the weights in Finish, EtapOmegaG_plot normalises them
+    // (only for outputs which are not merged with Ant-hadd or chained)
+    if(opts->Get<bool>("MCWeightingSinglePass", false)) {
+        for(auto mcWeighting : {&mcWeightingEtaPrime, &Sig.mcWeightingEtaPrime, &Ref.mcWeightingEtaPrime})
+            mcWeighting->SetSinglePass();
+    }
+
     t.CreateBranches(Sig.treeCommon);
     t.CreateBranches(Ref.treeCommon);
     t.Tree = nullptr; // prevent accidental misuse...
@@ -684,8 +691,8 @@ void EtapOmegaG::Sig_t::Pi0_t::Process(const params_t& params)
             auto match_bycandidate = [] (const TParticlePtr& mctrue, const TParticlePtr& recon) {
                 return mctrue->Angle(*recon->Candidate); // TCandidate converts into vec3
             };
-            auto matched = utils::match1to1(true_photons, photons_best,
-                                            match_bycandidate,IntervalD(0.0, std_ext::degree_to_radian(15.0)));
+            const auto& matched = matcher.Match(true_photons, photons_best,
+                                                match_bycandidate,IntervalD(0.0, std_ext::degree_to_radian(15.0)));
             if(matched.size() == 4) {
                 // find the two photons of the pi0
                 TParticleList pi0_photons;
@@ -698,8 +705,8 @@ void EtapOmegaG::Sig_t::Pi0_t::Process(const params_t& params)
                     }
                 });
                 TParticleList g_pi0_matched{
-                    utils::FindMatched(matched, pi0_photons.front()),
-                            utils::FindMatched(matched, pi0_photons.back())
+                    utils::FindMatched(matcher, true_photons, photons_best, pi0_photons.front()),
+                            utils::FindMatched(matcher, true_photons, photons_best, pi0_photons.back())
                 };
 
                 if(std_ext::contains(g_pi0_matched, g1_Pi0_best))
@@ -790,9 +797,9 @@ void EtapOmegaG::Sig_t::OmegaPi0_t::Process(const params_t& params)
             auto match_bycandidate = [] (const TParticlePtr& mctrue, const TParticlePtr& recon) {
                 return mctrue->Angle(*recon->Candidate); // TCandidate converts into vec3
             };
-            auto matched = utils::match1to1(true_photons, photons_best,
-                                            match_bycandidate,
-                                            IntervalD(0.0, std_ext::degree_to_radian(15.0)));
+            const auto& matched = matcher.Match(true_photons, photons_best,
+                                                match_bycandidate,
+                                                IntervalD(0.0, std_ext::degree_to_radian(15.0)));
             if(matched.size() == 4) {
                 // do that tedious photon determination (rewriting the matcher somehow would be nice....)
                 auto select_daughter = [] (TParticleTree_t tree, const ParticleTypeDatabase::Type& type) {
@@ -807,8 +814,8 @@ void EtapOmegaG::Sig_t::OmegaPi0_t::Process(const params_t& params)
                 auto omega = select_daughter(etap, ParticleTypeDatabase::Omega);
                 auto g_Omega = select_daughter(omega, ParticleTypeDatabase::Photon);
 
-                auto g_EtaPrime_matched = utils::FindMatched(matched, g_EtaPrime->Get());
-                auto g_Omega_matched = utils::FindMatched(matched, g_Omega->Get());
+                auto g_EtaPrime_matched = utils::FindMatched(matcher, true_photons, photons_best, g_EtaPrime->Get());
+                auto g_Omega_matched = utils::FindMatched(matcher, true_photons, photons_best, g_Omega->Get());
                 if(g_EtaPrime_matched == g_EtaPrime_best)
                     t.MCTrueMatch += 1;
                 if(g_Omega_matched == g_Omega_best)
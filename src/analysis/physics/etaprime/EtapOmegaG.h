@@ -3,6 +3,7 @@
 #include "physics/Physics.h"
 #include "utils/ParticleTools.h"
 #include "utils/fitter/TreeFitter.h"
+#include "utils/Matcher.h"
 #include "utils/MCWeighting.h"
 #include "utils/A2GeoAcceptance.h"
 #include "plot/PromptRandomHist.h"
@@ -151,6 +152,7 @@ struct EtapOmegaG : Physics {
             static utils::TreeFitter Make(const ParticleTypeDatabase::Type& subtree, fitparams_t fitparams);
 
             utils::TreeFitter treefitter;
+            utils::Matcher1to1 matcher;
             utils::TreeFitter::tree_t fitted_Pi0;
             utils::TreeFitter::tree_t fitted_g1_Pi0;
             utils::TreeFitter::tree_t fitted_g2_Pi0;
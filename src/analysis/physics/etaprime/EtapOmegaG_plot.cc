@@ -34,7 +34,7 @@ struct CommonHist_t {
 
         double Weight() const {
             if(MCWeighting.Tree)
-                return MCWeighting.MCWeight;
+                return MCWeighting.Weight();
             return Common.TaggW;
         }
 
@@ -648,7 +648,8 @@ struct EtapOmegaG_plot : Plotter {
 
         if(input.GetObject("EtapOmegaG/"+tag+"/"+utils::MCWeighting::treeName, treeMCWeighting.Tree)) {
             LOG(INFO) << "Found " << tag << " MCWeighting tree";
-            treeMCWeighting.LinkBranches();
+            treeMCWeighting.LinkWeights();
+            treeMCWeighting.EnableReadAhead();
             check_entries(treeMCWeighting);
         }
 
@@ -661,7 +662,7 @@ struct EtapOmegaG_plot : Plotter {
 
         if(input.GetObject("EtapOmegaG/"+utils::MCWeighting::treeName, treeMCWeighting.Tree) &&
            input.GetObject("EtapOmegaG/"+utils::MCWeighting::treeName+"_extra", treeMCWeighting_extra.Tree)) {
-            treeMCWeighting.LinkBranches();
+            treeMCWeighting.LinkWeights();
             treeMCWeighting_extra.LinkBranches();
             if(treeMCWeighting.Tree->GetEntries() != treeMCWeighting.Tree->GetEntries()) {
                 LOG(ERROR) << "Mismatch in trees for MCTrue generated hist";
@@ -678,7 +679,7 @@ struct EtapOmegaG_plot : Plotter {
                 if(tag == "Ref" && treeMCWeighting_extra.MCTrue != 2)
                     continue;
                 treeMCWeighting.Tree->GetEntry(entry);
-                h->Fill(treeMCWeighting_extra.TaggCh(), treeMCWeighting.MCWeight());
+                h->Fill(treeMCWeighting_extra.TaggCh(), treeMCWeighting.Weight());
             }
         }
 
@@ -688,6 +689,8 @@ struct EtapOmegaG_plot : Plotter {
         if(!input.GetObject(name, tree.Tree))
             throw Exception("Cannot find tree "+name);
         tree.LinkBranches();
+        tree.EnableLazyLoading();
+        tree.EnableReadAhead();
     }
 
     void check_entries(const WrapTTree& tree) {
@@ -705,9 +708,9 @@ struct EtapOmegaG_plot : Plotter {
 
     virtual void ProcessEntry(const long long entry) override
     {
-        treeCommon.Tree->GetEntry(entry);
+        treeCommon.GetEntry(entry);
         if(treeMCWeighting.Tree)
-            treeMCWeighting.Tree->GetEntry(entry);
+            treeMCWeighting.GetEntry(entry);
     }
 
 };
@@ -731,7 +734,7 @@ struct EtapOmegaG_plot_Ref : EtapOmegaG_plot {
     virtual void ProcessEntry(const long long entry) override
     {
         EtapOmegaG_plot::ProcessEntry(entry);
-        treeRef.Tree->GetEntry(entry);
+        treeRef.GetEntry(entry);
         cuttree::Fill<MCRefHist_t>(cuttreeRef, {treeCommon, treeRef, treeMCWeighting});
     }
 };
@@ -766,9 +769,9 @@ struct EtapOmegaG_plot_Sig : EtapOmegaG_plot {
     virtual void ProcessEntry(const long long entry) override
     {
         EtapOmegaG_plot::ProcessEntry(entry);
-        treeSigShared.Tree->GetEntry(entry);
-        treeSigPi0.Tree->GetEntry(entry);
-        treeSigOmegaPi0.Tree->GetEntry(entry);
+        treeSigShared.GetEntry(entry);
+        treeSigPi0.GetEntry(entry);
+        treeSigOmegaPi0.GetEntry(entry);
         cuttree::Fill<MCSigPi0Hist_t>(cuttreeSigPi0, {treeCommon, treeSigShared, treeSigPi0, treeMCWeighting});
         if(cuttreeSigOmegaPi0)
             cuttree::Fill<MCSigOmegaPi0Hist_t>(cuttreeSigOmegaPi0, {treeCommon, treeSigShared, treeSigOmegaPi0, treeMCWeighting});
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <memory>
+
 namespace ant {
 namespace analysis {
 
 class PhysicsManager;
 class SlowControlManager;
 
+namespace utils {
+class CalibrationContext;
+}
+
 namespace physics {
 
 struct manager_t {
@@ -18,9 +24,12 @@ struct manager_t {
 private:
     friend class ant::analysis::PhysicsManager;
     friend class ant::analysis::SlowControlManager;
+    friend class ant::analysis::utils::CalibrationContext;
     bool saveEvent = false;
     bool keepReadHits = false;
 
+    // shared by the calibration physics classes, see utils::CalibrationContext::Get
+    std::shared_ptr<utils::CalibrationContext> calibrationContext;
 };
 
 }
@@ -115,15 +115,17 @@ void FindProton::ProcessEvent(const TEvent& event, manager_t&)
 
         if(true_proton && true_photons.size() == 3) {
 
-            const auto matched  = utils::match1to1(mcparticles,
-                                                   cands.get_ptr_list(),
-                                                   [] (const TParticlePtr& p1, const TCandidatePtr& p2) {
-                return p1->Angle(*p2);
+            const auto& matched = matcher.Match(mcparticles,
+                                                cands,
+                                                [] (const TParticlePtr& p1, const TCandidate& p2) {
+                return p1->Angle(p2);
             }, {0.0, degree_to_radian(15.0)});
 
             if(matched.size() == mcparticles.size()) {
 
-                matchedProton = utils::FindMatched(matched, true_proton);
+                const auto b = matcher.MatchedB(utils::Matcher1to1::IndexOf(mcparticles, true_proton));
+                if(b != utils::Matcher1to1::npos)
+                    matchedProton = cands.get_ptr_at(b);
             }
         }
     }
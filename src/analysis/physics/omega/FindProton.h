@@ -3,6 +3,7 @@
 #include "analysis/physics/Physics.h"
 #include "base/std_ext/math.h"
 #include "analysis/utils/fitter/TreeFitter.h"
+#include "analysis/utils/Matcher.h"
 #include "analysis/plot/PromptRandomHist.h"
 #include "utils/TriggerSimulation.h"
 
@@ -55,6 +56,7 @@ protected:
 
     branches_t tree_branches;
     utils::KinFitter fitter;
+    utils::Matcher1to1 matcher;
 
     TH1D* steps = nullptr;
 
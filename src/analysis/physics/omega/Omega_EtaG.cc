@@ -1980,7 +1980,7 @@ OmegaEtaG_Plot::OmegaEtaG_Plot(const string &name, const WrapTFileInput &input,
 OmegaEtaG_Plot::~OmegaEtaG_Plot() {}
 
 void OmegaEtaG_Plot::ProcessEntry(const long long entry) {
-    t->GetEntry(entry);
+    tree.GetEntry(entry);
 
     plot::cuttree::Fill<MCTrue_Splitter<OmegaHist_t>>(signal_hists, {tree});
 
@@ -173,19 +173,18 @@ void JustPi0::MultiPi0::ProcessData(const TEventData& data, const TParticleTree_
         auto true_proton = utils::ParticleTools::FindParticle(ParticleTypeDatabase::Proton, ptree, 1);
         auto true_photons = utils::ParticleTools::FindParticles(ParticleTypeDatabase::Photon, ptree);
 
-        auto mymatcher = [&cands] (const std::vector<TParticlePtr> true_particles) {
-            return utils::match1to1(true_particles,
-                                    cands.get_ptr_list(),
-                                    [] (const TParticlePtr& p1, const TCandidatePtr& p2) {
-                return p1->Angle(*p2);
-            }, {0.0, std_ext::degree_to_radian(15.0)});
-        };
-
         vector<TParticlePtr> true_all(true_photons);
         true_all.push_back(true_proton);
-        const auto match_all = mymatcher(true_all);
-
-        proton_mctrue_match = utils::FindMatched(match_all, true_proton);
+        matcher.Match(true_all,
+                      cands,
+                      [] (const TParticlePtr& p1, const TCandidate& p2) {
+            return p1->Angle(p2);
+        }, {0.0, std_ext::degree_to_radian(15.0)});
+
+        // proton is last in true_all
+        const auto b = matcher.MatchedB(true_all.size()-1);
+        if(b != utils::Matcher1to1::npos)
+            proton_mctrue_match = cands.get_ptr_at(b);
 
         t.reaction = 1; // signal
     } else {
@@ -4,6 +4,7 @@
 #include "analysis/plot/PromptRandomHist.h"
 #include "analysis/utils/TriggerSimulation.h"
 #include "analysis/utils/fitter/TreeFitter.h"
+#include "analysis/utils/Matcher.h"
 #include "base/ParticleTypeTree.h"
 #include "TLorentzVector.h"
 #include "TVector2.h"
@@ -106,6 +107,7 @@ public:
         PromptRandom::Hist1 IM_2g_fitted;
 
         utils::TreeFitter treefitter;
+        utils::Matcher1to1 matcher;
 
         static ParticleTypeTree getParticleTree(const unsigned nPi0);
 
@@ -873,14 +873,14 @@ TCandidate Pi0Dalitz::ParticleECorr(const TCandidatePtr cand, const bool &photon
 
 void Pi0Dalitz::DoMatchTrueRecoStuff(const TParticleList &allmcpart, const std::vector<TParticlePtr> &trueparts, const TCandidatePtrList& recocands, std::vector<TParticlePtr> &matchrecopart)
 {
-    const auto matched  = utils::match1to1(allmcpart, recocands,
-                                           [] (const TParticlePtr& p1, const TCandidatePtr& p2) {return p1->Angle(*p2);},
-                                           {0.0, std_ext::degree_to_radian(15.0)});
+    matcher.Match(allmcpart, recocands,
+                  [] (const TParticlePtr& p1, const TCandidatePtr& p2) {return p1->Angle(*p2);},
+                  {0.0, std_ext::degree_to_radian(15.0)});
 
     h_RecoTrueMatch->Fill(0);
     int nrgamma = 0; double Ekrecg=0; double Ektrueg=0;
     for(auto& truepart: trueparts){
-        TCandidatePtr match = utils::FindMatched(matched,truepart);
+        TCandidatePtr match = utils::FindMatched(matcher, allmcpart, recocands, truepart);
         if(match){
             if(truepart->Type() == ParticleTypeDatabase::Proton){
                 matchrecopart.push_back(make_shared<TParticle>(ParticleTypeDatabase::Proton,match));
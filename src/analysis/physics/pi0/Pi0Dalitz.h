@@ -15,6 +15,7 @@
 #include "analysis/utils/Uncertainties.h"
 #include "TLorentzVector.h"
 #include "analysis/utils/ClusterECorr_simple.h"
+#include "analysis/utils/Matcher.h"
 
 class TH1D;
 
@@ -72,6 +73,7 @@ protected:
     utils::UncertaintyModelPtr fit_model;
     utils::KinFitter fitter;
     utils::NoProtonFitter npfitter;
+    utils::Matcher1to1 matcher;
 
     TFFTree_t TFFTree;
 
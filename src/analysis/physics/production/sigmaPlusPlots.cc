@@ -499,8 +499,8 @@ public:
 
     virtual void ProcessEntry(const long long entry) override
     {
-        t->GetEntry(entry);
-        rec->GetEntry(entry);
+        tree.GetEntry(entry);
+        recTree.GetEntry(entry);
 
         cuttree::Fill<MCTrue_Splitter<SigmaK0Hist_t>>(signal_hists, {tree, recTree});
     }
@@ -886,8 +886,8 @@ public:
 
     virtual void ProcessEntry(const long long entry) override
     {
-        t->GetEntry(entry);
-        rec->GetEntry(entry);
+        tree.GetEntry(entry);
+        recTree.GetEntry(entry);
 
         cuttree::Fill<MCTrue_Splitter<SigmaK0Hist_t>>(signal_hists, {tree, recTree});
     }
@@ -611,8 +611,8 @@ public:
 
     virtual void ProcessEntry(const long long entry) override
     {
-        t->GetEntry(entry);
-        rec->GetEntry(entry);
+        tree.GetEntry(entry);
+        recTree.GetEntry(entry);
         cuttree::Fill<MCTrue_Splitter<SinglePi0Hist_t>>(signal_hists, {tree, recTree});
     }
 
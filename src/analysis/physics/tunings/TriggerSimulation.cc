@@ -275,6 +275,7 @@ struct TriggerSimulation_plot : Plotter {
         if(!input.GetObject("TriggerSimulation/tree", tree.Tree))
             throw Exception("Cannot find tree TriggerSimulation/tree");
         tree.LinkBranches();
+        tree.EnableReadAhead();
 
         mycuttree = cuttree::Make<DataMC_Splitter>(HistFac);
     }
@@ -286,7 +287,7 @@ struct TriggerSimulation_plot : Plotter {
 
     virtual void ProcessEntry(const long long entry) override
     {
-        tree.Tree->GetEntry(entry);
+        tree.GetEntry(entry);
         cuttree::Fill<DataMC_Splitter>(mycuttree, tree);
     }
 
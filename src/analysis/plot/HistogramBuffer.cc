@@ -0,0 +1,264 @@
+#include "HistogramBuffer.h"
+
+#include "TAxis.h"
+#include "RVersion.h"
+
+#include <algorithm>
+#include <list>
+#include <stdexcept>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis;
+
+namespace {
+
+// slots of exited threads are handed out again,
+// so that many short-lived threads do not end up in the shared buffer
+mutex slotMutex;
+unsigned nextSlot = 0;
+vector<unsigned> freeSlots;
+
+struct thread_slot_t {
+    unsigned Slot;
+    thread_slot_t() {
+        lock_guard<mutex> lock(slotMutex);
+        if(freeSlots.empty()) {
+            Slot = nextSlot < HistogramBuffer::MaxThreads ? nextSlot++ : HistogramBuffer::MaxThreads;
+        }
+        else {
+            Slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+    }
+    ~thread_slot_t() {
+        if(Slot == HistogramBuffer::MaxThreads)
+            return;
+        // the mutex also orders the last fills of this thread before the ones of the next owner
+        lock_guard<mutex> lock(slotMutex);
+        freeSlots.push_back(Slot);
+    }
+    thread_slot_t(const thread_slot_t&) = delete;
+    thread_slot_t& operator=(const thread_slot_t&) = delete;
+};
+thread_local const thread_slot_t threadSlot;
+
+bool canExtend(const TAxis& axis, const TH1& hist) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    (void)hist;
+    return axis.CanExtend();
+#else
+    (void)axis;
+    return hist.TestBit(TH1::kCanRebin);
+#endif
+}
+
+// the running sums are protected, so they are reached via member pointers of derived classes
+struct TH1_stats_t : TH1 {
+    static void Add(TH1& h, const HistogramBuffer::stats_t& s) {
+        h.*(&TH1_stats_t::fTsumw)   += s[0];
+        h.*(&TH1_stats_t::fTsumw2)  += s[1];
+        h.*(&TH1_stats_t::fTsumwx)  += s[2];
+        h.*(&TH1_stats_t::fTsumwx2) += s[3];
+    }
+};
+
+struct TH2_stats_t : TH2 {
+    static void Add(TH2& h, const HistogramBuffer::stats_t& s) {
+        h.*(&TH2_stats_t::fTsumwy)  += s[4];
+        h.*(&TH2_stats_t::fTsumwy2) += s[5];
+        h.*(&TH2_stats_t::fTsumwxy) += s[6];
+    }
+};
+
+struct TH3_stats_t : TH3 {
+    static void Add(TH3& h, const HistogramBuffer::stats_t& s) {
+        h.*(&TH3_stats_t::fTsumwy)  += s[4];
+        h.*(&TH3_stats_t::fTsumwy2) += s[5];
+        h.*(&TH3_stats_t::fTsumwxy) += s[6];
+        h.*(&TH3_stats_t::fTsumwz)  += s[7];
+        h.*(&TH3_stats_t::fTsumwz2) += s[8];
+        h.*(&TH3_stats_t::fTsumwxz) += s[9];
+        h.*(&TH3_stats_t::fTsumwyz) += s[10];
+    }
+};
+
+// registry for FlushAll
+mutex registryMutex;
+list<HistogramBuffer*> registry;
+
+}
+
+constexpr unsigned HistogramBuffer::MaxThreads;
+constexpr int HistogramBuffer::MaxDenseCells;
+
+HistogramBuffer::HistogramBuffer(TH1& hist) :
+    Hist(hist),
+    Dimension(hist.GetDimension()),
+    UseDense(hist.GetNcells() <= MaxDenseCells),
+    buffers(MaxThreads+1) // last one is shared
+{
+    lock_guard<mutex> lock(registryMutex);
+    registry.push_back(this);
+}
+
+HistogramBuffer::~HistogramBuffer()
+{
+    lock_guard<mutex> lock(registryMutex);
+    registry.remove(this);
+}
+
+HistogramBuffer::thread_buffer_t& HistogramBuffer::GetBuffer(unsigned slot)
+{
+    auto& b = buffers[slot];
+    if(!b)
+        return NewBuffer(slot);
+    return *b;
+}
+
+void HistogramBuffer::Fill(int bin, double w, bool inRange, double x, double y, double z)
+{
+    FillSum(bin, 1.0, w, w*w, w != 1.0, inRange, x, y, z);
+}
+
+bool HistogramBuffer::IsBufferable(const TH1& hist)
+{
+    const TAxis* axes[] = {hist.GetXaxis(), hist.GetYaxis(), hist.GetZaxis()};
+    for(int i=0;i<hist.GetDimension();i++) {
+        if(axes[i]->GetLabels() || canExtend(*axes[i], hist))
+            return false;
+    }
+    return true;
+}
+
+HistogramBuffer::thread_buffer_t& HistogramBuffer::NewBuffer(unsigned slot)
+{
+    // labels or extendable axes may change the binning while filling,
+    // which TH1::Fill handles but the buffers cannot follow
+    if(!IsBufferable(Hist))
+        throw logic_error(string("Histogram ")+Hist.GetName()
+                          +" has labelled or extendable axes, which cannot be filled via buffers");
+    auto& b = buffers[slot];
+    b = std::unique_ptr<thread_buffer_t>(new thread_buffer_t());
+    if(UseDense)
+        b->Dense.resize(Hist.GetNcells());
+    return *b;
+}
+
+unsigned HistogramBuffer::ThreadSlot()
+{
+    return threadSlot.Slot;
+}
+
+void HistogramBuffer::AddStats(TH1& hist, const stats_t& stats)
+{
+    TH1_stats_t::Add(hist, stats);
+    if(auto h2 = dynamic_cast<TH2*>(addressof(hist)))
+        TH2_stats_t::Add(*h2, stats);
+    else if(auto h3 = dynamic_cast<TH3*>(addressof(hist)))
+        TH3_stats_t::Add(*h3, stats);
+}
+
+void HistogramBuffer::FillSum(int bin, double n, double sumw, double sumw2, bool weighted,
+                              bool inRange, double x, double y, double z)
+{
+    const auto slot = threadSlot.Slot;
+    if(slot < MaxThreads) {
+        FillSum(GetBuffer(slot), bin, n, sumw, sumw2, weighted, inRange, x, y, z);
+        return;
+    }
+    lock_guard<mutex> lock(shared_mutex);
+    FillSum(GetBuffer(MaxThreads), bin, n, sumw, sumw2, weighted, inRange, x, y, z);
+}
+
+HistogramBuffer* HistogramBuffer::Get(TH1& hist)
+{
+    if(auto h = dynamic_cast<BufferedTH1D*>(&hist))
+        return &h->GetBuffer();
+    if(auto h = dynamic_cast<BufferedTH2D*>(&hist))
+        return &h->GetBuffer();
+    if(auto h = dynamic_cast<BufferedTH3D*>(&hist))
+        return &h->GetBuffer();
+    return nullptr;
+}
+
+void HistogramBuffer::FillSum(thread_buffer_t& b, int bin, double n, double sumw, double sumw2, bool weighted,
+                              bool inRange, double x, double y, double z)
+{
+    auto& c = UseDense ? b.Dense[bin] : b.Sparse[bin];
+    c.W  += sumw;
+    c.W2 += sumw2;
+
+    b.Entries += n;
+    if(weighted)
+        b.Weighted = true;
+
+    // statistics like TH1::Fill, ignoring under/overflow
+    if(!inRange)
+        return;
+    auto& s = b.Stats;
+    s[0] += sumw;
+    s[1] += sumw2;
+    s[2] += sumw*x;
+    s[3] += sumw*x*x;
+    if(Dimension > 1) {
+        s[4] += sumw*y;
+        s[5] += sumw*y*y;
+        s[6] += sumw*x*y;
+    }
+    if(Dimension > 2) {
+        s[7]  += sumw*z;
+        s[8]  += sumw*z*z;
+        s[9]  += sumw*x*z;
+        s[10] += sumw*y*z;
+    }
+}
+
+void HistogramBuffer::Flush()
+{
+    for(auto& b : buffers) {
+        if(!b || b->Entries == 0)
+            continue;
+
+        // TH1::Fill switches to Sumw2 as soon as weights are used
+        if(b->Weighted && Hist.GetSumw2N() == 0 && !Hist.TestBit(TH1::kIsNotW))
+            Hist.Sumw2();
+
+        const auto entries = Hist.GetEntries() + b->Entries;
+        const bool hasSumw2 = Hist.GetSumw2N() > 0;
+        auto add = [this, hasSumw2] (int bin, const bin_t& c) {
+            Hist.AddBinContent(bin, c.W);
+            if(hasSumw2)
+                Hist.GetSumw2()->fArray[bin] += c.W2;
+        };
+
+        if(UseDense) {
+            for(int bin=0;bin<int(b->Dense.size());bin++) {
+                auto& c = b->Dense[bin];
+                if(c.W == 0 && c.W2 == 0)
+                    continue;
+                add(bin, c);
+                c = bin_t();
+            }
+        }
+        else {
+            for(const auto& it_bin : b->Sparse)
+                add(it_bin.first, it_bin.second);
+            b->Sparse.clear();
+        }
+
+        AddStats(Hist, b->Stats);
+        Hist.SetEntries(entries);
+
+        b->Stats.fill(0);
+        b->Entries = 0;
+        b->Weighted = false;
+    }
+}
+
+void HistogramBuffer::FlushAll()
+{
+    lock_guard<mutex> lock(registryMutex);
+    for(auto buffer : registry)
+        buffer->Flush();
+}
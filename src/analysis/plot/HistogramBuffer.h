@@ -0,0 +1,227 @@
+#pragma once
+
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TH3D.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ant {
+namespace analysis {
+
+/**
+ * @brief The HistogramBuffer class collects fills of a histogram in per-thread bin arrays
+ *
+ * Each thread fills its own buffer without locking, dense for histograms with a
+ * moderate number of cells and a sparse hash map otherwise (large TH3).
+ * Flush() adds all buffers to the histogram, it must not run concurrently with Fill().
+ */
+class HistogramBuffer {
+public:
+    explicit HistogramBuffer(TH1& hist);
+    ~HistogramBuffer();
+    HistogramBuffer(const HistogramBuffer&) = delete;
+    HistogramBuffer& operator=(const HistogramBuffer&) = delete;
+
+    /**
+     * @brief Fill adds weight w to global bin, the coordinates are used for the statistics
+     * @param bin global bin number as returned by TH1::GetBin
+     * @param inRange if false, bin is under- or overflow and does not contribute to statistics
+     */
+    void Fill(int bin, double w, bool inRange, double x, double y = 0, double z = 0);
+
+    /**
+     * @brief FillSum adds n fills at the same coordinates at once, as n calls of Fill would do
+     * @param sumw sum of the weights
+     * @param sumw2 sum of the squared weights
+     * @param weighted true if any of the weights is not 1
+     */
+    void FillSum(int bin, double n, double sumw, double sumw2, bool weighted,
+                 bool inRange, double x, double y = 0, double z = 0);
+
+    /**
+     * @brief Get the buffer of a BufferedTH1D/2D/3D
+     * @return nullptr if hist is not filled via a buffer
+     */
+    static HistogramBuffer* Get(TH1& hist);
+
+    /**
+     * @brief Flush reduces all thread buffers into the histogram
+     */
+    void Flush();
+
+    /**
+     * @brief FlushAll flushes all existing buffers
+     */
+    static void FlushAll();
+
+    /**
+     * @brief IsBufferable checks if hist has no labelled or extendable axes
+     * @note the first Fill of a thread throws std::logic_error if this is false
+     */
+    static bool IsBufferable(const TH1& hist);
+
+    /**
+     * @brief ThreadSlot gives the buffer index of the calling thread, free again when the thread exits
+     * @return MaxThreads if the thread uses the shared, locked buffer
+     */
+    static unsigned ThreadSlot();
+
+    // same layout as TH1::GetStats, up to 3 dimensions
+    using stats_t = std::array<double, 11>;
+
+    /**
+     * @brief AddStats adds to the running sums of hist, as TH1::Fill does
+     * @note unlike GetStats/PutStats, sums recomputed from the bin centres never get written back
+     */
+    static void AddStats(TH1& hist, const stats_t& stats);
+
+    // maximum number of concurrent threads with lock-free buffers, further threads share a locked one
+    static constexpr unsigned MaxThreads = 64;
+    // histograms with more cells use a sparse buffer
+    static constexpr int MaxDenseCells = 1 << 16;
+
+private:
+    struct bin_t {
+        double W  = 0;
+        double W2 = 0;
+    };
+
+    struct thread_buffer_t {
+        std::vector<bin_t> Dense;
+        std::unordered_map<int, bin_t> Sparse;
+        stats_t Stats{};
+        double Entries = 0;
+        bool Weighted = false;
+    };
+
+    TH1& Hist;
+    const int Dimension;
+    const bool UseDense;
+
+    std::vector<std::unique_ptr<thread_buffer_t>> buffers;
+    std::mutex shared_mutex;
+
+    thread_buffer_t& GetBuffer(unsigned slot);
+    thread_buffer_t& NewBuffer(unsigned slot);
+    void FillSum(thread_buffer_t& b, int bin, double n, double sumw, double sumw2, bool weighted,
+                 bool inRange, double x, double y, double z);
+};
+
+/**
+ * @brief The BufferedTH1D class is a TH1D filled via a HistogramBuffer
+ *
+ * As it has no own ClassDef, ROOT streams it as an ordinary TH1D.
+ * Call Flush() before reading the content, Write() does that automatically.
+ */
+class BufferedTH1D : public TH1D {
+public:
+    using TH1D::TH1D;
+    using TH1D::Fill;
+
+    virtual Int_t Fill(Double_t x) override {
+        return Fill(x, 1.0);
+    }
+    virtual Int_t Fill(Double_t x, Double_t w) override {
+        const auto binx = fXaxis.FindFixBin(x);
+        Buffer.Fill(binx, w, binx > 0 && binx <= fXaxis.GetNbins(), x);
+        return binx;
+    }
+
+    void Flush() const { Buffer.Flush(); }
+    HistogramBuffer& GetBuffer() const { return Buffer; }
+
+    virtual Int_t Write(const char* name = 0, Int_t option = 0, Int_t bufsize = 0) override {
+        Flush();
+        return TH1D::Write(name, option, bufsize);
+    }
+    virtual Int_t Write(const char* name = 0, Int_t option = 0, Int_t bufsize = 0) const override {
+        Flush();
+        return TH1D::Write(name, option, bufsize);
+    }
+
+private:
+    mutable HistogramBuffer Buffer{*this};
+};
+
+/**
+ * @brief The BufferedTH2D class is a TH2D filled via a HistogramBuffer, see BufferedTH1D
+ */
+class BufferedTH2D : public TH2D {
+public:
+    using TH2D::TH2D;
+    using TH2D::Fill;
+
+    virtual Int_t Fill(Double_t x, Double_t y) override {
+        return Fill(x, y, 1.0);
+    }
+    virtual Int_t Fill(Double_t x, Double_t y, Double_t w) override {
+        const auto binx = fXaxis.FindFixBin(x);
+        const auto biny = fYaxis.FindFixBin(y);
+        const bool inRange = binx > 0 && binx <= fXaxis.GetNbins() &&
+                             biny > 0 && biny <= fYaxis.GetNbins();
+        const auto bin = GetBin(binx, biny);
+        Buffer.Fill(bin, w, inRange, x, y);
+        return bin;
+    }
+
+    void Flush() const { Buffer.Flush(); }
+    HistogramBuffer& GetBuffer() const { return Buffer; }
+
+    virtual Int_t Write(const char* name = 0, Int_t option = 0, Int_t bufsize = 0) override {
+        Flush();
+        return TH2D::Write(name, option, bufsize);
+    }
+    virtual Int_t Write(const char* name = 0, Int_t option = 0, Int_t bufsize = 0) const override {
+        Flush();
+        return TH2D::Write(name, option, bufsize);
+    }
+
+private:
+    mutable HistogramBuffer Buffer{*this};
+};
+
+/**
+ * @brief The BufferedTH3D class is a TH3D filled via a HistogramBuffer, see BufferedTH1D
+ */
+class BufferedTH3D : public TH3D {
+public:
+    using TH3D::TH3D;
+    using TH3D::Fill;
+
+    virtual Int_t Fill(Double_t x, Double_t y, Double_t z) override {
+        return Fill(x, y, z, 1.0);
+    }
+    virtual Int_t Fill(Double_t x, Double_t y, Double_t z, Double_t w) override {
+        const auto binx = fXaxis.FindFixBin(x);
+        const auto biny = fYaxis.FindFixBin(y);
+        const auto binz = fZaxis.FindFixBin(z);
+        const bool inRange = binx > 0 && binx <= fXaxis.GetNbins() &&
+                             biny > 0 && biny <= fYaxis.GetNbins() &&
+                             binz > 0 && binz <= fZaxis.GetNbins();
+        const auto bin = GetBin(binx, biny, binz);
+        Buffer.Fill(bin, w, inRange, x, y, z);
+        return bin;
+    }
+
+    void Flush() const { Buffer.Flush(); }
+    HistogramBuffer& GetBuffer() const { return Buffer; }
+
+    virtual Int_t Write(const char* name = 0, Int_t option = 0, Int_t bufsize = 0) override {
+        Flush();
+        return TH3D::Write(name, option, bufsize);
+    }
+    virtual Int_t Write(const char* name = 0, Int_t option = 0, Int_t bufsize = 0) const override {
+        Flush();
+        return TH3D::Write(name, option, bufsize);
+    }
+
+private:
+    mutable HistogramBuffer Buffer{*this};
+};
+
+}} // namespace ant::analysis
@@ -1,4 +1,5 @@
 #include "HistogramFactory.h"
+#include "HistogramBuffer.h"
 
 #include "base/std_ext/string.h"
 
@@ -100,6 +101,7 @@ HistogramFactory::HistogramFactory(const string& directory_name, const Histogram
                                                     std_ext::formatter() << parent.title_prefix << ": " << title_prefix_))
 
 {
+    buffered_filling = parent.buffered_filling;
 }
 
 void HistogramFactory::SetTitlePrefix(const string& title_prefix_)
@@ -107,6 +109,24 @@ void HistogramFactory::SetTitlePrefix(const string& title_prefix_)
     title_prefix = title_prefix_;
 }
 
+void HistogramFactory::SetBufferedFilling(bool enable)
+{
+    buffered_filling = enable;
+}
+
+void HistogramFactory::FlushBuffers()
+{
+    HistogramBuffer::FlushAll();
+}
+
+template<class Hist, class BufferedHist, typename... Args>
+Hist* HistogramFactory::makeHist(Args&&... args) const
+{
+    if(buffered_filling)
+        return make<BufferedHist>(std::forward<Args>(args)...);
+    return make<Hist>(std::forward<Args>(args)...);
+}
+
 void HistogramFactory::SetDirDescription(const string &desc)
 {
     my_directory->SetTitle(desc.c_str());
@@ -140,8 +160,8 @@ TH1D* HistogramFactory::makeTH1D(
 {
     auto& xbins = x_axis_settings;
 
-    auto r = make<TH1D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
-                        xbins.Bins(), xbins.Start(), xbins.Stop());
+    auto r = makeHist<TH1D, BufferedTH1D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
+                                          xbins.Bins(), xbins.Start(), xbins.Stop());
 
     r->SetXTitle(x_axis_settings.Label().c_str());
     r->SetYTitle(ylabel.c_str());
@@ -179,8 +199,8 @@ TH1D* HistogramFactory::makeTH1D(
 {
     auto& xbins = x_axis_settings;
 
-    auto r = make<TH1D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
-                        xbins.Bins(), &xbins.Edges()[0]);
+    auto r = makeHist<TH1D, BufferedTH1D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
+                                          xbins.Bins(), &xbins.Edges()[0]);
 
     r->SetXTitle(x_axis_settings.Label().c_str());
     r->SetYTitle(ylabel.c_str());
@@ -219,9 +239,9 @@ TH2D* HistogramFactory::makeTH2D(
     auto& xbins = x_axis_settings;
     auto& ybins = y_axis_settings;
 
-    auto h = make<TH2D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
-                        xbins.Bins(), xbins.Start(), xbins.Stop(),
-                        ybins.Bins(), ybins.Start(), ybins.Stop());
+    auto h = makeHist<TH2D, BufferedTH2D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
+                                          xbins.Bins(), xbins.Start(), xbins.Stop(),
+                                          ybins.Bins(), ybins.Start(), ybins.Stop());
 
     h->SetXTitle(x_axis_settings.Label().c_str());
     h->SetYTitle(y_axis_settings.Label().c_str());
@@ -252,9 +272,9 @@ TH2D* HistogramFactory::makeTH2D(
     auto& xbins = x_axis_settings;
     auto& ybins = y_axis_settings;
 
-    auto h = make<TH2D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
-                        xbins.Bins(), &xbins.Edges()[0],
-                        ybins.Bins(), &ybins.Edges()[0]);
+    auto h = makeHist<TH2D, BufferedTH2D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
+                                          xbins.Bins(), &xbins.Edges()[0],
+                                          ybins.Bins(), &ybins.Edges()[0]);
 
     h->SetXTitle(x_axis_settings.Label().c_str());
     h->SetYTitle(y_axis_settings.Label().c_str());
@@ -285,9 +305,9 @@ TH2D* HistogramFactory::makeTH2D(
     auto& xbins = x_axis_settings;
     auto& ybins = y_axis_settings;
 
-    auto h = make<TH2D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
-                        xbins.Bins(), &xbins.Edges()[0],
-                        ybins.Bins(), ybins.Start(), ybins.Stop());
+    auto h = makeHist<TH2D, BufferedTH2D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
+                                          xbins.Bins(), &xbins.Edges()[0],
+                                          ybins.Bins(), ybins.Start(), ybins.Stop());
 
     h->SetXTitle(x_axis_settings.Label().c_str());
     h->SetYTitle(y_axis_settings.Label().c_str());
@@ -318,9 +338,9 @@ TH2D* HistogramFactory::makeTH2D(
     auto& xbins = x_axis_settings;
     auto& ybins = y_axis_settings;
 
-    auto h = make<TH2D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
-                        xbins.Bins(), xbins.Start(), xbins.Stop(),
-                        ybins.Bins(), &ybins.Edges()[0]);
+    auto h = makeHist<TH2D, BufferedTH2D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
+                                          xbins.Bins(), xbins.Start(), xbins.Stop(),
+                                          ybins.Bins(), &ybins.Edges()[0]);
 
     h->SetXTitle(x_axis_settings.Label().c_str());
     h->SetYTitle(y_axis_settings.Label().c_str());
@@ -353,10 +373,10 @@ TH3D* HistogramFactory::makeTH3D(
     auto& ybins = y_axis_settings;
     auto& zbins = z_axis_settings;
 
-    auto h = make<TH3D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
-                        xbins.Bins(), xbins.Start(), xbins.Stop(),
-                        ybins.Bins(), ybins.Start(), ybins.Stop(),
-                        zbins.Bins(), zbins.Start(), zbins.Stop());
+    auto h = makeHist<TH3D, BufferedTH3D>(GetNextName(name).c_str(), MakeTitle(title).c_str(),
+                                          xbins.Bins(), xbins.Start(), xbins.Stop(),
+                                          ybins.Bins(), ybins.Start(), ybins.Stop(),
+                                          zbins.Bins(), zbins.Start(), zbins.Stop());
 
     h->SetXTitle(x_axis_settings.Label().c_str());
     h->SetYTitle(y_axis_settings.Label().c_str());
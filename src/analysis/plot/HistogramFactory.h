@@ -38,6 +38,11 @@ private:
     mutable unsigned n_unnamed = 0;
     std::string GetNextName(const std::string& name, const std::string& autogenerate_prefix = "hist") const;
 
+    bool buffered_filling = false;
+
+    template<class Hist, class BufferedHist, typename... Args>
+    Hist* makeHist(Args&&... args) const;
+
 
 public:
     struct DirStackPush {
@@ -57,6 +62,22 @@ public:
     void SetDirDescription(const std::string& desc);
     std::string MakeTitle(const std::string& title) const;
 
+    /**
+     * @brief SetBufferedFilling makes makeTH1D/makeTH2D/makeTH3D return histograms filled via per-thread buffers
+     * @param enable if true, Fill() of new histograms can be called concurrently from different threads
+     *
+     * Child factories inherit this setting. The buffers are added to the histograms
+     * by FlushBuffers() or when the histogram is written. Labelled or extendable axes
+     * are not supported, filling such a buffered histogram throws std::logic_error.
+     */
+    void SetBufferedFilling(bool enable = true);
+
+    /**
+     * @brief FlushBuffers adds the buffered fills to all histograms created with buffered filling
+     * @note must not be called while other threads fill histograms
+     */
+    static void FlushBuffers();
+
     //__attribute__((deprecated)) // enable this when AxisSettings interface accepted
     TH1D* makeTH1D(const std::string& title,
             const std::string& xlabel,
@@ -1,5 +1,7 @@
 #include "PromptRandomHist.h"
 
+#include "HistogramBuffer.h"
+
 #include "expconfig/ExpConfig.h"
 
 using namespace ant;
@@ -7,6 +9,66 @@ using namespace ant::analysis;
 using namespace ant::analysis::PromptRandom;
 using namespace std;
 
+namespace {
+
+// what TH1::Fill does for n fills into the same bin, with the summed weights
+struct bin_fill_t {
+    double n;        // number of fills
+    double sumw;
+    double sumw2;
+    bool   weighted; // any weight != 1
+};
+
+void fill_bin(TH1* h, const int bin, const bool inRange, const bin_fill_t& f,
+              const double x, const double y = 0.0, const bool is2D = false)
+{
+    if(f.n == 0)
+        return;
+
+    if(auto buffer = HistogramBuffer::Get(*h)) {
+        buffer->FillSum(bin, f.n, f.sumw, f.sumw2, f.weighted, inRange, x, y);
+        return;
+    }
+
+    if(f.weighted && h->GetSumw2N() == 0 && !h->TestBit(TH1::kIsNotW))
+        h->Sumw2();
+
+    h->AddBinContent(bin, f.sumw);
+    if(h->GetSumw2N() > 0)
+        h->GetSumw2()->fArray[bin] += f.sumw2;
+
+    // as in TH1::Fill, under- and overflows only count as entries
+    if(inRange) {
+        HistogramBuffer::stats_t stats{};
+        stats[0] = f.sumw;
+        stats[1] = f.sumw2;
+        stats[2] = f.sumw*x;
+        stats[3] = f.sumw*x*x;
+        if(is2D) {
+            stats[4] = f.sumw*y;
+            stats[5] = f.sumw*y*y;
+            stats[6] = f.sumw*x*y;
+        }
+        HistogramBuffer::AddStats(*h, stats);
+    }
+    h->SetEntries(h->GetEntries() + f.n);
+}
+
+bin_fill_t prompt_fill(const Batch& batch) {
+    return {double(batch.NPrompt()), double(batch.NPrompt()), double(batch.NPrompt()), false};
+}
+
+bin_fill_t random_fill(const Batch& batch) {
+    return {double(batch.NRandom()), double(batch.NRandom()), double(batch.NRandom()), false};
+}
+
+bin_fill_t subtracted_fill(const Batch& batch) {
+    // random and outside hits have weights != 1
+    return {double(batch.size()), batch.SumWeights(), batch.SumWeights2(), batch.NPrompt() != batch.size()};
+}
+
+}
+
 void Hist1::MakeHistograms(const HistogramFactory& factory, const string& name, const string& title, const BinSettings& bins, const string& xtitle, const string& ytitle) {
 
     HistogramFactory myFactory(name, factory, title);
@@ -18,6 +80,20 @@ void Hist1::MakeHistograms(const HistogramFactory& factory, const string& name,
     subtracted->Sumw2();
 }
 
+void Hist1::Fill(const Batch& batch, const double x)
+{
+    if(batch.empty())
+        return;
+
+    // all three histograms have the same binning
+    const auto bin = prompt->GetXaxis()->FindFixBin(x);
+    const bool inRange = bin > 0 && bin <= prompt->GetNbinsX();
+
+    fill_bin(prompt,     bin, inRange, prompt_fill(batch),     x);
+    fill_bin(random,     bin, inRange, random_fill(batch),     x);
+    fill_bin(subtracted, bin, inRange, subtracted_fill(batch), x);
+}
+
 void Hist2::MakeHistograms(const HistogramFactory& factory, const string& name, const string& title, const BinSettings& xbins, const BinSettings& ybins, const string& xtitle, const string& ytitle) {
 
     HistogramFactory myFactory(name, factory, title);
@@ -29,6 +105,23 @@ void Hist2::MakeHistograms(const HistogramFactory& factory, const string& name,
     subtracted->Sumw2();
 }
 
+void Hist2::Fill(const Batch& batch, const double x, const double y)
+{
+    if(batch.empty())
+        return;
+
+    // all three histograms have the same binning
+    const auto binx = prompt->GetXaxis()->FindFixBin(x);
+    const auto biny = prompt->GetYaxis()->FindFixBin(y);
+    const auto bin = prompt->GetBin(binx, biny);
+    const bool inRange = binx > 0 && binx <= prompt->GetNbinsX()
+                         && biny > 0 && biny <= prompt->GetNbinsY();
+
+    fill_bin(prompt,     bin, inRange, prompt_fill(batch),     x, y, true);
+    fill_bin(random,     bin, inRange, random_fill(batch),     x, y, true);
+    fill_bin(subtracted, bin, inRange, subtracted_fill(batch), x, y, true);
+}
+
 void Switch::update_ratio() {
     double p = promptw.Area();
     double r = randomw.Area();
@@ -58,15 +151,71 @@ void Switch::AddRandomRange(const Switch::interval_t& i) {
 
 void Switch::SetTaggerTime(const double tagtime) {
 
+    const auto c = Classify(tagtime);
+    rpcase = c.State;
+    fillw = c.Weight;
+
+}
+
+Classification Switch::Classify(const double tagtime) const {
+
+    Classification c;
     if(randomw.Contains(tagtime)) {
-        rpcase = Case::Random;
-        fillw = -Ratio();
+        c.State = Case::Random;
+        c.Weight = -Ratio();
     } else if(promptw.Contains(tagtime)) {
-        rpcase = Case::Prompt;
-        fillw = 1.0;
-    } else {
-        rpcase = Case::Outside;
-        fillw = 0.0;
+        c.State = Case::Prompt;
+        c.Weight = 1.0;
     }
+    return c;
+}
+
+void Switch::Classify(const std::vector<double>& tagtimes, Batch& batch) const {
+    batch.times = tagtimes;
+    classify(batch);
+}
 
+void Switch::classify(Batch& batch) const {
+
+    const auto n = batch.times.size();
+    const double* t = batch.times.data();
+
+    batch.inRandom.assign(n, 0);
+    batch.inPrompt.assign(n, 0);
+
+    auto mark = [n, t] (const windows_t& windows, unsigned char* in) {
+        for(const auto& w : windows) {
+            const auto start = w.Start();
+            const auto stop  = w.Stop();
+            for(size_t i=0;i<n;i++)
+                in[i] |= (start <= t[i]) & (t[i] <= stop);
+        }
+    };
+    mark(randomw, batch.inRandom.data());
+    mark(promptw, batch.inPrompt.data());
+
+    // random windows take precedence, as in SetTaggerTime
+    const auto randomWeight = -Ratio();
+    batch.items.resize(n);
+    batch.nPrompt = 0;
+    batch.nRandom = 0;
+    batch.sumW = 0.0;
+    batch.sumW2 = 0.0;
+    for(size_t i=0;i<n;i++) {
+        auto& item = batch.items[i];
+        if(batch.inRandom[i]) {
+            item.State = Case::Random;
+            item.Weight = randomWeight;
+            batch.nRandom++;
+        } else if(batch.inPrompt[i]) {
+            item.State = Case::Prompt;
+            item.Weight = 1.0;
+            batch.nPrompt++;
+        } else {
+            item.State = Case::Outside;
+            item.Weight = 0.0;
+        }
+        batch.sumW  += item.Weight;
+        batch.sumW2 += item.Weight*item.Weight;
+    }
 }
@@ -9,6 +9,7 @@
 #include "TH2D.h"
 
 #include <string>
+#include <vector>
 
 namespace ant {
 
@@ -25,6 +26,49 @@ enum class Case {
     Outside
 };
 
+/**
+ * @brief Classification of one tagger hit, what Switch::SetTaggerTime sets as State and FillWeight
+ */
+struct Classification {
+    Case   State  = Case::Outside;
+    double Weight = 0.0;
+};
+
+/**
+ * @brief Batch holds the classification of all tagger hits of one event
+ *
+ * Filled by Switch::Classify, and reused from event to event to avoid allocations.
+ * The sums are what Hist1/Hist2::Fill need to fill all hits at once.
+ */
+class Batch {
+    friend class Switch;
+protected:
+    std::vector<double>         times;
+    std::vector<unsigned char>  inRandom;
+    std::vector<unsigned char>  inPrompt;
+    std::vector<Classification> items;
+
+    unsigned nPrompt = 0;
+    unsigned nRandom = 0;
+    double   sumW    = 0.0;
+    double   sumW2   = 0.0;
+
+public:
+    using const_iterator = std::vector<Classification>::const_iterator;
+
+    const Classification& operator[](size_t i) const { return items[i]; }
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+
+    unsigned NPrompt() const { return nPrompt; }
+    unsigned NRandom() const { return nRandom; }
+    /// @brief sum of the fill weights, the subtracted contribution of all hits
+    double SumWeights() const { return sumW; }
+    double SumWeights2() const { return sumW2; }
+};
+
 
 class Switch {
 public:
@@ -41,6 +85,8 @@ protected:
     Case rpcase = Case::Prompt;
     double fillw = 1.0;
 
+    void classify(Batch& batch) const;
+
 public:
     Switch()  = default;
     Switch(const expconfig::Setup_traits& setup);
@@ -70,6 +116,32 @@ public:
 
     void SetTaggerTime(double tagtime);
 
+    /// @brief Classify a tagger time without changing State and FillWeight
+    Classification Classify(double tagtime) const;
+
+    /**
+     * @brief Classify all tagger times of an event at once
+     * @param tagtimes tagger times, for example corrected by TriggerSimulation
+     * @param batch overwritten with the classification of each time, in the same order
+     *
+     * Each window is tested against all times in one branch-free loop, which the compiler
+     * can vectorise, instead of searching the windows for every hit.
+     */
+    void Classify(const std::vector<double>& tagtimes, Batch& batch) const;
+
+    /**
+     * @brief Classify all tagger hits at once, see Classify(tagtimes, batch)
+     * @param hits range of tagger hits
+     * @param get_time returns the tagger time of a hit
+     */
+    template<typename Hits, typename GetTime>
+    void Classify(const Hits& hits, GetTime&& get_time, Batch& batch) const {
+        batch.times.clear();
+        for(const auto& hit : hits)
+            batch.times.push_back(get_time(hit));
+        classify(batch);
+    }
+
 
 };
 
@@ -102,6 +174,14 @@ struct Hist1 {
         }
 
     }
+
+    /**
+     * @brief Fill x for all tagger hits of the batch at once
+     *
+     * Same result as SetTaggerTime and Fill(x) for each hit, but the bin is looked up
+     * only once, and each histogram is updated once per call.
+     */
+    void Fill(const Batch& batch, const double x);
 };
 
 struct Hist2 {
@@ -133,6 +213,9 @@ struct Hist2 {
         }
 
     }
+
+    /// @brief Fill (x,y) for all tagger hits of the batch at once, see Hist1::Fill(batch, x)
+    void Fill(const Batch& batch, const double x, const double y);
 };
 
 }
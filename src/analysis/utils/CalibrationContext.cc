@@ -0,0 +1,94 @@
+#include "CalibrationContext.h"
+
+#include "analysis/physics/manager_t.h"
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+#include "tree/TParticle.h"
+#include "base/std_ext/container.h"
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis::utils;
+
+CalibrationContext::CalibrationContext(const TEvent& event_) :
+    event(event_)
+{}
+
+CalibrationContext& CalibrationContext::Get(const TEvent& event, physics::manager_t& manager)
+{
+    auto& context = manager.calibrationContext;
+    // the manager is usually per event, but be safe if it's reused
+    if(!context || addressof(context->event) != addressof(event))
+        context = make_shared<CalibrationContext>(event);
+    return *context;
+}
+
+const vector<CalibrationContext::photon_t>& CalibrationContext::Photons()
+{
+    if(hasPhotons)
+        return photons;
+    hasPhotons = true;
+
+    const auto& cands = event.Reconstructed().Candidates;
+    photons.reserve(cands.size());
+    for(const auto& cand : cands.get_iter()) {
+        photons.emplace_back(photon_t{cand, cand->FindCaloCluster(),
+                                      TParticle(ParticleTypeDatabase::Photon, cand)});
+    }
+    return photons;
+}
+
+const vector<CalibrationContext::photon_pair_t>& CalibrationContext::PhotonPairs()
+{
+    if(hasPairs)
+        return pairs;
+    hasPairs = true;
+
+    const auto& p = Photons();
+    const auto n = p.size();
+    pairs.reserve(n > 1 ? n*(n-1)/2 : 0);
+    for(size_t i=0;i<n;i++) {
+        const vec3 dir_i(*p[i].Candidate);
+        for(size_t j=i+1;j<n;j++) {
+            const vec3 dir_j(*p[j].Candidate);
+            pairs.emplace_back(photon_pair_t{i, j,
+                                             (p[i].Photon + p[j].Photon).M(),
+                                             dir_i.Angle(dir_j)});
+        }
+    }
+    return pairs;
+}
+
+const CalibrationContext::readhits_t& CalibrationContext::ReadHits(Detector_t::Type_t type)
+{
+    auto it = readhits.find(type);
+    if(it != readhits.end())
+        return it->second;
+
+    auto& hits = readhits[type];
+    for(const TDetectorReadHit& readhit : event.Reconstructed().DetectorReadHits) {
+        if(readhit.DetectorType != type)
+            continue;
+        if(readhit.ChannelType == Channel_t::Type_t::Integral) {
+            std_ext::concatenate(hits[readhit.Channel].Integrals, readhit.Values);
+        }
+        else if(readhit.ChannelType == Channel_t::Type_t::Timing) {
+            std_ext::concatenate(hits[readhit.Channel].Timings, readhit.Values);
+        }
+    }
+    return hits;
+}
+
+const TClusterPtrList& CalibrationContext::Clusters(Detector_t::Type_t type)
+{
+    auto it = clusters.find(type);
+    if(it != clusters.end())
+        return it->second;
+
+    auto& list = clusters[type];
+    for(const auto& cl : event.Reconstructed().Clusters.get_iter()) {
+        if(cl->DetectorType == type)
+            list.emplace_back(cl);
+    }
+    return list;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "tree/TCandidate.h"
+#include "tree/TCluster.h"
+#include "tree/TDetectorReadHit.h"
+#include "base/vec/LorentzVec.h"
+
+#include <map>
+#include <vector>
+
+namespace ant {
+
+struct TEvent;
+
+namespace analysis {
+
+namespace physics {
+struct manager_t;
+}
+
+namespace utils {
+
+/**
+ * @brief The CalibrationContext class holds per-event data shared by the calibration physics classes
+ *
+ * Obtain it via Get(event, manager): the first calibration class processing an event
+ * creates it, all following ones reuse it. Each part is only built when first asked for,
+ * so running several calibrations at once costs about as much as the most expensive one.
+ */
+class CalibrationContext {
+public:
+
+    /// candidate interpreted as photon
+    struct photon_t {
+        TCandidatePtr Candidate;
+        TClusterPtr   CaloCluster; // might be nullptr
+        LorentzVec    Photon;
+    };
+
+    /// pair of photons with indices into Photons()
+    struct photon_pair_t {
+        std::size_t I;
+        std::size_t J;
+        double IM;           // invariant mass of both photons
+        double OpeningAngle; // between the candidate directions
+    };
+
+    /// read hit values of one channel, grouped by channel type
+    struct channel_hits_t {
+        std::vector<TDetectorReadHit::Value_t> Integrals;
+        std::vector<TDetectorReadHit::Value_t> Timings;
+    };
+    using readhits_t = std::map<unsigned, channel_hits_t>;
+
+    explicit CalibrationContext(const TEvent& event_);
+    CalibrationContext(const CalibrationContext&) = delete;
+    CalibrationContext& operator=(const CalibrationContext&) = delete;
+
+    /**
+     * @brief Get the context for the event currently processed
+     * @param event the event under investigation
+     * @param manager the per-event manager, which keeps the context
+     * @return context shared by all physics classes processing this event
+     */
+    static CalibrationContext& Get(const TEvent& event, physics::manager_t& manager);
+
+    /// @brief all reconstructed candidates as photons
+    const std::vector<photon_t>& Photons();
+
+    /// @brief all pairs i<j of Photons()
+    const std::vector<photon_pair_t>& PhotonPairs();
+
+    /// @brief read hits of the given detector by channel, Integral and Timing only
+    const readhits_t& ReadHits(Detector_t::Type_t type);
+
+    /// @brief reconstructed clusters of the given detector
+    const TClusterPtrList& Clusters(Detector_t::Type_t type);
+
+protected:
+    const TEvent& event;
+
+    bool hasPhotons = false;
+    std::vector<photon_t> photons;
+
+    bool hasPairs = false;
+    std::vector<photon_pair_t> pairs;
+
+    std::map<Detector_t::Type_t, readhits_t> readhits;
+    std::map<Detector_t::Type_t, TClusterPtrList> clusters;
+};
+
+}}} // namespace ant::analysis::utils
@@ -0,0 +1,179 @@
+#include "CoherentBremsstrahlung.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+using namespace ant::analysis::utils;
+
+constexpr std::array<int, 5> CoherentBremsstrahlung::Vectors;
+
+namespace {
+// put in formula for k later (my own stonehenge paper)
+constexpr double k = 26.5601;
+// beyond this, erf is exactly +-1 in double precision
+constexpr double erf_saturation = 6.0;
+}
+
+CoherentBremsstrahlung::CoherentBremsstrahlung(const vector<double>& photonEnergies, unsigned thetaSteps_) :
+    energies(photonEnergies),
+    thetaSteps(thetaSteps_),
+    cd(energies.size()),
+    cohTotal(energies.size()),
+    phiTotal(energies.size()),
+    polSum(energies.size()),
+    intensitySum(energies.size())
+{
+    if(energies.empty())
+        throw invalid_argument("No photon energies given");
+    if(thetaSteps == 0)
+        throw invalid_argument("Need at least one theta step");
+}
+
+vector<double> CoherentBremsstrahlung::ParametersFromHuman(double beamMeV, double edgeMeV, double spreadMeV,
+                                                           double colliDist_m, double colliRad_mm, unsigned nVec)
+{
+    if(nVec > Vectors.size())
+        throw invalid_argument("Too many vectors requested");
+
+    // variables used in CLAS note
+    const double g = 2;
+    const double E0 = beamMeV;
+    const double Eg = edgeMeV;
+
+    vector<double> par(IVec+nVec);
+    par[Theta]  = k/(g*E0*E0*((1/Eg)-(1/E0)));                                // theta from edge and beam energy
+    par[Sigma]  = (par[Theta]-(k/(g*E0*E0*((1/(Eg-spreadMeV))-(1/E0)))))/3.0; // spread in theta from spread in edge
+    par[ThetaR] = E0*0.001*5.0*colliRad_mm/colliDist_m;                       // cut from collimator
+    par[SigmaR] = par[ThetaR]*par[Sigma]/par[Theta];                          // smear in above same fractional sigma as above
+    par[E0MeV]  = E0;
+    par[NVec]   = nVec;
+
+    // intensities tailing off as 1/vector
+    for(unsigned v=0;v<nVec;v++)
+        par[IVec+v] = 2.0/Vectors[v];
+
+    return par;
+}
+
+void CoherentBremsstrahlung::update_bins(double E0) const
+{
+    if(bins.E0 == E0 && !bins.X.empty())
+        return;
+
+    const auto n = energies.size();
+    bins.E0 = E0;
+    bins.X.resize(n);
+    bins.Amo.resize(n);
+    bins.A.resize(n);
+    bins.OneMinusX_X.resize(n);
+    bins.X_OneMinusX.resize(n);
+    bins.X2_OneMinusX.resize(n);
+
+    for(size_t i=0;i<n;i++) {
+        const double x = energies[i]/E0;
+        bins.X[i] = x;
+        bins.Amo[i] = 1/x; // assume amo = inc = 1/x over region of interest
+        bins.A[i] = 1+(1-x)*(1-x);
+        bins.OneMinusX_X[i] = (1-x)/x;
+        bins.X_OneMinusX[i] = x/(1-x);
+        bins.X2_OneMinusX[i] = x*x/(1-x);
+    }
+}
+
+void CoherentBremsstrahlung::Calculate(const double* par,
+                                       vector<double>& enhancement,
+                                       vector<double>& polarisation) const
+{
+    const auto n = energies.size();
+    const unsigned nVec = unsigned(par[NVec]);
+    if(nVec > Vectors.size())
+        throw invalid_argument("Too many vectors in parameters");
+    if(!(par[Sigma] > 0) || !(par[SigmaR] > 0))
+        throw invalid_argument("Smearing parameters must be positive");
+
+    update_bins(par[E0MeV]);
+
+    enhancement.assign(n, 0.0);
+    polarisation.resize(n);
+    fill(polSum.begin(), polSum.end(), 0.0);
+    fill(intensitySum.begin(), intensitySum.end(), 0.0);
+
+    // raw pointers help the compiler to vectorise the loops over bins
+    const double* X = bins.X.data();
+    const double* Amo = bins.Amo.data();
+    const double* A = bins.A.data();
+    const double* OneMinusX_X = bins.OneMinusX_X.data();
+    const double* X_OneMinusX = bins.X_OneMinusX.data();
+    const double* X2_OneMinusX = bins.X2_OneMinusX.data();
+    double* CD = cd.data();
+    double* Coh = cohTotal.data();
+    double* Phi = phiTotal.data();
+    double* Enh = enhancement.data();
+
+    const double E0 = par[E0MeV];
+    const double invSigmaR = 1.0/(std::sqrt(2.0)*par[SigmaR]);
+    const double thetaR2 = par[ThetaR]*par[ThetaR];
+
+    // convolute with gaussian distribution of theta,
+    // the polarisation only uses the first thetaSteps+1 points
+    double weightSum = 0;
+    unsigned jbin = 0;
+    for(double j=par[Theta]-3.0*par[Sigma]; j<=par[Theta]+3.001*par[Sigma]; j+=(6.0*par[Sigma])/thetaSteps, jbin++) {
+        const double arg = (j-par[Theta])/par[Sigma];
+        const double weight = std::exp(-0.5*arg*arg);
+        weightSum += weight;
+
+        fill(cohTotal.begin(), cohTotal.end(), 0.0);
+        fill(phiTotal.begin(), phiTotal.end(), 0.0);
+
+        for(unsigned v=0;v<nVec;v++) {
+            // the discontinuity for this vector
+            const double g = Vectors[v];
+            const double xd = 1.0/((k/(g*E0*j))+1.0);
+            const double Q = (1.0-xd)/xd;
+            const double Q2 = Q*Q;
+            const double invQ = 1.0/Q;
+            const double xc = xd/(1+(thetaR2*(1-xd)));
+            const double intensity = par[IVec+v];
+
+            // smeared collimator cut-off, erf is only evaluated in the transition region
+            for(size_t i=0;i<n;i++) {
+                const double a = (X[i]-xc)*invSigmaR;
+                CD[i] = a > erf_saturation ? 1.0 : a < -erf_saturation ? 0.0 : 0.5*(1+std::erf(a));
+            }
+
+            // coherent contribution of this vector, only up to x_d
+            for(size_t i=0;i<n;i++) {
+                const double d = A[i]-4*Q2*X2_OneMinusX[i]*(OneMinusX_X[i]*invQ-1);
+                const double chi = Q2*X_OneMinusX[i]*d;
+                const double phi = 2*Q2*X2_OneMinusX[i]/d;
+                const double contrib = CD[i]*intensity*chi;
+                const bool below = X[i] <= xd;
+                Coh[i] += below ? contrib : 0.0;
+                Phi[i] += below ? contrib*phi : 0.0;
+            }
+        }
+
+        // enhancement = (amo + coherent total) / amo
+        for(size_t i=0;i<n;i++)
+            Enh[i] += weight*(Amo[i]+Coh[i])/Amo[i];
+
+        if(jbin > thetaSteps)
+            continue;
+
+        // the polarisation is weighted by the total intensity
+        for(size_t i=0;i<n;i++) {
+            // weighted mean phi times coherent total
+            const double pol = (Coh[i] > 0.0 ? Phi[i]/Coh[i] : Phi[i])*Coh[i];
+            polSum[i] += pol*weight;
+            intensitySum[i] += (Coh[i]+Amo[i])*weight;
+        }
+    }
+
+    for(size_t i=0;i<n;i++) {
+        Enh[i] /= weightSum;
+        polarisation[i] = polSum[i]/intensitySum[i];
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+namespace ant {
+namespace analysis {
+namespace utils {
+
+/**
+ * @brief The CoherentBremsstrahlung class calculates enhancement and linear polarisation
+ *        of coherent bremsstrahlung from a diamond radiator
+ *
+ * The analytic model follows the CLAS note (as used in cbremFit): The contributions of the
+ * reciprocal lattice vectors are averaged over a Gaussian distribution of the main angle theta
+ * and smeared at the collimator cut-off.
+ *
+ * The calculation runs over all photon energy bins at once with precomputed per-bin terms,
+ * such that the inner loops can be vectorised by the compiler. It is meant to be called
+ * many times inside a fit, but is not thread-safe (use one instance per thread).
+ */
+class CoherentBremsstrahlung {
+public:
+
+    /**
+     * @brief Parameter indices, IVec is the first of NVec intensities
+     */
+    enum param_t {
+        Theta,  // main angle responsible for coherent edge cutoffs
+        Sigma,  // smearing of theta
+        ThetaR, // relative angle resonsible for collimator cutoffs
+        SigmaR, // smearing of collimator cutoff angle
+        E0MeV,  // beam energy
+        NVec,   // number of vectors contributing
+        IVec    // intensities of the vectors up to NVec
+    };
+
+    /**
+     * @brief Vectors lists the reciprocal lattice vectors which can be included (022, 044, ...)
+     */
+    static constexpr std::array<int, 5> Vectors{{2, 4, 6, 8, 10}};
+
+    /**
+     * @brief CoherentBremsstrahlung prepares the calculation for the given photon energies
+     * @param photonEnergies center of each energy bin in MeV
+     * @param thetaSteps number of steps in the convolution with the Gaussian theta distribution
+     */
+    explicit CoherentBremsstrahlung(const std::vector<double>& photonEnergies, unsigned thetaSteps = 201);
+
+    /**
+     * @brief ParametersFromHuman makes parameters from physical quantities
+     * @return parameters with intensities falling off as 1/vector
+     */
+    static std::vector<double> ParametersFromHuman(double beamMeV, double edgeMeV, double spreadMeV,
+                                                   double colliDist_m, double colliRad_mm, unsigned nVec);
+
+    /**
+     * @brief Calculate the enhancement and polarisation for each photon energy bin
+     * @param par parameters indexed by param_t, with par[NVec] intensities starting at par[IVec]
+     * @param enhancement resized to the number of bins
+     * @param polarisation resized to the number of bins
+     */
+    void Calculate(const double* par, std::vector<double>& enhancement, std::vector<double>& polarisation) const;
+
+    std::size_t GetNBins() const { return energies.size(); }
+
+private:
+    const std::vector<double> energies;
+    const unsigned thetaSteps;
+
+    // per-bin terms depending only on beam energy, see update_bins()
+    struct bins_t {
+        double E0 = 0;
+        std::vector<double> X;            // x = E/E0
+        std::vector<double> Amo;          // 1/x, amorphous contribution
+        std::vector<double> A;            // 1+(1-x)^2
+        std::vector<double> OneMinusX_X;  // (1-x)/x
+        std::vector<double> X_OneMinusX;  // x/(1-x)
+        std::vector<double> X2_OneMinusX; // x^2/(1-x)
+    };
+    mutable bins_t bins;
+    void update_bins(double E0) const;
+
+    // work arrays, reused for each call
+    mutable std::vector<double> cd;
+    mutable std::vector<double> cohTotal;
+    mutable std::vector<double> phiTotal;
+    mutable std::vector<double> polSum;
+    mutable std::vector<double> intensitySum;
+};
+
+}}} // namespace ant::analysis::utils
@@ -1,5 +1,6 @@
 #include "MCFakeReconstructed.h"
 
+#include "base/MemoryArena.h"
 #include "utils/ParticleTools.h"
 
 #include "expconfig/detectors/CB.h"
@@ -88,7 +89,7 @@ void do_calo_veto(const TParticle& p,
         type |= veto.Type;
     }
 
-    auto candidate = make_shared<TCandidate>(
+    auto candidate = make_arena_shared<TCandidate>(
                          type,
                          p.Ek(),
                          p.p.Theta(),
@@ -101,7 +102,7 @@ void do_calo_veto(const TParticle& p,
                                  : TClusterList{std::prev(clusters.end())}
                                    );
 
-    list.emplace_back(make_shared<TParticle>(p.Type(), candidate));
+    list.emplace_back(make_arena_shared<TParticle>(p.Type(), candidate));
 }
 
 ParticleTypeList MCFakeReconstructed::Get(const TEventData& mctrue)
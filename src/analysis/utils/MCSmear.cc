@@ -2,6 +2,7 @@
 #include <memory>
 #include "tree/TParticle.h"
 #include "base/std_ext/memory.h"
+#include "base/MemoryArena.h"
 
 #include "TRandom2.h"
 
@@ -28,7 +29,7 @@ ant::TParticlePtr MCSmear::Smear(const TParticlePtr& p, Uncertainties_t& sigmas)
 
         const double Ek = rng->Gaus(p->Ek(), sigmas.sigmaEk); // photon energy
 
-        smeared = make_shared<TParticle>(
+        smeared = make_arena_shared<TParticle>(
                       type,
                       // spatial components are given by photon direction,
                       // time component is sum of resting target and photon energy
@@ -42,7 +43,7 @@ ant::TParticlePtr MCSmear::Smear(const TParticlePtr& p, Uncertainties_t& sigmas)
         const double Theta = rng->Gaus(p->Theta(), sigmas.sigmaTheta);
         const double Phi   = rng->Gaus(p->Phi(),   sigmas.sigmaPhi);
 
-        smeared = make_shared<TParticle>(type, Ek, Theta, Phi);
+        smeared = make_arena_shared<TParticle>(type, Ek, Theta, Phi);
         smeared->Candidate = p->Candidate;
     }
 
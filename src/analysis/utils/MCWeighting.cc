@@ -4,17 +4,22 @@
 #include "base/std_ext/string.h"
 #include "base/Logger.h"
 
-
-// use ROOT's function GSL wrapper...
-#include "Math/SpecFuncMathMore.h"
+#include "TTree.h"
+#include "TChain.h"
+#include "TList.h"
+#include "TParameter.h"
 
 #include <numeric>
+#include <algorithm>
+#include <iomanip>
 
 using namespace std;
 using namespace ant;
 using namespace ant::analysis::utils;
 
 const string MCWeighting::treeName = "MCWeighting";
+const string MCWeighting::normalisationName = "MCWeightNormalisation";
+const string MCWeighting::entriesName = "MCWeightEntries";
 
 // data for the EtaPrime was copied from P.Adlarson code
 // but actually merged from provided files by mail (uses Sergey's original binning not Viktors bin center positions
@@ -88,6 +93,62 @@ MCWeighting::MCWeighting(const HistogramFactory& histFac, const item_t& item) :
     Item(item),
     HistFac(histFac)
 {
+    MakeTable();
+}
+
+void MCWeighting::SetSinglePass(bool singlePass_)
+{
+    if(t.Tree)
+        throw Exception("Cannot change mode after first SetParticleTree");
+    singlePass = singlePass_;
+}
+
+void MCWeighting::MakeTable()
+{
+    const auto& db = Item.Database;
+
+    size_t nCoeffs = 0;
+    for(const auto& c : db)
+        nCoeffs = max(nCoeffs, c.LegendreCoefficients.size());
+
+    // Legendre polynomials as power series by recursion
+    // (l+1) P_{l+1}(x) = (2l+1) x P_l(x) - l P_{l-1}(x)
+    vector<vector<double>> P(nCoeffs, vector<double>(nCoeffs, 0.0));
+    if(nCoeffs>0)
+        P[0][0] = 1.0;
+    if(nCoeffs>1)
+        P[1][1] = 1.0;
+    for(size_t l=1;l+1<nCoeffs;l++) {
+        for(size_t k=0;k<nCoeffs;k++) {
+            double p = -double(l)*P[l-1][k];
+            if(k>0)
+                p += double(2*l+1)*P[l][k-1];
+            P[l+1][k] = p/double(l+1);
+        }
+    }
+
+    auto power_series = [&P, nCoeffs] (const coefficients_t& c) {
+        vector<double> series(nCoeffs, 0.0);
+        for(size_t l=0;l<c.LegendreCoefficients.size();l++)
+            for(size_t k=0;k<=l;k++)
+                series[k] += c.LegendreCoefficients[l]*P[l][k];
+        return series;
+    };
+
+    tableBeamE.clear();
+    for(const auto& c : db)
+        tableBeamE.push_back(c.BeamE.Center());
+
+    table.clear();
+    for(size_t i=0;i+1<db.size();i++) {
+        const auto N_lo = power_series(db[i]);
+        const auto N_hi = power_series(db[i+1]);
+        const double dE = tableBeamE[i+1] - tableBeamE[i];
+        table_t e{tableBeamE[i], N_lo, vector<double>(nCoeffs)};
+        for(size_t k=0;k<nCoeffs;k++)
+            e.Slope[k] = (N_hi[k] - N_lo[k])/dE;
+        table.emplace_back(move(e));
+    }
 }
 
 MCWeighting::database_t MCWeighting::SanitizeDatabase(database_t d)
@@ -126,45 +187,19 @@ double MCWeighting::GetCosTheta(const TParticleTree_t& tree)
 
 double MCWeighting::GetN(const double beamE, const double cosTheta) const
 {
-    // database coefficients are sorted in ascending BeamE
-    // find the first item which has larger beamE
-    const auto& db = Item.Database;
-    using it_t = vector<coefficients_t>::const_iterator;
-    it_t it_coeff_hi = std::find_if(db.begin(), db.end(),
-                                    [beamE] (const coefficients_t& c) { return c.BeamE.Center() > beamE; });
-
-    // handle corner cases of extrapolation
-    if(it_coeff_hi == db.begin()) {
-        // beamE smaller than all entries
-        it_coeff_hi = std::next(db.begin());
-    }
-    else if(it_coeff_hi == db.end()) {
-        // beamE larger than all entries
-        it_coeff_hi = std::prev(it_coeff_hi);
-    }
-
-    // get linearly interpolated legendre coefficients
-    auto it_coeff_lo = std::prev(it_coeff_hi);
-
-    // calculate N_lo / N_hi
-    auto get_N = [cosTheta] (const it_t& it_coeff) {
-        auto& coeffs = it_coeff->LegendreCoefficients;
-        double sum = 0;
-        for(auto l=0u;l<coeffs.size();l++)
-            sum += coeffs[l]*ROOT::Math::legendre(l, cosTheta);
-        return sum;
-    };
-
-    const double beamE_lo = it_coeff_lo->BeamE.Center();
-    const double beamE_hi = it_coeff_hi->BeamE.Center();
-    const double N_lo = get_N(it_coeff_lo);
-    const double N_hi = get_N(it_coeff_hi);
-
-    // slope
-    const double m = (N_hi - N_lo)/(beamE_hi - beamE_lo);
-
-    // calc energy-interpolated N
-    return N_lo + m*(beamE - beamE_lo);
+    // database entries are sorted in ascending BeamE, so use the pair of entries
+    // around beamE, or the first/last pair to extrapolate
+    const auto it = std::upper_bound(tableBeamE.begin(), tableBeamE.end(), beamE);
+    const auto i = it == tableBeamE.begin() ? 0u :
+                   min(size_t(distance(tableBeamE.begin(), it))-1, table.size()-1);
+    const auto& e = table[i];
+
+    // energy-interpolated power series, evaluated by Horner's scheme
+    const double dE = beamE - e.BeamE;
+    double sum = 0;
+    for(auto k=e.N.size();k-->0;)
+        sum = sum*cosTheta + (e.N[k] + e.Slope[k]*dE);
+    return sum;
 }
 
 void MCWeighting::SetParticleTree(const TParticleTree_t& tree)
@@ -172,9 +207,9 @@ void MCWeighting::SetParticleTree(const TParticleTree_t& tree)
     if(tree && tree->Get()->Type() != ParticleTypeDatabase::BeamTarget)
         throw Exception("Root of ParticleTree must be beam particle");
 
-    // lazy init of tree
+    // lazy init of tree, in single-pass mode it's already the final one
     if(t.Tree == nullptr)
-        t.CreateBranches(HistFac.makeTTree(treeName+"_UNFINISHED"));
+        t.CreateBranches(HistFac.makeTTree(singlePass ? treeName : treeName+"_UNFINISHED"));
 
     // check if it the specified meson was produced
     if(ParticleTools::FindParticle(Item.Type, tree, 1) &&
@@ -193,7 +228,7 @@ void MCWeighting::Fill()
     if(!t.Tree)
         return;
 
-    t.MCWeight = last_N;
+    t.MCWeightRaw = last_N;
     t.Tree->Fill();
 }
 
@@ -202,12 +237,31 @@ void MCWeighting::Finish()
     if(!t.Tree)
         return;
 
-    tree_t t_norm;
+    if(singlePass) {
+        // just attach the normalisation, applied by readers
+        // merging keeps the user info and alias of the first tree only,
+        // so the number of entries identifies the tree it belongs to
+        const double normalisation = nParticleTrees/N_sum;
+        const Long64_t entries = t.Tree->GetEntries();
+        auto& userInfo = *t.Tree->GetUserInfo();
+        delete userInfo.FindObject(normalisationName.c_str());
+        delete userInfo.FindObject(entriesName.c_str());
+        userInfo.Add(new TParameter<double>(normalisationName.c_str(), normalisation));
+        userInfo.Add(new TParameter<Long64_t>(entriesName.c_str(), entries));
+        const string alias = std_ext::formatter()
+                             << "Entries$!=" << entries << "?TMath::QuietNaN():"
+                             << "(TMath::Finite(MCWeightRaw)?MCWeightRaw*" << setprecision(17) << normalisation << ":1.0)";
+        t.Tree->SetAlias("MCWeight", alias.c_str());
+        treeWeighted = t.Tree;
+        return;
+    }
+
+    tree_norm_t t_norm;
     t_norm.CreateBranches(HistFac.makeTTree(treeName));
 
     for(auto entry = 0;entry<t.Tree->GetEntries(); entry++) {
         t.Tree->GetEntry(entry);
-        t_norm.MCWeight = isfinite(t.MCWeight) ? (t.MCWeight * nParticleTrees)/N_sum : 1.0;
+        t_norm.MCWeight = isfinite(t.MCWeightRaw) ? (t.MCWeightRaw * nParticleTrees)/N_sum : 1.0;
         t_norm.Tree->Fill();
     }
 
@@ -219,6 +273,31 @@ void MCWeighting::Finish()
     treeWeighted = t_norm.Tree;
 }
 
+void MCWeighting::tree_t::LinkWeights(TTree* tree)
+{
+    LinkBranches(tree);
+    if(MCWeight.IsPresent)
+        return;
+    if(!MCWeightRaw.IsPresent)
+        throw Exception("Tree has neither MCWeight nor MCWeightRaw branch");
+    // the normalisation of the first file would silently be applied to all
+    if(dynamic_cast<TChain*>(Tree))
+        throw Exception("Single-pass MCWeightRaw cannot be read from a TChain");
+    auto& userInfo = *Tree->GetUserInfo();
+    auto param = dynamic_cast<TParameter<double>*>(userInfo.FindObject(normalisationName.c_str()));
+    if(!param)
+        throw Exception("Tree with MCWeightRaw has no "+normalisationName);
+    auto entries = dynamic_cast<TParameter<Long64_t>*>(userInfo.FindObject(entriesName.c_str()));
+    if(!entries)
+        throw Exception("Tree with MCWeightRaw has no "+entriesName);
+    if(entries->GetVal() != Tree->GetEntries())
+        throw Exception(std_ext::formatter()
+                        << "Tree with MCWeightRaw has " << Tree->GetEntries() << " entries, but its "
+                        << normalisationName << " is for " << entries->GetVal()
+                        << ", merged from several files?");
+    Normalisation = param->GetVal();
+}
+
 bool MCWeighting::FriendTTree(TTree* tree)
 {
     if(treeWeighted) {
@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <map>
+#include <cmath>
 
 namespace ant {
 namespace analysis {
@@ -42,6 +43,18 @@ public:
 
     MCWeighting(const HistogramFactory& histFac, const item_t& item);
 
+    /**
+     * @brief SetSinglePass writes the unnormalised weights directly to the final tree
+     * @param singlePass if true, Finish() does not read back and rewrite all entries
+     *
+     * The tree then has the branch MCWeightRaw and the normalisation as user info,
+     * the alias MCWeight applies it for TTree::Draw and friend trees, tree_t::Weight() for readers.
+     * The normalisation only holds for the entries of this very tree, so merged (hadd) or chained
+     * trees are rejected by tree_t::LinkWeights and give NaN via the alias, use the default mode for those.
+     * Must be called before the first SetParticleTree()
+     */
+    void SetSinglePass(bool singlePass = true);
+
     // usage of those methods is tricky...see also test/TestMCWeighting physics class
     // 1) SetParticleTree should be called for each event encountered
     // 2) Fill() should be called everytime a tree is filled with "physics" results
@@ -58,10 +71,28 @@ public:
         using std::runtime_error::runtime_error;
     };
 
+    static const std::string normalisationName;
+    // number of entries the normalisation was calculated for, in single-pass mode
+    static const std::string entriesName;
+
     struct tree_t : WrapTTree {
         // use "unique" branch name to make it easy to friend
-        // this TTree
-        ADD_BRANCH_T(double, MCWeight)
+        // this TTree, MCWeightRaw is written in single-pass mode
+        ADD_BRANCH_OPT_T(double, MCWeight)
+        ADD_BRANCH_OPT_T(double, MCWeightRaw)
+
+        /// @brief LinkWeights links the tree written in either mode, throws if it has no weights
+        /// or single-pass weights of a merged or chained tree
+        void LinkWeights(TTree* tree = nullptr);
+
+        /// @brief Weight is the normalised weight of the current entry, in either mode
+        double Weight() const {
+            if(MCWeight.IsPresent)
+                return MCWeight;
+            return std::isfinite(MCWeightRaw()) ? MCWeightRaw*Normalisation : 1.0;
+        }
+
+        double Normalisation = std_ext::NaN;
     };
 
 //protected:
@@ -74,12 +105,32 @@ public:
 
     const item_t& Item;
 
+    // Legendre expansion as power series in cosTheta, tabulated for each
+    // pair of neighbouring database entries the energy is interpolated between
+    struct table_t {
+        double BeamE;              // center of the lower entry
+        std::vector<double> N;     // coefficients at BeamE
+        std::vector<double> Slope; // their change per MeV towards the upper entry
+    };
+    std::vector<double> tableBeamE; // centers of all database entries
+    std::vector<table_t> table;
+    void MakeTable();
+
+    bool singlePass = false;
+
     unsigned nParticleTrees = 0;
     double N_sum = 0;
     double last_N = std_ext::NaN;
 
+    struct tree_raw_t : WrapTTree {
+        ADD_BRANCH_T(double, MCWeightRaw)
+    };
+    struct tree_norm_t : WrapTTree {
+        ADD_BRANCH_T(double, MCWeight)
+    };
+
     HistogramFactory HistFac;
-    tree_t t;
+    tree_raw_t t;
     TTree* treeWeighted = nullptr;
 };
 
@@ -0,0 +1,165 @@
+#include "Matcher.h"
+
+#include <cmath>
+
+using namespace std;
+using namespace ant::analysis::utils;
+
+constexpr size_t Matcher1to1::npos;
+
+namespace {
+// order of the legacy stable list sort: by score, then in list order
+struct match_order {
+    bool operator()(const Matcher1to1::match_t& x, const Matcher1to1::match_t& y) const {
+        if(x.Score != y.Score)
+            return x.Score < y.Score;
+        if(x.A != y.A)
+            return x.A < y.A;
+        return x.B < y.B;
+    }
+};
+}
+
+void Matcher1to1::solve()
+{
+    matches.clear();
+    matchOfA.assign(n1, npos);
+    matchOfB.assign(n2, npos);
+
+    if(mode == Mode_t::Greedy)
+        solveGreedy();
+    else
+        solveOptimal();
+
+    unmatchedA.clear();
+    for(size_t a=0;a<n1;a++)
+        if(matchOfA[a] == npos)
+            unmatchedA.push_back(a);
+    unmatchedB.clear();
+    for(size_t b=0;b<n2;b++)
+        if(matchOfB[b] == npos)
+            unmatchedB.push_back(b);
+}
+
+void Matcher1to1::solveGreedy()
+{
+    candidates.clear();
+    for(size_t a=0;a<n1;a++) {
+        for(size_t b=0;b<n2;b++) {
+            const double score = scores[a*n2+b];
+            // as match1to1, infinite scores are matched last (or first)
+            if(!std::isnan(score))
+                candidates.push_back({score, a, b});
+        }
+    }
+
+    // heap with the best candidate on top, so only the popped part gets sorted
+    const auto worse = [] (const match_t& x, const match_t& y) { return match_order()(y, x); };
+    make_heap(candidates.begin(), candidates.end(), worse);
+
+    const auto nMax = min(n1, n2);
+    auto end = candidates.end();
+    while(end != candidates.begin() && matches.size() < nMax) {
+        pop_heap(candidates.begin(), end, worse);
+        --end;
+        const match_t& m = *end;
+        if(matchOfA[m.A] != npos || matchOfB[m.B] != npos)
+            continue;
+        matchOfA[m.A] = m.B;
+        matchOfB[m.B] = m.A;
+        matches.push_back(m);
+    }
+}
+
+void Matcher1to1::solveOptimal()
+{
+    // rows are the shorter list, as the method needs rows <= cols
+    const bool transposed = n1 > n2;
+    const size_t rows = transposed ? n2 : n1;
+    const size_t cols = transposed ? n1 : n2;
+    if(rows == 0)
+        return;
+
+    auto score_at = [this, transposed] (size_t r, size_t c) {
+        return transposed ? scores[c*n2+r] : scores[r*n2+c];
+    };
+
+    // shift allowed scores to be non-negative and choose the cost for forbidden pairs
+    // larger than any sum of allowed ones, so the number of matches is maximised first
+    double lo = numeric_limits<double>::infinity();
+    double hi = -numeric_limits<double>::infinity();
+    for(const auto s : scores) {
+        if(!std::isfinite(s))
+            continue;
+        lo = min(lo, s);
+        hi = max(hi, s);
+    }
+    if(lo > hi)
+        return; // nothing allowed
+    const double forbidden = (rows+1)*(hi-lo+1);
+    auto cost = [&score_at, lo, forbidden] (size_t r, size_t c) {
+        const double s = score_at(r, c);
+        return std::isfinite(s) ? s - lo : forbidden;
+    };
+
+    // Hungarian method with potentials, indices are 1-based, 0 is the dummy column
+    const double inf = numeric_limits<double>::infinity();
+    u.assign(rows+1, 0.0);
+    v.assign(cols+1, 0.0);
+    p.assign(cols+1, 0);
+    way.assign(cols+1, 0);
+    for(size_t i=1;i<=rows;i++) {
+        p[0] = i;
+        size_t j0 = 0;
+        minv.assign(cols+1, inf);
+        used.assign(cols+1, false);
+        do {
+            used[j0] = true;
+            const size_t i0 = p[j0];
+            double delta = inf;
+            size_t j1 = 0;
+            for(size_t j=1;j<=cols;j++) {
+                if(used[j])
+                    continue;
+                const double cur = cost(i0-1, j-1) - u[i0] - v[j];
+                if(cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if(minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for(size_t j=0;j<=cols;j++) {
+                if(used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                }
+                else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while(p[j0] != 0);
+        do {
+            const size_t j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while(j0 != 0);
+    }
+
+    for(size_t j=1;j<=cols;j++) {
+        if(p[j] == 0)
+            continue;
+        const size_t a = transposed ? j-1 : p[j]-1;
+        const size_t b = transposed ? p[j]-1 : j-1;
+        const double score = scores[a*n2+b];
+        if(!std::isfinite(score))
+            continue; // only forbidden pairs were left
+        matchOfA[a] = b;
+        matchOfB[b] = a;
+        matches.push_back({score, a, b});
+    }
+    sort(matches.begin(), matches.end(), match_order());
+}
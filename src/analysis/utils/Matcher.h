@@ -3,6 +3,8 @@
 #include <list>
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include <cmath>
 
 #include "base/interval.h"
 #include "base/std_ext/math.h"
@@ -36,6 +38,103 @@ struct scored_match {
     std::pair<T1,T2> getPair() const { return std::pair<T1,T2>(a,b); }
 };
 
+/**
+ * @brief The Matcher1to1 class matches the elements of two lists 1-to-1 by a score
+ *
+ * The buffers are kept between calls, so matching once per event does not
+ * allocate anymore once they have grown. Results are given as indices into the lists.
+ *
+ * Greedy mode takes the pairs with minimal score first (ties in list order),
+ * exactly as match1to1 does, so ±inf scores within the score window are matched as well.
+ * Optimal mode finds the assignment with the most matches and,
+ * among those, the minimal sum of scores (Hungarian method, O(n^3), meant for small lists),
+ * it never matches non-finite scores.
+ * Pairs with NaN scores or scores outside the score window are never matched.
+ */
+class Matcher1to1 {
+public:
+    enum class Mode_t {
+        Greedy,
+        Optimal
+    };
+
+    struct match_t {
+        double Score;
+        std::size_t A; // index in list1
+        std::size_t B; // index in list2
+    };
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    explicit Matcher1to1(Mode_t mode_ = Mode_t::Greedy) : mode(mode_) {}
+
+    /**
+     * @brief Match the elements of list1 and list2 by score f(element1, element2)
+     * @return matches sorted by score, same as Matched()
+     */
+    template <class MatchFunction, typename List1, typename List2>
+    const std::vector<match_t>& Match(const List1& list1,
+                                      const List2& list2,
+                                      MatchFunction f,
+                                      const ant::IntervalD& score_window=ant::IntervalD(-std::numeric_limits<double>::infinity(),std::numeric_limits<double>::infinity()))
+    {
+        n1 = std::size_t(std::distance(std::begin(list1), std::end(list1)));
+        n2 = std::size_t(std::distance(std::begin(list2), std::end(list2)));
+        scores.clear();
+        for(const auto& i : list1) {
+            for(const auto& j : list2) {
+                const double score = f(i,j);
+                // NaN is never contained
+                scores.push_back(score_window.Contains(score) ? score : std_ext::NaN);
+            }
+        }
+        solve();
+        return matches;
+    }
+
+    const std::vector<match_t>& Matched() const { return matches; }
+
+    /// @brief index in list2 matched to list1[a], or npos
+    std::size_t MatchedB(std::size_t a) const { return a < matchOfA.size() ? matchOfA[a] : npos; }
+    /// @brief index in list1 matched to list2[b], or npos
+    std::size_t MatchedA(std::size_t b) const { return b < matchOfB.size() ? matchOfB[b] : npos; }
+
+    /// @brief indices of unmatched elements in list1, ascending
+    const std::vector<std::size_t>& UnmatchedA() const { return unmatchedA; }
+    /// @brief indices of unmatched elements in list2, ascending
+    const std::vector<std::size_t>& UnmatchedB() const { return unmatchedB; }
+
+    /// @brief index of element in list, or npos, to look up matches by element
+    template<typename List, typename T>
+    static std::size_t IndexOf(const List& list, const T& element) {
+        const auto it = std::find(std::begin(list), std::end(list), element);
+        return it == std::end(list) ? npos : std::size_t(std::distance(std::begin(list), it));
+    }
+
+protected:
+    const Mode_t mode;
+
+    std::size_t n1 = 0;
+    std::size_t n2 = 0;
+    std::vector<double> scores; // row-major n1 x n2, NaN if not allowed
+
+    std::vector<match_t> matches;
+    std::vector<std::size_t> matchOfA;
+    std::vector<std::size_t> matchOfB;
+    std::vector<std::size_t> unmatchedA;
+    std::vector<std::size_t> unmatchedB;
+
+    // work buffers
+    std::vector<match_t> candidates;
+    std::vector<double> u, v, minv;
+    std::vector<std::size_t> p, way;
+    std::vector<char> used;
+
+    void solve();
+    void solveGreedy();
+    void solveOptimal();
+};
+
 /**
  * @brief Particle Matcher
  * @param list1 vector of elements 1
@@ -48,6 +147,7 @@ struct scored_match {
  * every element of list1,list2 occurs only once in the pair list
  *
  * The Matcher Function can be a lambda function
+ * @see Matcher1to1 to obtain indices without copying the elements
  */
 template <class MatchFunction, typename List1, typename List2>
 std::list< scored_match<typename List1::value_type, typename List2::value_type> >
@@ -61,38 +161,16 @@ std::list< scored_match<typename List1::value_type, typename List2::value_type>
     typedef typename List2::value_type T2;
     typedef std::list< scored_match<T1, T2> > scorelist;
 
+    // buffers are reused between calls
+    static thread_local Matcher1to1 matcher;
+    matcher.Match(list1, list2, f, score_window);
 
     scorelist scores;
-
-    // build pairs and calculate scores
-    for( const auto& i : list1 )
-        for( const auto& j : list2 ) {
-            const double score = f(i,j);
-            if( score_window.Contains(score)) {
-                scored_match<T1,T2> s = {score,i,j};
-                scores.emplace_back(s);
-            }
-        }
-
-    scores.sort();
-
-    // find best matching pairs
-    auto i = scores.begin();
-    while(  i != scores.end() ) {
-
-        auto j = i;
-        ++j;
-
-        //remove all matches that include one of the two just matched particles
-        while( j!=scores.end() ) {
-
-            if( j->a == i->a || j->b == i->b)
-                j = scores.erase(j);
-            else
-                ++j;
-        }
-
-        ++i;
+    for(const auto& m : matcher.Matched()) {
+        scored_match<T1,T2> s = {m.Score,
+                                 *std::next(std::begin(list1), m.A),
+                                 *std::next(std::begin(list2), m.B)};
+        scores.emplace_back(s);
     }
 
     return scores;
@@ -108,25 +186,34 @@ T2 FindMatched(const std::list<utils::scored_match<T1,T2>>& l, const T1& f) {
     return T2();
 }
 
+/**
+ * @brief FindMatched returns the element of list2 matched to element a of list1 in the last Match
+ * @return default constructed element if a is not matched, as FindMatched for match1to1
+ */
+template <typename List1, typename List2>
+typename List2::value_type FindMatched(const Matcher1to1& matcher, const List1& list1, const List2& list2,
+                                       const typename List1::value_type& a) {
+    const auto b = matcher.MatchedB(Matcher1to1::IndexOf(list1, a));
+    return b == Matcher1to1::npos ? typename List2::value_type() : *std::next(std::begin(list2), b);
+}
+
 // this method returns a list of particles
 // which are not in the in the scored list
 template <typename T1, typename T2>
 std::vector<T2> FindUnmatched(const std::list<utils::scored_match<T1,T2>>& l, const std::vector<T2>& f) {
+    std::vector<T2> matched;
+    matched.reserve(l.size());
+    for( const auto& j : l )
+        matched.push_back(j.b);
+    std::sort(matched.begin(), matched.end());
+
     std::vector<T2> unmatched;
-    for( const auto& i : f ) { // loop over std::vector<T2>
-        bool found = false;
-        for( const auto& j : l ) { // loop over list of scored_match<T1,T2>
-            if( j.b == i) {
-                found = true;
-                continue;
-            }
-        }
-        if (found == false) {
+    for( const auto& i : f ) {
+        if(!std::binary_search(matched.begin(), matched.end(), i))
             unmatched.push_back(i);
-        }
     }
     return unmatched;
-};
+}
 
 
 
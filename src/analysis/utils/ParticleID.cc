@@ -1,12 +1,15 @@
 #include "ParticleID.h"
 
+#include "base/MemoryArena.h"
 #include "tree/TParticle.h"
 
 #include "base/std_ext/system.h"
 #include "base/WrapTFile.h"
 #include "base/Logger.h"
+#include "base/std_ext/memory.h"
 
 #include "TCutG.h"
+#include "TRandom2.h"
 
 
 using namespace std;
@@ -21,7 +24,7 @@ TParticlePtr ParticleID::Process(const TCandidatePtr& cand) const
 {
     auto type = Identify(cand);
     if(type !=nullptr) {
-       return std::make_shared<TParticle>(*type, cand);
+       return make_arena_shared<TParticle>(*type, cand);
     }
 
     return nullptr;
@@ -64,12 +67,55 @@ bool TestCut(const std::shared_ptr<TCutG>& cut, const double& x, const double& y
     return (cut) && cut->IsInside(x,y);
 }
 
+bool TestCut(const std::shared_ptr<TCutG>& cut, const std::unique_ptr<const RasterizedCut>& compiled,
+             const double& x, const double& y) {
+    // only use the compiled cut if it still belongs to the set cut
+    if(compiled && compiled->GetCut() == cut.get())
+        return compiled->IsInside(x,y);
+    return TestCut(cut, x, y);
+}
+
+void BasicParticleID::Compile(unsigned nBins)
+{
+    auto compile = [nBins] (const std::shared_ptr<TCutG>& cut) -> std::unique_ptr<const RasterizedCut> {
+        if(!cut)
+            return nullptr;
+        return std_ext::make_unique<const RasterizedCut>(cut, nBins, nBins);
+    };
+    compiled.dEE_proton   = compile(dEE_proton);
+    compiled.dEE_pion     = compile(dEE_pion);
+    compiled.dEE_electron = compile(dEE_electron);
+    compiled.tof          = compile(tof);
+    compiled.size         = compile(size);
+}
+
+unsigned BasicParticleID::Validate(unsigned nPoints) const
+{
+    TRandom2 rng(nPoints); // reproducible
+    unsigned nMismatches = 0;
+    auto validate = [&rng, &nMismatches, nPoints] (const std::unique_ptr<const RasterizedCut>& c) {
+        if(!c)
+            return;
+        const auto n = c->Validate(nPoints, rng);
+        if(n>0)
+            LOG(WARNING) << "Compiled cut " << c->GetCut()->GetName() << " has "
+                         << n << " mismatches at " << nPoints << " random points";
+        nMismatches += n;
+    };
+    validate(compiled.dEE_proton);
+    validate(compiled.dEE_pion);
+    validate(compiled.dEE_electron);
+    validate(compiled.tof);
+    validate(compiled.size);
+    return nMismatches;
+}
+
 
 
 const ParticleTypeDatabase::Type* BasicParticleID::Identify(const TCandidatePtr& cand) const
 {
-    const bool hadronic =    TestCut(tof,  cand->CaloEnergy, cand->Time)
-                  || TestCut(size, cand->CaloEnergy, cand->ClusterSize);
+    const bool hadronic =    TestCut(tof,  compiled.tof,  cand->CaloEnergy, cand->Time)
+                  || TestCut(size, compiled.size, cand->CaloEnergy, cand->ClusterSize);
 
     const bool hadronic_enabled = (tof) || (size);
 
@@ -89,19 +135,19 @@ const ParticleTypeDatabase::Type* BasicParticleID::Identify(const TCandidatePtr&
 
         if(
            (hadronic_enabled && hadronic)
-           || (TestCut(dEE_proton, cand->CaloEnergy, cand->VetoEnergy))
+           || (TestCut(dEE_proton, compiled.dEE_proton, cand->CaloEnergy, cand->VetoEnergy))
            ) {
             return addressof(ParticleTypeDatabase::Proton);
         }
 
         if(
-           TestCut(dEE_pion, cand->CaloEnergy, cand->VetoEnergy)
+           TestCut(dEE_pion, compiled.dEE_pion, cand->CaloEnergy, cand->VetoEnergy)
            ) {
             return addressof(ParticleTypeDatabase::PiCharged);
         }
 
         if(
-           TestCut(dEE_electron, cand->CaloEnergy, cand->VetoEnergy)
+           TestCut(dEE_electron, compiled.dEE_electron, cand->CaloEnergy, cand->VetoEnergy)
            ) {
             return addressof(ParticleTypeDatabase::eCharged);
         }
@@ -149,6 +195,11 @@ const ParticleTypeDatabase::Type* CBTAPSBasicParticleID::Identify(const TCandida
     return nullptr;
 }
 
+unsigned CBTAPSBasicParticleID::Validate(unsigned nPoints) const
+{
+    return cb.Validate(nPoints) + taps.Validate(nPoints);
+}
+
 void CBTAPSBasicParticleID::LoadFrom(WrapTFile& file)
 {
 
@@ -163,6 +214,14 @@ void CBTAPSBasicParticleID::LoadFrom(WrapTFile& file)
         taps.dEE_electron   = file.GetSharedClone<TCutG>("taps_dEE_electron");
         taps.tof            = file.GetSharedClone<TCutG>("taps_ToF");
         taps.size           = file.GetSharedClone<TCutG>("taps_CluserSize");
+
+        cb.Compile();
+        taps.Compile();
+
+        if(VLOG_IS_ON(5)) {
+            const auto nMismatches = Validate(100000);
+            VLOG(5) << "Validated compiled ParticleID cuts, found " << nMismatches << " mismatches";
+        }
 }
 
 
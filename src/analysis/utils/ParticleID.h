@@ -2,6 +2,7 @@
 
 #include "tree/TParticle.h"
 #include "base/ParticleType.h"
+#include "RasterizedCut.h"
 
 #include <memory>
 
@@ -53,6 +54,30 @@ public:
     std::shared_ptr<TCutG> size;
 
     virtual const ParticleTypeDatabase::Type* Identify(const TCandidatePtr& cand) const override;
+
+    /**
+     * @brief Compile rasterizes the currently set cuts for fast lookup in Identify
+     * @param nBins number of grid cells per axis
+     * @note cuts changed after compiling are tested exactly again, until Compile is called again
+     */
+    void Compile(unsigned nBins = 256);
+
+    /**
+     * @brief Validate compares the compiled cuts with TCutG::IsInside at random points
+     * @param nPoints number of random points per cut
+     * @return total number of mismatches, should be zero
+     */
+    unsigned Validate(unsigned nPoints) const;
+
+protected:
+    struct compiled_t {
+        std::unique_ptr<const RasterizedCut> dEE_proton;
+        std::unique_ptr<const RasterizedCut> dEE_pion;
+        std::unique_ptr<const RasterizedCut> dEE_electron;
+        std::unique_ptr<const RasterizedCut> tof;
+        std::unique_ptr<const RasterizedCut> size;
+    };
+    compiled_t compiled;
 };
 
 class CBTAPSBasicParticleID: public ParticleID {
@@ -66,6 +91,13 @@ public:
     virtual ~CBTAPSBasicParticleID();
 
     virtual const ParticleTypeDatabase::Type* Identify(const TCandidatePtr& cand) const override;
+
+    /**
+     * @brief Validate compares the compiled CB and TAPS cuts with TCutG::IsInside at random points
+     * @param nPoints number of random points per cut
+     * @return total number of mismatches, should be zero
+     */
+    unsigned Validate(unsigned nPoints) const;
 };
 
 }
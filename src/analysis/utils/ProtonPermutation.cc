@@ -1,5 +1,6 @@
 #include "ProtonPermutation.h"
 
+#include "base/MemoryArena.h"
 #include "base/ParticleType.h"
 
 #include <memory>
@@ -14,9 +15,9 @@ void ProtonPermutation::Fill()
 
     for(auto i = cands.cbegin(); i!=cands.cend(); ++i) {
         if(i != p_it) {
-            photons.emplace_back(make_shared<TParticle>(ParticleTypeDatabase::Photon, *i));
+            photons.emplace_back(make_arena_shared<TParticle>(ParticleTypeDatabase::Photon, *i));
         } else {
-            proton = make_shared<TParticle>(ParticleTypeDatabase::Proton, *i);
+            proton = make_arena_shared<TParticle>(ParticleTypeDatabase::Proton, *i);
             trueMatch = (*i == true_proton);
         }
     }
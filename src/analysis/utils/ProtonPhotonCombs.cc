@@ -1,5 +1,7 @@
 #include "ProtonPhotonCombs.h"
 
+#include "base/MemoryArena.h"
+
 using namespace std;
 using namespace ant;
 using namespace ant::analysis::utils;
@@ -117,8 +119,8 @@ ProtonPhotonCombs::MakeCombinations(const TCandidateList& cands, const combfilte
     TParticleList all_protons;
     TParticleList all_photons;
     for(auto cand : cands.get_iter()) {
-        all_protons.emplace_back(std::make_shared<TParticle>(ParticleTypeDatabase::Proton, cand));
-        all_photons.emplace_back(std::make_shared<TParticle>(ParticleTypeDatabase::Photon, cand));
+        all_protons.emplace_back(make_arena_shared<TParticle>(ParticleTypeDatabase::Proton, cand));
+        all_photons.emplace_back(make_arena_shared<TParticle>(ParticleTypeDatabase::Photon, cand));
     }
 
     // important for DiscardedEk cut later
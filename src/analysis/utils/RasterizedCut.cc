@@ -0,0 +1,165 @@
+#include "RasterizedCut.h"
+
+#include "TCutG.h"
+#include "TRandom.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis::utils;
+
+RasterizedCut::RasterizedCut(std::shared_ptr<const TCutG> cut_, unsigned nBinsX_, unsigned nBinsY_) :
+    cut(move(cut_)),
+    nBinsX(nBinsX_),
+    nBinsY(nBinsY_)
+{
+    if(!cut)
+        throw std::invalid_argument("RasterizedCut needs a cut");
+    if(nBinsX==0 || nBinsY==0)
+        throw std::invalid_argument("RasterizedCut needs at least one bin in x and y");
+
+    const auto n = cut->GetN();
+    const double* px = cut->GetX();
+    const double* py = cut->GetY();
+    if(n<3)
+        return;
+
+    xmin = *min_element(px, px+n);
+    xmax = *max_element(px, px+n);
+    ymin = *min_element(py, py+n);
+    ymax = *max_element(py, py+n);
+    if(!(xmax>xmin) || !(ymax>ymin))
+        return;
+
+    dx = (xmax-xmin)/nBinsX;
+    dy = (ymax-ymin)/nBinsY;
+
+    cells.resize(nBinsX*nBinsY, cell_t::Outside);
+
+    // TCutG::IsInside implicitly closes the polygon,
+    // so mark the edge from the last to the first point as well
+    for(int i=0;i<n;i++) {
+        const int j = i==0 ? n-1 : i-1;
+        MarkEdge(px[j], py[j], px[i], py[i]);
+    }
+
+    // cells not touched by any edge are either completely inside or outside,
+    // so the center decides for the whole cell
+    for(unsigned iy=0;iy<nBinsY;iy++) {
+        for(unsigned ix=0;ix<nBinsX;ix++) {
+            auto& c = Cell(ix, iy);
+            if(c == cell_t::Boundary)
+                continue;
+            const double x = xmin + (ix+0.5)*dx;
+            const double y = ymin + (iy+0.5)*dy;
+            c = cut->IsInside(x, y) ? cell_t::Inside : cell_t::Outside;
+        }
+    }
+}
+
+void RasterizedCut::MarkEdge(double x1, double y1, double x2, double y2)
+{
+    // enlarge cells by a small margin, such that rounding
+    // in IsInside can never put a point into a wrongly classified cell
+    const double ex = 1e-3*dx;
+    const double ey = 1e-3*dy;
+
+    auto clamp_bin = [] (double v, unsigned nBins) {
+        return static_cast<unsigned>(std::max(0.0, std::min<double>(nBins-1, std::floor(v))));
+    };
+
+    const unsigned ix_lo = clamp_bin((std::min(x1,x2)-ex-xmin)/dx, nBinsX);
+    const unsigned ix_hi = clamp_bin((std::max(x1,x2)+ex-xmin)/dx, nBinsX);
+    const unsigned iy_lo = clamp_bin((std::min(y1,y2)-ey-ymin)/dy, nBinsY);
+    const unsigned iy_hi = clamp_bin((std::max(y1,y2)+ey-ymin)/dy, nBinsY);
+
+    // the bounding boxes of segment and cell overlap by construction,
+    // the cell is touched if its corners are not all strictly on one side of the line
+    const double nx = y2-y1;
+    const double ny = x1-x2;
+    const double c  = -(nx*x1 + ny*y1);
+
+    for(unsigned iy=iy_lo;iy<=iy_hi;iy++) {
+        for(unsigned ix=ix_lo;ix<=ix_hi;ix++) {
+            const double cx_lo = xmin + ix*dx - ex;
+            const double cx_hi = xmin + (ix+1)*dx + ex;
+            const double cy_lo = ymin + iy*dy - ey;
+            const double cy_hi = ymin + (iy+1)*dy + ey;
+
+            const double s[4] = {
+                nx*cx_lo + ny*cy_lo + c,
+                nx*cx_hi + ny*cy_lo + c,
+                nx*cx_lo + ny*cy_hi + c,
+                nx*cx_hi + ny*cy_hi + c
+            };
+            const bool all_pos = s[0]>0 && s[1]>0 && s[2]>0 && s[3]>0;
+            const bool all_neg = s[0]<0 && s[1]<0 && s[2]<0 && s[3]<0;
+            if(!all_pos && !all_neg)
+                Cell(ix, iy) = cell_t::Boundary;
+        }
+    }
+}
+
+bool RasterizedCut::IsInside(double x, double y) const
+{
+    if(cells.empty())
+        return cut->IsInside(x, y);
+
+    // nothing is inside outside of the bounding box (also catches NaN)
+    if(!(x>=xmin && x<=xmax && y>=ymin && y<=ymax))
+        return false;
+
+    const auto ix = std::min(static_cast<unsigned>((x-xmin)/dx), nBinsX-1);
+    const auto iy = std::min(static_cast<unsigned>((y-ymin)/dy), nBinsY-1);
+
+    switch(cells[iy*nBinsX+ix]) {
+    case cell_t::Inside:
+        return true;
+    case cell_t::Outside:
+        return false;
+    case cell_t::Boundary:
+        break;
+    }
+    return cut->IsInside(x, y);
+}
+
+unsigned RasterizedCut::Validate(unsigned nPoints, TRandom& rng) const
+{
+    const auto n = cut->GetN();
+    if(n==0)
+        return 0;
+    const double* px = cut->GetX();
+    const double* py = cut->GetY();
+
+    // also test some points outside of the bounding box
+    const double x_lo = *min_element(px, px+n);
+    const double x_hi = *max_element(px, px+n);
+    const double y_lo = *min_element(py, py+n);
+    const double y_hi = *max_element(py, py+n);
+    const double mx = 0.1*(x_hi-x_lo);
+    const double my = 0.1*(y_hi-y_lo);
+
+    unsigned nMismatches = 0;
+    for(unsigned i=0;i<nPoints;i++) {
+        const double x = rng.Uniform(x_lo-mx, x_hi+mx);
+        const double y = rng.Uniform(y_lo-my, y_hi+my);
+        if(IsInside(x, y) != static_cast<bool>(cut->IsInside(x, y)))
+            nMismatches++;
+    }
+    // polygon vertices are the most delicate points
+    for(int i=0;i<n;i++) {
+        if(IsInside(px[i], py[i]) != static_cast<bool>(cut->IsInside(px[i], py[i])))
+            nMismatches++;
+    }
+    return nMismatches;
+}
+
+double RasterizedCut::GetBoundaryFraction() const
+{
+    if(cells.empty())
+        return 1.0;
+    return double(count(cells.begin(), cells.end(), cell_t::Boundary))/cells.size();
+}
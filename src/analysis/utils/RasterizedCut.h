@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+class TCutG;
+class TRandom;
+
+namespace ant {
+namespace analysis {
+namespace utils {
+
+/**
+ * @brief The RasterizedCut class speeds up repeated TCutG::IsInside calls
+ *
+ * The bounding box of the polygon is divided into a regular grid at construction.
+ * Cells not touched by any polygon edge are completely inside or outside, so
+ * the result is a simple lookup. Only points falling into cells crossed by an edge
+ * are tested exactly with the underlying TCutG.
+ */
+class RasterizedCut {
+public:
+    RasterizedCut(std::shared_ptr<const TCutG> cut, unsigned nBinsX = 256, unsigned nBinsY = 256);
+
+    /**
+     * @brief IsInside gives the same result as TCutG::IsInside of the underlying cut
+     */
+    bool IsInside(double x, double y) const;
+
+    const TCutG* GetCut() const { return cut.get(); }
+
+    /**
+     * @brief Validate compares IsInside with TCutG::IsInside at random points
+     * @param nPoints number of points thrown uniformly in the (slightly enlarged) bounding box
+     * @param rng random generator to use
+     * @return number of points with different result, should be zero
+     */
+    unsigned Validate(unsigned nPoints, TRandom& rng) const;
+
+    /**
+     * @brief GetBoundaryFraction gives fraction of cells which need an exact polygon test
+     */
+    double GetBoundaryFraction() const;
+
+protected:
+    enum class cell_t : std::uint8_t {
+        Outside, Inside, Boundary
+    };
+
+    std::shared_ptr<const TCutG> cut;
+
+    unsigned nBinsX;
+    unsigned nBinsY;
+    double xmin = 0, xmax = 0, ymin = 0, ymax = 0;
+    double dx = 0, dy = 0;
+    std::vector<cell_t> cells; // empty if polygon is degenerate, always exact test then
+
+    void MarkEdge(double x1, double y1, double x2, double y2);
+    cell_t& Cell(unsigned ix, unsigned iy) { return cells[iy*nBinsX+ix]; }
+};
+
+}
+}
+}
@@ -11,6 +11,7 @@ using namespace ant::analysis::utils;
 
 TriggerSimulation::TriggerSimulation() :
     config(ExpConfig::Setup::Get().GetTriggerSimuConfig()),
+    triggersums(config),
     random_CBESum_threshold(config.CBESum_Edge, config.CBESum_Width)
 {}
 
@@ -22,43 +23,12 @@ bool TriggerSimulation::ProcessEvent(const TEvent& event)
 
     const bool isMC = recon.ID.isSet(TID::Flags_t::MC);
 
-    // CBTiming as average over cluster timings
-    {
-        if(isMC) {
-            info.CBTiming = 0;
-        }
-        else {
-            double TimeEsum = 0.0;
-            double TimeE = 0.0;
-            for(const auto& cluster : recon.Clusters) {
-                if(cluster.DetectorType != Detector_t::Type_t::CB)
-                    continue;
-                // ignore weird clusters
-                if(!cluster.isSane())
-                    continue;
-                TimeEsum += cluster.Energy;
-                TimeE += cluster.Energy*cluster.Time;
-            }
-            info.CBTiming = TimeE/TimeEsum;
-        }
-    }
-
-    // CBEsum is sum over detector read hits (except possibly ignored channels)
-    {
-        info.CBEnergySum = 0.0;
-        for(const TDetectorReadHit& dethit : recon.DetectorReadHits) {
-            if(dethit.DetectorType != Detector_t::Type_t::CB)
-                continue;
-            if(dethit.ChannelType != Channel_t::Type_t::Integral)
-                continue;
-            if(std_ext::contains(config.CBESum_MissingElements, dethit.Channel))
-                continue;
-            // one could also use uncalibrated values
-            // with some fixed constant? or average from all gains?
-            for(auto& energy : dethit.Values)
-                info.CBEnergySum += energy.Calibrated;
-        }
-    }
+    // CBEsum is sum over detector read hits (except possibly ignored channels),
+    // CBTiming the average over cluster timings,
+    // both already summed up during reconstruction if the event was reconstructed in this run
+    const auto sums = recon.TriggerSums.IsSet ? recon.TriggerSums : triggersums.Calculate(recon);
+    info.CBEnergySum = sums.CBEnergySum;
+    info.CBTiming = isMC ? 0 : sums.CBTiming;
 
     if(isMC) {
         if(config.Type == config_t::Type_t::CBESum) {
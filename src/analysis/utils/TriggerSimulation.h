@@ -2,6 +2,7 @@
 
 #include "base/std_ext/math.h"
 #include "expconfig/ExpConfig.h"
+#include "expconfig/TriggerSums.h"
 
 #include <random>
 
@@ -37,6 +38,7 @@ class TriggerSimulation {
 
     using config_t = expconfig::Setup_traits::triggersimu_config_t;
     const config_t config;
+    const expconfig::TriggerSums triggersums;
 
     std::unique_ptr<std::default_random_engine> random_gen;
     std::normal_distribution<double> random_CBESum_threshold;
@@ -49,6 +51,7 @@ public:
      * @brief ProcessEvent inspects the full event to tell trigger decision
      * @param event the event under investigation
      * @return true if successful, false on failure
+     * @note uses the sums filled during reconstruction, only events read from file are scanned
      */
     bool ProcessEvent(const TEvent& event);
 
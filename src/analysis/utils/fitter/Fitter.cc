@@ -1,5 +1,6 @@
 #include "Fitter.h"
 
+#include "base/MemoryArena.h"
 #include "expconfig/ExpConfig.h"
 #include "expconfig/detectors/CB.h"
 #include "expconfig/detectors/TAPS.h"
@@ -24,7 +25,7 @@ TParticlePtr Fitter::FitParticle::AsFitted() const
     if(!isfinite(Fitted_Z_Vertex))
         throw Exception("Need z vertex to calculate LorentzVec");
 
-    auto p = make_shared<TParticle>(Particle->Type(), GetLorentzVec(Fitted_Z_Vertex));
+    auto p = make_arena_shared<TParticle>(Particle->Type(), GetLorentzVec(Fitted_Z_Vertex));
     p->Candidate = Particle->Candidate; // link Candidate
     return p;
 }
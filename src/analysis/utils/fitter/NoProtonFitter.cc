@@ -1,5 +1,6 @@
 #include "NoProtonFitter.h"
 
+#include "base/MemoryArena.h"
 #include "base/Logger.h"
 #include "base/std_ext/map.h"
 #include "TVector3.h"
@@ -70,7 +71,7 @@ double NoProtonFitter::GetFittedBeamE() const
 
 TParticlePtr NoProtonFitter::GetFittedBeamParticle() const
 {
-    return std::make_shared<TParticle>(ParticleTypeDatabase::BeamProton, BeamE.GetLorentzVec());
+    return make_arena_shared<TParticle>(ParticleTypeDatabase::BeamProton, BeamE.GetLorentzVec());
 }
 
 double NoProtonFitter::GetFittedZVertex() const
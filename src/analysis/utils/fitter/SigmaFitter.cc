@@ -1,5 +1,6 @@
 #include "SigmaFitter.h"
 
+#include "base/MemoryArena.h"
 #include "base/Logger.h"
 #include "base/std_ext/map.h"
 
@@ -69,7 +70,7 @@ double SigmaFitter::GetFittedBeamE() const
 
 TParticlePtr SigmaFitter::GetFittedBeamParticle() const
 {
-    return std::make_shared<TParticle>(ParticleTypeDatabase::BeamProton, BeamE.GetLorentzVec());
+    return make_arena_shared<TParticle>(ParticleTypeDatabase::BeamProton, BeamE.GetLorentzVec());
 }
 
 double SigmaFitter::GetFittedZVertex() const
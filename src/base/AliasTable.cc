@@ -0,0 +1,67 @@
+#include "AliasTable.h"
+
+#include <cmath>
+
+using namespace std;
+using namespace ant;
+
+AliasTable::AliasTable(const std::vector<double>& weights) :
+    prob(weights.size()),
+    alias(weights.size())
+{
+    double sum = 0;
+    for(auto w : weights) {
+        if(!(w >= 0) || !isfinite(w))
+            throw Exception("Weights must be finite and non-negative");
+        sum += w;
+    }
+    if(!(sum > 0))
+        throw Exception("At least one weight must be positive");
+
+    // scale such that the mean probability is 1,
+    // then pair each small entry with a large one
+    const auto n = weights.size();
+    vector<double> scaled(n);
+    vector<unsigned> small, large;
+    for(unsigned i=0;i<n;i++) {
+        scaled[i] = weights[i]*n/sum;
+        (scaled[i] < 1 ? small : large).push_back(i);
+    }
+
+    while(!small.empty() && !large.empty()) {
+        const auto s = small.back();
+        small.pop_back();
+        const auto l = large.back();
+
+        prob[s] = scaled[s];
+        alias[s] = l;
+
+        scaled[l] = (scaled[l] + scaled[s]) - 1;
+        if(scaled[l] < 1) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // remaining ones are 1 up to rounding errors
+    for(auto l : large) {
+        prob[l] = 1;
+        alias[l] = l;
+    }
+    for(auto s : small) {
+        prob[s] = 1;
+        alias[s] = s;
+    }
+}
+
+double AliasTable::GetProbability(unsigned i) const
+{
+    // own column plus all columns pointing to i as alias
+    const auto n = prob.size();
+    double p = prob.at(i);
+    for(unsigned j=0;j<n;j++) {
+        if(alias[j] == i && j != i)
+            p += 1 - prob[j];
+    }
+    return p/n;
+}
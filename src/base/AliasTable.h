@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+
+namespace ant {
+
+/**
+ * @brief The AliasTable struct samples from a discrete distribution in constant time
+ *
+ * Uses Walker's alias method (in the numerically stable variant by Vose).
+ * Building the table is linear in the number of weights, each sample needs
+ * one uniform random number, independent of the number of weights.
+ */
+struct AliasTable {
+
+    /**
+     * @brief AliasTable builds the table
+     * @param weights non-negative, not necessarily normalized, at least one must be positive
+     */
+    explicit AliasTable(const std::vector<double>& weights);
+
+    /**
+     * @brief Sample picks an index according to the weights
+     * @param u uniformly distributed random number in [0,1)
+     * @return index into the weights given at construction
+     */
+    unsigned Sample(double u) const {
+        const double x = u*prob.size();
+        unsigned i = static_cast<unsigned>(x);
+        // protect against u=1
+        if(i >= prob.size())
+            i = prob.size()-1;
+        return x - i < prob[i] ? i : alias[i];
+    }
+
+    /**
+     * @brief GetProbability
+     * @param i index into the weights given at construction
+     * @return normalized probability to pick index i
+     */
+    double GetProbability(unsigned i) const;
+
+    std::size_t size() const { return prob.size(); }
+
+    struct Exception : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+protected:
+    std::vector<double>   prob;
+    std::vector<unsigned> alias;
+};
+
+}
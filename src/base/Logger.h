@@ -4,6 +4,8 @@
 #define ELPP_STL_LOGGING
 #define ELPP_DISABLE_DEFAULT_CRASH_HANDLING
 #define ELPP_NO_DEFAULT_LOG_FILE
+// readers may run on their own threads
+#define ELPP_THREAD_SAFE
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Weffc++"
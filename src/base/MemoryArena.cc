@@ -0,0 +1,117 @@
+#include "MemoryArena.h"
+
+#include <cstdlib>
+#include <new>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+
+constexpr size_t MemoryArena::ChunkSize;
+constexpr size_t MemoryArena::MaxSmallSize;
+constexpr size_t MemoryArena::HeaderSize;
+constexpr size_t MemoryArena::MaxFreeChunks;
+
+atomic<size_t> MemoryArena::totalChunks(0);
+
+namespace {
+
+// released chunks shared by all threads, only touched once per chunk
+struct free_chunks_t {
+    mutex Mutex;
+    vector<void*> Chunks;
+};
+
+free_chunks_t& free_chunks() {
+    // intentionally never destroyed, as other static objects
+    // may still release their chunks during exit
+    static auto instance = new free_chunks_t;
+    return *instance;
+}
+
+}
+
+MemoryArena& MemoryArena::Get()
+{
+    static thread_local MemoryArena arena;
+    return arena;
+}
+
+MemoryArena::chunk_t* MemoryArena::NewChunk()
+{
+    void* p = nullptr;
+    {
+        auto& f = free_chunks();
+        lock_guard<mutex> lock(f.Mutex);
+        if(!f.Chunks.empty()) {
+            p = f.Chunks.back();
+            f.Chunks.pop_back();
+        }
+    }
+    if(!p) {
+        // alignment to chunk size makes finding the chunk from any pointer trivial
+        if(posix_memalign(addressof(p), ChunkSize, ChunkSize) != 0)
+            throw bad_alloc();
+        totalChunks++;
+    }
+    auto chunk = new (p) chunk_t;
+    chunk->refs = 1;
+    chunk->used = HeaderSize;
+    return chunk;
+}
+
+void MemoryArena::Release(chunk_t* chunk) noexcept
+{
+    if(chunk->refs.fetch_sub(1) != 1)
+        return;
+    chunk->~chunk_t();
+    {
+        auto& f = free_chunks();
+        lock_guard<mutex> lock(f.Mutex);
+        if(f.Chunks.size() < MaxFreeChunks) {
+            f.Chunks.push_back(chunk);
+            return;
+        }
+    }
+    free(chunk);
+}
+
+void* MemoryArena::allocate(size_t size)
+{
+    // round up to keep everything maximally aligned
+    constexpr size_t align = alignof(max_align_t);
+    size = (size + align - 1) & ~(align - 1);
+
+    if(current) {
+        // only the arena itself holds a reference,
+        // so all previously allocated objects are gone
+        if(current->refs.load() == 1)
+            current->used = HeaderSize;
+        else if(current->used + size > ChunkSize) {
+            Release(current);
+            current = nullptr;
+        }
+    }
+
+    if(!current)
+        current = NewChunk();
+
+    void* p = reinterpret_cast<char*>(current) + current->used;
+    current->used += size;
+    current->refs++;
+    return p;
+}
+
+void MemoryArena::deallocate(void* p, size_t) noexcept
+{
+    const auto address = reinterpret_cast<uintptr_t>(p);
+    Release(reinterpret_cast<chunk_t*>(address & ~(uintptr_t(ChunkSize) - 1)));
+}
+
+MemoryArena::~MemoryArena()
+{
+    // still living objects keep the chunk alive
+    if(current)
+        Release(current);
+}
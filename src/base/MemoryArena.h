@@ -0,0 +1,104 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ant {
+
+/**
+ * @brief The MemoryArena class provides fast bump-pointer allocation of short-lived objects
+ *
+ * Memory is handed out from aligned chunks of fixed size, each chunk counts its live allocations.
+ * If all objects of the current chunk have been released, for example at the end of an event,
+ * the chunk is reused from its beginning, so in a steady event loop no heap allocation happens at all.
+ * Full chunks are recycled once their last object is released, which may happen on any thread.
+ *
+ * There's one arena per thread, use ArenaAllocator or make_arena_shared to allocate from it.
+ */
+class MemoryArena {
+public:
+    static constexpr std::size_t ChunkSize = 64*1024;
+    /// larger allocations go directly to the heap
+    static constexpr std::size_t MaxSmallSize = ChunkSize/8;
+
+    static MemoryArena& Get();
+
+    void* allocate(std::size_t size);
+    static void deallocate(void* p, std::size_t size) noexcept;
+
+    /// number of released chunks kept for reuse by any arena
+    static constexpr std::size_t MaxFreeChunks = 256;
+
+    /**
+     * @brief Number of chunks allocated from the heap by any arena so far, for testing and benchmarking
+     */
+    static std::size_t GetTotalChunks() { return totalChunks; }
+
+    MemoryArena() = default;
+    ~MemoryArena();
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+    MemoryArena(MemoryArena&&) = delete;
+    MemoryArena& operator=(MemoryArena&&) = delete;
+
+private:
+    struct chunk_t {
+        // one reference is held by the owning arena as long as the chunk is current
+        std::atomic<std::size_t> refs;
+        std::size_t used;
+    };
+    static_assert(sizeof(chunk_t) <= alignof(std::max_align_t)*2, "Chunk header too large");
+
+    static constexpr std::size_t HeaderSize = alignof(std::max_align_t)*2;
+
+    chunk_t* current = nullptr;
+
+    static chunk_t* NewChunk();
+    static void Release(chunk_t* chunk) noexcept;
+
+    static std::atomic<std::size_t> totalChunks;
+};
+
+/**
+ * @brief Standard conforming allocator using the thread's MemoryArena
+ */
+template<typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    ArenaAllocator() noexcept = default;
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        const auto size = n*sizeof(T);
+        if(size > MemoryArena::MaxSmallSize)
+            return static_cast<T*>(::operator new(size));
+        return static_cast<T*>(MemoryArena::Get().allocate(size));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        const auto size = n*sizeof(T);
+        if(size > MemoryArena::MaxSmallSize)
+            ::operator delete(p);
+        else
+            MemoryArena::deallocate(p, size);
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+};
+
+/**
+ * @brief make_arena_shared is a drop-in replacement for std::make_shared using the MemoryArena
+ */
+template<typename T, typename... Args>
+std::shared_ptr<T> make_arena_shared(Args&&... args) {
+    return std::allocate_shared<T>(ArenaAllocator<T>(), std::forward<Args>(args)...);
+}
+
+}
@@ -244,6 +244,16 @@ public:
         is_sorted = true;
     }
 
+    /**
+     * @brief SetSorted marks the tree as sorted without sorting,
+     * for trees which are built with their daughters already in sorted order
+     */
+    void SetSorted() {
+        for(auto& d : daughters)
+            d->SetSorted();
+        is_sorted = true;
+    }
+
     template<typename U, typename Compare>
     bool IsEqual(const snode_t<U>& other, Compare comp) const {
         // check daughters first (depth-first recursion)
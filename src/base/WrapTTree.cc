@@ -6,10 +6,38 @@
 
 #include "TBufferFile.h"
 #include "TLeaf.h"
+#include "TEnv.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
 
 using namespace std;
 using namespace ant;
 
+namespace {
+
+// GetEntry() may be called by readers on their own thread,
+// see PhysicsManager::SetReadAhead
+struct atomic_readStats_t {
+    atomic<long long> Entries{0};
+    atomic<long long> SharedEntries{0};
+    atomic<long long> Bytes{0};
+    atomic<long long> Nanoseconds{0};
+
+    void AddTime(const chrono::steady_clock::time_point& start) {
+        const auto elapsed = chrono::steady_clock::now() - start;
+        Nanoseconds += chrono::duration_cast<chrono::nanoseconds>(elapsed).count();
+    }
+    void AddBytes(Long64_t nbytes) {
+        if(nbytes>0)
+            Bytes += nbytes;
+    }
+} readStats;
+
+}
+
 void WrapTTree::CreateBranches(TTree* tree, bool skipOptional) {
     // some checks first
     if(tree==nullptr)
@@ -55,21 +83,136 @@ struct WrapTTree::ROOTArrayNotifier_t : TObject {
     }
 };
 
+struct WrapTTree::SharedTree_t {
+    const TTree* Tree;
+
+    // last entry read completely by GetEntry() of some user
+    Long64_t ReadEntry = -1;
+    Long64_t ReadBytes = 0;
+    const WrapTTree* ReadBy = nullptr;
+
+    // the first instance linking a branch owns it, the others follow
+    struct link_t {
+        WrapTTree* Owner;
+        std::size_t Index;
+        std::vector<std::pair<WrapTTree*, std::size_t>> Followers;
+    };
+    std::map<std::string, link_t> Links; // by full branch name
+    std::vector<WrapTTree*> Users;
+
+    explicit SharedTree_t(const TTree* tree) : Tree(tree) {}
+
+    static std::map<const TTree*, SharedTree_t>& Registry() {
+        static std::map<const TTree*, SharedTree_t> registry;
+        return registry;
+    }
+    static std::mutex& Mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+};
+
+void WrapTTree::Share()
+{
+    lock_guard<mutex> lock(SharedTree_t::Mutex());
+    auto& registry = SharedTree_t::Registry();
+    auto it_shared = registry.find(Tree);
+    if(it_shared == registry.end())
+        it_shared = registry.emplace(Tree, SharedTree_t(Tree)).first;
+    sharedTree = addressof(it_shared->second);
+    sharedTree->Users.push_back(this);
+}
+
+void WrapTTree::Unshare()
+{
+    lock_guard<mutex> lock(SharedTree_t::Mutex());
+    auto& shared = *sharedTree;
+    sharedTree = nullptr;
+
+    for(auto it_link = shared.Links.begin(); it_link != shared.Links.end(); ) {
+        auto& link = it_link->second;
+        auto& followers = link.Followers;
+        followers.erase(remove_if(followers.begin(), followers.end(),
+                                  [this] (const pair<WrapTTree*, size_t>& f) { return f.first == this; }),
+                        followers.end());
+        if(link.Owner != this) {
+            ++it_link;
+            continue;
+        }
+        if(followers.empty()) {
+            it_link = shared.Links.erase(it_link);
+            continue;
+        }
+        // first follower takes over, our values are already gone
+        auto& owner = *followers.front().first;
+        const auto& b = owner.branches[followers.front().second];
+        link.Owner = followers.front().first;
+        link.Index = followers.front().second;
+        followers.erase(followers.begin());
+        *b.ValuePtr = b.OwnValue;
+        for(auto& f : followers)
+            *f.first->branches[f.second].ValuePtr = b.OwnValue;
+        owner.SetAddress(b, it_link->first);
+        shared.ReadEntry = -1;
+        ++it_link;
+    }
+
+    if(shared.ReadBy == this)
+        shared.ReadBy = nullptr;
+
+    // keep the chain of notifiers intact
+    for(auto user : shared.Users) {
+        if(user->ROOTArrayNotifier->PrevNotifier == ROOTArrayNotifier.get())
+            user->ROOTArrayNotifier->PrevNotifier = ROOTArrayNotifier->PrevNotifier;
+    }
+
+    shared.Users.erase(remove(shared.Users.begin(), shared.Users.end(), this), shared.Users.end());
+    if(shared.Users.empty())
+        SharedTree_t::Registry().erase(shared.Tree);
+}
+
+bool WrapTTree::FollowBranch(size_t index, const string& branchname)
+{
+    auto it_link = sharedTree->Links.find(branchname);
+    if(it_link == sharedTree->Links.end() || it_link->second.Owner == this)
+        return false;
+    auto& link = it_link->second;
+    const auto& owner_b = link.Owner->branches[link.Index];
+    const auto& b = branches[index];
+    if(*owner_b.TypeInfo != *b.TypeInfo)
+        throw Exception(std_ext::formatter() << "Branch " << b.Name << " is linked with different type by another instance in tree " << Tree->GetName());
+    *b.ValuePtr = *owner_b.ValuePtr;
+    link.Followers.emplace_back(this, index);
+    return true;
+}
+
+void WrapTTree::SetAddress(const ROOT_branch_t& b, const string& branchname)
+{
+    // logic copied from TTree::SetBranchAddress<T>
+    const auto res = b.ROOTClass ?
+                         Tree->SetBranchAddress(branchname.c_str(),b.ValuePtr,0,b.ROOTClass,b.ROOTType,true) :
+                         // the default, some very simple type
+                         Tree->SetBranchAddress(branchname.c_str(),*b.ValuePtr,0,b.ROOTClass,b.ROOTType,false);
+    if(res < TTree::kMatch)
+        throw Exception(std_ext::formatter() << "Cannot set address for branch " << b.Name << " in tree " << Tree->GetName());
+}
+
 void WrapTTree::LinkBranches(TTree* tree, bool requireOptional) {
     if(tree != nullptr)
         Tree = tree;
     if(!Tree)
         throw Exception("Set the Tree pointer (or provide as argument) before calling LinkBranches");
 
-    auto set_branch_address = [] (TTree& t, const ROOT_branch_t& b, const string& branchname)
-    {
-        // logic copied from TTree::SetBranchAddress<T>
-        if(b.ROOTClass) {
-            return t.SetBranchAddress(branchname.c_str(),b.ValuePtr,0,b.ROOTClass,b.ROOTType,true);
-        }
-        // the default, some very simple type
-        return t.SetBranchAddress(branchname.c_str(),*b.ValuePtr,0,b.ROOTClass,b.ROOTType,false);
-    };
+    if(sharedTree && sharedTree->Tree != Tree) {
+        for(auto& b : branches)
+            *b.ValuePtr = b.OwnValue;
+        Unshare();
+    }
+    if(!sharedTree)
+        Share();
+
+    // the links of the shared tree are changed below
+    lock_guard<mutex> lock(SharedTree_t::Mutex());
 
     for(const auto& b : branches) {
         const auto& fullbranchname = branchNamePrefix+b.Name;
@@ -90,18 +233,22 @@ void WrapTTree::LinkBranches(TTree* tree, bool requireOptional) {
         if(!isPresent)
             throw Exception(std_ext::formatter() << "Did not find branch " << b.Name << " in tree " << Tree->GetName());
 
-        // check if this branch has already an address
-        if(rootbranch->GetAddress() != nullptr)
+        // check if this branch has already an address,
+        // which is fine if another instance linked it
+        const size_t index = &b - branches.data();
+        if(rootbranch->GetAddress() != nullptr) {
+            if(!b.IsROOTArray && FollowBranch(index, fullbranchname))
+                continue;
             throw Exception(std_ext::formatter() << "Branch " << b.Name << " already has address set in tree " << Tree->GetName());
+        }
 
         if(b.IsROOTArray) {
             HandleROOTArray(fullbranchname, b.ValuePtr);
             continue;
         }
 
-        const auto res = set_branch_address(*Tree, b, fullbranchname);
-        if(res < TTree::kMatch)
-            throw Exception(std_ext::formatter() << "Cannot set address for branch " << b.Name << " in tree " << Tree->GetName());
+        SetAddress(b, fullbranchname);
+        sharedTree->Links[fullbranchname] = SharedTree_t::link_t{this, index, {}};
     }
 
     // hook notify (important for TChain)
@@ -116,6 +263,137 @@ void WrapTTree::LinkBranches(bool requireOptional)
     LinkBranches(nullptr, requireOptional);
 }
 
+void WrapTTree::EnableReadAhead(Long64_t cacheSize)
+{
+    if(!Tree)
+        throw Exception("Set the Tree pointer before calling EnableReadAhead");
+
+    // prefetching and parallel unzipping are decided
+    // when the TTreeCache is created, so set them up before
+    // (several WrapTTree might read from the same Tree, keep existing cache then)
+    if(Tree->GetCacheSize() != cacheSize) {
+        Tree->SetParallelUnzip(true);
+        Tree->SetCacheSize(cacheSize);
+    }
+
+    // in lazy mode, let the cache learn which branches are actually accessed
+    if(lazy)
+        return;
+
+    // only add branches we actually read
+    for(const auto& b : branches) {
+        if(b.OptionalIsPresent && !*b.OptionalIsPresent)
+            continue;
+        Tree->AddBranchToCache((branchNamePrefix+b.Name).c_str(), true);
+    }
+    Tree->StopCacheLearningPhase();
+}
+
+void WrapTTree::EnableAsyncPrefetching()
+{
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+}
+
+void WrapTTree::EnableLazyLoading()
+{
+    if(!Tree)
+        throw Exception("Set the Tree pointer before calling EnableLazyLoading");
+    lazy = true;
+    // TChain switches to the next TTree, so branches need to be found again
+    ROOTArrayNotifier->LoadNotifiers.emplace_back([this] () {
+        for(auto& b : branches)
+            b.ROOTBranch = nullptr;
+    });
+}
+
+void WrapTTree::LoadBranch(std::size_t index) const
+{
+    const auto& b = branches[index];
+    if(b.LoadedGeneration == lazyGeneration)
+        return;
+    b.LoadedGeneration = lazyGeneration;
+    if(lazyLocalEntry < 0)
+        return;
+
+    if(!b.ROOTBranch) {
+        b.ROOTBranch = Tree->GetBranch((branchNamePrefix+b.Name).c_str());
+        // optional branch not present
+        if(!b.ROOTBranch)
+            return;
+    }
+
+    // the branch values might be shared with other instances
+    unique_lock<mutex> lock;
+    if(sharedTree)
+        lock = unique_lock<mutex>(SharedTree_t::Mutex());
+
+    const auto start = chrono::steady_clock::now();
+    const auto nbytes = b.ROOTBranch->GetEntry(lazyLocalEntry);
+    readStats.AddTime(start);
+    readStats.AddBytes(nbytes);
+}
+
+Long64_t WrapTTree::GetEntry(Long64_t entry)
+{
+    // checking and reading the entry must not interleave
+    // with another instance linked to the same tree
+    unique_lock<mutex> lock;
+    if(sharedTree)
+        lock = unique_lock<mutex>(SharedTree_t::Mutex());
+
+    // another instance linked to this tree read the entry already,
+    // and nobody read another entry since then
+    const bool alreadyRead = sharedTree && sharedTree->ReadEntry == entry
+                             && sharedTree->ReadBy != this
+                             && Tree->GetReadEntry() == entry;
+
+    if(lazy) {
+        const auto start = chrono::steady_clock::now();
+        // might notify about a new TTree in TChain
+        lazyLocalEntry = Tree->LoadTree(entry);
+        readStats.AddTime(start);
+        readStats.Entries++;
+        lazyGeneration++;
+        if(alreadyRead) {
+            readStats.SharedEntries++;
+            for(auto& b : branches)
+                b.LoadedGeneration = lazyGeneration;
+        }
+        else if(sharedTree) {
+            // loading branches lazily changes shared values
+            sharedTree->ReadEntry = -1;
+        }
+        return lazyLocalEntry < 0 ? 0 : 1;
+    }
+
+    readStats.Entries++;
+    if(alreadyRead) {
+        readStats.SharedEntries++;
+        return sharedTree->ReadBytes;
+    }
+
+    const auto start = chrono::steady_clock::now();
+    const auto nbytes = Tree->GetEntry(entry);
+    readStats.AddTime(start);
+    readStats.AddBytes(nbytes);
+    if(sharedTree) {
+        sharedTree->ReadEntry = nbytes > 0 ? entry : -1;
+        sharedTree->ReadBytes = nbytes;
+        sharedTree->ReadBy = this;
+    }
+    return nbytes;
+}
+
+WrapTTree::ReadStats_t WrapTTree::GetReadStats()
+{
+    ReadStats_t stats;
+    stats.Entries = readStats.Entries;
+    stats.SharedEntries = readStats.SharedEntries;
+    stats.Bytes = readStats.Bytes;
+    stats.Seconds = readStats.Nanoseconds*1e-9;
+    return stats;
+}
+
 bool WrapTTree::Matches(TTree* tree, bool exact, bool nowarn) const {
     if(tree == nullptr)
         tree = Tree;
@@ -168,12 +446,17 @@ bool WrapTTree::CopyFrom(const WrapTTree& src) {
 
     // copy branches by name
     for(const ROOT_branch_t& src_b : src.branches) {
+        if(src.lazy)
+            src.LoadBranch(&src_b - src.branches.data());
         auto it_b = std::find(branches.begin(), branches.end(), src_b.Name);
         // src branch not found in our list of branches
         if(it_b == branches.end())
             return false;
         if(it_b->ROOTType != src_b.ROOTType)
             return false;
+        // copied value should not be overwritten by lazy loading
+        if(lazy)
+            it_b->LoadedGeneration = lazyGeneration;
         // for complex types, we rely on the ROOT machinery to copy them
         if(src_b.ROOTType == kOther_t) {
             if(it_b->ROOTClass != src_b.ROOTClass)
@@ -206,7 +489,9 @@ WrapTTree::~WrapTTree()
     // Fix: Change order of initialization/destruction of WrapTFileInput and WrapTTree
     // (see UnpackerA2Geant as example, commit d7efcda8f)
     if(Tree && Tree->GetNotify() == ROOTArrayNotifier.get())
-        Tree->SetNotify(0);
+        Tree->SetNotify(ROOTArrayNotifier->PrevNotifier);
+    if(sharedTree)
+        Unshare();
 }
 
 void WrapTTree::HandleROOTArray(const std::string& branchname, void** valuePtr)
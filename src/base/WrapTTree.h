@@ -6,6 +6,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <typeinfo>
 
 namespace ant {
 
@@ -45,6 +46,16 @@ namespace ant {
  *
  * Note that WrapTTree even supports branches created with "branchname[sizebranch]" via
  * `WrapTTree::ROOTArray<T>`, which wraps it into an conviniently usable `std::vector<T>`
+ *
+ * If only some branches are used for most entries, `EnableLazyLoading()` after `LinkBranches()`
+ * lets `GetEntry()` read a branch only when it is accessed for the first time in this entry.
+ *
+ * Several instances may link the same TTree, for example several plotters reading one input file.
+ * A branch linked by more than one instance is shared, all see the value of the first instance
+ * linking it. The entry is then read only once by the first `GetEntry()`, the other instances
+ * linking this TTree get it without reading again. So treat the values as read-only then.
+ * Linking and reading entries of a shared TTree is serialized by a lock, so the instances
+ * may live in different threads, but the values must not be accessed while another instance reads.
  */
 class WrapTTree {
 public:
@@ -64,11 +75,63 @@ public:
      * @brief LinkBranches prepares the instance for reading the TTree
      * @param tree the tree to read from, or use already set Tree class member
      * @param requireOptional if true, do not ignore ADD_BRANCH_OPT_T branches silently
+     *
+     * Branches already linked by another instance are shared with it, see class description.
+     * ROOTArray branches cannot be shared.
      */
     void LinkBranches(TTree* tree = nullptr, bool requireOptional = false);
     // to avoid bogus LinkBranchs(nullptr, true) call
     void LinkBranches(bool requireOptional);
 
+    /**
+     * @brief EnableReadAhead sets up a TTreeCache holding only the linked branches
+     * @param cacheSize size of the cache in bytes
+     *
+     * Call after LinkBranches(). Upcoming baskets are read in large chunks
+     * and decompressed in parallel, so reading via GetEntry() mostly waits less for I/O.
+     * See also EnableAsyncPrefetching().
+     */
+    void EnableReadAhead(Long64_t cacheSize = 32 << 20);
+
+    /**
+     * @brief EnableAsyncPrefetching lets the caches of EnableReadAhead() prefetch on a separate thread
+     *
+     * Changes the global ROOT configuration (gEnv), so programs opt in
+     * by calling it once in main() before opening the input files.
+     */
+    static void EnableAsyncPrefetching();
+
+    /**
+     * @brief EnableLazyLoading makes GetEntry() only select the entry, branches are read on first access
+     *
+     * Call after LinkBranches(). Then only read entries via GetEntry() of this instance,
+     * and do not keep references to branch values across entries.
+     * If combined with EnableReadAhead(), the cache learns the accessed branches.
+     */
+    void EnableLazyLoading();
+
+    /**
+     * @brief GetEntry reads the given entry of Tree and accounts the time spent in ReadStats
+     * @param entry the entry number to read
+     * @return number of bytes read, as returned by TTree::GetEntry
+     *
+     * In lazy mode, returns 1 if the entry exists and the bytes are accounted once branches are read.
+     * If another instance linked to the same TTree has read this entry already, nothing is read.
+     */
+    Long64_t GetEntry(Long64_t entry);
+
+    /**
+     * @brief The ReadStats_t struct sums up GetEntry() calls of all WrapTTree instances
+     * @note GetReadStats() returns a snapshot, the sums are safely updated from several threads
+     */
+    struct ReadStats_t {
+        long long Entries = 0;
+        long long SharedEntries = 0; // entries already read by another instance linked to the same TTree
+        long long Bytes = 0;
+        double    Seconds = 0;
+    };
+    static ReadStats_t GetReadStats();
+
     /**
      * @brief Matches checks if the branch names are all available
      * @param tree the tree to check
@@ -97,6 +160,8 @@ public:
         Branch_t(WrapTTree& wraptree, const std::string& name, bool* optionalIsPresent,
                  Args&&... args) :
             Name(name),
+            WrapTree(wraptree),
+            Index(wraptree.branches.size()),
             // can't use unique_ptr because of std::addressof below
             Value(new T(std::forward<Args>(args)...))
         {
@@ -113,12 +178,16 @@ public:
                                   TClass::GetClass(typeid(T)),
                                   TDataType::GetType(typeid(T)),
                                   reinterpret_cast<void**>(std::addressof(Value.Ptr)),
+                                  Value.Own,
+                                  typeid(T),
                                   std::is_base_of<ROOTArray_traits, T>::value,
                                   optionalIsPresent);
         }
         ~Branch_t() = default;
         Branch_t(const Branch_t&) = delete;
         Branch_t& operator= (const Branch_t& other) {
+            Load();
+            other.Load();
             *Value = *(other.Value);
             return *this;
         }
@@ -128,27 +197,35 @@ public:
         const std::string Name;
 
         // implicit conversion
-        operator T& () { return *Value; }
-        operator const T& () const { return *Value; }
+        operator T& () { Load(); return *Value; }
+        operator const T& () const { Load(); return *Value; }
         // assignment/move
-        T& operator= (const T& v) { *Value = v; return *Value; }
-        T& operator= (T&& v) { *Value = std::move(v); return *Value; }
+        T& operator= (const T& v) { Load(); *Value = v; return *Value; }
+        T& operator= (T&& v) { Load(); *Value = std::move(v); return *Value; }
         // if you need to call methods of T, sometimes operator() is handy
-        T& operator() () { return *Value; }
-        const T& operator() () const { return *Value; }
+        T& operator() () { Load(); return *Value; }
+        const T& operator() () const { Load(); return *Value; }
         // subscript access for more convenient access
         // templated to use SFINAE for typedefs T::reference, T::const_reference
         template<typename U = T>
-        typename U::reference operator[](std::size_t n) { return (*Value)[n]; }
+        typename U::reference operator[](std::size_t n) { Load(); return (*Value)[n]; }
         template<typename U = T>
-        typename U::const_reference operator[](std::size_t n) const { return (*Value)[n]; }
+        typename U::const_reference operator[](std::size_t n) const { Load(); return (*Value)[n]; }
     private:
+        const WrapTTree& WrapTree;
+        const std::size_t Index;
+
+        void Load() const {
+            if(WrapTree.lazy)
+                WrapTree.LoadBranch(Index);
+        }
+
         struct Value_t {
-            explicit Value_t(T* ptr) : Ptr(ptr) {}
+            explicit Value_t(T* ptr) : Own(ptr), Ptr(ptr) {}
             T& operator* () { return *Ptr; }
             const T& operator* () const { return *Ptr; }
             ~Value_t() {
-                delete Ptr;
+                delete Own;
             }
             // forbid copy/move completely
             Value_t(const Value_t&) = delete;
@@ -156,7 +233,8 @@ public:
             Value_t(Value_t&&);
             Value_t& operator=(Value_t&&) = delete;
             // access by Branch_t ctor
-            T* Ptr;
+            T* const Own;
+            T* Ptr; // differs from Own if shared with another WrapTTree
         };
         Value_t Value;
     };
@@ -268,17 +346,27 @@ private:
 
     struct ROOT_branch_t : ROOT_branchinfo_t {
         void** const ValuePtr;
+        void* const OwnValue;
+        const std::type_info* const TypeInfo;
         const bool IsROOTArray;
         bool* const OptionalIsPresent; // is nullptr if branch non-optional
 
+        // state for lazy loading, see WrapTTree::LoadBranch
+        mutable TBranch* ROOTBranch = nullptr;
+        mutable Long64_t LoadedGeneration = -1;
+
         ROOT_branch_t(const std::string& name,
                       TClass* rootClass,
                       EDataType rootType,
                       void** valuePtr,
+                      void* ownValue,
+                      const std::type_info& typeInfo,
                       bool isROOTArray,
                       bool* optionalIsPresent) :
             ROOT_branchinfo_t(name, rootClass, rootType),
             ValuePtr(valuePtr),
+            OwnValue(ownValue),
+            TypeInfo(std::addressof(typeInfo)),
             IsROOTArray(isROOTArray),
             OptionalIsPresent(optionalIsPresent)
         {
@@ -292,9 +380,22 @@ private:
     const std::string branchNamePrefix;
     std::vector<ROOT_branch_t> branches;
 
+    bool lazy = false;
+    Long64_t lazyGeneration = 0; // incremented by each GetEntry
+    Long64_t lazyLocalEntry = -1;
+    void LoadBranch(std::size_t index) const;
+
     struct ROOTArrayNotifier_t;
     const std::unique_ptr<ROOTArrayNotifier_t> ROOTArrayNotifier;
     void HandleROOTArray(const std::string& branchname, void** valuePtr);
+
+    // instances linked to the same TTree share branch values and entry reads
+    struct SharedTree_t;
+    SharedTree_t* sharedTree = nullptr;
+    void Share();
+    void Unshare();
+    bool FollowBranch(std::size_t index, const std::string& branchname);
+    void SetAddress(const ROOT_branch_t& b, const std::string& branchname);
 };
 
 }
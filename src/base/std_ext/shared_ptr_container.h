@@ -1,5 +1,7 @@
 #pragma once
 
+#include "base/MemoryArena.h"
+
 #include <vector>
 #include <memory>
 #include <functional>
@@ -196,7 +198,8 @@ public:
     template<class... Args>
     void emplace_back(Args&&... args)
     {
-        c.emplace_back(std::make_shared<T>(std::forward<Args>(args)...));
+        // items typically live for one event only
+        c.emplace_back(make_arena_shared<T>(std::forward<Args>(args)...));
     }
 
     template<class it_t>
@@ -5,6 +5,8 @@
 #include "TF1.h"
 #include "TMath.h"
 
+#include <algorithm>
+
 using namespace std;
 
 using namespace ant::calibration::functions;
@@ -19,6 +21,16 @@ double gaus::fct(double *x, double *p)
     return p[0]*exp( - ant::std_ext::sqr(x[0]-p[1]) / (2 * ant::std_ext::sqr(p[2])) );
 }
 
+void gaus::grad(double* x, double* p, double* g)
+{
+    const auto dx = x[0]-p[1];
+    const auto s2 = ant::std_ext::sqr(p[2]);
+    const auto e = exp( - ant::std_ext::sqr(dx) / (2 * s2) );
+    g[0] = e;
+    g[1] = p[0]*e*dx/s2;
+    g[2] = p[0]*e*ant::std_ext::sqr(dx)/(s2*p[2]);
+}
+
 TF1* gaus::getTF1()
 {
     return helper::makeTF1(fct, 3); // new TF1("",fct,0,1,3);
@@ -34,6 +46,23 @@ double timewalk::fct(double* x, double* p)
             p[p::Scale]*std::exp(-p[p::Exp]*x_shift - p[p::Pow]*std::log(x_shift));
 }
 
+void timewalk::grad(double* x, double* p, double* g)
+{
+    const auto x_shift = x[0]-p[p::E0];
+    if(x_shift<=0) {
+        std::fill(g, g+6, 0.0);
+        return;
+    }
+    const auto log_shift = std::log(x_shift);
+    const auto e = std::exp(-p[p::Exp]*x_shift - p[p::Pow]*log_shift);
+    g[p::Offset] = 1;
+    g[p::Slope]  = x_shift;
+    g[p::Scale]  = e;
+    g[p::Exp]    = -x_shift*p[p::Scale]*e;
+    g[p::Pow]    = -log_shift*p[p::Scale]*e;
+    g[p::E0]     = -p[p::Slope] + p[p::Scale]*e*(p[p::Exp] + p[p::Pow]/x_shift);
+}
+
 TF1* timewalk::getTF1()
 {
     return helper::makeTF1(fct, 6);
@@ -49,6 +78,25 @@ TF1* exponential::getTF1()
     return helper::makeTF1(fct, 3);
 }
 
+double vetoband::fct(double* x, double* p)
+{
+    return p[0]*std::pow(p[1], p[2]-x[0]) + p[3];
+}
+
+void vetoband::grad(double* x, double* p, double* g)
+{
+    const auto b = std::pow(p[1], p[2]-x[0]);
+    g[0] = b;
+    g[1] = p[0]*(p[2]-x[0])*b/p[1];
+    g[2] = p[0]*b*std::log(p[1]);
+    g[3] = 1;
+}
+
+TF1* vetoband::getTF1()
+{
+    return helper::makeTF1(fct, 4);
+}
+
 double landau::fct(double *x, double *p)
 {
     return p[0]*TMath::Landau(x[0], p[1], p[2], false);
@@ -90,9 +138,17 @@ template double pol<2>::fct(double *x, double *p);
 template double pol<3>::fct(double *x, double *p);
 template double pol<4>::fct(double *x, double *p);
 
+template void pol<2>::grad(double *x, double *p, double *g);
+template void pol<3>::grad(double *x, double *p, double *g);
+template void pol<4>::grad(double *x, double *p, double *g);
+
 template double GausPol<2>::fct(double *x, double *p);
 template double GausPol<3>::fct(double *x, double *p);
 template double GausPol<4>::fct(double *x, double *p);
 
+template void GausPol<2>::grad(double *x, double *p, double *g);
+template void GausPol<3>::grad(double *x, double *p, double *g);
+template void GausPol<4>::grad(double *x, double *p, double *g);
+
 template double WeibullLandauPol<1>::fct(double *x, double *p);
 template double WeibullLandauPol<2>::fct(double *x, double *p);
@@ -12,11 +12,13 @@ struct helper {
 
 struct gaus {
     static double fct(double* x, double* p);
+    static void grad(double* x, double* p, double* g);
     static TF1* getTF1();
 };
 
 struct timewalk {
     static double fct(double* x, double* p);
+    static void grad(double* x, double* p, double* g);
     static TF1* getTF1();
     struct p {
         constexpr static auto Offset = 0;
@@ -33,6 +35,15 @@ struct exponential {
     static TF1* getTF1();
 };
 
+/**
+ * @brief Exponential falling band of the Veto, p[0]*p[1]^(p[2]-x) + p[3]
+ */
+struct vetoband {
+    static double fct(double* x, double* p);
+    static void grad(double* x, double* p, double* g);
+    static TF1* getTF1();
+};
+
 /**
  * @brief Weibull density function
  *
@@ -69,8 +80,16 @@ struct pol {
         return res;
     }
 
+    static void grad(double* x, double*, double* g) {
+        double mult = 1;
+        for(unsigned i=0; i<=order; ++i) {
+            g[i] = mult;
+            mult *= x[0];
+        }
+    }
+
     static TF1* getTF1() {
-        return helper::makeTF1(pol<order>::fct,order+1);
+        return helper::makeTF1(pol<order>::fct, order+1);
     }
 };
 
@@ -83,8 +102,13 @@ struct GausPol {
         return gaus::fct(x, &p[0]) + pol<order>::fct(x,&p[3]);
     }
 
+    static void grad(double *x, double *p, double* g) {
+        gaus::grad(x, &p[0], &g[0]);
+        pol<order>::grad(x, &p[3], &g[3]);
+    }
+
     static TF1* getTF1() {
-        return helper::makeTF1(GausPol<order>::fct,order+4); // gaus: 3 pramams, pol: order + 1
+        return helper::makeTF1(GausPol<order>::fct, order+4); // gaus: 3 pramams, pol: order + 1
     }
 };
 
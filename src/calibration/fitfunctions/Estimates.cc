@@ -0,0 +1,223 @@
+#include "Estimates.h"
+
+#include "TH1.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace ant;
+using namespace ant::calibration::functions;
+
+namespace {
+
+struct point_t {
+    double X;
+    double Y;
+    double W; // 1/sigma^2 of Y
+};
+
+// non-empty bins with center in range
+vector<point_t> getPoints(const TH1* hist, const interval<double>& range)
+{
+    vector<point_t> points;
+    const auto axis = hist->GetXaxis();
+    const int first = max(1, axis->FindFixBin(range.Start()));
+    const int last  = min(hist->GetNbinsX(), axis->FindFixBin(range.Stop()));
+    if(last >= first)
+        points.reserve(unsigned(last-first+1));
+    for(int bin=first; bin<=last; ++bin) {
+        const auto x = axis->GetBinCenter(bin);
+        if(!range.Contains(x))
+            continue;
+        const auto y = hist->GetBinContent(bin);
+        const auto err = hist->GetBinError(bin);
+        if(y == 0 && err == 0)
+            continue;
+        points.push_back({x, y, err > 0 ? 1.0/std_ext::sqr(err) : 1.0});
+    }
+    return points;
+}
+
+// solve symmetric A*x = b with partial pivoting, A is n x n row-major, false if singular
+bool solve(vector<double>& A, vector<double>& b, vector<double>& x)
+{
+    const auto n = b.size();
+    double tiny = 0;
+    for(size_t i=0; i<n; ++i)
+        tiny = max(tiny, abs(A[i*n+i]));
+    tiny *= 1e-12;
+    for(size_t col=0; col<n; ++col) {
+        size_t pivot = col;
+        for(size_t row=col+1; row<n; ++row)
+            if(abs(A[row*n+col]) > abs(A[pivot*n+col]))
+                pivot = row;
+        if(!(abs(A[pivot*n+col]) > tiny))
+            return false;
+        if(pivot != col) {
+            swap_ranges(next(A.begin(), col*n), next(A.begin(), (col+1)*n), next(A.begin(), pivot*n));
+            swap(b[col], b[pivot]);
+        }
+        for(size_t row=col+1; row<n; ++row) {
+            const auto f = A[row*n+col]/A[col*n+col];
+            for(size_t k=col; k<n; ++k)
+                A[row*n+k] -= f*A[col*n+k];
+            b[row] -= f*b[col];
+        }
+    }
+    x.assign(n, 0);
+    for(size_t i=n; i-- > 0;) {
+        double sum = b[i];
+        for(size_t k=i+1; k<n; ++k)
+            sum -= A[i*n+k]*x[k];
+        x[i] = sum/A[i*n+i];
+    }
+    return true;
+}
+
+}
+
+vector<double> estimate::polynomial(const TH1* hist, const interval<double>& range, unsigned order,
+                                    const interval<double>& exclude, bool logarithmic)
+{
+    const size_t n = order+1;
+
+    // fit in t = (x-center)/scale in [-1,1] to keep the normal equations well conditioned
+    const auto center = range.Center();
+    const auto scale = range.Length() > 0 ? range.Length()/2 : 1.0;
+
+    vector<double> A(n*n, 0.0);
+    vector<double> b(n, 0.0);
+    vector<double> t_pow(2*n-1);
+    size_t nPoints = 0;
+
+    for(auto p : getPoints(hist, range)) {
+        if(exclude.Contains(p.X))
+            continue;
+        if(logarithmic) {
+            if(p.Y <= 0)
+                continue;
+            // sigma of log(y) is sigma_y/y
+            p.W *= std_ext::sqr(p.Y);
+            p.Y = log(p.Y);
+        }
+        const auto t = (p.X-center)/scale;
+        t_pow[0] = 1;
+        for(size_t k=1; k<t_pow.size(); ++k)
+            t_pow[k] = t_pow[k-1]*t;
+        for(size_t i=0; i<n; ++i) {
+            for(size_t j=0; j<n; ++j)
+                A[i*n+j] += p.W*t_pow[i+j];
+            b[i] += p.W*p.Y*t_pow[i];
+        }
+        ++nPoints;
+    }
+
+    vector<double> q;
+    if(nPoints < n || !solve(A, b, q))
+        return {};
+
+    // expand sum_k q_k ((x-center)/scale)^k into monomials of x
+    vector<double> coefficients(n, 0.0);
+    vector<double> binomial{1.0};
+    for(size_t k=0; k<n; ++k) {
+        if(k>0) {
+            // next row of Pascal's triangle
+            binomial.push_back(1.0);
+            for(size_t j=k-1; j>0; --j)
+                binomial[j] += binomial[j-1];
+        }
+        const auto q_k = q[k]/pow(scale, k);
+        for(size_t j=0; j<=k; ++j)
+            coefficients[j] += q_k*binomial[j]*pow(-center, k-j);
+    }
+    return coefficients;
+}
+
+double estimate::eval(const vector<double>& p, double x)
+{
+    double res = 0;
+    for(auto it = p.rbegin(); it != p.rend(); ++it)
+        res = res*x + *it;
+    return res;
+}
+
+bool estimate::peak_t::IsValid() const
+{
+    return isfinite(Height) && isfinite(Position) && isfinite(Sigma)
+            && Height > 0 && FWHM > 0;
+}
+
+estimate::peak_t estimate::peak(const TH1* hist, const interval<double>& range, const background_t& bg)
+{
+    peak_t peak{std_ext::NaN, std_ext::NaN, std_ext::NaN, std_ext::NaN};
+
+    auto points = getPoints(hist, range);
+    if(points.empty())
+        return peak;
+    if(bg) {
+        for(auto& p : points)
+            p.Y -= bg(p.X);
+    }
+
+    const auto it_max = max_element(points.begin(), points.end(),
+                                    [] (const point_t& a, const point_t& b) { return a.Y < b.Y; });
+    peak.Height = it_max->Y;
+    if(!(peak.Height > 0))
+        return peak;
+    const auto half = peak.Height/2;
+
+    // walk down both flanks to half maximum
+    auto left = it_max;
+    while(left != points.begin() && prev(left)->Y > half)
+        --left;
+    auto right = it_max;
+    while(next(right) != points.end() && next(right)->Y > half)
+        ++right;
+
+    auto crossing = [half] (const point_t& outer, const point_t& inner) {
+        return outer.X + (half-outer.Y)*(inner.X-outer.X)/(inner.Y-outer.Y);
+    };
+    const auto x_left  = left  == points.begin()     ? left->X  : crossing(*prev(left), *left);
+    const auto x_right = next(right) == points.end() ? right->X : crossing(*next(right), *right);
+    peak.FWHM = x_right - x_left;
+    if(!(peak.FWHM > 0))
+        // peak within one bin
+        peak.FWHM = hist->GetXaxis()->GetBinWidth(hist->GetXaxis()->FindFixBin(it_max->X));
+    peak.Sigma = peak.FWHM/(2*sqrt(2*log(2)));
+
+    double sum = 0;
+    double sum_x = 0;
+    for(auto it = left; it != next(right); ++it) {
+        sum += it->Y;
+        sum_x += it->Y*it->X;
+    }
+    peak.Position = sum_x/sum;
+
+    return peak;
+}
+
+estimate::peak_bg_t estimate::peakOnPolynomial(const TH1* hist, const interval<double>& range, unsigned order)
+{
+    peak_bg_t result;
+    result.Peak = peak(hist, range);
+
+    // the first estimate without background underestimates the width on a high background,
+    // so refine once more with the improved peak
+    for(int i=0; i<2 && result.Peak.IsValid(); ++i) {
+        const auto exclude = interval<double>::CenterWidth(result.Peak.Position, 6*result.Peak.Sigma);
+        auto background = polynomial(hist, range, order, exclude);
+        if(background.empty())
+            break;
+        result.Background = move(background);
+        const auto& bg = result.Background;
+        const auto refined = peak(hist, range, [&bg] (double x) { return eval(bg, x); });
+        if(!refined.IsValid())
+            break;
+        result.Peak = refined;
+    }
+
+    if(result.Background.empty())
+        result.Background.assign(order+1, 0.0);
+    return result;
+}
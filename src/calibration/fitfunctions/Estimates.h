@@ -0,0 +1,76 @@
+#pragma once
+
+#include "base/interval.h"
+#include "base/std_ext/math.h"
+
+#include <functional>
+#include <vector>
+
+class TH1;
+
+namespace ant {
+namespace calibration {
+namespace functions {
+
+/**
+ * @brief Analytic start values for the fit functions, calculated directly from the histogram
+ *
+ * Start values close to the minimum let the minimizer converge in fewer calls,
+ * and make the fit of a channel independent of the channel fitted before.
+ * Nothing in here calls the minimizer.
+ */
+struct estimate {
+
+    using background_t = std::function<double(double)>;
+
+    /**
+     * @brief Weighted linear least squares fit of a polynomial to the bin contents
+     * @param hist the histogram, empty bins are ignored as in the chi^2 fit
+     * @param range only bins with center in range are used
+     * @param order of the polynomial
+     * @param exclude bins with center in exclude are ignored, for example the peak region
+     * @param logarithmic fit log(content) instead, for exponential backgrounds
+     * @return coefficients p_0, p_1, ... of p_0 + p_1*x + ..., empty if there are too few bins
+     */
+    static std::vector<double> polynomial(const TH1* hist, const interval<double>& range, unsigned order,
+                                          const interval<double>& exclude = {std_ext::NaN, std_ext::NaN},
+                                          bool logarithmic = false);
+
+    /// @brief evaluate polynomial with coefficients p at x, zero if p is empty
+    static double eval(const std::vector<double>& p, double x);
+
+    struct peak_t {
+        double Height;   // maximum above background
+        double Position; // centroid of the bins above half maximum
+        double FWHM;
+        double Sigma;    // FWHM/2.3548, as for a Gaussian
+        bool IsValid() const;
+    };
+
+    /**
+     * @brief Find the highest peak from its maximum and its width at half maximum
+     * @param hist the histogram
+     * @param range only bins with center in range are used
+     * @param bg background subtracted from the bin contents before, none if empty
+     * @return the estimated peak, check IsValid() before using it
+     */
+    static peak_t peak(const TH1* hist, const interval<double>& range, const background_t& bg = nullptr);
+
+    struct peak_bg_t {
+        peak_t Peak;
+        std::vector<double> Background; // coefficients as returned by polynomial()
+    };
+
+    /**
+     * @brief Find a peak on top of a polynomial background
+     *
+     * The background is fitted to the bins outside +-3 sigma of the peak,
+     * then the peak is estimated again above this background.
+     * Background is all zero if it can't be fitted.
+     */
+    static peak_bg_t peakOnPolynomial(const TH1* hist, const interval<double>& range, unsigned order);
+};
+
+}
+}
+}
@@ -5,9 +5,11 @@
 #include "base/interval.h"
 #include "base/Logger.h"
 #include "base/std_ext/math.h"
+#include "base/std_ext/memory.h"
 
 #include "TF1.h"
 #include "TH1.h"
+#include "TFitResult.h"
 
 #include <algorithm>
 
@@ -15,6 +17,42 @@ using namespace ant;
 using namespace ant::calibration;
 using namespace ant::calibration::gui;
 
+namespace {
+
+/**
+ * @brief Copy of a TF1 providing the analytic gradient in its parameters
+ *
+ * The fitter asks the TF1 for the gradient via the virtual GradientPar. The copy
+ * only lives during FitFunction::doFit, the fit functions themselves stay plain TF1s,
+ * as copies made by Clone() or DrawCopy() could not carry the gradient along.
+ */
+class TF1Gradient : public TF1 {
+public:
+    TF1Gradient(const TF1& func, FitFunction::gradient_t grad_) :
+        TF1(func),
+        grad(grad_)
+    {}
+
+    using TF1::GradientPar;
+
+    virtual void GradientPar(const Double_t* x, Double_t* g, Double_t) override {
+        grad(const_cast<Double_t*>(x), GetParameters(), g);
+    }
+
+    void CopyFitResults(TF1& func) const {
+        func.SetParameters(GetParameters());
+        func.SetParErrors(GetParErrors());
+        func.SetChisquare(GetChisquare());
+        func.SetNumberFitPoints(GetNumberFitPoints());
+        func.SetNDF(GetNDF());
+    }
+
+protected:
+    const FitFunction::gradient_t grad;
+};
+
+}
+
 
 ant::interval<double> FitFunction::getRange(const TF1* func)
 {
@@ -30,7 +68,19 @@ void FitFunction::setRange(TF1* func, const ant::interval<double>& i)
 
 void FitFunction::doFit(TH1* hist)
 {
-    hist->Fit(func,("RBNQ"+AdditionalFitArgs).c_str());
+    std::string options = "RBNQS";
+    std::unique_ptr<TF1Gradient> withGradient;
+    TF1* fitted = func;
+    if(analyticGradient && gradient) {
+        withGradient = std_ext::make_unique<TF1Gradient>(*func, gradient);
+        fitted = withGradient.get();
+        options += "G";
+    }
+    const auto result = hist->Fit(fitted,(options+AdditionalFitArgs).c_str());
+    if(withGradient)
+        withGradient->CopyFitResults(*func);
+    if(result.Get())
+        nCalls += result->NCalls();
 }
 
 void FitFunction::saveTF1(const TF1 *func, SavedState_t &out)
@@ -26,12 +26,17 @@ class FitFunction {
 public:
     using knoblist_t = std::list<std::unique_ptr<IndicatorKnob>>;
     using SavedState_t = std::vector<double>;
+    using gradient_t = void (*)(double* x, double* p, double* g);
 
     std::string AdditionalFitArgs;
 
 protected:
     TF1* func = nullptr;
+    /// analytic gradient of func in its parameters, see functions::gaus::grad, or nullptr
+    gradient_t gradient = nullptr;
     knoblist_t knobs;
+    bool analyticGradient = true;
+    unsigned long nCalls = 0;
 
     template <typename T, typename ... Args_t>
     void AddKnob(Args_t&& ... args) {
@@ -54,6 +59,18 @@ public:
     virtual void FitBackground(TH1*) {}
     void SetAdditionalFitArgs(const std::string& args) { AdditionalFitArgs = args; }
 
+    /**
+     * @brief Use the analytic gradient of the fit function, if it provides one (default)
+     * @param flag false to let the minimizer calculate numerical derivatives
+     */
+    void SetAnalyticGradient(bool flag) { analyticGradient = flag; }
+
+    /**
+     * @brief Number of function calls the minimizer needed for all fits so far
+     * @return sum of calls
+     */
+    unsigned long NCalls() const { return nCalls; }
+
     /**
      * @brief Set/Calculate default parameter values. The hist that will be fitted later is given to allow adaptions
      * @param hist The hist to fit later
@@ -16,6 +16,7 @@ using namespace ant::calibration::gui;
 FitGaus::FitGaus()
 {
     func = functions::gaus::getTF1();
+    gradient = functions::gaus::grad;
     func->SetNpx(1000);
 
     func->SetParName(0,"A");
@@ -3,6 +3,7 @@
 #include "base/interval.h"
 #include "base/Logger.h"
 #include "BaseFunctions.h"
+#include "Estimates.h"
 
 #include "TF1.h"
 #include "TH1.h"
@@ -16,6 +17,7 @@ using namespace ant::calibration::gui;
 FitGausPol0::FitGausPol0()
 {
     func = functions::GausPol<0>::getTF1();
+    gradient = functions::GausPol<0>::grad;
     func->SetNpx(1000);
 
     func->SetParName(0,"A");
@@ -54,6 +56,14 @@ void FitGausPol0::SetDefaults(TH1 *hist)
         SetRange({max_pos-20, max_pos+20});
         func->SetParameter(2,10);
         func->SetParameter(3,0);
+
+        const auto estimate = functions::estimate::peakOnPolynomial(hist, GetRange(), 0);
+        if(estimate.Peak.IsValid()) {
+            func->SetParameter(0, estimate.Peak.Height);
+            func->SetParameter(1, estimate.Peak.Position);
+            func->SetParameter(2, estimate.Peak.Sigma);
+            func->SetParameter(3, estimate.Background[0]);
+        }
     } else {
         func->SetParameter(0,100);
         func->SetParameter(1,100);
@@ -2,6 +2,7 @@
 
 
 #include "BaseFunctions.h"
+#include "Estimates.h"
 
 #include "base/Logger.h"
 
@@ -30,6 +31,7 @@ ant::calibration::gui::FitGausPol1::FitGausPol1()
     bg->SetLineColor(kBlue);
 
     func = functions::GausPol<1>::getTF1();
+    gradient = functions::GausPol<1>::grad;
     func->SetLineColor(kGreen);
 
     SetRange(ant::interval<double>(100,250));
@@ -92,12 +94,25 @@ void gui::FitGausPol1::FitSignal(TH1* hist)
 
 void ant::calibration::gui::FitGausPol1::SetDefaults(TH1 *hist)
 {
+    auto range = GetRange();
+
+    // estimate peak and linear background from the histogram
+    const auto estimate = functions::estimate::peakOnPolynomial(hist, range, 1);
+    if(estimate.Peak.IsValid()) {
+        func->SetParameter(0, estimate.Peak.Height);
+        func->SetParameter(1, range.Clip(estimate.Peak.Position));
+        func->SetParameter(2, estimate.Peak.Sigma);
+        func->SetParameter(3, estimate.Background[0]);
+        func->SetParameter(4, estimate.Background[1]);
+        Sync();
+        return;
+    }
+
     // Amplitude
     func->SetParameter(0, hist->GetMaximum());
     const double max_pos = hist->GetXaxis()->GetBinCenter(hist->GetMaximumBin());
 
     // x0
-    auto range = GetRange();
     func->SetParameter(1, range.Clip(max_pos));
 
     // sigma
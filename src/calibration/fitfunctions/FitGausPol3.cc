@@ -2,6 +2,7 @@
 
 
 #include "BaseFunctions.h"
+#include "Estimates.h"
 
 #include "base/Logger.h"
 
@@ -30,6 +31,7 @@ ant::calibration::gui::FitGausPol3::FitGausPol3()
     bg->SetLineColor(kBlue);
 
     func = functions::GausPol<3>::getTF1();
+    gradient = functions::GausPol<3>::grad;
     func->SetLineColor(kGreen);
 
     SetRange(ant::interval<double>(100,250));
@@ -108,36 +110,30 @@ void ant::calibration::gui::FitGausPol3::SetDefaults(TH1 *hist)
     const auto width = 12.0;
     func->SetParameter(2, width);
 
-    // prefit pol3 without the peak region go get starting values
-    {
-        const auto reject = interval<double>::CenterWidth(pos,4*width);
-        const auto pol3fct = [reject] (double* x, double* p) {
-            if(reject.Contains(x[0]))
-                TF1::RejectPoint(true);
-
-            return calibration::functions::pol<3>::fct(x,p);
-        };
-
-        auto func_pol3 = TF1("", pol3fct,range.Start(),range.Stop(),4);
-        func_pol3.SetParameters(1,1,1,1);
-
-        hist->Fit(addressof(func_pol3), "RBNQ");
-
-        const auto chi2ndf = func_pol3.GetChisquare()/func_pol3.GetNDF();
-        if(chi2ndf < 1e3) {
-            func->SetParameter(3, func_pol3.GetParameter(0));
-            func->SetParameter(4, func_pol3.GetParameter(1));
-            func->SetParameter(5, func_pol3.GetParameter(2));
-            func->SetParameter(6, func_pol3.GetParameter(3));
-        }
-        else {
-            LOG(WARNING) << "Chi2/NDF=" << chi2ndf << " higher than 1e3, resetting bkg params to 0";
-            func->SetParameter(3, 0);
-            func->SetParameter(4, 0);
-            func->SetParameter(5, 0);
-            func->SetParameter(6, 0);
+    // least squares pol3 without the peak region to get starting values
+    const auto reject = interval<double>::CenterWidth(pos,4*width);
+    const auto pol3 = functions::estimate::polynomial(hist, range, 3, reject);
+    if(!pol3.empty()) {
+        for(unsigned i=0;i<pol3.size();i++)
+            func->SetParameter(3+i, pol3[i]);
+
+        // peak above that background, if found where it's expected
+        const auto peak = functions::estimate::peak(hist, range, [&pol3] (double x) {
+            return functions::estimate::eval(pol3, x);
+        });
+        if(peak.IsValid() && reject.Contains(peak.Position)) {
+            func->SetParameter(0, peak.Height);
+            func->SetParameter(1, peak.Position);
+            func->SetParameter(2, peak.Sigma);
         }
     }
+    else {
+        LOG(WARNING) << "Not enough bins outside of peak region, resetting bkg params to 0";
+        func->SetParameter(3, 0);
+        func->SetParameter(4, 0);
+        func->SetParameter(5, 0);
+        func->SetParameter(6, 0);
+    }
 
     Sync();
 }
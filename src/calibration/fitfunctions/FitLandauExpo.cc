@@ -1,6 +1,7 @@
 #include "FitLandauExpo.h"
 
 #include "BaseFunctions.h"
+#include "Estimates.h"
 
 #include "base/TF1Ext.h"
 
@@ -124,11 +125,32 @@ void FitLandauExpo::SetDefaults(TH1 *hist)
         const double max_pos = hist->GetXaxis()->GetBinCenter(hist->GetMaximumBin());
         func->SetParameter(1,max_pos);
         func->SetParameter(3, log(range.Clip(max_pos)));
+        func->SetParameter(4, -0.7);
+
+        // exponential from the tail above the peak, then the Landau above that background
+        const auto coarse = functions::estimate::peak(hist, range);
+        if(coarse.IsValid()) {
+            const interval<double> tail(coarse.Position + coarse.FWHM, range.Stop());
+            const auto expo = functions::estimate::polynomial(hist, tail, 1, {std_ext::NaN, std_ext::NaN}, true);
+            functions::estimate::background_t background;
+            if(!expo.empty() && expo[1] < 0) {
+                func->SetParameter(3, expo[0]);
+                func->SetParameter(4, expo[1]);
+                background = [&expo] (double x) { return std::exp(expo[0] + expo[1]*x); };
+            }
+            const auto peak = functions::estimate::peak(hist, range, background);
+            if(peak.IsValid()) {
+                // the Landau density has FWHM=4.018*sigma and its maximum 0.1805 at the MPV
+                func->SetParameter(2, peak.FWHM/4.018);
+                func->SetParameter(0, peak.Height/0.1805);
+                func->SetParameter(1, range.Clip(MPV_trafo_inverse(peak.Position, func)));
+            }
+        }
     } else {
         func->SetParameter(0,1000);
         func->SetParameter(1,100);
+        func->SetParameter(4, -0.7);
     }
-    func->SetParameter(4, -0.7);
 
     Sync();
 }
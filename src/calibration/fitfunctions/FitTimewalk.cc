@@ -1,6 +1,7 @@
 #include "FitTimewalk.h"
 
 #include "BaseFunctions.h"
+#include "Estimates.h"
 
 #include "base/interval.h"
 #include "base/Logger.h"
@@ -21,6 +22,7 @@ FitTimewalk::FitTimewalk()
 {
     // p[0] + p[5]*x0 +  p[1]*std::exp(-p[4]*x0 - p[3]*std::log(x0));
     func = functions::timewalk::getTF1();
+    gradient = functions::timewalk::grad;
     func->SetNpx(1000);
     func->SetParName(0, "Offset");
     func->SetParName(2, "E_{0}");
@@ -68,7 +70,7 @@ void FitTimewalk::FitBackground(TH1* hist)
     UnFixParameters(func, fixedPars);
 }
 
-void FitTimewalk::SetDefaults(TH1*)
+void FitTimewalk::SetDefaults(TH1* hist)
 {
     using p = functions::timewalk::p;
     func->SetParameter(p::Offset,    0); // Offset
@@ -77,6 +79,18 @@ void FitTimewalk::SetDefaults(TH1*)
     func->SetParameter(p::Pow,     1); // power
     func->SetParameter(p::Exp,     0.5); // exp scale
     func->SetParameter(p::Slope,  0); // linear slope
+
+    if(hist) {
+        // far above E_0, offset and slope dominate
+        // the range might not be set yet, so use the upper half of the histogram
+        const interval<double> upper(hist->GetXaxis()->GetBinCenter(hist->GetNbinsX()/2),
+                                     hist->GetXaxis()->GetXmax());
+        const auto linear = functions::estimate::polynomial(hist, upper, 1);
+        if(!linear.empty()) {
+            func->SetParameter(p::Offset, interval<double>(-100, 100).Clip(linear[0]));
+            func->SetParameter(p::Slope,  interval<double>(-0.5, 0).Clip(linear[1]));
+        }
+    }
 }
 
 void FitTimewalk::EnsureParameterLimits()
@@ -33,7 +33,9 @@ FitVetoBand::FitVetoBand()
     bg = functions::pol<0>::getTF1();
     bg->SetLineColor(kBlue);
 
-    func = new TF1("","[0]*pow([1], [2]-x)+pol0(3)", 0, 1000);
+    func = functions::vetoband::getTF1();
+    gradient = functions::vetoband::grad;
+    setRange(func, {0, 1000});
     func->SetLineColor(kGreen);
     func->SetNpx(1000);
 
@@ -25,10 +25,13 @@ void ExpConfig::Setup::SetByTID(const TID& tid)
         return;
     }
 
-    // go to automatic search mode in all registered setups
+    // go to automatic search mode in all registered setups,
+    // but construct only those which can match by their registered time range
 
     std::list<SetupPtr> setups;
     for(auto setup_name : expconfig::SetupRegistry::GetNames()) {
+        if(!expconfig::SetupRegistry::MayMatch(setup_name, tid.Timestamp))
+            continue;
         setups.emplace_back(expconfig::SetupRegistry::GetSetup(setup_name));
     }
 
@@ -72,6 +72,8 @@ public:
         /**
          * @brief SetByTID automatically search setup by using their Matches() method
          * @param tid TID for searching (usually provided/generated by unpacker)
+         * \note only setups which may match by their registered time range are constructed,
+         * see expconfig::SetupRegistry::MayMatch
          */
         static void SetByTID(const TID& tid);
 
@@ -153,6 +155,8 @@ public:
         double CBESum_Edge  = std_ext::NaN;
         double CBESum_Width = std_ext::NaN;
         std::vector<unsigned> CBESum_MissingElements; // sometimes the analog sum does not include all elements
+        std::vector<double>   CBESum_Weights;         // per channel weight in the sum, channels not given count 1
+        std::vector<double>   CBESum_Thresholds;      // per channel discriminator threshold in MeV, channels not given have none
 
         // may add more fields, for example to specify TAPS multiplicity
     };
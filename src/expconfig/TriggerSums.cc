@@ -0,0 +1,59 @@
+#include "TriggerSums.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace ant;
+using namespace ant::expconfig;
+
+TriggerSums::TriggerSums(const config_t& config)
+{
+    size_t nChannels = max(config.CBESum_Weights.size(), config.CBESum_Thresholds.size());
+    for(auto ch : config.CBESum_MissingElements)
+        nChannels = max<size_t>(nChannels, ch+1);
+
+    cbWeights.assign(nChannels, 1.0);
+    copy(config.CBESum_Weights.begin(), config.CBESum_Weights.end(), cbWeights.begin());
+    for(auto ch : config.CBESum_MissingElements)
+        cbWeights[ch] = 0;
+
+    cbThresholds.assign(nChannels, -numeric_limits<double>::infinity());
+    copy(config.CBESum_Thresholds.begin(), config.CBESum_Thresholds.end(), cbThresholds.begin());
+}
+
+double TriggerSums::CBEnergy(const TDetectorReadHit& readhit) const
+{
+    if(readhit.DetectorType != Detector_t::Type_t::CB)
+        return 0;
+    if(readhit.ChannelType != Channel_t::Type_t::Integral)
+        return 0;
+
+    double weight = 1.0;
+    double threshold = -numeric_limits<double>::infinity();
+    if(readhit.Channel < cbWeights.size()) {
+        weight = cbWeights[readhit.Channel];
+        if(weight == 0)
+            return 0;
+        threshold = cbThresholds[readhit.Channel];
+    }
+
+    // one could also use uncalibrated values
+    // with some fixed constant? or average from all gains?
+    double energy = 0;
+    for(auto& value : readhit.Values) {
+        // NaN values are not rejected by the threshold, as without any threshold
+        if(!(value.Calibrated < threshold))
+            energy += value.Calibrated;
+    }
+    return weight*energy;
+}
+
+TEventData::TriggerSums_t TriggerSums::Calculate(const TEventData& eventdata) const
+{
+    TEventData::TriggerSums_t sums;
+    sums.IsSet = true;
+    sums.CBEnergySum = CBEnergySum(eventdata.DetectorReadHits);
+    sums.CBTiming = CBTiming(eventdata.Clusters);
+    return sums;
+}
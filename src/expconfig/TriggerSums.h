@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ExpConfig.h"
+
+#include "tree/TEventData.h"
+
+#include <vector>
+
+namespace ant {
+namespace expconfig {
+
+/**
+ * @brief The TriggerSums class calculates the detector sums the trigger simulation is based on
+ *
+ * Missing elements, weights and discriminator thresholds of the setup's triggersimu_config_t
+ * are tabulated by channel once, so each read hit costs one lookup.
+ * The reconstruction fills TEventData::TriggerSums with it, the trigger simulation
+ * only calculates them itself for events which were not reconstructed in the same run.
+ */
+class TriggerSums {
+public:
+    using config_t = Setup_traits::triggersimu_config_t;
+
+    explicit TriggerSums(const config_t& config);
+
+    /// @brief weighted contribution of the read hit to the CB energy sum, zero for non-CB Integral hits
+    double CBEnergy(const TDetectorReadHit& readhit) const;
+
+    /// @brief CB energy sum of the given read hits, also accepts references to read hits
+    template<typename ReadHits>
+    double CBEnergySum(const ReadHits& readhits) const {
+        double sum = 0;
+        for(const TDetectorReadHit& readhit : readhits)
+            sum += CBEnergy(readhit);
+        return sum;
+    }
+
+    /// @brief energy weighted timing of the sane CB clusters, NaN if there are none
+    template<typename Clusters>
+    static double CBTiming(const Clusters& clusters) {
+        double TimeEsum = 0.0;
+        double TimeE = 0.0;
+        for(const TCluster& cluster : clusters) {
+            if(cluster.DetectorType != Detector_t::Type_t::CB)
+                continue;
+            // ignore weird clusters
+            if(!cluster.isSane())
+                continue;
+            TimeEsum += cluster.Energy;
+            TimeE += cluster.Energy*cluster.Time;
+        }
+        return TimeE/TimeEsum;
+    }
+
+    /// @brief calculate the sums from the read hits and clusters of the event
+    TEventData::TriggerSums_t Calculate(const TEventData& eventdata) const;
+
+protected:
+    // by channel, channels beyond the tables have weight 1 and no threshold
+    std::vector<double> cbWeights;
+    std::vector<double> cbThresholds;
+};
+
+}
+}
@@ -139,21 +139,28 @@ void TAPS::BuildMappings(
 
 unsigned TAPS::GetRing(const unsigned channel) const
 {
-    const vector< interval<unsigned> > ringRanges = {
-        {0, 0}, {1, 2}, {3, 5}, {6, 9}, {10, 14}, {15, 20},
-        {21, 27}, {28, 35}, {36, 44}, {45, 54}, {55, 63}
-    };
-    assert(ringRanges.size() == 11);
-    // the GetHexChannel is always between 0 and 383
-    // the %64 maps it to the first sector
     constexpr unsigned HexElementsPerSector = NHexElements/NSectors;
-    unsigned hexChannelFirstSector = GetHexChannel(channel) % HexElementsPerSector;
+    // ring of each hex channel within the first sector, built once
+    static const vector<unsigned> rings = [] () {
+        const vector< interval<unsigned> > ringRanges = {
+            {0, 0}, {1, 2}, {3, 5}, {6, 9}, {10, 14}, {15, 20},
+            {21, 27}, {28, 35}, {36, 44}, {45, 54}, {55, 63}
+        };
+        assert(ringRanges.size() == 11);
+        vector<unsigned> table(HexElementsPerSector, 0);
+        for(size_t i=0;i<ringRanges.size();i++) {
+            for(auto hex = ringRanges[i].Start(); hex <= ringRanges[i].Stop(); hex++)
+                table[hex] = i+1; // ring0 is central element (never installed)
+        }
+        return table;
+    }();
 
-    for(size_t i=0;i<ringRanges.size();i++) {
-        if(ringRanges[i].Contains(hexChannelFirstSector))
-            return i+1; // ring0 is central element (never installed)
-    }
-    throw Exception("Cannot find ring for TAPS channel "+to_string(channel));
+    // the GetHexChannel is always between 0 and 383
+    // the %64 maps it to the first sector
+    const unsigned hexChannelFirstSector = GetHexChannel(channel) % HexElementsPerSector;
+    if(rings[hexChannelFirstSector] == 0)
+        throw Exception("Cannot find ring for TAPS channel "+to_string(channel));
+    return rings[hexChannelFirstSector];
 }
 
 unsigned TAPS::GetHexChannel(const unsigned channel) const
@@ -5,6 +5,8 @@
 
 #include "calibration/modules/ClusterCorrection.h"
 
+#include <tuple>
+
 using namespace ant::expconfig;
 
 
@@ -75,6 +77,9 @@ Setup::Setup(const std::string& name, OptionsPtr opts) :
     std::string calibrationDataFolder = std::string(ANT_PATH_DATABASE)+"/"+GetName()+"/calibration";
     calibrationDataManager = std::make_shared<calibration::DataManager>(calibrationDataFolder);
     LOG_IF(includeIgnoredElements, WARNING) << "Including ignored detector elements";
+
+    // registered by AUTO_REGISTER_SETUP_TIMERANGE, or set later by SetTimeRange
+    std::tie(startDate, endDate) = SetupRegistry::GetTimeRange(name);
 }
 
 bool Setup::Matches(const ant::TID& tid) const {
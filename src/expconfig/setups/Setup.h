@@ -133,6 +133,7 @@ protected:
         random.emplace_back(i);
     }
 
+    /// @brief overrides the time range from AUTO_REGISTER_SETUP_TIMERANGE, for setups not constructed by the registry
     void SetTimeRange(const std::string& start, const std::string& end) {
         startDate = start;
         endDate = end;
@@ -4,6 +4,7 @@
 
 #include "base/Logger.h"
 #include "base/std_ext/string.h"
+#include "base/std_ext/time.h"
 
 #include <stdexcept>
 
@@ -41,6 +42,12 @@ void SetupRegistry::RegisterSetup(Creator creator, string name)
     setup_creators[name] = creator;
 }
 
+void SetupRegistry::RegisterSetup(Creator creator, string name, timerange_t timerange)
+{
+    timeranges[name] = timerange;
+    RegisterSetup(creator, name);
+}
+
 SetupRegistry::SetupRegistry() : options(make_shared<const OptionsList>())
 {
 
@@ -65,6 +72,23 @@ list<string> SetupRegistry::GetNames()
     return list;
 }
 
+SetupRegistry::timerange_t SetupRegistry::GetTimeRange(const string& name)
+{
+    auto& timeranges = get_instance().timeranges;
+    auto it_timerange = timeranges.find(name);
+    if(it_timerange == timeranges.end())
+        return {};
+    return it_timerange->second;
+}
+
+bool SetupRegistry::MayMatch(const string& name, const time_t& timestamp)
+{
+    const auto timerange = GetTimeRange(name);
+    if(timerange.first.empty() || timerange.second.empty())
+        return true; // only the constructed setup knows
+    return std_ext::time_between(timestamp, timerange.first, timerange.second);
+}
+
 void SetupRegistry::AddSetup(const string& name, shared_ptr<Setup> setup)
 {
     get_instance().setups[name] = setup;
@@ -81,3 +105,8 @@ SetupRegistration::SetupRegistration(SetupRegistry::Creator creator, string name
 {
     SetupRegistry::get_instance().RegisterSetup(creator, name);
 }
+
+SetupRegistration::SetupRegistration(SetupRegistry::Creator creator, string name, string start, string end)
+{
+    SetupRegistry::get_instance().RegisterSetup(creator, name, {start, end});
+}
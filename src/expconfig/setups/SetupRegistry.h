@@ -6,6 +6,9 @@
 #include <list>
 #include <memory>
 #include <functional>
+#include <string>
+#include <ctime>
+#include <utility>
 
 namespace ant {
 namespace expconfig {
@@ -16,21 +19,29 @@ class Setup;
  * @brief The SetupRegistry class semi-automatically registers Setups
  *
  * \note don't forget to use AUTO_REGISTER_SETUP
+ * \note setups registered with their time range via AUTO_REGISTER_SETUP_TIMERANGE
+ * are only constructed by ExpConfig::Setup::SetByTID if the TID falls into it
  * \note linking order is important to get this registry properly working, see CMakeLists.txt
  */
 class SetupRegistry
 {
 friend class SetupRegistration;
 
+public:
+    using timerange_t = std::pair<std::string, std::string>;
+
 private:
     using Creator = std::function<std::shared_ptr<Setup>(const std::string& name, OptionsPtr)>;
     using setup_creators_t = std::map<std::string, Creator>;
     using setups_t = std::map<std::string, std::shared_ptr<Setup> >;
+    using timeranges_t = std::map<std::string, timerange_t>;
     setup_creators_t setup_creators;
     setups_t setups;
+    timeranges_t timeranges;
     OptionsPtr options;
 
     void RegisterSetup(Creator, std::string);
+    void RegisterSetup(Creator, std::string, timerange_t);
     static SetupRegistry& get_instance();
 
     SetupRegistry();
@@ -38,6 +49,22 @@ private:
 public:
     static std::shared_ptr<Setup> GetSetup(const std::string& name);
     static std::list<std::string> GetNames();
+
+    /**
+     * @brief GetTimeRange of a registered setup
+     * @param name of the setup
+     * @return start and end date as for Setup::SetTimeRange, empty if not registered with a time range
+     */
+    static timerange_t GetTimeRange(const std::string& name);
+
+    /**
+     * @brief MayMatch tells if the setup can match the given timestamp without constructing it
+     * @param name of the setup
+     * @param timestamp of the TID to match
+     * @return false if the setup was registered with a time range not containing timestamp
+     */
+    static bool MayMatch(const std::string& name, const time_t& timestamp);
+
     static void AddSetup(const std::string& name, std::shared_ptr<Setup> setup);
     static void SetSetupOptions(OptionsPtr opt);
     static void Cleanup();
@@ -50,6 +77,7 @@ class SetupRegistration
 {
 public:
     SetupRegistration(SetupRegistry::Creator, std::string);
+    SetupRegistration(SetupRegistry::Creator, std::string, std::string start, std::string end);
 };
 
 template<class T>
@@ -61,4 +89,8 @@ std::shared_ptr<Setup> setup_factory(const std::string& name, OptionsPtr opt)
 #define AUTO_REGISTER_SETUP(setup) \
     SetupRegistration _setup_registration_ ## setup(ant::expconfig::setup_factory<setup>, #setup);
 
+/// @brief as AUTO_REGISTER_SETUP, with the time range of the beamtime (format YYYY-MM-DD) the setup matches
+#define AUTO_REGISTER_SETUP_TIMERANGE(setup, start, end) \
+    SetupRegistration _setup_registration_ ## setup(ant::expconfig::setup_factory<setup>, #setup, start, end);
+
 }} // namespace ant::expconfig
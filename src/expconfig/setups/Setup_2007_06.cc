@@ -17,8 +17,6 @@ public:
     Setup_2007_06(const std::string& name, OptionsPtr opt)
         : Setup_2007_Base(name, opt)
     {
-        SetTimeRange("2007-06-06", "2007-06-24");
-
         CB->SetElementFlag(Detector_t::ElementFlag_t::Broken,     {518, 540});
         CB->SetElementFlag(Detector_t::ElementFlag_t::Broken,     {125}); // uncalibrateable
 
@@ -44,6 +42,6 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2007_06)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2007_06, "2007-06-06", "2007-06-24")
 
 }}} // namespace ant::expconfig::setup
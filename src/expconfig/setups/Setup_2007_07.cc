@@ -17,8 +17,6 @@ public:
     Setup_2007_07(const std::string& name, OptionsPtr opt)
         : Setup_2007_Base(name, opt)
     {
-        SetTimeRange("2007-07-19", "2007-07-30");
-
         CB->SetElementFlag(Detector_t::ElementFlag_t::Broken, {518, 540});
 
         vector<unsigned> switched_off;
@@ -33,6 +31,6 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2007_07)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2007_07, "2007-07-19", "2007-07-30")
 
 }}} // namespace ant::expconfig::setup
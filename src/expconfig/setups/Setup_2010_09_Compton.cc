@@ -17,8 +17,6 @@ public:
     Setup_2010_09_Compton(const std::string& name, OptionsPtr opt)
         : Setup_2010_03_Base(name, opt)
     {
-        SetTimeRange("2010-09-13", "2010-10-04");
-
         CB->SetElementFlag(Detector_t::ElementFlag_t::Broken, {518, 540});
 
         vector<unsigned> switched_off;
@@ -33,6 +31,6 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2010_09_Compton)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2010_09_Compton, "2010-09-13", "2010-10-04")
 
 }}} // namespace ant::expconfig::setup
@@ -19,8 +19,6 @@ public:
     Setup_2014_07_EPT_Prod(const std::string& name, OptionsPtr opt)
         : Setup_2014_EPT(name, opt)
     {
-        SetTimeRange("2014-07-29", "2014-08-25");
-
         // CB
         CB->SetElementFlag(Detector_t::ElementFlag_t::Broken, {203,265,267,479,549,565,607,677});
         CB->SetElementFlag(Detector_t::ElementFlag_t::BadTDC, {623,662,57,59,162,582,586,672,696});
@@ -52,6 +50,6 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2014_07_EPT_Prod)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2014_07_EPT_Prod, "2014-07-29", "2014-08-25")
 
 }}} // namespace ant::expconfig::setup
@@ -17,8 +17,6 @@ public:
     Setup_2014_10_EPT_Prod(const std::string& name, OptionsPtr opt)
         : Setup_2014_EPT(name, opt)
     {
-        SetTimeRange("2014-10-14", "2014-11-03");
-
         // see https://wwwa2.kph.uni-mainz.de/intern/daqwiki/analysis/beamtimes/2014-10-14
         CB->SetElementFlag(Detector_t::ElementFlag_t::Broken, {265,549,565,597,677});
         CB->SetElementFlag(Detector_t::ElementFlag_t::BadTDC, {547,662,678,17,59,162,557,582,586,672,696});
@@ -31,6 +29,6 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2014_10_EPT_Prod)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2014_10_EPT_Prod, "2014-10-14", "2014-11-03")
 
 }}} // namespace ant::expconfig::setup
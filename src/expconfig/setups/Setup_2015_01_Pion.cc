@@ -89,8 +89,6 @@ ImprovedTimeFct2015::~ImprovedTimeFct2015()
 Setup_2015_01_Pion::Setup_2015_01_Pion(const std::string& name, OptionsPtr opt) : Setup(name, opt),
     MCTaggerHits(opt->Get<bool>("MCTaggerHits",false))
 {
-    SetTimeRange("2015-01-27", "2015-02-01");
-
     auto cb = make_shared<detector::CB>();
     AddDetector(cb);
 
@@ -232,6 +230,6 @@ Setup_traits::candidatebuilder_config_t Setup_2015_01_Pion::GetCandidateBuilderC
     return conf;
 }
 
-AUTO_REGISTER_SETUP(Setup_2015_01_Pion)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2015_01_Pion, "2015-01-27", "2015-02-01")
 
 }}} // namespace ant::expconfig::setup
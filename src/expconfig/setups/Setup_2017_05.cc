@@ -206,8 +206,6 @@ Setup_2017_05::Setup_2017_05(const string& name, OptionsPtr opt) :
     AddPromptRange({-6, 8});
     AddRandomRange({ -100,  -50});
     AddRandomRange({  50,   100});
-
-    SetTimeRange("2017-05-09", "2017-05-22");
 }
 
 double Setup_2017_05::GetElectronBeamEnergy() const {
@@ -256,6 +254,6 @@ ant::UnpackerA2GeantConfig::promptrandom_config_t Setup_2017_05::GetPromptRandom
 }
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2017_05)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2017_05, "2017-05-09", "2017-05-22")
 
 
@@ -28,8 +28,6 @@ public:
         Setup_2017Plus_NewTagger_Base(name, opt),
         Tagger(make_shared<detector::Tagger_2018_03>())
     {
-        SetTimeRange("2018-05-02", "2018-05-28");
-
         // add the specific Tagger cabling
         AddDetector(Tagger);
 
@@ -111,7 +109,7 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2018_05)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2018_05, "2018-05-02", "2018-05-28")
 
 
 }}} // namespace ant::expconfig::setup
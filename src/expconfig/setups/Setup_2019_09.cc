@@ -228,8 +228,6 @@ Setup_2019_09::Setup_2019_09(const string& name, OptionsPtr opt) :
     AddPromptRange({-6, 8});
     AddRandomRange({ -100,  -50});
     AddRandomRange({  50,   100});
-
-    SetTimeRange("2019-09-27", "2019-10-11");
 }
 
 double Setup_2019_09::GetElectronBeamEnergy() const {
@@ -287,5 +285,5 @@ ant::UnpackerA2GeantConfig::promptrandom_config_t Setup_2019_09::GetPromptRandom
 }
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2019_09)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2019_09, "2019-09-27", "2019-10-11")
 
@@ -225,8 +225,6 @@ Setup_2021_10::Setup_2021_10(const string& name, OptionsPtr opt) :
     AddPromptRange({-10, 10});
     AddRandomRange({ -100,  -50});
     AddRandomRange({  50,   100});
-
-    SetTimeRange("2021-10-11", "2021-10-14");
 }
 
 double Setup_2021_10::GetElectronBeamEnergy() const {
@@ -263,5 +261,5 @@ Setup_traits::triggersimu_config_t Setup_2021_10::GetTriggerSimuConfig() const
 }
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2021_10)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2021_10, "2021-10-11", "2021-10-14")
 
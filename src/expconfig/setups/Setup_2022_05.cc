@@ -231,8 +231,6 @@ Setup_2022_05::Setup_2022_05(const string& name, OptionsPtr opt) :
     AddPromptRange({-20, 20});
     AddRandomRange({ -100,  -50});
     AddRandomRange({  50,   100});
-
-    SetTimeRange("2022-05-05", "2022-05-07");
 }
 
 double Setup_2022_05::GetElectronBeamEnergy() const {
@@ -290,5 +288,5 @@ ant::UnpackerA2GeantConfig::promptrandom_config_t Setup_2022_05::GetPromptRandom
 }
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2022_05)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2022_05, "2022-05-05", "2022-05-07")
 
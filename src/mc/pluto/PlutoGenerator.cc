@@ -3,6 +3,8 @@
 
 #include "PlutoExtensions.h"
 
+#include "base/std_ext/memory.h"
+
 #include "PReaction.h"
 #include "PParticle.h"
 
@@ -22,7 +24,8 @@ Cocktail::Cocktail(const string& outfile,
                    bool saveUnstable, bool doBulk,
                    const int verbosity,
                    const string& energyDistribution,
-                   const data::Query::ChannelSelector_t& selector):
+                   const data::Query::ChannelSelector_t& selector,
+                   const unsigned seed):
     _fileOutput(outfile),
     _energies(energies),
     _settings(saveUnstable,doBulk),
@@ -36,70 +39,54 @@ Cocktail::Cocktail(const string& outfile,
     // prevent unnused variable warning
     (void)verbosity;
 #endif
-    initLUT();
+    initLUT(seed);
 }
 
-void Cocktail::initLUT()
+void Cocktail::initLUT(const unsigned seed)
 {
-    // helpers:
-    double acc_E = 0;
-
     // -- Init outputfile and Tree --
     _data = _fileOutput.CreateInside<TTree>("data","Event data");
 
     // -- Init root - random engine ---
-    _rndEngine = new TRandom3(0);
+    _rndEngine = new TRandom3(seed);
 
+    const auto channels = data::Query::GetProductionChannels(ChannelSelector);
+
+    // joint probability for energy bin and channel:
+    //    p(E) = f(E) * totalXsection(E)
+    //    p(channel|E) = xsection(channel, E) / sum of xsections(E)
+    vector<double> weights;
     for(double energy : _energies)
     {
-        BinContent currentBin;
-        // -- Energy in MeV --
-        currentBin.Energy = energy;
-
-        // -- Statistics for Energy --
-        //    p(E) = f(E) * totalXsection(E)
-        acc_E += _energyFunction(currentBin.Energy) * data::Query::TotalXsection(currentBin.Energy,ChannelSelector);
-        currentBin.AccProbability = acc_E;
-
-        // -- Statistics for Channels in this energy bin --
-        //    Generate accumulated probabilities with PReaction(tm)
-        //    for all channels in at current energy
-        double acc_prob_channels = 0;
-        for ( auto& product: data::Query::GetProductionChannels(ChannelSelector))
+        const double p_E = _energyFunction(energy) * data::Query::TotalXsection(energy,ChannelSelector);
+
+        vector<double> xsections;
+        vector<const ParticleTypeTreeDatabase::Channel*> products;
+        double sum_xsections = 0;
+        for (auto& product: channels)
         {
-            double xsection = data::Query::Xsection(product, currentBin.Energy);
+            double xsection = data::Query::Xsection(product, energy);
 
             if ( xsection > 0)  // make sure channel is available
             {
-                acc_prob_channels += xsection;
-
-                currentBin.ReactionLUT.emplace_back(BinContent::Reaction_t(acc_prob_channels,
-                                                                           makeReaction(currentBin.Energy,product)));
+                sum_xsections += xsection;
+                xsections.push_back(xsection);
+                products.push_back(addressof(product));
             }
         }
-        // -- fill --
-        _energyBins.emplace_back(currentBin);
+
+        for(unsigned i=0;i<products.size();i++) {
+            weights.push_back(p_E * xsections[i] / sum_xsections);
+            _reactions.push_back(makeReaction(energy, *products[i]));
+        }
     }
+
+    _reactionTable = std_ext::make_unique<const AliasTable>(weights);
 }
 
 PReaction* Cocktail::getRandomReaction() const
 {
-    double rndEnergyBinValue = _rndEngine->Rndm() * _energyBins.back().AccProbability;
-
-    for (auto& eBin: _energyBins)
-    {
-        if ( rndEnergyBinValue <= eBin.AccProbability )
-        {
-            double rndChannelValue = _rndEngine->Rndm() * eBin.ReactionLUT.back().AccProb;
-            for (auto& reactrion: eBin.ReactionLUT)
-            {
-                if ( rndChannelValue <= reactrion.AccProb ){
-                    return reactrion.PlutoReaction;
-                }
-            }
-        }
-    }
-    return nullptr;
+    return _reactions[_reactionTable->Sample(_rndEngine->Rndm())];
 }
 
 
@@ -4,8 +4,10 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 
 #include "base/WrapTFile.h"
+#include "base/AliasTable.h"
 
 #include "mc/database/Query.h"
 #include "PlutoFactory.h"
@@ -54,26 +56,6 @@ protected:
 class Cocktail: public PlutoGenerator
 {
 private:
-    /**
-     * @brief The BinContent class is a container for all necessary information in each energy channel.
-     *        The data is provided by A2ChannelManager
-     */
-    struct BinContent{
-        struct Reaction_t{
-            const double AccProb;
-            PReaction*   PlutoReaction;
-            Reaction_t(double accProb, PReaction* pReaction):
-                AccProb(accProb),
-                PlutoReaction(pReaction){}
-        };
-
-        double Energy; // in MeV
-        double AccProbability;
-        std::vector<std::string> DecayProducts;
-        std::vector<Reaction_t>  ReactionLUT;
-    };
-
-
     WrapTFileOutput _fileOutput;
     //-- Options ---
     std::vector<double> _energies;
@@ -85,30 +67,35 @@ private:
     TTree* _data;
 
     //-- data:
-    std::vector<BinContent> _energyBins;
+    // one reaction for each energy bin and channel,
+    // picked with probability f(E) * xsection(channel, E)
+    std::vector<PReaction*> _reactions;
+    std::unique_ptr<const AliasTable> _reactionTable;
 
     //-- Tools ---
     TRandom3* _rndEngine;
 
-    void initLUT();
+    void initLUT(const unsigned seed);
     PReaction* makeReaction(const double energy,
                             const ParticleTypeTreeDatabase::Channel& channel) const;
 
     /**
-     * @brief getRandomReaction
+     * @brief getRandomReaction picks a reaction in constant time from the alias table
      * @return pointer to randomly picked Pluto reaction from database
      */
     PReaction* getRandomReaction() const;
 
 public:
 
+    // seed=0 chooses a random seed, see TRandom3::SetSeed
     Cocktail(const std::string& outfile,
              const std::vector<double>& energies,
              bool saveUnstable = 0, bool doBulk = 1,
              const int verbosity = 0,
              const std::string& energyDistribution = "1.0 / x",
              const data::Query::ChannelSelector_t& selector
-                        = data::Query::GetSelector(data::Query::Selection::gpBeamTarget));
+                        = data::Query::GetSelector(data::Query::Selection::gpBeamTarget),
+             const unsigned seed = 0);
 
     virtual unsigned long Sample(const unsigned long &nevts) const override;
 
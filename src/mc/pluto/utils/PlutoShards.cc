@@ -0,0 +1,97 @@
+#include "PlutoShards.h"
+
+#include "base/Logger.h"
+
+#include "TFileMerger.h"
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace ant;
+using namespace ant::mc::pluto::utils;
+
+namespace {
+
+// waits for one shard, returns false if it failed
+bool wait_for_shard() {
+    int status = 0;
+    if(::wait(addressof(status)) < 0)
+        throw std::runtime_error("Waiting for Pluto shard failed");
+    return WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+}
+
+}
+
+unsigned PlutoShards::Seed(unsigned seed, unsigned shard)
+{
+    seed_seq seq{seed, shard};
+    unsigned result = 0;
+    seq.generate(&result, &result+1);
+    return result == 0 ? 1 : result;
+}
+
+bool PlutoShards::Generate(const generator_t& generate, const vector<string>& shardfiles,
+                           unsigned long nEvents, unsigned jobs, unsigned seed)
+{
+    const unsigned nShards = shardfiles.size();
+    if(jobs == 0)
+        jobs = nShards;
+
+    unsigned nRunning = 0;
+    bool failed = false;
+    for(unsigned shard=0;shard<nShards;shard++) {
+        // distribute remaining events to first shards
+        const auto nShardEvents = nEvents/nShards + (shard < nEvents % nShards ? 1 : 0);
+        const auto shardSeed = Seed(seed, shard);
+
+        while(nRunning >= jobs) {
+            failed |= !wait_for_shard();
+            nRunning--;
+        }
+
+        const auto pid = fork();
+        if(pid < 0)
+            throw std::runtime_error("Cannot fork Pluto shard");
+        if(pid == 0) {
+            // in shard process, never return
+            try {
+                generate(shardfiles[shard], nShardEvents, shardSeed);
+            }
+            catch(const std::exception& e) {
+                LOG(ERROR) << "Shard " << shard << " failed: " << e.what();
+                _exit(EXIT_FAILURE);
+            }
+            _exit(EXIT_SUCCESS);
+        }
+        nRunning++;
+    }
+
+    while(nRunning > 0) {
+        failed |= !wait_for_shard();
+        nRunning--;
+    }
+
+    return !failed;
+}
+
+void PlutoShards::Merge(const string& outfile, const vector<string>& shardfiles)
+{
+    // hadd::MergeRecursive only handles histograms,
+    // the TFileMerger also merges the trees
+    TFileMerger merger(kFALSE, kFALSE);
+    merger.SetMsgPrefix("Ant-cocktail");
+    merger.SetPrintLevel(0);
+    if(!merger.OutputFile(outfile.c_str(), kTRUE))
+        throw std::runtime_error("Cannot create output file " + outfile);
+    for(const auto& shardfile : shardfiles) {
+        if(!merger.AddFile(shardfile.c_str(), kFALSE))
+            throw std::runtime_error("Cannot open shard file " + shardfile);
+    }
+    if(!merger.Merge())
+        throw std::runtime_error("Merging shards into " + outfile + " failed");
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ant {
+namespace mc {
+namespace pluto {
+namespace utils
+{
+
+/**
+ * @brief Generate Pluto events in independent shards and merge them
+ *
+ * Pluto and ROOT keep global state (gRandom, the Pluto data base),
+ * so each shard runs in its own forked process and writes its own file.
+ */
+struct PlutoShards {
+
+    /**
+     * @brief generator_t writes nEvents to filename, using the given seed
+     * @note runs in the forked shard process, exceptions mark the shard as failed
+     */
+    using generator_t = std::function<void(const std::string& filename, unsigned long nEvents, unsigned seed)>;
+
+    /**
+     * @brief Seed derives the seed of a shard from the seed of the run and the shard index
+     * @return never 0, which would make TRandom3 choose a random seed
+     *
+     * Different (seed, shard) pairs give unrelated seeds, so separate runs
+     * do not repeat each other's shards.
+     */
+    static unsigned Seed(unsigned seed, unsigned shard);
+
+    /**
+     * @brief Generate runs one shard per filename, at most jobs at the same time
+     * @param generate called in the shard process
+     * @param shardfiles output filenames, one per shard
+     * @param nEvents total number of events, distributed evenly over the shards
+     * @param jobs number of concurrent shard processes, 0 runs all at once
+     * @param seed seed of the run, see Seed
+     * @return false if at least one shard failed
+     */
+    static bool Generate(const generator_t& generate, const std::vector<std::string>& shardfiles,
+                         unsigned long nEvents, unsigned jobs, unsigned seed);
+
+    /**
+     * @brief Merge all objects of the shard files into outfile, including the Pluto "data" tree
+     * @throws std::runtime_error if merging fails
+     */
+    static void Merge(const std::string& outfile, const std::vector<std::string>& shardfiles);
+};
+
+}
+}
+}
+}
@@ -22,7 +22,7 @@ bool CheckExists(WrapTFile& file, const std::string& name) {
     return file.GetObject(name, obj);
 }
 
-void PlutoTID::AddTID(const std::string &filename)
+unsigned long PlutoTID::AddTID(const std::string &filename, unsigned long firstIndex)
 {
     const auto random_bits = 4;
 
@@ -30,7 +30,7 @@ void PlutoTID::AddTID(const std::string &filename)
 
     if(CheckExists<TTree>(file, tidtree_name)) {
         LOG(WARNING) << "TID tree already exists in " << filename;
-        return;
+        return 0;
     }
 
     TTree* data = nullptr;
@@ -45,7 +45,7 @@ void PlutoTID::AddTID(const std::string &filename)
 
         auto nEvents = data->GetEntries();
 
-        if(nEvents >= 1 << (sizeof(TID::Lower)*8 - random_bits)) {
+        if(firstIndex + nEvents >= 1ul << (sizeof(TID::Lower)*8 - random_bits)) {
            throw std::runtime_error("Too many entries to fit into TID together with random bits.");
         }
 
@@ -55,14 +55,15 @@ void PlutoTID::AddTID(const std::string &filename)
         for(decltype(nEvents) i=0; i<nEvents; ++i) {
 
             unsigned r = floor(rng.Uniform(1 << random_bits));
-            tid.Lower = (i << random_bits) + r;
+            tid.Lower = ((firstIndex + i) << random_bits) + r;
 
             data_tid->Fill();
         }
-    } else {
-        LOG(WARNING) << "No pluto data Tree found";
+        return nEvents;
     }
 
+    LOG(WARNING) << "No pluto data Tree found";
+    return 0;
 }
 
 void PlutoTID::CopyTIDPlutoGeant(const string& pluto_filename, const string& geant_filename)
@@ -16,11 +16,13 @@ struct PlutoTID {
     /**
      * @brief Add a TID Tree to a pluto generated ROOT file.
      * @param filename File to edit
+     * @param firstIndex index of the first entry, files which are chained later need distinct ranges
+     * @return number of added TIDs
      *
      * Opens the ROOT file in read/write, looks for a "data" TTree and then adds a TID in a new TTree
      * called "dataTID" for each entry in "data"
      */
-    static void AddTID(const std::string& filename);
+    static unsigned long AddTID(const std::string& filename, unsigned long firstIndex = 0);
 
     static void CopyTIDPlutoGeant(const std::string& pluto_filename, const std::string& geant_filename);
 };
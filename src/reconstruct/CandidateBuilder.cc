@@ -8,6 +8,9 @@
 #include "base/std_ext/math.h"
 #include "base/std_ext/misc.h"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace ant;
 using namespace std;
 using namespace ant::reconstruct;
@@ -18,6 +21,23 @@ struct det_type {
     using type = typename T::element_type;
 };
 
+namespace {
+
+// removes the flagged clusters, keeping the order of the remaining ones
+void remove_matched(TClusterList& clusters, const vector<bool>& matched)
+{
+    TClusterList remaining;
+    auto it_cluster = clusters.begin();
+    for(bool m : matched) {
+        if(!m)
+            remaining.push_back(it_cluster);
+        ++it_cluster;
+    }
+    clusters = move(remaining);
+}
+
+}
+
 CandidateBuilder::CandidateBuilder() :
     cb(ExpConfig::Setup::GetDetector<det_type<decltype(cb)>::type>()),
     pid(ExpConfig::Setup::GetDetector<det_type<decltype(pid)>::type>()),
@@ -25,6 +45,45 @@ CandidateBuilder::CandidateBuilder() :
     tapsveto(ExpConfig::Setup::GetDetector<det_type<decltype(tapsveto)>::type>()),
     config(ExpConfig::Setup::Get().GetCandidateBuilderConfig())
 {
+    if(cb && pid) {
+        double dphi_max = 0;
+        for(unsigned ch=0;ch<pid->GetNChannels();ch++)
+            dphi_max = max(dphi_max, pid->dPhi(ch) + config.PID_Phi_Epsilon);
+        // small margin protects against rounding at the sector borders
+        constexpr double margin = 1e-6;
+        if(isfinite(dphi_max) && dphi_max > 0) {
+            auto nSectors = static_cast<unsigned>(2*M_PI/(dphi_max + margin));
+            while(nSectors > 0 && 2*M_PI/nSectors < dphi_max + margin)
+                --nSectors;
+            // less than three sectors don't help at all
+            if(nSectors >= 3)
+                phi_nSectors = nSectors;
+        }
+    }
+
+    if(taps && tapsveto) {
+        for(unsigned ch=0;ch<taps->GetNChannels();ch++) {
+            taps_veto_center.push_back(taps->GetHexChannel(ch));
+            // convert neighbouring baf2/pbwo4 channel ids to channel identifiers
+            // which could be matched with Veto channels
+            vector<unsigned> neighbours;
+            for(auto neighbour : taps->GetClusterElement(ch)->Neighbours)
+                neighbours.push_back(taps->GetHexChannel(neighbour));
+            sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            taps_veto_neighbours.emplace_back(move(neighbours));
+        }
+    }
+}
+
+unsigned CandidateBuilder::GetPhiSector(double phi) const
+{
+    if(phi_nSectors == 1 || !isfinite(phi))
+        return 0;
+    const int n = phi_nSectors;
+    const auto sector = static_cast<int>(floor((phi + M_PI)/(2*M_PI)*n));
+    // wrap-around, phi might be exactly 180 deg
+    return ((sector % n) + n) % n;
 }
 
 void CandidateBuilder::Build_PID_CB(sorted_clusters_t& sorted_clusters,
@@ -44,19 +103,65 @@ void CandidateBuilder::Build_PID_CB(sorted_clusters_t& sorted_clusters,
     if(pid_clusters.empty())
         return;
 
-    auto it_pid_cluster = pid_clusters.begin();
+    // remember the CB cluster iterators and sort them into phi sectors,
+    // the clusters are only removed after all matching is done
+    vector<clusters_t::iterator> cb_its;
+    vector<unsigned> cb_sectors;
+    for(auto it_cb_cluster = cb_clusters.begin(); it_cb_cluster != cb_clusters.end(); ++it_cb_cluster) {
+        cb_its.push_back(it_cb_cluster);
+        cb_sectors.push_back(GetPhiSector(it_cb_cluster->Position.Phi()));
+    }
+
+    // counting sort keeps the original order within each sector
+    vector<unsigned> sector_begin(phi_nSectors+1, 0);
+    for(auto sector : cb_sectors)
+        sector_begin[sector+1]++;
+    partial_sum(sector_begin.begin(), sector_begin.end(), sector_begin.begin());
+    vector<unsigned> cb_by_sector(cb_its.size());
+    {
+        auto sector_fill = sector_begin;
+        for(unsigned i=0;i<cb_sectors.size();i++)
+            cb_by_sector[sector_fill[cb_sectors[i]]++] = i;
+    }
+
+    vector<bool> cb_matched(cb_its.size(), false);
+    vector<bool> pid_matched(pid_clusters.size(), false);
+    vector<unsigned> cb_indices;
 
-    while(it_pid_cluster != pid_clusters.end()) {
+    auto add_sector = [&cb_indices, &cb_by_sector, &sector_begin] (unsigned sector) {
+        cb_indices.insert(cb_indices.end(),
+                          next(cb_by_sector.begin(), sector_begin[sector]),
+                          next(cb_by_sector.begin(), sector_begin[sector+1]));
+    };
+
+    unsigned i_pid = 0;
+    for(auto it_pid_cluster = pid_clusters.begin(); it_pid_cluster != pid_clusters.end(); ++it_pid_cluster, ++i_pid) {
 
         auto& pid_cluster = *it_pid_cluster;
         const auto pid_phi = pid_cluster.Position.Phi();
         const auto dphi_max = (pid->dPhi(pid_cluster.CentralElement) + config.PID_Phi_Epsilon);
 
+        // only the own and the two neighbouring sectors can match
+        cb_indices.clear();
+        if(phi_nSectors == 1) {
+            add_sector(0);
+        }
+        else {
+            const auto sector = GetPhiSector(pid_phi);
+            add_sector((sector + phi_nSectors - 1) % phi_nSectors);
+            add_sector(sector);
+            add_sector((sector + 1) % phi_nSectors);
+        }
+        // keep the original order of the CB clusters
+        sort(cb_indices.begin(), cb_indices.end());
+
         bool matched = false;
 
-        auto it_cb_cluster = cb_clusters.begin();
+        for(auto i_cb : cb_indices) {
+            if(cb_matched[i_cb])
+                continue;
 
-        while(it_cb_cluster != cb_clusters.end()) {
+            const auto& it_cb_cluster = cb_its[i_cb];
             auto& cb_cluster = *it_cb_cluster;
             const auto cb_phi = cb_cluster.Position.Phi();
 
@@ -77,21 +182,19 @@ void CandidateBuilder::Build_PID_CB(sorted_clusters_t& sorted_clusters,
                             TClusterList{it_cb_cluster, it_pid_cluster}
                             );
                 all_clusters.push_back(it_cb_cluster);
-                it_cb_cluster = cb_clusters.erase(it_cb_cluster);
+                cb_matched[i_cb] = true;
                 matched = true;
             }
-            else {
-                ++it_cb_cluster;
-            }
         }
 
         if(matched) {
             all_clusters.push_back(it_pid_cluster);
-            it_pid_cluster = pid_clusters.erase(it_pid_cluster);
-        } else {
-            ++it_pid_cluster;
+            pid_matched[i_pid] = true;
         }
     }
+
+    remove_matched(cb_clusters, cb_matched);
+    remove_matched(pid_clusters, pid_matched);
 }
 
 void CandidateBuilder::Build_TAPS_Veto(sorted_clusters_t& sorted_clusters,
@@ -111,52 +214,81 @@ void CandidateBuilder::Build_TAPS_Veto(sorted_clusters_t& sorted_clusters,
     if(veto_clusters.empty())
         return;
 
+    // index the Veto clusters by their channel,
+    // several clusters in the same channel are chained in their original order
+    vector<clusters_t::iterator> veto_its;
+    unsigned max_channel = 0;
+    for(auto it_veto_cluster = veto_clusters.begin(); it_veto_cluster != veto_clusters.end(); ++it_veto_cluster) {
+        veto_its.push_back(it_veto_cluster);
+        max_channel = max(max_channel, it_veto_cluster->CentralElement);
+    }
+    constexpr int none = -1;
+    vector<int> channel_first(max_channel+1, none);
+    vector<int> veto_next(veto_its.size(), none);
+    for(int i=veto_its.size()-1;i>=0;i--) {
+        auto& first = channel_first[veto_its[i]->CentralElement];
+        veto_next[i] = first;
+        first = i;
+    }
 
-    auto it_taps_cluster = taps_clusters.begin();
-    vector<unsigned> neighbours;
+    vector<bool> taps_matched(taps_clusters.size(), false);
+    vector<bool> veto_matched(veto_its.size(), false);
+    vector<int> veto_indices;
 
-    while (it_taps_cluster != taps_clusters.end()) {
+    auto add_channel = [&veto_indices, &channel_first, &veto_next] (unsigned channel) {
+        if(channel >= channel_first.size())
+            return;
+        for(int i = channel_first[channel]; i != none; i = veto_next[i])
+            veto_indices.push_back(i);
+    };
 
-        const auto& taps_cluster = *it_taps_cluster;
-        auto center = taps->GetHexChannel(taps_cluster.CentralElement);
+    const vector<unsigned> no_neighbours;
 
-        auto it_veto_cluster = veto_clusters.begin();
+    unsigned i_taps = 0;
+    for(auto it_taps_cluster = taps_clusters.begin(); it_taps_cluster != taps_clusters.end(); ++it_taps_cluster, ++i_taps) {
 
-        auto matched_veto = veto_clusters.end();
-        neighbours.clear();
+        const auto& taps_cluster = *it_taps_cluster;
+        const auto center = taps_veto_center.at(taps_cluster.CentralElement);
 
         // only check neighbouring Veto elements for clusters with at least 2 crystals
-        if (taps_cluster.Hits.size() > 1) {
-            neighbours = taps->GetClusterElement(taps_cluster.CentralElement)->Neighbours;
-            // convert neighbouring baf2/pbwo4 channel ids to channel identifiers
-            // which could be matched with Veto channels
-            transform(neighbours.begin(), neighbours.end(),
-                      neighbours.begin(), [=] (const unsigned channel) {
-                return taps->GetHexChannel(channel);
-            });
+        const auto& neighbours = taps_cluster.Hits.size() > 1
+                                 ? taps_veto_neighbours.at(taps_cluster.CentralElement)
+                                 : no_neighbours;
+
+        // collect only the Veto clusters which can match at all,
+        // but visit them in their original order
+        veto_indices.clear();
+        add_channel(center);
+        for(auto neighbour : neighbours) {
+            if(neighbour != center)
+                add_channel(neighbour);
         }
+        sort(veto_indices.begin(), veto_indices.end());
+
+        int matched_veto = none;
 
-        while (it_veto_cluster != veto_clusters.end()) {
+        for(auto i_veto : veto_indices) {
+            if(veto_matched[i_veto])
+                continue;
 
-            auto& veto_cluster = *it_veto_cluster;
+            auto& veto_cluster = *veto_its[i_veto];
 
             // does the hit veto channel match the TAPS central cluster element?
             if (veto_cluster.CentralElement == center)
-                matched_veto = it_veto_cluster;
+                matched_veto = i_veto;
 
             // check the neighbouring Vetos
-            if (find(neighbours.begin(), neighbours.end(),
-                     veto_cluster.CentralElement) != neighbours.end()) {
+            if (binary_search(neighbours.begin(), neighbours.end(), veto_cluster.CentralElement)) {
                 // in case the currently checked Veto is one of the central elements neighbours,
                 // check if the deposited energy is higher than in the stored matched Veto element (if existent)
-                if (matched_veto == veto_clusters.end() || veto_cluster.Energy > matched_veto->Energy)
-                    matched_veto = it_veto_cluster;
+                if (matched_veto == none || veto_cluster.Energy > veto_its[matched_veto]->Energy)
+                    matched_veto = i_veto;
             }
-            ++it_veto_cluster;
         }
 
         // match found?
-        if (matched_veto != veto_clusters.end()) {
+        if (matched_veto != none) {
+            const auto& it_veto_cluster = veto_its[matched_veto];
             candidates.emplace_back(
                         Detector_t::Type_t::TAPS | Detector_t::Type_t::TAPSVeto,
                         taps_cluster.Energy,
@@ -164,18 +296,19 @@ void CandidateBuilder::Build_TAPS_Veto(sorted_clusters_t& sorted_clusters,
                         taps_cluster.Position.Phi(),
                         taps_cluster.Time,
                         taps_cluster.Hits.size(),
-                        matched_veto->Energy,
+                        it_veto_cluster->Energy,
                         numeric_limits<double>::quiet_NaN(), // no tracker information
-                        TClusterList{it_taps_cluster, matched_veto}
+                        TClusterList{it_taps_cluster, it_veto_cluster}
                         );
             all_clusters.push_back(it_taps_cluster);
-            it_taps_cluster = taps_clusters.erase(it_taps_cluster);
-            all_clusters.push_back(matched_veto);
-            veto_clusters.erase(matched_veto);
-        } else {
-            ++it_taps_cluster;
+            taps_matched[i_taps] = true;
+            all_clusters.push_back(it_veto_cluster);
+            veto_matched[matched_veto] = true;
         }
     }
+
+    remove_matched(taps_clusters, taps_matched);
+    remove_matched(veto_clusters, veto_matched);
 }
 
 void CandidateBuilder::Catchall(sorted_clusters_t& sorted_clusters,
@@ -10,6 +10,7 @@
 #include <map>
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace ant {
 
@@ -43,6 +44,18 @@ protected:
 
     const expconfig::Setup_traits::candidatebuilder_config_t config;
 
+    // geometry lookup tables, built once in the constructor
+
+    // CB clusters are sorted into phi sectors which are at least as wide
+    // as the largest PID phi acceptance, so only three sectors need to be checked
+    unsigned phi_nSectors = 1;
+    unsigned GetPhiSector(double phi) const;
+
+    // for each TAPS element, the Veto channel in front of it
+    // and the Veto channels in front of its neighbours (sorted, unique)
+    std::vector<unsigned> taps_veto_center;
+    std::vector<std::vector<unsigned>> taps_veto_neighbours;
+
     void Build_PID_CB(
             sorted_clusters_t& sorted_clusters,
             candidates_t& candidates, clusters_t& all_clusters
@@ -5,6 +5,7 @@
 #include "UpdateableManager.h"
 
 #include "expconfig/ExpConfig.h"
+#include "expconfig/TriggerSums.h"
 
 #include "tree/TEventData.h"
 
@@ -70,6 +71,7 @@ Reconstruct::Reconstruct(clustering_t clustering_, candidatebuilder_t candidateb
     hooks_clusterhits(getSortedHooks<decltype(hooks_clusterhits)>()),
     hooks_clusters(getSortedHooks<decltype(hooks_clusters)>()),
     hooks_eventdata(getSortedHooks<decltype(hooks_eventdata)>()),
+    triggersums(std_ext::make_unique<expconfig::TriggerSums>(ExpConfig::Setup::Get().GetTriggerSimuConfig())),
     clustering(move(clustering_)),
     candidatebuilder(move(candidatebuilder_)),
     updateablemanager(std_ext::make_unique<UpdateableManager>(ExpConfig::Setup::Get().GetUpdateables()))
@@ -80,12 +82,39 @@ Reconstruct::Reconstruct(clustering_t clustering_, candidatebuilder_t candidateb
 // makes forward declaration work properly
 Reconstruct::~Reconstruct() = default;
 
+void Reconstruct::EnableStageTimings()
+{
+    stage_timings = std_ext::make_unique<StageTimings_t>();
+}
+
+namespace {
+// little helper to accumulate the time since the last call
+struct stage_clock_t {
+    using clock_t = std::chrono::steady_clock;
+    using timings_t = Reconstruct::StageTimings_t;
+    explicit stage_clock_t(timings_t* timings_) :
+        timings(timings_), last(timings ? clock_t::now() : clock_t::time_point()) {}
+    void AddTo(timings_t::duration_t timings_t::* stage) {
+        if(!timings)
+            return;
+        const auto now = clock_t::now();
+        timings->*stage += now - last;
+        last = now;
+    }
+private:
+    timings_t* const timings;
+    clock_t::time_point last;
+};
+}
+
 void Reconstruct::DoReconstruct(TEventData& reconstructed) const
 {
     // ignore empty events
     if(reconstructed.DetectorReadHits.empty())
         return;
 
+    stage_clock_t stage_clock(stage_timings.get());
+
     // update the updateables :)
     updateablemanager->UpdateParameters(reconstructed.ID);
 
@@ -96,12 +125,18 @@ void Reconstruct::DoReconstruct(TEventData& reconstructed) const
     // the detectorReads are now calibrated as far as possible
     // one might return now and detectorRead is just calibrated...
 
+    // the trigger energy sum only needs the calibrated CB hits,
+    // so physics classes don't need to scan all hits again
+    reconstructed.TriggerSums.CBEnergySum =
+            triggersums->CBEnergySum(sorted_readhits.get_item(Detector_t::Type_t::CB));
+    stage_clock.AddTo(&StageTimings_t::Calibrate);
 
     // do the hit matching, which builds the TClusterHit's
     // put into the AdaptorTClusterHit to track Energy/Timing information
     // for subsequent clustering
     sorted_bydetectortype_t<TClusterHit> sorted_clusterhits;
     BuildHits(sorted_clusterhits, reconstructed.TaggerHits);
+    stage_clock.AddTo(&StageTimings_t::Hits);
 
     // apply hooks which modify clusterhits
     for(const auto& hook : hooks_clusterhits) {
@@ -116,6 +151,7 @@ void Reconstruct::DoReconstruct(TEventData& reconstructed) const
     for(const auto& hook : hooks_clusters) {
         hook->ApplyTo(sorted_clusters);
     }
+    stage_clock.AddTo(&StageTimings_t::Clustering);
 
     // do the candidate building (if available)
     if(candidatebuilder) {
@@ -136,6 +172,9 @@ void Reconstruct::DoReconstruct(TEventData& reconstructed) const
         hook->ApplyTo(reconstructed);
     }
 
+    reconstructed.TriggerSums.CBTiming = triggersums->CBTiming(reconstructed.Clusters);
+    reconstructed.TriggerSums.IsSet = true;
+    stage_clock.AddTo(&StageTimings_t::Candidates);
 }
 
 void Reconstruct::ApplyHooksToReadHits(std::vector<TDetectorReadHit>& detectorReadHits) const
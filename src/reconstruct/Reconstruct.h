@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <list>
+#include <chrono>
 
 #include "Reconstruct_traits.h"
 
@@ -13,6 +14,10 @@ namespace reconstruct {
 class UpdateableManager;
 }
 
+namespace expconfig {
+class TriggerSums;
+}
+
 class Reconstruct : public Reconstruct_traits {
 public:
 
@@ -31,6 +36,24 @@ public:
 
     virtual ~Reconstruct();
 
+    /**
+     * @brief The StageTimings_t struct accumulates the wall time spent in the reconstruction stages
+     */
+    struct StageTimings_t {
+        using duration_t = std::chrono::duration<double>;
+        duration_t Calibrate{0};
+        duration_t Hits{0};
+        duration_t Clustering{0};
+        duration_t Candidates{0};
+    };
+
+    /**
+     * @brief EnableStageTimings starts measuring the time spent in each stage of DoReconstruct
+     * @note by default, no timing is done to avoid the overhead
+     */
+    void EnableStageTimings();
+    const StageTimings_t* GetStageTimings() const { return stage_timings.get(); }
+
     class Exception : public std::runtime_error {
         using std::runtime_error::runtime_error; // use base class constructor
     };
@@ -98,9 +121,15 @@ protected:
     const shared_ptr_list<ReconstructHook::Clusters>         hooks_clusters;
     const shared_ptr_list<ReconstructHook::EventData>        hooks_eventdata;
 
+    // sums for the trigger simulation, filled into the event data
+    const std::unique_ptr<const expconfig::TriggerSums> triggersums;
+
     const clustering_t       clustering;
     const candidatebuilder_t candidatebuilder;
     const std::unique_ptr<reconstruct::UpdateableManager> updateablemanager;
+
+    // only present if enabled
+    std::unique_ptr<StageTimings_t> stage_timings;
 };
 
 }
@@ -20,6 +20,7 @@
 
 #pragma link C++ class ant::histtools+;
 #pragma link C++ class ant::MC::ThetaCBToyMC+;
+#pragma link C++ class ant::MC::ToyMC+;
 #pragma link C++ class ant::KinfitExtract+;
 #pragma link C++ class ant::Math+;
 #pragma link C++ class ant::InterpolatedPulls+;
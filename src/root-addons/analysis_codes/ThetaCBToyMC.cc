@@ -1,4 +1,5 @@
 #include "ThetaCBToyMC.h"
+#include "ToyMC.h"
 #include "base/std_ext/math.h"
 #include "TH2.h"
 #include "TH3.h"
@@ -16,7 +17,7 @@ using namespace ant::MC;
 using namespace ant::std_ext;
 
 #include <cmath>
-#include "TRandom2.h"
+#include "TRandom.h"
 
 double ThetaCBToyMC::dTheta(const double theta, const double z, const double r, const double yoffset) {
     const auto a0 = r*cos(theta);
@@ -25,7 +26,8 @@ double ThetaCBToyMC::dTheta(const double theta, const double z, const double r,
     return atan2(b,a0-z);
 }
 
-TH2* ThetaCBToyMC::SimTheta(const unsigned n, const double r, const double l, const double gap, TH2* hist)
+TH2* ThetaCBToyMC::SimTheta(const unsigned n, const double r, const double l, const double gap, TH2* hist,
+                            const unsigned seed, const unsigned nThreads)
 {
     const double theta_min = degree_to_radian(20.0);
     const double theta_max = degree_to_radian(160.0);
@@ -36,17 +38,16 @@ TH2* ThetaCBToyMC::SimTheta(const unsigned n, const double r, const double l, co
         hist->SetYTitle("d#theta [#circ]");
     }
 
-    TRandom2 rng;
-    rng.SetSeed();
+    ToyMC::Fill(hist, n, [=] (TH1* h, TRandom& rng, unsigned long long begin, unsigned long long end) {
+        for(auto i=begin; i<end; ++i) {
+            const auto theta = rng.Uniform(theta_max - theta_min) + theta_min;
+            const auto z     = rng.Uniform(l) - l/2.0;
 
-    for(unsigned i=0; i<n; ++i) {
-        const auto theta = rng.Uniform(theta_max - theta_min) + theta_min;
-        const auto z     = rng.Uniform(l) - l/2.0;
+            const auto dtheta = theta - dTheta(theta, z, r, gap/2.0);
 
-        const auto dtheta = theta - dTheta(theta, z, r, gap/2.0);
-
-        hist->Fill(radian_to_degree(theta), radian_to_degree(dtheta));
-    }
+            h->Fill(radian_to_degree(theta), radian_to_degree(dtheta));
+        }
+    }, seed, nThreads);
 
     return hist;
 
@@ -111,7 +112,8 @@ void ThetaCBToyMC::Analyse3(TH3* hist)
     slope->Draw("AP");
 }
 
-void ThetaCBToyMC::SimThetaMulti(const unsigned n, const double rmin, const double rmax, const unsigned steps, const double l)
+void ThetaCBToyMC::SimThetaMulti(const unsigned n, const double rmin, const double rmax, const unsigned steps, const double l,
+                                 const unsigned seed, const unsigned nThreads)
 {
     const std::vector<int> colors = {kBlack, kRed, kBlue, kGreen, kPink, kCyan, kOrange, kTeal};
 
@@ -122,7 +124,7 @@ void ThetaCBToyMC::SimThetaMulti(const unsigned n, const double rmin, const doub
     for(unsigned i=0; i<steps; ++i) {
         const double r = rmin + ((rmax - rmin)/steps)*i;
 
-        const auto hist = SimTheta(n, r, l);
+        const auto hist = SimTheta(n, r, l, 0.0, nullptr, seed+i, nThreads);
 
         cHists << drawoption("colz")
                 << hist;
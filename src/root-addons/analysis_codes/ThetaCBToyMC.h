@@ -8,10 +8,18 @@ namespace MC {
 
 struct ThetaCBToyMC {
     static double dTheta(const double theta, const double z, const double r, const double gap);
-    static TH2* SimTheta(const unsigned n, const double r=25.0, const double l=10.0, const double gap=0.0, TH2* hist=nullptr);
+
+    /**
+     * @brief SimTheta fills n toy events into hist, created if not given, see ToyMC::Fill
+     * @param seed same seed gives the same histogram
+     * @param nThreads 0 uses all cores
+     */
+    static TH2* SimTheta(const unsigned n, const double r=25.0, const double l=10.0, const double gap=0.0, TH2* hist=nullptr,
+                         const unsigned seed=1, const unsigned nThreads=0);
 
     static void Analyse3(TH3* hist);
-    static void SimThetaMulti(const unsigned n=1E+9, const double rmin=25.0, const double rmax=65, const unsigned steps=4, const double l=10.0);
+    static void SimThetaMulti(const unsigned n=1E+9, const double rmin=25.0, const double rmax=65, const unsigned steps=4, const double l=10.0,
+                              const unsigned seed=1, const unsigned nThreads=0);
 };
 
 }
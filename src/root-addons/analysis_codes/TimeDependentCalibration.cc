@@ -1,4 +1,5 @@
 #include "TimeDependentCalibration.h"
+#include "ToyMC.h"
 
 #include "base/WrapTFile.h"
 #include "analysis/plot/HistogramFactory.h"
@@ -7,6 +8,7 @@
 
 #include "TH2D.h"
 #include "TF1.h"
+#include "TRandom.h"
 
 using namespace std;
 using namespace ant;
@@ -14,7 +16,8 @@ using namespace ant::analysis;
 
 void TimeDependentCalibration::MakeCBEnergyFile(const char* basefilename,
                                                 const char* setupname,
-                                                int fillsPerChannel, int nSlices)
+                                                int fillsPerChannel, int nSlices,
+                                                unsigned seed, unsigned nThreads)
 {
     vector<double> peakPos(nSlices, 135);
 
@@ -67,11 +70,14 @@ void TimeDependentCalibration::MakeCBEnergyFile(const char* basefilename,
         f.SetParameter(6,  1);
         f.SetParameter(7,  0);
 
-        for(auto ch=0u;ch<nCBChannels;ch++) {
-            for(auto i=0;i<fillsPerChannel;i++) {
-                ggIM->Fill(f.GetRandom(), ch);
+        const MC::ToyMC::Sampler sampler(f, 0, 1000);
+        const auto nFills = static_cast<unsigned long long>(max(0, fillsPerChannel));
+        MC::ToyMC::Fill(ggIM, nFills*nCBChannels,
+                        [&sampler, nFills] (TH1* h, TRandom& rng, unsigned long long begin, unsigned long long end) {
+            for(auto i=begin;i<end;i++) {
+                h->Fill(sampler(rng), i/nFills);
             }
-        }
+        }, seed+slice, nThreads);
 
         header->CmdLine = "root ant::TimeDependentCalibration";
         header->FirstID = TID(slice, 0, {TID::Flags_t::AdHoc});
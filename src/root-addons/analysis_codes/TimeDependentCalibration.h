@@ -2,10 +2,17 @@
 
 namespace ant {
 struct TimeDependentCalibration {
+    /**
+     * @brief MakeCBEnergyFile writes nSlices files with a toy ggIM peak per CB channel
+     * @param seed the same seed gives the same files
+     * @param nThreads the toy MC runs on this many threads, 0 uses all cores
+     */
     static void MakeCBEnergyFile(const char* basefilename,
                                  const char* setupname,
                                  int fillsPerChannel = 10000,
-                                 int nSlices = 10);
+                                 int nSlices = 10,
+                                 unsigned seed = 1,
+                                 unsigned nThreads = 0);
 };
 
 }
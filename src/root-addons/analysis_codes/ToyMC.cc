@@ -0,0 +1,148 @@
+#include "ToyMC.h"
+
+#include "TH1.h"
+#include "TF1.h"
+#include "TRandom3.h"
+#include "RVersion.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+using namespace ant;
+using namespace ant::MC;
+
+namespace {
+
+// samples per chunk, each chunk gets its own generator
+constexpr unsigned long long chunkSize = 1 << 16;
+
+unsigned chunkSeed(unsigned seed, unsigned long long chunk) {
+    // TRandom3 seeded with 0 would take a seed from the time
+    seed_seq seq{seed, unsigned(chunk), unsigned(chunk >> 32)};
+    unsigned result = 0;
+    seq.generate(&result, &result+1);
+    return result == 0 ? 1 : result;
+}
+
+}
+
+unsigned ToyMC::DefaultThreads()
+{
+    return max(1u, thread::hardware_concurrency());
+}
+
+void ToyMC::Fill(TH1* hist, unsigned long long n, const fill_t& fill, unsigned seed, unsigned nThreads)
+{
+    if(!hist)
+        throw invalid_argument("ToyMC: no histogram given");
+
+    const auto nChunks = (n + chunkSize - 1)/chunkSize;
+    if(nThreads == 0)
+        nThreads = DefaultThreads();
+    nThreads = unsigned(min<unsigned long long>(nThreads, max(1ull, nChunks)));
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    if(nThreads > 1)
+        ROOT::EnableThreadSafety();
+#endif
+
+    // create everything ROOT related here, the threads only fill
+    struct worker_t {
+        unique_ptr<TH1> hist;
+        TRandom3 rng;
+    };
+    vector<worker_t> workers(nThreads);
+    {
+        const auto addDirectory = TH1::AddDirectoryStatus();
+        TH1::AddDirectory(false);
+        for(auto& w : workers) {
+            w.hist = unique_ptr<TH1>(dynamic_cast<TH1*>(hist->Clone()));
+            w.hist->Reset();
+        }
+        TH1::AddDirectory(addDirectory);
+    }
+
+    atomic<unsigned long long> nextChunk(0);
+    mutex exception_mutex;
+    exception_ptr exception;
+
+    auto work = [&] (worker_t& w) {
+        try {
+            unsigned long long chunk;
+            while((chunk = nextChunk++) < nChunks) {
+                w.rng.SetSeed(chunkSeed(seed, chunk));
+                const auto begin = chunk*chunkSize;
+                fill(w.hist.get(), w.rng, begin, min(n, begin + chunkSize));
+            }
+        }
+        catch(...) {
+            // let the others stop early
+            nextChunk = nChunks;
+            lock_guard<mutex> lock(exception_mutex);
+            if(!exception)
+                exception = current_exception();
+        }
+    };
+
+    vector<thread> threads;
+    for(unsigned i=1;i<nThreads;i++)
+        threads.emplace_back(work, ref(workers[i]));
+    work(workers.front());
+    for(auto& t : threads)
+        t.join();
+
+    if(exception)
+        rethrow_exception(exception);
+
+    for(auto& w : workers)
+        hist->Add(w.hist.get());
+}
+
+ToyMC::Sampler::Sampler(const TF1& f, double xmin_, double xmax, unsigned npx) :
+    xmin(xmin_)
+{
+    if(npx == 0)
+        npx = unsigned(max(1, f.GetNpx()));
+    if(!(xmax > xmin))
+        throw invalid_argument("ToyMC::Sampler: empty range");
+    dx = (xmax - xmin)/npx;
+
+    y.resize(npx+1);
+    for(unsigned i=0;i<=npx;i++)
+        y[i] = max(0.0, f.Eval(xmin + i*dx));
+
+    cumulative.resize(npx+1);
+    cumulative[0] = 0;
+    for(unsigned i=0;i<npx;i++)
+        cumulative[i+1] = cumulative[i] + (y[i] + y[i+1])/2;
+    const auto total = cumulative.back();
+    if(!(total > 0) || !isfinite(total))
+        throw invalid_argument("ToyMC::Sampler: function has no positive integral in range");
+    for(auto& c : cumulative)
+        c /= total;
+}
+
+double ToyMC::Sampler::operator()(TRandom& rng) const
+{
+    const auto u = rng.Rndm();
+    const auto it = upper_bound(cumulative.begin(), cumulative.end(), u);
+    const auto i = size_t(min(distance(cumulative.begin(), it), ptrdiff_t(cumulative.size()-1))) - 1;
+
+    // invert the integral of the linear function within the interval
+    const auto v = (u - cumulative[i])/(cumulative[i+1] - cumulative[i]);
+    const auto y0 = y[i];
+    const auto slope = y[i+1] - y0;
+    double t = v;
+    if(abs(slope) > 1e-6*(y0 + y[i+1]))
+        t = (sqrt(y0*y0 + slope*v*(2*y0 + slope)) - y0)/slope;
+    return xmin + (i + t)*dx;
+}
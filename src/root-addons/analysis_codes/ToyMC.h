@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+
+#ifndef __CINT__
+#include <functional>
+#endif
+
+class TH1;
+class TF1;
+class TRandom;
+
+namespace ant {
+namespace MC {
+
+/**
+ * @brief Fill histograms with toy Monte Carlo samples on several threads
+ *
+ * The samples 0..n-1 are split into chunks of fixed size. Each chunk gets its own
+ * random number generator, seeded from the seed and the chunk index only. The threads
+ * take the chunks one after another and fill their own clone of the histogram, which
+ * are added to the given histogram at the end. So the result does not depend on the
+ * number of threads, and the same seed gives the same histogram.
+ *
+ * From the ROOT prompt:
+ * @code
+ * auto h = new TH1D("h","",100,-5,5);
+ * ant::MC::ToyMC::Fill(h, 1e8, [] (TH1* h, TRandom& rng, ULong64_t begin, ULong64_t end) {
+ *     for(auto i=begin;i<end;i++) h->Fill(rng.Gaus());
+ * });
+ * @endcode
+ */
+struct ToyMC {
+
+#ifndef __CINT__
+    /**
+     * @brief fill_t fills the samples [begin, end) into hist
+     * @note called concurrently, only use hist and rng, or objects which are only read
+     */
+    using fill_t = std::function<void(TH1* hist, TRandom& rng, unsigned long long begin, unsigned long long end)>;
+
+    /**
+     * @brief Fill n samples into hist, existing content of hist is kept
+     * @param hist histogram to add the samples to
+     * @param n number of samples
+     * @param fill called once per chunk
+     * @param seed the same seed gives the same result
+     * @param nThreads number of threads, 0 uses all cores
+     */
+    static void Fill(TH1* hist, unsigned long long n, const fill_t& fill,
+                     unsigned seed = 1, unsigned nThreads = 0);
+#endif
+
+    /// @brief number of threads used for nThreads=0
+    static unsigned DefaultThreads();
+
+    /**
+     * @brief Sampler draws random numbers following a TF1, like TF1::GetRandom
+     *
+     * TF1::GetRandom uses gRandom and is not safe to call from several threads.
+     * The function is tabulated once here, sampling only reads the table.
+     */
+    class Sampler {
+    protected:
+        double xmin;
+        double dx;
+        std::vector<double> y;          // function at the npx+1 points
+        std::vector<double> cumulative; // integral up to each point, normalised to 1
+    public:
+        /**
+         * @brief Sampler tabulates f, linear between the points
+         * @param f function, negative values count as zero
+         * @param xmin lower end
+         * @param xmax upper end
+         * @param npx number of intervals, 0 uses f.GetNpx()
+         */
+        Sampler(const TF1& f, double xmin, double xmax, unsigned npx = 0);
+        double operator()(TRandom& rng) const;
+    };
+};
+
+}
+}
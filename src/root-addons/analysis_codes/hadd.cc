@@ -3,6 +3,9 @@
 #include "hstack.h"
 #include "tree/TAntHeader.h"
 #include "base/ProgressCounter.h"
+#include "base/tmpfile_t.h"
+#include "base/Logger.h"
+#include "base/std_ext/memory.h"
 
 #include "TDirectory.h"
 #include "TFile.h"
@@ -13,6 +16,11 @@
 #include "TFileMergeInfo.h"
 
 #include <algorithm>
+#include <stdexcept>
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 using namespace std;
 using namespace ant;
@@ -165,3 +173,132 @@ void hadd::MergeRecursive(TDirectory& target, const hadd::sources_t& sources, un
         }
 
 }
+
+void hadd::MergeFiles(const string& outputfile, const vector<string>& inputfiles, unsigned& nPaths,
+                      bool skipBroken)
+{
+    auto target = std_ext::make_unique<TFile>(outputfile.c_str(), "RECREATE");
+    if(target->IsZombie())
+        throw std::runtime_error("Cannot create output file " + outputfile);
+
+    sources_t sources;
+    for(const auto& filename : inputfiles) {
+        auto source = std_ext::make_unique<TFile>(filename.c_str(), "READ");
+        if(source->IsZombie()) {
+            if(!skipBroken)
+                throw std::runtime_error("Cannot open input file " + filename);
+            LOG(WARNING) << "Skipping input file " << filename << ", cannot be opened";
+            continue;
+        }
+        sources.emplace_back(move(source));
+    }
+
+    MergeRecursive(*target, sources, nPaths);
+
+    target->Write();
+}
+
+namespace {
+
+// a node in the merge tree, intermediate results
+// are removed once no later merge refers to them
+struct merge_node_t {
+    string Filename;
+    shared_ptr<const tmpfile_t> TmpFile;
+    explicit merge_node_t(const string& filename) : Filename(filename) {}
+    explicit merge_node_t(shared_ptr<const tmpfile_t> tmpfile) :
+        Filename(tmpfile->filename), TmpFile(move(tmpfile)) {}
+};
+
+// waits for one worker, returns false if it failed
+bool wait_for_worker() {
+    int status = 0;
+    if(::wait(addressof(status)) < 0)
+        throw std::runtime_error("Waiting for merge worker failed");
+    return WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+}
+
+}
+
+void hadd::MergeParallel(const string& outputfile, const vector<string>& inputfiles,
+                         unsigned jobs, unsigned maxOpenFiles, unsigned& nPaths,
+                         bool skipBroken)
+{
+    if(maxOpenFiles < 2)
+        throw std::runtime_error("Merging requires at least two open files per merge");
+    jobs = std::max(jobs, 1u);
+
+    tmpfolder_t tmpfolder;
+
+    vector<merge_node_t> level;
+    for(const auto& inputfile : inputfiles)
+        level.emplace_back(inputfile);
+
+    unsigned nLevel = 0;
+    while(level.size() > maxOpenFiles) {
+
+        // split into contiguous groups of (almost) equal size
+        const auto nGroups = (level.size() + maxOpenFiles - 1)/maxOpenFiles;
+        LOG(INFO) << "Merge level " << nLevel << ": " << level.size()
+                  << " files in " << nGroups << " partial merges";
+
+        vector<merge_node_t> next_level;
+        unsigned nRunning = 0;
+        bool failed = false;
+
+        for(size_t g=0; g<nGroups; g++) {
+            const auto begin = next(level.begin(), g*level.size()/nGroups);
+            const auto end   = next(level.begin(), (g+1)*level.size()/nGroups);
+
+            // nothing to merge, just pass it to the next level
+            if(distance(begin, end) == 1) {
+                next_level.emplace_back(*begin);
+                continue;
+            }
+
+            vector<string> group;
+            for(auto it = begin; it != end; ++it)
+                group.emplace_back(it->Filename);
+
+            shared_ptr<const tmpfile_t> tmpfile = make_shared<tmpfile_t>(tmpfolder, ".root");
+            next_level.emplace_back(tmpfile);
+
+            while(nRunning >= jobs) {
+                failed |= !wait_for_worker();
+                nRunning--;
+            }
+
+            const auto pid = fork();
+            if(pid < 0)
+                throw std::runtime_error("Cannot fork merge worker");
+            if(pid == 0) {
+                // in worker process, never return to the caller
+                try {
+                    MergeFiles(tmpfile->filename, group, nPaths, skipBroken);
+                }
+                catch(const std::exception& e) {
+                    LOG(ERROR) << "Partial merge into " << tmpfile->filename << " failed: " << e.what();
+                    _exit(EXIT_FAILURE);
+                }
+                _exit(EXIT_SUCCESS);
+            }
+            nRunning++;
+        }
+
+        while(nRunning > 0) {
+            failed |= !wait_for_worker();
+            nRunning--;
+        }
+
+        if(failed)
+            throw std::runtime_error("At least one partial merge failed in level " + to_string(nLevel));
+
+        level = move(next_level);
+        nLevel++;
+    }
+
+    vector<string> lastgroup;
+    for(const auto& node : level)
+        lastgroup.emplace_back(node.Filename);
+    MergeFiles(outputfile, lastgroup, nPaths, skipBroken);
+}
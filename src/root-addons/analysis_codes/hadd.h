@@ -3,6 +3,7 @@
 #include "TDirectory.h"
 #include <memory>
 #include <vector>
+#include <string>
 
 namespace ant {
 
@@ -14,6 +15,33 @@ struct hadd {
 
     static void MergeRecursive(TDirectory& target, const sources_t& sources, unsigned& nPaths);
 
+    /**
+     * @brief MergeFiles opens all inputfiles and merges them into outputfile using MergeRecursive
+     * @param outputfile filename of the merged file, is recreated
+     * @param inputfiles filenames of the files to be merged
+     * @param nPaths counter for merged directories
+     * @param skipBroken skip input files which cannot be opened instead of throwing
+     */
+    static void MergeFiles(const std::string& outputfile, const std::vector<std::string>& inputfiles, unsigned& nPaths,
+                           bool skipBroken = false);
+
+    /**
+     * @brief MergeParallel merges the inputfiles in a balanced tree of partial merges
+     * @param outputfile filename of the merged file, is recreated
+     * @param inputfiles filenames of the files to be merged
+     * @param jobs number of partial merges running concurrently as forked worker processes
+     * @param maxOpenFiles maximum number of files opened by one (partial) merge, at least 2
+     * @param nPaths counter for merged directories
+     * @param skipBroken skip input files which cannot be opened instead of throwing
+     *
+     * Each partial merge uses MergeFiles and writes into a temporary file, which is removed
+     * as soon as the next level of the tree has been merged. The final merge of the
+     * remaining files runs in the calling process.
+     */
+    static void MergeParallel(const std::string& outputfile, const std::vector<std::string>& inputfiles,
+                              unsigned jobs, unsigned maxOpenFiles, unsigned& nPaths,
+                              bool skipBroken = false);
+
 };
 
 }
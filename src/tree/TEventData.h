@@ -33,6 +33,15 @@ struct TEventData
     TCandidateList   Candidates;
     TParticleTree_t  ParticleTree; // only on MC
 
+    // sums the trigger simulation is based on, filled during reconstruction
+    // not serialized, so not set for events read from file
+    struct TriggerSums_t {
+        bool  IsSet = false;
+        mev_t CBEnergySum = std_ext::NaN; // weighted sum of calibrated CB energies
+        ns_t  CBTiming = std_ext::NaN;    // energy weighted timing of CB clusters
+    };
+    TriggerSums_t TriggerSums;
+
     template<class Archive>
     void serialize(Archive& archive) {
         archive(ID,
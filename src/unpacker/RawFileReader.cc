@@ -3,7 +3,9 @@
 #include "base/Logger.h"
 #include "base/std_ext/memory.h"
 
+#include <algorithm>
 #include <cstdio> // for BUFSIZ
+#include <cstdlib> // for free
 #include <cstring> // for strerror
 #include <limits>
 #include <iomanip>
@@ -83,8 +85,28 @@ RawFileReader::progress_t RawFileReader::MakeProgressCounter()
     return std_ext::make_unique<ProgressCounter>(updater);
 }
 
+void RawFileReader::PlainBase::discard(streamsize n)
+{
+    vector<char> scratch(std::min<streamsize>(n, 1 << 16));
+    while(n>0) {
+        read(scratch.data(), std::min<streamsize>(n, scratch.size()));
+        if(gcount() == 0)
+            throw Exception("Cannot seek beyond end of file");
+        n -= gcount();
+    }
+}
+
 struct RawFileReader::XZ::lzma_stream : ::lzma_stream {};
 
+struct RawFileReader::XZ::block_index {
+    lzma_index* index = nullptr;
+    lzma_index_iter iter;
+    lzma_stream_flags flags;
+    lzma_block block;
+    lzma_filter filters[LZMA_FILTERS_MAX + 1];
+    ~block_index() { lzma_index_end(index, nullptr); }
+};
+
 RawFileReader::XZ::XZ(const std::string &filename, const size_t inbufsize) :
     PlainBase(filename),
     inbuf(inbufsize),
@@ -119,6 +141,7 @@ void RawFileReader::XZ::init_decoder()
     // using C-style init is a bit messy in C++
     using lzma_stream_pod = ::lzma_stream;
     auto ptr = reinterpret_cast<lzma_stream_pod*>(strm.get());
+    lzma_end(ptr); // in case of re-initialization
     *ptr = LZMA_STREAM_INIT;
 
     lzma_ret ret = lzma_stream_decoder(strm.get(), UINT64_MAX, LZMA_CONCATENATED);
@@ -168,8 +191,17 @@ void RawFileReader::XZ::read(char* s, streamsize n) {
 
         lzma_ret ret = lzma_code(strm.get(), action);
 
-        if(ret == LZMA_STREAM_END) {
+        if(ret == LZMA_STREAM_END && in_block
+           && !lzma_index_iter_next(&blocks->iter, LZMA_INDEX_ITER_BLOCK)) {
+            // after seeking, blocks are decoded one by one
+            start_block();
+            action = LZMA_RUN;
+            if(strm->avail_out > 0)
+                continue;
+        }
+        else if(ret == LZMA_STREAM_END) {
             gcount_ = n - strm->avail_out; // number of decompressed bytes
+            pos_ += gcount_;
             if(strm->avail_out > 0)
                 eof_ = true;
             return;
@@ -177,6 +209,7 @@ void RawFileReader::XZ::read(char* s, streamsize n) {
 
         if(strm->avail_out == 0) {
             gcount_ = n;
+            pos_ += gcount_;
             return;
         }
 
@@ -214,7 +247,117 @@ void RawFileReader::XZ::read(char* s, streamsize n) {
     }
 }
 
+void RawFileReader::XZ::read_block_index()
+{
+    blocks_read = true;
+
+    // the index is located in front of the stream footer at the end of the file
+    const streamsize filesize = filesize_total();
+    if(filesize < 2*LZMA_STREAM_HEADER_SIZE)
+        return;
 
+    // the sequential decoder continues where it stopped
+    struct restore_pos_t {
+        PlainBase& file;
+        const streamsize pos;
+        ~restore_pos_t() { file.PlainBase::reset(pos); }
+    } restore_pos{*this, PlainBase::pos()};
+
+    deleted_unique_ptr<block_index> b(new block_index(), [] (block_index* b) { delete b; });
+
+    uint8_t footer[LZMA_STREAM_HEADER_SIZE];
+    PlainBase::reset(filesize - LZMA_STREAM_HEADER_SIZE);
+    PlainBase::read(reinterpret_cast<char*>(footer), sizeof(footer));
+    if(PlainBase::gcount() != sizeof(footer)
+       || lzma_stream_footer_decode(&b->flags, footer) != LZMA_OK)
+        return;
+
+    const streamsize index_size = b->flags.backward_size;
+    if(index_size + 2*LZMA_STREAM_HEADER_SIZE > filesize)
+        return;
+
+    vector<uint8_t> index_buffer(index_size);
+    PlainBase::reset(filesize - LZMA_STREAM_HEADER_SIZE - index_size);
+    PlainBase::read(reinterpret_cast<char*>(index_buffer.data()), index_buffer.size());
+    if(PlainBase::gcount() != index_size)
+        return;
+
+    uint64_t memlimit = UINT64_MAX;
+    size_t in_pos = 0;
+    if(lzma_index_buffer_decode(&b->index, &memlimit, nullptr,
+                                index_buffer.data(), &in_pos, index_buffer.size()) != LZMA_OK)
+        return;
+
+    // concatenated streams or stream padding are not handled,
+    // and single block files do not profit from the index
+    if(lzma_index_file_size(b->index) != static_cast<lzma_vli>(filesize)
+       || lzma_index_block_count(b->index) < 2) {
+        VLOG(5) << "XZ file not seekable by blocks, fall back to decompressing from start";
+        return;
+    }
+
+    blocks = move(b);
+}
+
+void RawFileReader::XZ::start_block()
+{
+    block_index& b = *blocks;
+
+    PlainBase::reset(b.iter.block.compressed_file_offset);
+
+    uint8_t header[LZMA_BLOCK_HEADER_SIZE_MAX];
+    PlainBase::read(reinterpret_cast<char*>(header), 1);
+
+    b.block = lzma_block();
+    b.block.version = 0;
+    b.block.check = b.flags.check;
+    b.block.filters = b.filters;
+    b.block.header_size = lzma_block_header_size_decode(header[0]);
+
+    const streamsize remaining = b.block.header_size - 1;
+    PlainBase::read(reinterpret_cast<char*>(&header[1]), remaining);
+    if(PlainBase::gcount() != remaining
+       || lzma_block_header_decode(addressof(b.block), nullptr, header) != LZMA_OK) {
+        decompressFailed = true;
+        throw Exception("Cannot decode xz block header");
+    }
+
+    const lzma_ret ret = lzma_block_decoder(strm.get(), addressof(b.block));
+    // the decoder keeps its own copy of the filter options
+    for(size_t i=0; b.filters[i].id != LZMA_VLI_UNKNOWN; i++)
+        free(b.filters[i].options);
+    if(ret != LZMA_OK) {
+        decompressFailed = true;
+        throw Exception("Cannot initialize xz block decoder");
+    }
+
+    strm->avail_in = 0;
+    eof_ = false;
+    in_block = true;
+}
+
+void RawFileReader::XZ::seek(streamsize pos)
+{
+    if(!blocks_read)
+        read_block_index();
+
+    if(blocks) {
+        lzma_index_iter_init(&blocks->iter, blocks->index);
+        if(lzma_index_iter_locate(&blocks->iter, pos))
+            throw Exception("Cannot seek beyond end of file");
+        // only restart if we can't simply continue from the current position
+        const streamsize block_start = blocks->iter.block.uncompressed_file_offset;
+        if(pos < pos_ || pos_ < block_start) {
+            start_block();
+            pos_ = block_start;
+        }
+    }
+    else if(pos < pos_) {
+        reset();
+    }
+
+    discard(pos - pos_);
+}
 
 
 
@@ -252,6 +395,7 @@ bool RawFileReader::GZ::test(ifstream& file) {
 
 void RawFileReader::GZ::init_decoder()
 {
+    inflateEnd(strm.get()); // in case of re-initialization, harmless otherwise
 
     strm->zalloc   = Z_NULL;
     strm->zfree    = Z_NULL;
@@ -283,7 +427,9 @@ void RawFileReader::GZ::init_decoder()
 
 void RawFileReader::GZ::read(char* s, streamsize n) {
 
-    auto action = PlainBase::eof() ? Z_FINISH : Z_NO_FLUSH;
+    // recording access points needs to stop at each deflate block boundary
+    const auto action_finish = points_span>0 ? Z_BLOCK : Z_FINISH;
+    auto action = PlainBase::eof() ? action_finish : (points_span>0 ? Z_BLOCK : Z_NO_FLUSH);
 
     strm->next_out = reinterpret_cast<uint8_t*>(s);
     strm->avail_out = n;
@@ -300,7 +446,7 @@ void RawFileReader::GZ::read(char* s, streamsize n) {
             gcount_compressed_ += strm->avail_in;
 
             if(PlainBase::eof()) {
-                action = Z_FINISH;
+                action = action_finish;
             }
             else if (!PlainBase::operator bool()) {
                 throw Exception(string("Error while reading from compressed input file: ")
@@ -308,10 +454,19 @@ void RawFileReader::GZ::read(char* s, streamsize n) {
             }
         }
 
+        const auto next_out = strm->next_out;
         int ret = inflate(strm.get(), action);
 
+        if(points_span>0) {
+            update_window(next_out, strm->next_out - next_out);
+            // at the end of a deflate block header, but not the last one
+            if((strm->data_type & 128) && !(strm->data_type & 64))
+                add_access_point(pos_ + n - strm->avail_out);
+        }
+
         if(ret == Z_STREAM_END) {
             gcount_ = n - strm->avail_out; // number of decompressed bytes
+            pos_ += gcount_;
             if(strm->avail_out > 0)
                 eof_ = true;
             return;
@@ -319,6 +474,7 @@ void RawFileReader::GZ::read(char* s, streamsize n) {
 
         if(strm->avail_out == 0) {
             gcount_ = n;
+            pos_ += gcount_;
             return;
         }
 
@@ -353,3 +509,84 @@ void RawFileReader::GZ::read(char* s, streamsize n) {
         }
     }
 }
+
+void RawFileReader::GZ::enable_access_points(streamsize span)
+{
+    points_span = span;
+    window.resize(1 << 15); // maximum deflate window
+    window_filled = 0;
+}
+
+void RawFileReader::GZ::update_window(const uint8_t* out, streamsize n)
+{
+    const streamsize size = window.size();
+    if(n > size) {
+        out += n - size;
+        window_filled += n - size;
+        n = size;
+    }
+    while(n>0) {
+        const streamsize p = window_filled % size;
+        const streamsize c = std::min(n, size - p);
+        copy(out, out+c, &window[p]);
+        out += c;
+        n -= c;
+        window_filled += c;
+    }
+}
+
+void RawFileReader::GZ::add_access_point(streamsize out_pos)
+{
+    // window must be completely known
+    const streamsize size = window.size();
+    if(window_filled < size)
+        return;
+    if(!points.empty() && out_pos < points.back().Uncompressed + points_span)
+        return;
+
+    AccessPoint point;
+    point.Uncompressed = out_pos;
+    point.Compressed = PlainBase::pos() - strm->avail_in;
+    point.Bits = strm->data_type & 7;
+    // unroll the ring buffer
+    const streamsize p = window_filled % size;
+    point.Window.reserve(size);
+    point.Window.insert(point.Window.end(), next(window.begin(), p), window.end());
+    point.Window.insert(point.Window.end(), window.begin(), next(window.begin(), p));
+    points.emplace_back(move(point));
+}
+
+void RawFileReader::GZ::seek(streamsize pos)
+{
+    auto it_point = upper_bound(points.begin(), points.end(), pos,
+                                [] (streamsize pos, const AccessPoint& p) { return pos < p.Uncompressed; });
+    const AccessPoint* point = it_point == points.begin() ? nullptr : addressof(*prev(it_point));
+    const streamsize restart = point ? point->Uncompressed : 0;
+
+    // only restart if we can't simply continue from the current position
+    if(pos < pos_ || pos_ < restart) {
+        if(point) {
+            // see zran.c, restart raw inflate in the middle of the compressed stream
+            const int bits = point->Bits;
+            PlainBase::reset(point->Compressed - (bits ? 1 : 0));
+            if(inflateReset2(strm.get(), -15) != Z_OK)
+                throw Exception("Cannot reset gz decoder");
+            strm->avail_in = 0;
+            if(bits) {
+                char c;
+                PlainBase::read(&c, 1);
+                inflatePrime(strm.get(), bits, static_cast<uint8_t>(c) >> (8 - bits));
+            }
+            inflateSetDictionary(strm.get(), point->Window.data(), point->Window.size());
+            pos_ = point->Uncompressed;
+            gcount_ = 0;
+            eof_ = false;
+            window_filled = 0;
+        }
+        else {
+            reset();
+        }
+    }
+
+    discard(pos - pos_);
+}
@@ -96,6 +96,62 @@ public:
         p->reset();
     }
 
+    /**
+     * @brief An AccessPoint allows restarting decompression in the middle of a file
+     *
+     * Only needed for gz files, where the decoder state at a deflate block boundary
+     * is the bit offset into the compressed data plus the preceding 32k window
+     */
+    struct AccessPoint {
+        std::int64_t  Uncompressed = 0;
+        std::int64_t  Compressed = 0;
+        std::uint8_t  Bits = 0;
+        std::vector<std::uint8_t> Window;
+
+        template<class Archive>
+        void serialize(Archive& archive) {
+            archive(Uncompressed, Compressed, Bits, Window);
+        }
+    };
+
+    /**
+     * @brief record access points every span uncompressed bytes while reading
+     * @param span
+     *
+     * Ignored for plain and xz files, which can be seeked without further help
+     */
+    void EnableAccessPoints(std::streamsize span = 16 << 20) {
+        p->enable_access_points(span);
+    }
+
+    std::vector<AccessPoint> GetAccessPoints() const {
+        return p->get_access_points();
+    }
+
+    void SetAccessPoints(std::vector<AccessPoint> points) {
+        p->set_access_points(std::move(points));
+    }
+
+    /**
+     * @brief seek to the given position in the uncompressed data
+     * @param pos byte offset
+     *
+     * Plain files simply seek, xz files jump to the enclosing xz block (if the file
+     * consists of several blocks) and gz files restart at the closest access point.
+     * The remaining bytes are decompressed and discarded.
+     */
+    void seek(std::streamsize pos) {
+        p->seek(pos);
+    }
+
+    /**
+     * @brief tell the current position
+     * @return byte offset in the uncompressed data
+     */
+    std::streamsize tell() const {
+        return p->tell();
+    }
+
     class Exception : public std::runtime_error {
         using std::runtime_error::runtime_error; // use base class constructor
     };
@@ -141,10 +197,19 @@ private:
         // reset called with an argument for plain files resets the streamer pointer not
         // to the beginning of the file, but to the specified position
         virtual void reset(std::streamsize val) {
+            file.clear(); // seekg fails if reading hit the end of file before
             file.seekg(val, std::ios_base::beg);
             gcount_total = val;
         }
 
+        virtual void seek(std::streamsize pos) {
+            reset(pos);
+        }
+
+        virtual void enable_access_points(std::streamsize) {}
+        virtual std::vector<AccessPoint> get_access_points() const { return {}; }
+        virtual void set_access_points(std::vector<AccessPoint>) {}
+
         virtual bool eof() const {
             return file.eof();
         }
@@ -170,6 +235,13 @@ private:
 
         virtual std::streamsize pos() const { return gcount_total; }
 
+        // position in uncompressed data
+        virtual std::streamsize tell() const { return gcount_total; }
+
+    protected:
+        // read and throw away n bytes, used by seek of the compressed readers
+        void discard(std::streamsize n);
+
     private:
         std::ifstream file;
         std::streamsize filesize;
@@ -203,9 +275,17 @@ private:
             gcount_ = 0;
             gcount_compressed_ = 0;
             eof_ = false;
+            pos_ = 0;
+            in_block = false;
             init_decoder();
         }
 
+        virtual void seek(std::streamsize pos) override;
+
+        virtual std::streamsize tell() const override {
+            return pos_;
+        }
+
         virtual std::streamsize gcount() const override {
             return gcount_;
         }
@@ -224,6 +304,7 @@ private:
         std::streamsize gcount_;
         std::streamsize gcount_compressed_;
         bool eof_;
+        std::streamsize pos_ = 0; // position in uncompressed data
 
         template<typename T>
         using deleted_unique_ptr = std::unique_ptr<T, std::function<void(T*)>>;
@@ -232,6 +313,14 @@ private:
         deleted_unique_ptr<lzma_stream> strm;
         void init_decoder();
 
+        // block index of the xz file, read on first seek
+        struct block_index;
+        deleted_unique_ptr<block_index> blocks;
+        bool blocks_read = false;
+        bool in_block = false; // decoding single blocks after seek
+        void read_block_index();
+        void start_block();
+
     }; // class RawFileReader::XZ
 
 
@@ -255,9 +344,24 @@ private:
             gcount_ = 0;
             gcount_compressed_ = 0;
             eof_ = false;
+            pos_ = 0;
             init_decoder();
         }
 
+        virtual void seek(std::streamsize pos) override;
+
+        virtual std::streamsize tell() const override {
+            return pos_;
+        }
+
+        virtual void enable_access_points(std::streamsize span) override;
+        virtual std::vector<AccessPoint> get_access_points() const override {
+            return points;
+        }
+        virtual void set_access_points(std::vector<AccessPoint> points_) override {
+            points = std::move(points_);
+        }
+
         virtual std::streamsize gcount() const override {
             return gcount_;
         }
@@ -276,6 +380,7 @@ private:
         std::streamsize gcount_;
         std::streamsize gcount_compressed_;
         bool eof_;
+        std::streamsize pos_ = 0; // position in uncompressed data
 
         template<typename T>
         using deleted_unique_ptr = std::unique_ptr<T, std::function<void(T*)>>;
@@ -284,6 +389,14 @@ private:
         deleted_unique_ptr<gz_stream> strm;
         void init_decoder();
 
+        // access point recording, see zlib's examples/zran.c
+        std::vector<AccessPoint> points;
+        std::streamsize points_span = 0; // 0 means disabled
+        std::vector<uint8_t> window;     // ring buffer of last output
+        std::streamsize window_filled = 0;
+        void update_window(const uint8_t* out, std::streamsize n);
+        void add_access_point(std::streamsize out_pos);
+
     }; // class RawFileReader::GZ
 
 
@@ -0,0 +1,65 @@
+#include "TIDIndex.h"
+
+#include "base/std_ext/string.h"
+
+#include "cereal/cereal.hpp"
+#include "cereal/archives/binary.hpp"
+#include "cereal/types/vector.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+using namespace std;
+using namespace ant;
+
+namespace {
+// identifies the sidecar file, increase version if layout changes
+const string magic = "AntTIDIndex1";
+}
+
+const TIDIndex::Record_t* TIDIndex::Find(const TID& id) const
+{
+    auto it = upper_bound(Records.begin(), Records.end(), id,
+                          [] (const TID& id, const Record_t& r) { return id < r.FirstID; });
+    if(it == Records.begin())
+        return nullptr;
+    const Record_t& record = *prev(it);
+    if(record.FirstID.Flags != id.Flags)
+        return nullptr;
+    if(id.Value() - record.FirstID.Value() >= record.nIDs)
+        return nullptr;
+    return addressof(record);
+}
+
+void TIDIndex::Save(const string& filename) const
+{
+    ofstream file(filename, ios::binary);
+    if(!file)
+        throw Exception(std_ext::formatter() << "Cannot open " << filename << " for writing");
+    file.write(magic.data(), magic.size());
+    cereal::BinaryOutputArchive ar(file);
+    ar(*this);
+    if(!file)
+        throw Exception(std_ext::formatter() << "Error while writing " << filename);
+}
+
+TIDIndex TIDIndex::Load(const string& filename)
+{
+    ifstream file(filename, ios::binary);
+    if(!file)
+        throw Exception(std_ext::formatter() << "Cannot open " << filename);
+    string header(magic.size(), '\0');
+    file.read(&header[0], header.size());
+    if(header != magic)
+        throw Exception(std_ext::formatter() << filename << " is not a TID index file");
+    TIDIndex index;
+    try {
+        cereal::BinaryInputArchive ar(file);
+        ar(index);
+    }
+    catch(cereal::Exception& e) {
+        throw Exception(std_ext::formatter() << "Error while reading " << filename << ": " << e.what());
+    }
+    return index;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "RawFileReader.h"
+#include "tree/TID.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ant {
+
+/**
+ * @brief The TIDIndex maps TIDs to records in a raw file
+ *
+ * It is written as a sidecar file next to the raw file while unpacking it
+ * sequentially, and allows to jump directly to the record containing a
+ * requested TID afterwards. For gz compressed files, it also stores the
+ * access points needed by RawFileReader::seek
+ */
+struct TIDIndex {
+
+    struct Record_t {
+        TID           FirstID;  // ID of first event unpacked from record
+        std::uint32_t nIDs = 0; // number of IDs assigned while unpacking the record
+        std::uint32_t State = 0;// unpacker state before the record (last Acqu event ID)
+        std::int64_t  Offset = 0; // byte offset of record in uncompressed file
+
+        Record_t() = default;
+        Record_t(const TID& firstID, std::uint32_t state, std::int64_t offset) :
+            FirstID(firstID), State(state), Offset(offset) {}
+
+        template<class Archive>
+        void serialize(Archive& archive) {
+            archive(FirstID, nIDs, State, Offset);
+        }
+    };
+
+    std::uint32_t RecordLength = 0; // in bytes
+    std::vector<Record_t> Records;  // sorted by FirstID
+    std::vector<RawFileReader::AccessPoint> AccessPoints;
+
+    /**
+     * @brief Find the record which contains the given id
+     * @return pointer to record, or nullptr if not found
+     */
+    const Record_t* Find(const TID& id) const;
+
+    static std::string GetFilename(const std::string& rawfile) {
+        return rawfile + ".tidx";
+    }
+
+    void Save(const std::string& filename) const;
+    static TIDIndex Load(const std::string& filename);
+
+    template<class Archive>
+    void serialize(Archive& archive) {
+        archive(RecordLength, Records, AccessPoints);
+    }
+
+    class Exception : public std::runtime_error {
+        using std::runtime_error::runtime_error; // use base class constructor
+    };
+};
+
+} // namespace ant
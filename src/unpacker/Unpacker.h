@@ -24,10 +24,12 @@
 #include <string>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace ant {
 
 struct TEvent;
+struct TID;
 
 /**
  * @brief The Unpacker class encapsulates the interface for unpacking raw data
@@ -48,6 +50,21 @@ public:
         virtual TEvent NextEvent() = 0;
         virtual double PercentDone() const = 0;
         virtual bool   ProvidesSlowControl() const = 0;
+
+        /**
+         * @brief WriteTIDIndex enables writing an index for SelectTIDs while unpacking
+         * @return false if not supported by unpacker
+         */
+        virtual bool WriteTIDIndex() { return false; }
+
+        /**
+         * @brief SelectTIDs makes NextEvent() return only events with the given TIDs
+         * @param tids list of TIDs
+         * @return false if not supported by unpacker or if no index is available
+         *
+         * The returned events are the same as reading the file sequentially
+         */
+        virtual bool SelectTIDs(const std::vector<TID>&) { return false; }
     protected:
         friend class Unpacker;
         virtual bool OpenFile(const std::string& filename) = 0;
@@ -1,5 +1,6 @@
 #include "UnpackerAcqu.h"
 #include "detail/UnpackerAcqu_detail.h"
+#include "TIDIndex.h"
 
 #include "tree/TEvent.h"
 #include "base/Logger.h"
@@ -27,9 +28,30 @@ bool UnpackerAcqu::OpenFile(const std::string &filename)
         return false;
 
     LOG(INFO) << "Successfully opened " << filename;
+    this->filename = filename;
     return true;
 }
 
+bool UnpackerAcqu::WriteTIDIndex()
+{
+    file->WriteIndex(TIDIndex::GetFilename(filename));
+    return true;
+}
+
+bool UnpackerAcqu::SelectTIDs(const std::vector<TID>& tids)
+{
+    const auto indexfile = TIDIndex::GetFilename(filename);
+    try {
+        tids_selected = file->SelectIDs(TIDIndex::Load(indexfile), tids);
+    }
+    catch(TIDIndex::Exception& e) {
+        LOG(WARNING) << "Cannot use TID index: " << e.what();
+        return false;
+    }
+    LOG_IF(!tids_selected, WARNING) << "TID index " << indexfile << " does not match " << filename;
+    return tids_selected;
+}
+
 TEvent UnpackerAcqu::NextEvent()
 {
     // check if we need to replenish the queue
@@ -11,6 +11,7 @@
 #include <vector>
 #include <cstdint>
 #include <limits>
+#include <string>
 
 namespace ant {
 
@@ -22,7 +23,9 @@ public:
     UnpackerAcqu();
     virtual bool OpenFile(const std::string& filename) override;
     virtual TEvent NextEvent() override;
-    virtual bool ProvidesSlowControl() const override { return true; }
+    virtual bool ProvidesSlowControl() const override { return !tids_selected; }
+    virtual bool WriteTIDIndex() override;
+    virtual bool SelectTIDs(const std::vector<TID>& tids) override;
 
     class Exception : public Unpacker::Exception {
         using Unpacker::Exception::Exception; // use base class constructor
@@ -35,6 +38,8 @@ public:
 private:
     std::list<TEvent> queue; // std::list supports splice
     std::unique_ptr<UnpackerAcquFileFormat> file;
+    std::string filename;
+    bool tids_selected = false;
 
 };
 
@@ -14,6 +14,7 @@
 #include "base/Logger.h"
 #include "base/std_ext/misc.h"
 #include "RawFileReader.h"
+#include "TIDIndex.h"
 
 #include <algorithm>
 #include <exception>
@@ -141,9 +142,67 @@ acqu::FileFormatBase::~FileFormatBase()
 
 double acqu::FileFormatBase::PercentDone() const
 {
+    if(selection)
+        return double(next_record)/selected_records.size();
     return reader->PercentDone();
 }
 
+void acqu::FileFormatBase::WriteIndex(const string& filename)
+{
+    index = std_ext::make_unique<TIDIndex>();
+    index->RecordLength = 4*trueRecordLength;
+    index_filename = filename;
+    // only needed (and used) for gz files
+    reader->EnableAccessPoints();
+}
+
+void acqu::FileFormatBase::SaveIndex() noexcept
+{
+    index->AccessPoints = reader->GetAccessPoints();
+    try {
+        index->Save(index_filename);
+        LOG(INFO) << "Wrote TID index with " << index->Records.size() << " records to " << index_filename;
+    }
+    catch(TIDIndex::Exception& e) {
+        LOG(WARNING) << "Could not write TID index: " << e.what();
+    }
+    index = nullptr;
+}
+
+bool acqu::FileFormatBase::SelectIDs(TIDIndex index_, std::vector<TID> ids)
+{
+    // the first record starts with the ID derived from the header,
+    // this should be sufficient to detect a stale index
+    if(index_.RecordLength != 4*unsigned(trueRecordLength)
+       || index_.Records.empty()
+       || index_.Records.front().FirstID != id)
+        return false;
+
+    selection = std_ext::make_unique<TIDIndex>(move(index_));
+
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    selected_ids.clear();
+    selected_records.clear();
+    next_record = 0;
+    for(const TID& tid : ids) {
+        auto record = selection->Find(tid);
+        if(record == nullptr) {
+            LOG(WARNING) << "TID " << tid << " not found in index";
+            continue;
+        }
+        selected_ids.push_back(tid);
+        const size_t i = record - selection->Records.data();
+        if(selected_records.empty() || selected_records.back() != i)
+            selected_records.push_back(i);
+    }
+
+    reader->SetAccessPoints(selection->AccessPoints);
+    LOG(INFO) << "Selected " << selected_ids.size() << " TIDs from "
+              << selected_records.size() << " records";
+    return true;
+}
+
 time_t acqu::FileFormatBase::GetTimeStamp()
 {
     // the following calculation assumes
@@ -248,6 +307,11 @@ void acqu::FileFormatBase::FillEvents(queue_t& queue) noexcept
     // this method never throws exceptions, but just adds TUnpackerMessage to event
     // if something strange while unpacking is encountered
 
+    if(selection) {
+        FillSelectedEvents(queue);
+        return;
+    }
+
     // we use the buffer as some state-variable
     // if the buffer is already empty now, there is nothing more to read
     if(buffer.empty()) {
@@ -262,6 +326,10 @@ void acqu::FileFormatBase::FillEvents(queue_t& queue) noexcept
         return;
     }
 
+    // the buffer was just read completely
+    if(index)
+        index->Records.emplace_back(id, AcquID_last, reader->tell() - 4*trueRecordLength);
+
     // start parsing the filled buffer
     // however, we fill a temporary queue first
     auto it = buffer.cbegin();
@@ -291,6 +359,8 @@ void acqu::FileFormatBase::FillEvents(queue_t& queue) noexcept
 
     nUnpackedBuffers++;
 
+    if(index)
+        index->Records.back().nIDs = id.Value() - index->Records.back().FirstID.Value();
 
     // refill the buffer
     try {
@@ -321,6 +391,9 @@ void acqu::FileFormatBase::FillEvents(queue_t& queue) noexcept
         buffer.clear();
     }
 
+    if(buffer.empty() && index)
+        SaveIndex();
+
     // the above refill might have created messages,
     // and to suppress empty events with messages only,
     // we simply append them to the last event if any present
@@ -328,6 +401,53 @@ void acqu::FileFormatBase::FillEvents(queue_t& queue) noexcept
         AppendMessagesToEvent(queue.back());
 }
 
+void acqu::FileFormatBase::FillSelectedEvents(queue_t& queue) noexcept
+{
+    while(next_record < selected_records.size()) {
+        const size_t i = selected_records[next_record++];
+        const TIDIndex::Record_t& record = selection->Records[i];
+
+        try {
+            reader->seek(record.Offset);
+            buffer.resize(trueRecordLength);
+            reader->read(buffer.data(), trueRecordLength);
+        }
+        catch(ant::RawFileReader::Exception& e) {
+            LOG(WARNING) << "Error while reading record at offset " << record.Offset << ": " << e.what();
+            continue;
+        }
+        if(reader->gcount() != 4*trueRecordLength) {
+            LOG(WARNING) << "Could not read complete record at offset " << record.Offset;
+            continue;
+        }
+
+        // restore the state as if the file was unpacked sequentially,
+        // header messages only belong to the very first record
+        id = record.FirstID;
+        AcquID_last = record.State;
+        nUnpackedBuffers = i;
+        if(i>0)
+            messages.clear();
+
+        auto it = buffer.cbegin();
+        queue_t queue_buffer;
+        if(!UnpackDataBuffer(queue_buffer, it, buffer.cend())) {
+            LOG(WARNING) << "Error while unpacking buffer n=" << nUnpackedBuffers
+                         << ", discarding all unpacked data from buffer.";
+            continue;
+        }
+
+        queue_buffer.remove_if([this] (const TEvent& event) {
+            return !binary_search(selected_ids.begin(), selected_ids.end(), event.Reconstructed().ID);
+        });
+        queue.splice(queue.end(), move(queue_buffer));
+
+        if(!queue.empty())
+            return;
+    }
+    buffer.clear();
+}
+
 uint32_t acqu::FileFormatBase::GetDataBufferMarker() const
 {
     switch(info.Format) {
@@ -23,6 +23,7 @@ namespace ant {
 class RawFileReader;
 struct TEvent;
 struct TSlowControl;
+struct TIDIndex;
 
 class UnpackerAcquFileFormat {
 public:
@@ -44,6 +45,20 @@ public:
       */
     virtual void FillEvents(queue_t& queue) noexcept = 0;
 
+    /**
+      * @brief WriteIndex writes a TIDIndex to filename once the file is completely unpacked
+      * @param filename
+      */
+    virtual void WriteIndex(const std::string& filename) = 0;
+
+    /**
+      * @brief SelectIDs restricts FillEvents to the given ids, using the index to find them
+      * @param index
+      * @param ids
+      * @return false if the index does not belong to the file
+      */
+    virtual bool SelectIDs(TIDIndex index, std::vector<TID> ids) = 0;
+
     virtual ~UnpackerAcquFileFormat();
 
     virtual double PercentDone() const =0;
@@ -67,6 +82,9 @@ public:
 
     virtual double PercentDone() const override;
 
+    virtual void WriteIndex(const std::string& filename) override;
+    virtual bool SelectIDs(TIDIndex index, std::vector<TID> ids) override;
+
 private:
     std::unique_ptr<RawFileReader> reader;
     std::vector<std::uint32_t>     buffer;
@@ -78,6 +96,18 @@ private:
     unsigned nUnpackedBuffers;
     unsigned nEventsInBuffer;
     time_t GetTimeStamp();
+
+    // index writing during sequential unpacking
+    std::unique_ptr<TIDIndex> index;
+    std::string index_filename;
+    void SaveIndex() noexcept;
+
+    // random access to selected ids
+    std::unique_ptr<TIDIndex> selection;
+    std::vector<TID> selected_ids;
+    std::vector<size_t> selected_records; // indices into selection->Records
+    size_t next_record = 0;
+    void FillSelectedEvents(queue_t& queue) noexcept;
 protected:
 
     using reader_t = decltype(reader);
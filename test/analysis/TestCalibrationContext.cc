@@ -0,0 +1,197 @@
+#include "catch.hpp"
+
+#include "analysis/utils/CalibrationContext.h"
+#include "analysis/utils/Combinatorics.h"
+#include "analysis/physics/manager_t.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+#include "tree/TParticle.h"
+
+#include "base/std_ext/container.h"
+#include "base/std_ext/math.h"
+
+#include <map>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis;
+using namespace ant::analysis::utils;
+
+void dotest_photons();
+void dotest_readhits_clusters();
+void dotest_shared();
+
+TEST_CASE("CalibrationContext: Photons and pairs", "[analysis]") {
+    dotest_photons();
+}
+
+TEST_CASE("CalibrationContext: Read hits and clusters", "[analysis]") {
+    dotest_readhits_clusters();
+}
+
+TEST_CASE("CalibrationContext: Shared per event", "[analysis]") {
+    dotest_shared();
+}
+
+// some clusters, candidates and read hits as the reconstruction would provide them
+TEvent makeEvent() {
+    TEvent event(TID(0, 0));
+    auto& recon = event.Reconstructed();
+
+    using det_t = Detector_t::Type_t;
+    auto& clusters = recon.Clusters;
+    clusters.emplace_back(vec3(10, 0, 10), 150.0, 1.0, det_t::CB,   3);
+    clusters.emplace_back(vec3(0, 10, 10), 250.0, 2.0, det_t::CB,  17);
+    clusters.emplace_back(vec3(5, 5, 0),     1.5, 0.5, det_t::PID,  4);
+    clusters.emplace_back(vec3(-5, 0, 40), 350.0, 0.0, det_t::TAPS, 100);
+    clusters.emplace_back(vec3(-10, 5, 30), 80.0, 3.0, det_t::CB,  200);
+    clusters.emplace_back(vec3(3, 3, 50),    2.0, 1.0, det_t::TAPSVeto, 12);
+
+    auto cluster = [&clusters] (size_t i) {
+        return TClusterList{std::next(clusters.begin(), i)};
+    };
+    auto& cands = recon.Candidates;
+    auto deg = [] (double d) { return std_ext::degree_to_radian(d); };
+    cands.emplace_back(det_t::CB, 150.0, deg(45),  deg(0),   1.0, 3, 0.0, 0.0, cluster(0));
+    cands.emplace_back(Detector_t::Any_t(det_t::CB) | det_t::PID,
+                       250.0, deg(45), deg(90), 2.0, 5, 1.5, 0.0,
+                       TClusterList{std::next(clusters.begin(), 1), std::next(clusters.begin(), 2)});
+    cands.emplace_back(det_t::TAPS, 350.0, deg(10), deg(180), 0.0, 4, 0.0, 0.0, cluster(3));
+    cands.emplace_back(det_t::CB, 80.0, deg(70), deg(150), 3.0, 2, 0.0, 0.0, cluster(4));
+    // veto only, no calo cluster
+    cands.emplace_back(det_t::TAPSVeto, 0.0, deg(5), deg(45), 1.0, 1, 2.0, 0.0, cluster(5));
+
+    auto& readhits = recon.DetectorReadHits;
+    using ch_t = Channel_t::Type_t;
+    auto add = [&readhits] (det_t det, ch_t ch, unsigned channel, vector<double> values) {
+        readhits.emplace_back(LogicalChannel_t{det, ch, channel}, vector<uint8_t>{});
+        for(auto v : values)
+            readhits.back().Values.emplace_back(v);
+    };
+    add(det_t::CB, ch_t::Integral, 3, {150.0});
+    add(det_t::CB, ch_t::Timing, 3, {1.0, 20.0});
+    add(det_t::CB, ch_t::Integral, 17, {250.0});
+    add(det_t::CB, ch_t::Timing, 3, {-5.0});
+    add(det_t::CB, ch_t::IntegralShort, 17, {12.0});
+    add(det_t::PID, ch_t::Integral, 4, {1.5});
+    add(det_t::PID, ch_t::Timing, 5, {2.0});
+    add(det_t::TAPS, ch_t::IntegralShort, 100, {300.0});
+    return event;
+}
+
+void dotest_photons() {
+    const auto event = makeEvent();
+    CalibrationContext context(event);
+    const auto& cands = event.Reconstructed().Candidates;
+
+    const auto& photons = context.Photons();
+    REQUIRE(photons.size() == cands.size());
+    for(size_t i=0;i<cands.size();i++) {
+        const auto cand = cands.get_ptr_at(i);
+        REQUIRE(photons[i].Candidate == cand);
+        REQUIRE(photons[i].CaloCluster == cand->FindCaloCluster());
+        const TParticle g(ParticleTypeDatabase::Photon, cand);
+        REQUIRE(photons[i].Photon == g);
+    }
+    REQUIRE(photons.back().CaloCluster == nullptr);
+
+    // as the calibrations did before, with makeCombination over the candidates
+    const auto& pairs = context.PhotonPairs();
+    auto it_pair = pairs.begin();
+    for(auto comb = makeCombination(cands.get_ptr_list(),2); !comb.done(); ++comb) {
+        const TCandidatePtr& p1 = comb.at(0);
+        const TCandidatePtr& p2 = comb.at(1);
+        REQUIRE(it_pair != pairs.end());
+        REQUIRE(photons[it_pair->I].Candidate == p1);
+        REQUIRE(photons[it_pair->J].Candidate == p2);
+        const TParticle g1(ParticleTypeDatabase::Photon,p1);
+        const TParticle g2(ParticleTypeDatabase::Photon,p2);
+        REQUIRE(it_pair->IM == Approx((g1 + g2).M()));
+        REQUIRE(it_pair->OpeningAngle == Approx(vec3(*p1).Angle(*p2)));
+        ++it_pair;
+    }
+    REQUIRE(it_pair == pairs.end());
+    REQUIRE(pairs.size() == 10);
+
+    // built only once
+    REQUIRE(addressof(context.Photons()) == addressof(photons));
+    REQUIRE(context.PhotonPairs().size() == pairs.size());
+}
+
+void dotest_readhits_clusters() {
+    const auto event = makeEvent();
+    CalibrationContext context(event);
+
+    for(auto type : {Detector_t::Type_t::CB, Detector_t::Type_t::PID, Detector_t::Type_t::TAPS}) {
+
+        // as the calibrations did before, per channel
+        struct hitmapping_t {
+            vector<TDetectorReadHit::Value_t> Integrals;
+            vector<TDetectorReadHit::Value_t> Timings;
+        };
+        std::map<unsigned, hitmapping_t> hits;
+        for(const TDetectorReadHit& readhit : event.Reconstructed().DetectorReadHits) {
+            if(readhit.DetectorType != type)
+                continue;
+            auto& item = hits[readhit.Channel];
+            if(readhit.ChannelType == Channel_t::Type_t::Integral) {
+                std_ext::concatenate(item.Integrals, readhit.Values);
+            }
+            else if(readhit.ChannelType == Channel_t::Type_t::Timing) {
+                std_ext::concatenate(item.Timings, readhit.Values);
+            }
+        }
+
+        const auto& readhits = context.ReadHits(type);
+        // the old loop created channels of other channel types as well, with empty values
+        for(const auto& it_hit : hits) {
+            auto it_readhit = readhits.find(it_hit.first);
+            if(it_hit.second.Integrals.empty() && it_hit.second.Timings.empty()) {
+                if(it_readhit != readhits.end()) {
+                    CHECK(it_readhit->second.Integrals.empty());
+                    CHECK(it_readhit->second.Timings.empty());
+                }
+                continue;
+            }
+            REQUIRE(it_readhit != readhits.end());
+            auto values = [] (const vector<TDetectorReadHit::Value_t>& v) {
+                vector<double> r;
+                for(auto& value : v)
+                    r.push_back(value.Calibrated);
+                return r;
+            };
+            REQUIRE(values(it_readhit->second.Integrals) == values(it_hit.second.Integrals));
+            REQUIRE(values(it_readhit->second.Timings) == values(it_hit.second.Timings));
+        }
+        for(const auto& it_readhit : readhits)
+            REQUIRE(hits.find(it_readhit.first) != hits.end());
+
+        TClusterPtrList clusters;
+        for(auto cl : event.Reconstructed().Clusters.get_iter()) {
+            if(cl->DetectorType == type)
+                clusters.emplace_back(cl);
+        }
+        REQUIRE(context.Clusters(type) == clusters);
+    }
+
+    const auto& cb_hits = context.ReadHits(Detector_t::Type_t::CB);
+    REQUIRE(cb_hits.at(3).Timings.size() == 3);
+    REQUIRE(addressof(context.ReadHits(Detector_t::Type_t::CB)) == addressof(cb_hits));
+    REQUIRE(context.Clusters(Detector_t::Type_t::CB).size() == 3);
+    REQUIRE(context.Clusters(Detector_t::Type_t::TAPSVeto).size() == 1);
+    REQUIRE(context.Clusters(Detector_t::Type_t::MWPC0).empty());
+}
+
+void dotest_shared() {
+    const auto event = makeEvent();
+    physics::manager_t manager;
+
+    auto& context = CalibrationContext::Get(event, manager);
+    REQUIRE(addressof(CalibrationContext::Get(event, manager)) == addressof(context));
+
+    // a manager reused for another event gets a new context
+    const auto other = makeEvent();
+    auto& context_other = CalibrationContext::Get(other, manager);
+    REQUIRE(context_other.Photons().front().Candidate == other.Reconstructed().Candidates.get_ptr_at(0));
+}
@@ -0,0 +1,133 @@
+#include "catch.hpp"
+#include "catch_config.h"
+
+#include "analysis/utils/CoherentBremsstrahlung.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis::utils;
+
+void dotest_reference(unsigned nVec);
+void dotest_params();
+
+TEST_CASE("CoherentBremsstrahlung: Compare to reference, 1 vector", "[analysis]") {
+    dotest_reference(1);
+}
+
+TEST_CASE("CoherentBremsstrahlung: Compare to reference, 4 vectors", "[analysis]") {
+    dotest_reference(4);
+}
+
+TEST_CASE("CoherentBremsstrahlung: Parameters", "[analysis]") {
+    dotest_params();
+}
+
+// straightforward per-bin implementation as used before in Ant-makeLinPol
+void reference(const vector<double>& energies, const double* par, unsigned thetaSteps,
+               vector<double>& enh, vector<double>& pol)
+{
+    using P = CoherentBremsstrahlung;
+    const double k = 26.5601;
+    const auto n = energies.size();
+    enh.assign(n, 0);
+    vector<double> polSum(n), itotSum(n);
+    double weightSum = 0;
+    unsigned jbin = 0;
+    for(double j=par[P::Theta]-3.0*par[P::Sigma];j<=par[P::Theta]+3.001*par[P::Sigma];j+=(6.0*par[P::Sigma])/thetaSteps) {
+        const double weight = exp(-0.5*pow((j-par[P::Theta])/par[P::Sigma],2));
+        weightSum += weight;
+        for(size_t bin=0;bin<n;bin++) {
+            const double x = energies[bin]/par[P::E0MeV];
+            const double amo = 1/x;
+            double cohTotal = 0;
+            double phiTotal = 0;
+            for(int v=0;v<par[P::NVec];v++) {
+                const double g = P::Vectors[v];
+                const double xd = 1.0/((k/(g*par[P::E0MeV]*j))+1.0);
+                const double Q = (1.0-xd)/xd;
+                const double xc = xd/(1+((par[P::ThetaR]*par[P::ThetaR])*(1-xd)));
+                if(x>xd)
+                    continue;
+                const double phi = (2*Q*Q*x*x)/((1-x)*(1+((1-x)*(1-x))-((4*Q*Q*x*x/(1-x))*(((1-x)/(Q*x))-1))));
+                const double chi = ((Q*Q*x)/(1-x))*(1+((1-x)*(1-x))-((4*Q*Q*x*x/(1-x))*(((1-x)/(Q*x))-1)));
+                const double cd = 0.5*(1+erf((x-xc)/(sqrt(2)*par[P::SigmaR])));
+                const double cohContrib = cd*par[P::IVec+v]*chi;
+                cohTotal += cohContrib;
+                phiTotal += cohContrib*phi;
+            }
+            if(cohTotal>0.0)
+                phiTotal /= cohTotal;
+            enh[bin] += weight*(amo+cohTotal)/amo;
+            if(jbin <= thetaSteps) {
+                polSum[bin] += phiTotal*cohTotal*weight;
+                itotSum[bin] += (cohTotal+amo)*weight;
+            }
+        }
+        jbin++;
+    }
+    pol.resize(n);
+    for(size_t bin=0;bin<n;bin++) {
+        enh[bin] /= weightSum;
+        pol[bin] = polSum[bin]/itotSum[bin];
+    }
+}
+
+void dotest_reference(unsigned nVec) {
+    // tagger-like binning
+    vector<double> energies;
+    for(double e=100;e<850;e+=2.3)
+        energies.push_back(e);
+
+    auto par = CoherentBremsstrahlung::ParametersFromHuman(883, 350, 10, 2.5, 1.0, nVec);
+    REQUIRE(par.size() == CoherentBremsstrahlung::IVec+nVec);
+
+    const unsigned thetaSteps = 51;
+    CoherentBremsstrahlung model(energies, thetaSteps);
+    REQUIRE(model.GetNBins() == energies.size());
+
+    // same model must give same results for changed parameters
+    for(auto sigma_scale : {1.0, 2.5}) {
+        par[CoherentBremsstrahlung::Sigma] *= sigma_scale;
+
+        vector<double> enh, pol;
+        model.Calculate(par.data(), enh, pol);
+        vector<double> enh_ref, pol_ref;
+        reference(energies, par.data(), thetaSteps, enh_ref, pol_ref);
+
+        REQUIRE(enh.size() == energies.size());
+        REQUIRE(pol.size() == energies.size());
+
+        unsigned nEnhanced = 0;
+        for(size_t i=0;i<energies.size();i++) {
+            REQUIRE(enh[i] == Approx(enh_ref[i]).epsilon(1e-10));
+            REQUIRE(pol[i] == Approx(pol_ref[i]).epsilon(1e-10));
+            REQUIRE(pol[i] >= 0);
+            REQUIRE(pol[i] < 1);
+            if(enh[i] > 1.01)
+                nEnhanced++;
+        }
+        // the edge is somewhere in between
+        REQUIRE(nEnhanced > 10);
+        REQUIRE(nEnhanced < energies.size());
+    }
+}
+
+void dotest_params() {
+    auto par = CoherentBremsstrahlung::ParametersFromHuman(1557, 450, 10, 2.5, 1.0, 3);
+    REQUIRE(par[CoherentBremsstrahlung::E0MeV] == Approx(1557));
+    REQUIRE(par[CoherentBremsstrahlung::NVec] == Approx(3));
+    REQUIRE(par[CoherentBremsstrahlung::Theta] > 0);
+    REQUIRE(par[CoherentBremsstrahlung::Sigma] > 0);
+    REQUIRE(par[CoherentBremsstrahlung::IVec] == Approx(1.0));
+
+    // the edge of the first vector is at given photon energy for the main angle
+    const double g = CoherentBremsstrahlung::Vectors[0];
+    const double xd = 1.0/((26.5601/(g*1557*par[CoherentBremsstrahlung::Theta]))+1.0);
+    REQUIRE(xd*1557 == Approx(450));
+
+    REQUIRE_THROWS_AS(CoherentBremsstrahlung::ParametersFromHuman(1557, 450, 10, 2.5, 1.0, 6), std::invalid_argument);
+    REQUIRE_THROWS_AS(CoherentBremsstrahlung({}), std::invalid_argument);
+}
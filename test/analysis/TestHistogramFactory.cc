@@ -1,6 +1,7 @@
 #include "catch.hpp"
 
 #include "analysis/plot/HistogramFactory.h"
+#include "analysis/plot/HistogramBuffer.h"
 #include "base/WrapTFile.h"
 #include "base/tmpfile_t.h"
 
@@ -10,6 +11,8 @@
 #include "TGraph.h"
 #include "TTree.h"
 
+#include <thread>
+
 using namespace std;
 using namespace ant;
 using namespace ant::analysis;
@@ -17,6 +20,9 @@ using namespace ant::analysis;
 void dotest_make();
 void dotest_nameclash();
 void dotest_numdir();
+void dotest_buffered();
+void dotest_buffered_slots();
+void dotest_buffered_labels();
 
 
 TEST_CASE("HistogramFactory: Make", "[analysis]") {
@@ -32,6 +38,18 @@ TEST_CASE("HistogramFactory: Numbered directories", "[analysis]") {
     dotest_numdir();
 }
 
+TEST_CASE("HistogramFactory: Buffered filling", "[analysis]") {
+    dotest_buffered();
+}
+
+TEST_CASE("HistogramFactory: Buffered filling thread slots", "[analysis]") {
+    dotest_buffered_slots();
+}
+
+TEST_CASE("HistogramFactory: Buffered filling labels", "[analysis]") {
+    dotest_buffered_labels();
+}
+
 
 void dotest_make() {
     gDirectory->Clear();
@@ -100,3 +118,122 @@ void dotest_numdir() {
     // back in old dir
     REQUIRE(dynamic_cast<TDirectory*>(gDirectory->FindObject("Test_2")));
 }
+
+template<typename Hist>
+void require_equal(const Hist* h, const Hist* h_ref) {
+    REQUIRE(h->GetNcells() == h_ref->GetNcells());
+    for(int bin=0;bin<h->GetNcells();bin++) {
+        REQUIRE(h->GetBinContent(bin) == Approx(h_ref->GetBinContent(bin)));
+        REQUIRE(h->GetBinError(bin) == Approx(h_ref->GetBinError(bin)));
+    }
+    REQUIRE(h->GetEntries() == h_ref->GetEntries());
+    for(int axis=1;axis<=h->GetDimension();axis++) {
+        REQUIRE(h->GetMean(axis) == Approx(h_ref->GetMean(axis)));
+        REQUIRE(h->GetRMS(axis) == Approx(h_ref->GetRMS(axis)));
+    }
+}
+
+void dotest_buffered() {
+    gDirectory->Clear();
+
+    HistogramFactory h("Test");
+    HistogramFactory h_buffered("Buffered");
+    h_buffered.SetBufferedFilling();
+    // inherited by child factories
+    HistogramFactory h_child("Child", h_buffered);
+
+    auto h1_ref = h.makeTH1D("h1",{"",{50,{0,10}}});
+    auto h2_ref = h.makeTH2D("h2",{"",{50,{0,10}}},{"",{20,{-1,1}}});
+    // TH3D large enough to be buffered sparsely
+    auto h3_ref = h.makeTH3D("h3",{"",{60,{0,10}}},{"",{60,{-1,1}}},{"",{60,{0,1}}});
+
+    auto h1 = h_buffered.makeTH1D("h1",{"",{50,{0,10}}});
+    auto h2 = h_child.makeTH2D("h2",{"",{50,{0,10}}},{"",{20,{-1,1}}});
+    auto h3 = h_buffered.makeTH3D("h3",{"",{60,{0,10}}},{"",{60,{-1,1}}},{"",{60,{0,1}}});
+
+    // the buffered histograms are stored as usual ones
+    REQUIRE(h1->IsA() == TH1D::Class());
+    REQUIRE(h3->IsA() == TH3D::Class());
+
+    auto value = [] (int i, double scale) { return scale*((i*7919) % 1000)/1000.0 - scale/10; };
+
+    auto fill = [value] (TH1D* h1, TH2D* h2, TH3D* h3, int begin, int end) {
+        for(int i=begin;i<end;i++) {
+            const double x = value(i, 11);
+            const double y = value(i+1, 2.2)-1;
+            const double z = value(i+2, 1.1);
+            h1->Fill(x);
+            h1->Fill(x, 0.5);
+            h2->Fill(x, y, 2.0);
+            h3->Fill(x, y, z);
+        }
+    };
+
+    constexpr int n = 10000;
+    fill(h1_ref, h2_ref, h3_ref, 0, n);
+
+    vector<thread> threads;
+    constexpr int nThreads = 4;
+    for(int t=0;t<nThreads;t++)
+        threads.emplace_back(fill, h1, h2, h3, t*n/nThreads, (t+1)*n/nThreads);
+    for(auto& t : threads)
+        t.join();
+
+    HistogramFactory::FlushBuffers();
+
+    require_equal(h1, h1_ref);
+    require_equal(h2, h2_ref);
+    require_equal(h3, h3_ref);
+
+    // flushing again does not change anything
+    HistogramFactory::FlushBuffers();
+    require_equal(h1, h1_ref);
+}
+
+void dotest_buffered_slots() {
+    gDirectory->Clear();
+
+    HistogramFactory h("Test");
+    HistogramFactory h_buffered("Buffered");
+    h_buffered.SetBufferedFilling();
+
+    auto h1_ref = h.makeTH1D("h1",{"",{50,{0,10}}});
+    auto h1 = h_buffered.makeTH1D("h1",{"",{50,{0,10}}});
+
+    // many more short-lived threads than slots, each must get a lock-free one
+    constexpr unsigned nThreads = 3*HistogramBuffer::MaxThreads;
+    vector<unsigned> slots(nThreads);
+    for(unsigned t=0;t<nThreads;t++) {
+        const double x = 10.0*t/nThreads;
+        h1_ref->Fill(x);
+        thread([h1, x, &slots, t] () {
+            h1->Fill(x);
+            slots[t] = HistogramBuffer::ThreadSlot();
+        }).join();
+    }
+    for(auto slot : slots)
+        REQUIRE(slot < HistogramBuffer::MaxThreads);
+
+    HistogramFactory::FlushBuffers();
+    require_equal(h1, h1_ref);
+}
+
+void dotest_buffered_labels() {
+    gDirectory->Clear();
+
+    HistogramFactory h_buffered("Buffered");
+    h_buffered.SetBufferedFilling();
+
+    auto h1 = h_buffered.makeTH1D("h1",{"",{3,{0,3}}});
+    REQUIRE(HistogramBuffer::IsBufferable(*h1));
+
+    auto h1_labels = h_buffered.makeTH1D("h1_labels",{"",{3,{0,3}}});
+    h1_labels->GetXaxis()->SetBinLabel(1, "a");
+    REQUIRE_FALSE(HistogramBuffer::IsBufferable(*h1_labels));
+    REQUIRE_THROWS_AS(h1_labels->Fill(0.5), std::logic_error);
+
+    auto h2_extend = h_buffered.makeTH2D("h2_extend",{"",{3,{0,3}}},{"",{3,{0,3}}});
+    h2_extend->GetYaxis()->SetCanExtend(true);
+    REQUIRE_FALSE(HistogramBuffer::IsBufferable(*h2_extend));
+    REQUIRE_THROWS_AS(h2_extend->Fill(0.5, 0.5), std::logic_error);
+}
@@ -0,0 +1,135 @@
+#include "catch.hpp"
+#include "catch_config.h"
+
+#include "analysis/utils/MCWeighting.h"
+#include "analysis/plot/HistogramFactory.h"
+#include "base/std_ext/math.h"
+
+#include "TTree.h"
+#include "TList.h"
+#include "TParameter.h"
+
+#include <limits>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis;
+
+void dotest_GetN(const utils::MCWeighting::item_t& item);
+void dotest_reader();
+
+TEST_CASE("MCWeighting: Tabulated GetN", "[analysis]") {
+    for(auto item : {&utils::MCWeighting::EtaPrime, &utils::MCWeighting::Omega,
+                     &utils::MCWeighting::Pi0, &utils::MCWeighting::Eta})
+        dotest_GetN(*item);
+}
+
+TEST_CASE("MCWeighting: Single-pass reader", "[analysis]") {
+    dotest_reader();
+}
+
+// direct evaluation of the Legendre expansion as done before the tabulation
+double legendre_N(const utils::MCWeighting::item_t& item, double beamE, double cosTheta) {
+    auto legendre = [] (unsigned l, double x) {
+        double p0 = 1, p1 = x;
+        if(l == 0)
+            return p0;
+        for(unsigned k=1;k<l;k++) {
+            const double p2 = ((2*k+1)*x*p1 - k*p0)/(k+1);
+            p0 = p1;
+            p1 = p2;
+        }
+        return p1;
+    };
+
+    const auto& db = item.Database;
+    auto it_hi = find_if(db.begin(), db.end(),
+                         [beamE] (const decltype(db.front())& c) { return c.BeamE.Center() > beamE; });
+    if(it_hi == db.begin())
+        it_hi = next(db.begin());
+    else if(it_hi == db.end())
+        it_hi = prev(it_hi);
+    auto it_lo = prev(it_hi);
+
+    auto get_N = [cosTheta, legendre] (const decltype(db.front())& c) {
+        double sum = 0;
+        for(auto l=0u;l<c.LegendreCoefficients.size();l++)
+            sum += c.LegendreCoefficients[l]*legendre(l, cosTheta);
+        return sum;
+    };
+
+    const double N_lo = get_N(*it_lo);
+    const double N_hi = get_N(*it_hi);
+    const double m = (N_hi - N_lo)/(it_hi->BeamE.Center() - it_lo->BeamE.Center());
+    return N_lo + m*(beamE - it_lo->BeamE.Center());
+}
+
+void dotest_GetN(const utils::MCWeighting::item_t& item) {
+    HistogramFactory histfac("MCWeighting");
+    utils::MCWeighting mcWeighting(histfac, item);
+
+    const auto& db = item.Database;
+    // also extrapolate below and above the database
+    const double E_min = db.front().BeamE.Start() - 50;
+    const double E_max = db.back().BeamE.Stop() + 50;
+
+    for(int i=0;i<=200;i++) {
+        const double beamE = E_min + (E_max-E_min)*i/200.0;
+        for(int j=0;j<=50;j++) {
+            const double cosTheta = -1.0 + 2.0*j/50.0;
+            const double expected = legendre_N(item, beamE, cosTheta);
+            const double N = mcWeighting.GetN(beamE, cosTheta);
+            REQUIRE(N == Approx(expected).epsilon(1e-9).margin(1e-12));
+        }
+    }
+
+    // database entries themselves
+    for(const auto& c : db) {
+        REQUIRE(mcWeighting.GetN(c.BeamE.Center(), 0.3) ==
+                Approx(legendre_N(item, c.BeamE.Center(), 0.3)).epsilon(1e-9).margin(1e-12));
+    }
+}
+
+void dotest_reader() {
+    const double normalisation = 0.25;
+
+    TTree tree("MCWeighting","");
+    double raw = 0;
+    tree.Branch("MCWeightRaw", &raw);
+    for(const auto w : {2.0, std_ext::NaN, 8.0}) {
+        raw = w;
+        tree.Fill();
+    }
+
+    {
+        utils::MCWeighting::tree_t t;
+        REQUIRE_THROWS_AS(t.LinkWeights(&tree), utils::MCWeighting::Exception);
+    }
+
+    tree.GetUserInfo()->Add(new TParameter<double>(utils::MCWeighting::normalisationName.c_str(), normalisation));
+    {
+        // number of entries missing
+        utils::MCWeighting::tree_t t;
+        REQUIRE_THROWS_AS(t.LinkWeights(&tree), utils::MCWeighting::Exception);
+    }
+
+    auto entries = new TParameter<Long64_t>(utils::MCWeighting::entriesName.c_str(), 2);
+    tree.GetUserInfo()->Add(entries);
+    {
+        // as if merged with another tree, keeping the user info of the first
+        utils::MCWeighting::tree_t t;
+        REQUIRE_THROWS_AS(t.LinkWeights(&tree), utils::MCWeighting::Exception);
+    }
+    entries->SetVal(tree.GetEntries());
+
+    utils::MCWeighting::tree_t t;
+    REQUIRE_NOTHROW(t.LinkWeights(&tree));
+    REQUIRE_FALSE(t.MCWeight.IsPresent);
+    REQUIRE(t.MCWeightRaw.IsPresent);
+
+    const vector<double> expected{0.5, 1.0, 2.0};
+    for(long long entry=0;entry<tree.GetEntries();entry++) {
+        tree.GetEntry(entry);
+        REQUIRE(t.Weight() == Approx(expected[size_t(entry)]));
+    }
+}
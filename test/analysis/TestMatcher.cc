@@ -9,6 +9,10 @@
 #include <vector>
 #include <iostream>
 #include <cassert>
+#include <random>
+#include <numeric>
+#include <limits>
+#include <cmath>
 #include "analysis/utils/Matcher.h"
 
 
@@ -75,3 +79,218 @@ TEST_CASE("Matcher2: va < vb", "[analysis]") {
 
     test_matcher2(va, vb, exp);
 }
+
+// the list-based implementation match1to1 had before
+list<utils::scored_match<int,int>> legacy_match1to1(const vector<int>& va, const vector<int>& vb,
+                                                    const IntervalD& window) {
+    list<utils::scored_match<int,int>> scores;
+    for(auto a : va)
+        for(auto b : vb) {
+            const double score = abs(a - b);
+            if(window.Contains(score))
+                scores.push_back({score, a, b});
+        }
+    scores.sort();
+    for(auto i = scores.begin(); i != scores.end(); ++i) {
+        auto j = i;
+        ++j;
+        while(j != scores.end()) {
+            if(j->a == i->a || j->b == i->b)
+                j = scores.erase(j);
+            else
+                ++j;
+        }
+    }
+    return scores;
+}
+
+TEST_CASE("Matcher1to1: Greedy as legacy match1to1", "[analysis]") {
+    std::mt19937 rng(1234);
+    utils::Matcher1to1 matcher;
+    for(int n=0;n<500;n++) {
+        // distinct values, but many equal distances
+        vector<int> values(40);
+        iota(values.begin(), values.end(), 0);
+        shuffle(values.begin(), values.end(), rng);
+        const size_t na = rng() % 8;
+        const size_t nb = rng() % 8;
+        const vector<int> va(values.begin(), values.begin()+na);
+        const vector<int> vb(values.begin()+na, values.begin()+na+nb);
+        const IntervalD window(0, n % 2 ? 10 : 100);
+
+        const auto f = [] (int a, int b) { return abs(a - b); };
+        const auto legacy = legacy_match1to1(va, vb, window);
+        const auto res = utils::match1to1(va, vb, f, window);
+        const auto& matched = matcher.Match(va, vb, f, window);
+
+        REQUIRE(res.size() == legacy.size());
+        REQUIRE(matched.size() == legacy.size());
+        auto it_legacy = legacy.begin();
+        auto it_res = res.begin();
+        for(const auto& m : matched) {
+            REQUIRE(it_res->a == it_legacy->a);
+            REQUIRE(it_res->b == it_legacy->b);
+            REQUIRE(it_res->score == it_legacy->score);
+            REQUIRE(va.at(m.A) == it_legacy->a);
+            REQUIRE(vb.at(m.B) == it_legacy->b);
+            REQUIRE(m.Score == it_legacy->score);
+            REQUIRE(matcher.MatchedB(m.A) == m.B);
+            REQUIRE(matcher.MatchedA(m.B) == m.A);
+            ++it_legacy;
+            ++it_res;
+        }
+
+        for(auto a : matcher.UnmatchedA()) {
+            REQUIRE(matcher.MatchedB(a) == utils::Matcher1to1::npos);
+            for(const auto& m : legacy)
+                REQUIRE(m.a != va.at(a));
+        }
+        for(auto b : matcher.UnmatchedB())
+            REQUIRE(matcher.MatchedA(b) == utils::Matcher1to1::npos);
+        REQUIRE(matcher.UnmatchedA().size() + matched.size() == na);
+        REQUIRE(matcher.UnmatchedB().size() + matched.size() == nb);
+    }
+}
+
+TEST_CASE("Matcher1to1: Optimal assignment", "[analysis]") {
+    std::mt19937 rng(5678);
+    std::uniform_real_distribution<double> dist(0, 10);
+    utils::Matcher1to1 matcher(utils::Matcher1to1::Mode_t::Optimal);
+    for(int n=0;n<300;n++) {
+        const size_t na = rng() % 6;
+        const size_t nb = rng() % 6;
+        vector<double> scores(na*nb);
+        for(auto& s : scores)
+            s = dist(rng);
+        const IntervalD window(0, n % 3 ? 10 : 4);
+
+        vector<size_t> ia(na), ib(nb);
+        iota(ia.begin(), ia.end(), 0);
+        iota(ib.begin(), ib.end(), 0);
+        const auto f = [&scores, nb] (size_t a, size_t b) { return scores[a*nb+b]; };
+        const auto& matched = matcher.Match(ia, ib, f, window);
+
+        // brute force over all assignments of the shorter list
+        size_t best_n = 0;
+        double best_sum = 0;
+        const bool swap_lists = na > nb;
+        vector<size_t> perm(swap_lists ? na : nb);
+        iota(perm.begin(), perm.end(), 0);
+        do {
+            size_t n_matched = 0;
+            double sum = 0;
+            for(size_t i=0;i<min(na,nb);i++) {
+                const auto s = swap_lists ? f(perm[i], i) : f(i, perm[i]);
+                if(!window.Contains(s))
+                    continue;
+                n_matched++;
+                sum += s;
+            }
+            if(n_matched > best_n || (n_matched == best_n && sum < best_sum)) {
+                best_n = n_matched;
+                best_sum = sum;
+            }
+        } while(next_permutation(perm.begin(), perm.end()));
+
+        REQUIRE(matched.size() == best_n);
+        double sum = 0;
+        for(const auto& m : matched) {
+            REQUIRE(window.Contains(m.Score));
+            REQUIRE(m.Score == f(m.A, m.B));
+            sum += m.Score;
+        }
+        REQUIRE(sum == Approx(best_sum));
+        REQUIRE(is_sorted(matched.begin(), matched.end(),
+                          [] (const utils::Matcher1to1::match_t& x, const utils::Matcher1to1::match_t& y) {
+            return x.Score < y.Score;
+        }));
+        REQUIRE(matcher.UnmatchedA().size() + matched.size() == na);
+        REQUIRE(matcher.UnmatchedB().size() + matched.size() == nb);
+    }
+}
+
+TEST_CASE("Matcher1to1: Optimal beats greedy", "[analysis]") {
+    const vector<double> va = {1.0, 2.0};
+    const vector<double> vb = {1.9, 3.5};
+    const auto f = [] (double a, double b) { return std::abs(a - b); };
+
+    // greedy takes 2.0->1.9 first, leaving 1.0->3.5
+    utils::Matcher1to1 greedy;
+    greedy.Match(va, vb, f);
+    REQUIRE(greedy.MatchedB(1) == 0);
+    REQUIRE(greedy.MatchedB(0) == 1);
+
+    utils::Matcher1to1 optimal(utils::Matcher1to1::Mode_t::Optimal);
+    optimal.Match(va, vb, f);
+    REQUIRE(optimal.MatchedB(0) == 0);
+    REQUIRE(optimal.MatchedB(1) == 1);
+
+    // with a window, optimal keeps the number of matches maximal
+    greedy.Match(va, vb, f, IntervalD(0, 1.6));
+    REQUIRE(greedy.Matched().size() == 1);
+    REQUIRE(greedy.UnmatchedA() == vector<size_t>{0});
+    optimal.Match(va, vb, f, IntervalD(0, 1.6));
+    REQUIRE(optimal.Matched().size() == 2);
+    REQUIRE(optimal.UnmatchedA().empty());
+    optimal.Match(va, vb, f, IntervalD(0, 0.5));
+    REQUIRE(optimal.Matched().size() == 1);
+    REQUIRE(optimal.UnmatchedA() == vector<size_t>{0});
+    REQUIRE(optimal.UnmatchedB() == vector<size_t>{1});
+}
+
+TEST_CASE("Matcher1to1: Non-finite scores", "[analysis]") {
+    const vector<size_t> ia = {0, 1, 2};
+    const vector<size_t> ib = {0, 1, 2};
+    const double inf = numeric_limits<double>::infinity();
+    const vector<double> scores = {
+        -inf, 1.0,  2.0,
+        3.0,  inf,  std::nan(""),
+        inf,  -inf, 0.5
+    };
+    const auto f = [&scores] (size_t a, size_t b) { return scores[a*3+b]; };
+
+    // greedy matches infinite scores within the window as match1to1 did, NaN never
+    utils::Matcher1to1 greedy;
+    const auto& matched_greedy = greedy.Match(ia, ib, f);
+    REQUIRE(matched_greedy.size() == 2);
+    REQUIRE(greedy.MatchedB(0) == 0);
+    REQUIRE(greedy.MatchedB(2) == 1);
+    REQUIRE(greedy.UnmatchedA() == vector<size_t>{1});
+    const auto legacy = utils::match1to1(ia, ib, f);
+    REQUIRE(legacy.size() == matched_greedy.size());
+    for(const auto& m : legacy)
+        REQUIRE(greedy.MatchedB(m.a) == m.b);
+
+    // a finite window excludes them
+    greedy.Match(ia, ib, f, IntervalD(0, 10));
+    REQUIRE(greedy.Matched().size() == 3);
+    REQUIRE(greedy.MatchedB(0) == 1);
+    REQUIRE(greedy.MatchedB(1) == 0);
+    REQUIRE(greedy.MatchedB(2) == 2);
+
+    // optimal never matches non-finite scores, also not with the default window
+    utils::Matcher1to1 optimal(utils::Matcher1to1::Mode_t::Optimal);
+    const auto& matched = optimal.Match(ia, ib, f);
+    REQUIRE(matched.size() == 3);
+    for(const auto& m : matched)
+        REQUIRE(std::isfinite(m.Score));
+    REQUIRE(optimal.MatchedB(0) == 1);
+    REQUIRE(optimal.MatchedB(1) == 0);
+    REQUIRE(optimal.MatchedB(2) == 2);
+}
+
+TEST_CASE("Matcher: Find matched and unmatched", "[analysis]") {
+    const vector<int> va = {30, 40, 10};
+    const vector<int> vb = {11, 22, 34, 39};
+    const auto f = [] (int a, int b) { return abs(a - b); };
+
+    utils::Matcher1to1 matcher;
+    matcher.Match(va, vb, f);
+    REQUIRE(utils::FindMatched(matcher, va, vb, 10) == 11);
+    REQUIRE(utils::FindMatched(matcher, va, vb, 40) == 39);
+    // not in va
+    REQUIRE(utils::FindMatched(matcher, va, vb, 20) == 0);
+
+    const auto matched = utils::match1to1(va, vb, f, IntervalD(0, 5));
+    REQUIRE(utils::FindUnmatched(matched, vb) == (vector<int>{22}));
+}
@@ -5,6 +5,7 @@
 #include "analysis/utils/RootAddons.h"
 
 #include "TCutG.h"
+#include "TRandom2.h"
 
 #include <cassert>
 #include <iostream>
@@ -35,6 +36,7 @@ void test_electoncut();
 void test_electonantprotoncut();
 void test_tof();
 void test_tofdee();
+void test_compiled();
 
 
 struct testdata {
@@ -75,6 +77,10 @@ TEST_CASE("ParticleID: tof + dEE cut", "[analysis]") {
     test_tofdee();
 }
 
+TEST_CASE("ParticleID: compiled cuts", "[analysis]") {
+    test_compiled();
+}
+
 void test_makeTCutG() {
     auto cut = root::makeTCutG("a", {{1,1},{3,1},{3,3},{1,3}});
     REQUIRE(cut->IsInside(2,2));
@@ -156,6 +162,37 @@ void test_tofdee() {
 
 
 
+void test_compiled() {
+    BasicParticleID pid;
+
+    pid.dEE_electron = data.dEE_electron;
+    pid.dEE_proton = data.dEE_proton;
+    pid.tof = data.tofcut;
+    pid.Compile();
+    REQUIRE(pid.Identify(data.gamma)   == &ParticleTypeDatabase::Photon);
+    REQUIRE(pid.Identify(data.proton)  == &ParticleTypeDatabase::Proton);
+    REQUIRE(pid.Identify(data.neutron) == &ParticleTypeDatabase::Neutron);
+    REQUIRE(pid.Identify(data.electron)== &ParticleTypeDatabase::eCharged);
+    REQUIRE(pid.Validate(100000) == 0);
+
+    // some concave polygon, coarse and fine grid
+    auto cut = root::makeTCutG("concave", {{0,0},{10,0},{10,10},{5,2},{0,10}});
+    for(unsigned nBins : {1, 3, 17, 256}) {
+        RasterizedCut rasterized(cut, nBins, nBins);
+        TRandom2 rng(nBins);
+        CHECK(rasterized.Validate(100000, rng) == 0);
+        CHECK(rasterized.IsInside(5,1));
+        CHECK_FALSE(rasterized.IsInside(5,5));
+        CHECK_FALSE(rasterized.IsInside(20,1));
+    }
+
+    // changing a cut after compiling falls back to the exact test
+    pid.dEE_proton = nullptr;
+    REQUIRE(pid.Identify(data.proton)  == &ParticleTypeDatabase::Proton); // still tof cut
+    pid.tof = nullptr;
+    REQUIRE(pid.Identify(data.proton)  == nullptr);
+}
+
 
 testdata::testdata()
 {
@@ -6,6 +6,7 @@
 #include "analysis/input/ant/AntReader.h"
 #include "analysis/input/pluto/PlutoReader.h"
 #include "analysis/input/goat/GoatReader.h"
+#include "analysis/input/ReadAheadReader.h"
 
 #include "analysis/utils/Uncertainties.h"
 #include "analysis/utils/ParticleTools.h"
@@ -30,7 +31,7 @@ using namespace ant::analysis;
 
 void dotest_raw();
 void dotest_raw_nowrite();
-void dotest_plutogeant(bool insertGoat, bool checktaggerhits = false);
+void dotest_plutogeant(bool insertGoat, bool checktaggerhits = false, unsigned readAhead = 0);
 void dotest_pluto(bool insertGoat);
 void dotest_runall();
 
@@ -54,6 +55,11 @@ TEST_CASE("PhysicsManager: Pluto/Geant Input check tagger hits", "[analysis]") {
     dotest_plutogeant(false, true);
 }
 
+TEST_CASE("PhysicsManager: Pluto/Geant Input reading ahead", "[analysis]") {
+    test::EnsureSetup();
+    dotest_plutogeant(false, true, 4);
+}
+
 TEST_CASE("PhysicsManager: Pluto only Input", "[analysis]") {
     test::EnsureSetup();
     dotest_pluto(false);
@@ -164,6 +170,8 @@ void dotest_raw()
         auto reconstruct = std_ext::make_unique<Reconstruct>();
         list< unique_ptr<analysis::input::DataReader> > readers;
         readers.emplace_back(std_ext::make_unique<input::AntReader>(nullptr, move(unpacker), move(reconstruct)));
+        // unpacking and reconstruction share the setup with the physics classes
+        REQUIRE_FALSE(readers.back()->ReadsIndependently());
         pm.ReadFrom(move(readers), numeric_limits<long long>::max());
 
         const std::uint32_t timestamp = 1408221194;
@@ -198,6 +206,7 @@ void dotest_raw()
         list< unique_ptr<analysis::input::DataReader> > readers;
 
         readers.emplace_back(std_ext::make_unique<input::AntReader>(inputfiles, nullptr, move(reconstruct)));
+        REQUIRE_FALSE(readers.back()->ReadsIndependently());
         pm.ReadFrom(move(readers), numeric_limits<long long>::max());
 
         // note that we actually requested every third event to be saved in the physics class
@@ -223,6 +232,8 @@ void dotest_raw()
 
         list< unique_ptr<analysis::input::DataReader> > readers;
         readers.emplace_back(std_ext::make_unique<input::AntReader>(inputfiles, nullptr, nullptr));
+        // pure tree reader
+        REQUIRE(readers.back()->ReadsIndependently());
         pm.ReadFrom(move(readers), numeric_limits<long long>::max());
 
         // note that we actually requested every third event to be saved in the physics class
@@ -270,13 +281,18 @@ void dotest_raw_nowrite()
     REQUIRE(outfile.GetSharedClone<TTree>("treeEvents") == nullptr);
 }
 
-void dotest_plutogeant(bool insertGoat, bool checktaggerhits)
+void dotest_plutogeant(bool insertGoat, bool checktaggerhits, unsigned readAhead)
 {
+    // as in Ant, thread safety before any file is opened
+    if(readAhead > 0)
+        input::ReadAheadReader::Available();
+
     tmpfile_t tmpfile;
     WrapTFileOutput outfile(tmpfile.filename, true);
 
     PhysicsManagerTester pm;
     pm.AddPhysics<TestPhysics>(false, checktaggerhits);
+    pm.SetReadAhead(readAhead);
 
     // make some meaningful input for the physics manager
     auto unpacker = Unpacker::Get(string(TEST_BLOBS_DIRECTORY)+"/Geant_with_TID.root");
@@ -0,0 +1,103 @@
+#include "catch.hpp"
+#include "catch_config.h"
+#include "expconfig_helpers.h"
+
+#include "analysis/input/pluto/PlutoReader.h"
+#include "analysis/input/event_t.h"
+
+#include "base/WrapTFile.h"
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis;
+using namespace ant::analysis::input;
+
+void dotest_template();
+void dotest_template_changed();
+
+TEST_CASE("PlutoReader: Decay template", "[analysis]") {
+    test::EnsureSetup();
+    dotest_template();
+}
+
+TEST_CASE("PlutoReader: Decay template topology changed", "[analysis]") {
+    test::EnsureSetup();
+    dotest_template_changed();
+}
+
+struct PlutoReaderTester : PlutoReader {
+    using PlutoReader::PlutoReader;
+
+    // forget the template before each event, so the tree is always fully built
+    bool FullBuild = false;
+
+    virtual bool ReadNextEvent(event_t& event) override {
+        if(FullBuild)
+            decayTemplate = decay_template_t();
+        return PlutoReader::ReadNextEvent(event);
+    }
+
+    long long GetNTemplateBuilt() const { return nTemplateBuilt; }
+    void CopyTemplate(const PlutoReaderTester& other) { decayTemplate = other.decayTemplate; }
+};
+
+shared_ptr<WrapTFileInput> openBlob(const string& filename) {
+    return make_shared<WrapTFileInput>(string(TEST_BLOBS_DIRECTORY)+"/"+filename);
+}
+
+bool isEqual(const TParticleTree_t& tree, const TParticleTree_t& tree_ref) {
+    REQUIRE(tree);
+    REQUIRE(tree_ref);
+    return tree->IsEqual(tree_ref, [] (const TParticlePtr& a, const TParticlePtr& b) {
+        if(!a || !b)
+            return !a && !b;
+        return a->Type() == b->Type() &&
+                static_cast<const LorentzVec&>(*a) == static_cast<const LorentzVec&>(*b);
+    });
+}
+
+void dotest_template() {
+    PlutoReaderTester reader(openBlob("Pluto_EtapOmegaG.root"));
+    PlutoReaderTester reader_ref(openBlob("Pluto_EtapOmegaG.root"));
+    reader_ref.FullBuild = true;
+
+    long long nEvents = 0;
+    while(nEvents < 100) {
+        event_t event, event_ref;
+        const bool read = reader.ReadNextEvent(event);
+        REQUIRE(read == reader_ref.ReadNextEvent(event_ref));
+        if(!read)
+            break;
+        nEvents++;
+        INFO("nEvents=" << nEvents);
+        REQUIRE(isEqual(event.MCTrue().ParticleTree, event_ref.MCTrue().ParticleTree));
+    }
+    REQUIRE(nEvents > 10);
+
+    // only the first event is built fully
+    CHECK(reader.GetNTemplateBuilt() == nEvents-1);
+    CHECK(reader_ref.GetNTemplateBuilt() == 0);
+}
+
+void dotest_template_changed() {
+    PlutoReaderTester reader_etap2g(openBlob("Pluto_Etap2g.root"));
+    event_t event_etap2g;
+    REQUIRE(reader_etap2g.ReadNextEvent(event_etap2g));
+
+    // template of another channel must not be used
+    PlutoReaderTester reader(openBlob("Pluto_EtapOmegaG.root"));
+    reader.CopyTemplate(reader_etap2g);
+    PlutoReaderTester reader_ref(openBlob("Pluto_EtapOmegaG.root"));
+    reader_ref.FullBuild = true;
+
+    for(long long n=0;n<2;n++) {
+        event_t event, event_ref;
+        REQUIRE(reader.ReadNextEvent(event));
+        REQUIRE(reader_ref.ReadNextEvent(event_ref));
+        REQUIRE(isEqual(event.MCTrue().ParticleTree, event_ref.MCTrue().ParticleTree));
+        // first event falls back to full build and learns the new template
+        REQUIRE(reader.GetNTemplateBuilt() == n);
+    }
+}
@@ -0,0 +1,115 @@
+#include "catch.hpp"
+
+#include "mc/pluto/PlutoGenerator.h"
+#include "mc/pluto/utils/PlutoShards.h"
+#include "mc/pluto/utils/PlutoTID.h"
+
+#include "base/WrapTFile.h"
+#include "base/tmpfile_t.h"
+#include "tree/TID.h"
+
+#include "TTree.h"
+
+#include <set>
+#include <stdexcept>
+
+using namespace std;
+using namespace ant;
+using namespace ant::mc::pluto;
+using namespace ant::mc::pluto::utils;
+
+void dotest_seeds();
+void dotest_generate_merge();
+void dotest_failing_shard();
+
+TEST_CASE("PlutoShards: Seeds", "[analysis]") {
+    dotest_seeds();
+}
+
+TEST_CASE("PlutoShards: Generate and merge", "[analysis]") {
+    dotest_generate_merge();
+}
+
+TEST_CASE("PlutoShards: Failing shard", "[analysis]") {
+    dotest_failing_shard();
+}
+
+void dotest_seeds() {
+    // seed*nShards+shard+1 gave the same seeds for (seed=1, 2 shards) and (seed=0, 4 shards)
+    set<unsigned> seeds;
+    for(unsigned seed=0;seed<20;seed++) {
+        for(unsigned shard=0;shard<20;shard++) {
+            const auto s = PlutoShards::Seed(seed, shard);
+            CHECK(s != 0);
+            CHECK(s == PlutoShards::Seed(seed, shard));
+            seeds.insert(s);
+        }
+    }
+    CHECK(seeds.size() == 20*20);
+}
+
+long long getEntries(const string& filename, const string& treename) {
+    WrapTFileInput input(filename);
+    TTree* tree = nullptr;
+    if(!input.GetObject(treename, tree))
+        return -1;
+    return tree->GetEntries();
+}
+
+void dotest_generate_merge() {
+    tmpfolder_t tmpfolder;
+    const vector<string> shardfiles{
+        tmpfolder.foldername + "/shard0.root",
+        tmpfolder.foldername + "/shard1.root"
+    };
+
+    const auto generate = [] (const string& filename, unsigned long nEvents, unsigned seed) {
+        Cocktail cocktail(filename, {1400, 1500}, false, true, 0, "1.0 / x",
+                          mc::data::Query::GetSelector(mc::data::Query::Selection::gpBeamTarget),
+                          seed);
+        cocktail.Sample(nEvents);
+    };
+
+    const unsigned long nEvents = 11;
+    REQUIRE(PlutoShards::Generate(generate, shardfiles, nEvents, 0, 1));
+    REQUIRE(getEntries(shardfiles[0], "data") == 6);
+    REQUIRE(getEntries(shardfiles[1], "data") == 5);
+
+    tmpfile_t merged;
+    REQUIRE_NOTHROW(PlutoShards::Merge(merged.filename, shardfiles));
+    CHECK(getEntries(merged.filename, "data") == nEvents);
+
+    // unmerged shards get distinct TIDs when added with consecutive ranges
+    unsigned long firstIndex = 0;
+    for(const auto& shardfile : shardfiles)
+        firstIndex += PlutoTID::AddTID(shardfile, firstIndex);
+    REQUIRE(firstIndex == nEvents);
+
+    set<TID> tids;
+    for(const auto& shardfile : shardfiles) {
+        WrapTFileInput input(shardfile);
+        TTree* tidtree = nullptr;
+        REQUIRE(input.GetObject(PlutoTID::tidtree_name, tidtree));
+        TID* tid = nullptr;
+        tidtree->SetBranchAddress("tid", &tid);
+        for(long long entry=0;entry<tidtree->GetEntries();entry++) {
+            tidtree->GetEntry(entry);
+            tids.insert(*tid);
+        }
+    }
+    CHECK(tids.size() == nEvents);
+}
+
+void dotest_failing_shard() {
+    tmpfolder_t tmpfolder;
+    const vector<string> shardfiles{
+        tmpfolder.foldername + "/shard0.root",
+        tmpfolder.foldername + "/shard1.root"
+    };
+    const auto generate = [] (const string&, unsigned long nEvents, unsigned) {
+        if(nEvents < 5)
+            throw runtime_error("Failing shard");
+    };
+    CHECK(PlutoShards::Generate(generate, shardfiles, 9, 1, 0) == false);
+    CHECK(PlutoShards::Generate(generate, shardfiles, 10, 1, 0));
+}
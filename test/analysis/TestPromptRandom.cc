@@ -0,0 +1,201 @@
+#include "catch.hpp"
+
+#include "analysis/plot/PromptRandomHist.h"
+#include "analysis/plot/HistogramBuffer.h"
+#include "base/std_ext/math.h"
+
+#include "TH1D.h"
+#include "TH2D.h"
+
+#include <array>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis;
+
+void dotest_classify();
+void dotest_fill(bool buffered);
+void dotest_fill_recomputed_stats();
+
+TEST_CASE("PromptRandom: Classify batch", "[analysis]") {
+    dotest_classify();
+}
+
+TEST_CASE("PromptRandom: Fill batch", "[analysis]") {
+    dotest_fill(false);
+}
+
+TEST_CASE("PromptRandom: Fill batch buffered", "[analysis]") {
+    dotest_fill(true);
+}
+
+TEST_CASE("PromptRandom: Fill batch recomputed stats", "[analysis]") {
+    dotest_fill_recomputed_stats();
+}
+
+void setupSwitch(PromptRandom::Switch& prs) {
+    prs.AddPromptRange({-5, 5});
+    prs.AddRandomRange({-50, -10});
+    prs.AddRandomRange({ 10,  50});
+    // overlaps the prompt window, random has precedence
+    prs.AddRandomRange({  4,   6});
+}
+
+// tagger times in and around all windows, including the edges
+const vector<double> tagtimes{-60, -50, -30, -10, -7, -5, 0, 3.9, 4, 5, 5.5, 6, 8, 10, 49, 50, 51, std_ext::NaN};
+
+void dotest_classify() {
+    PromptRandom::Switch prs;
+    setupSwitch(prs);
+
+    PromptRandom::Batch batch;
+    prs.Classify(tagtimes, batch);
+    REQUIRE(batch.size() == tagtimes.size());
+
+    unsigned nPrompt = 0;
+    unsigned nRandom = 0;
+    double sumW = 0;
+    for(size_t i=0;i<tagtimes.size();i++) {
+        prs.SetTaggerTime(tagtimes[i]);
+        CHECK(batch[i].State == prs.State());
+        CHECK(batch[i].Weight == prs.FillWeight());
+        if(prs.State() == PromptRandom::Case::Prompt)
+            nPrompt++;
+        else if(prs.State() == PromptRandom::Case::Random)
+            nRandom++;
+        sumW += prs.FillWeight();
+    }
+    CHECK(batch.NPrompt() == nPrompt);
+    CHECK(batch.NRandom() == nRandom);
+    CHECK(batch.SumWeights() == Approx(sumW));
+
+    // templated version, batch is reused
+    struct hit_t { double Time; };
+    const vector<hit_t> hits{{0}, {20}, {100}};
+    prs.Classify(hits, [] (const hit_t& h) { return h.Time; }, batch);
+    REQUIRE(batch.size() == 3);
+    CHECK(batch[0].State == PromptRandom::Case::Prompt);
+    CHECK(batch[1].State == PromptRandom::Case::Random);
+    CHECK(batch[2].State == PromptRandom::Case::Outside);
+    CHECK(batch.NPrompt() == 1);
+    CHECK(batch.NRandom() == 1);
+
+    prs.Classify(vector<double>{}, batch);
+    CHECK(batch.empty());
+    CHECK(batch.SumWeights() == 0);
+}
+
+void requireEqual(const TH1* a, const TH1* b) {
+    REQUIRE(a->GetNcells() == b->GetNcells());
+    for(int bin=0;bin<a->GetNcells();bin++) {
+        REQUIRE(a->GetBinContent(bin) == Approx(b->GetBinContent(bin)));
+        REQUIRE(a->GetBinError(bin) == Approx(b->GetBinError(bin)));
+    }
+    REQUIRE(a->GetEntries() == Approx(b->GetEntries()));
+    REQUIRE(a->GetSumw2N() == b->GetSumw2N());
+    array<double, 13> stats_a{};
+    array<double, 13> stats_b{};
+    a->GetStats(stats_a.data());
+    b->GetStats(stats_b.data());
+    for(size_t i=0;i<stats_a.size();i++)
+        REQUIRE(stats_a[i] == Approx(stats_b[i]));
+}
+
+void fillEvents(PromptRandom::Switch& prs,
+                PromptRandom::Hist1& h1, PromptRandom::Hist1& h1_batch,
+                PromptRandom::Hist2& h2, PromptRandom::Hist2& h2_batch)
+{
+    PromptRandom::Batch batch;
+
+    for(int event=0;event<100;event++) {
+        // different subsets of the tagger times per event
+        vector<double> times;
+        for(size_t i=0;i<tagtimes.size();i++)
+            if((i+event) % 3 != 0)
+                times.push_back(tagtimes[i]);
+        prs.Classify(times, batch);
+
+        // includes under- and overflow
+        const double x = (event % 25) * 0.5 - 1.2;
+        const double y = (event % 7) * 0.4 - 1.3;
+
+        for(auto t : times) {
+            prs.SetTaggerTime(t);
+            h1.Fill(x);
+            h2.Fill(x, y);
+        }
+        h1_batch.Fill(batch, x);
+        h2_batch.Fill(batch, x, y);
+    }
+}
+
+void dotest_fill(bool buffered) {
+    PromptRandom::Switch prs;
+    setupSwitch(prs);
+
+    HistogramFactory histfac("PromptRandom");
+    HistogramFactory histfac_batch("PromptRandom_batch");
+    histfac_batch.SetBufferedFilling(buffered);
+
+    PromptRandom::Hist1 h1(prs);
+    PromptRandom::Hist1 h1_batch(prs);
+    h1.MakeHistograms(histfac, "h1", "", {20, {0, 10}}, "x", "");
+    h1_batch.MakeHistograms(histfac_batch, "h1", "", {20, {0, 10}}, "x", "");
+
+    PromptRandom::Hist2 h2(prs);
+    PromptRandom::Hist2 h2_batch(prs);
+    h2.MakeHistograms(histfac, "h2", "", {20, {0, 10}}, {10, {-1, 1}}, "x", "y");
+    h2_batch.MakeHistograms(histfac_batch, "h2", "", {20, {0, 10}}, {10, {-1, 1}}, "x", "y");
+
+    fillEvents(prs, h1, h1_batch, h2, h2_batch);
+
+    if(buffered)
+        HistogramBuffer::FlushAll();
+
+    requireEqual(h1.prompt,     h1_batch.prompt);
+    requireEqual(h1.random,     h1_batch.random);
+    requireEqual(h1.subtracted, h1_batch.subtracted);
+    requireEqual(h2.prompt,     h2_batch.prompt);
+    requireEqual(h2.random,     h2_batch.random);
+    requireEqual(h2.subtracted, h2_batch.subtracted);
+}
+
+void dotest_fill_recomputed_stats() {
+    PromptRandom::Switch prs;
+    setupSwitch(prs);
+
+    HistogramFactory histfac("PromptRandom_recomputed");
+    HistogramFactory histfac_batch("PromptRandom_recomputed_batch");
+
+    PromptRandom::Hist1 h1(prs);
+    PromptRandom::Hist1 h1_batch(prs);
+    h1.MakeHistograms(histfac, "h1", "", {20, {0, 10}}, "x", "");
+    h1_batch.MakeHistograms(histfac_batch, "h1", "", {20, {0, 10}}, "x", "");
+
+    PromptRandom::Hist2 h2(prs);
+    PromptRandom::Hist2 h2_batch(prs);
+    h2.MakeHistograms(histfac, "h2", "", {20, {0, 10}}, {10, {-1, 1}}, "x", "y");
+    h2_batch.MakeHistograms(histfac_batch, "h2", "", {20, {0, 10}}, {10, {-1, 1}}, "x", "y");
+
+    // GetStats computes the sums from the bin centres within a restricted axis range,
+    // and after SetBinContent, which resets the sums but counts an entry
+    const vector<TH1*> ranged{h1.prompt, h1.random, h1_batch.prompt, h1_batch.random,
+                              h2.prompt, h2.random, h2_batch.prompt, h2_batch.random};
+    const vector<TH1*> set{h1.subtracted, h1_batch.subtracted, h2.subtracted, h2_batch.subtracted};
+    for(auto h : ranged)
+        h->GetXaxis()->SetRange(3, 12);
+    for(auto h : set)
+        h->SetBinContent(5, 2.0);
+
+    fillEvents(prs, h1, h1_batch, h2, h2_batch);
+
+    for(auto h : ranged)
+        h->GetXaxis()->SetRange();
+
+    requireEqual(h1.prompt,     h1_batch.prompt);
+    requireEqual(h1.random,     h1_batch.random);
+    requireEqual(h1.subtracted, h1_batch.subtracted);
+    requireEqual(h2.prompt,     h2_batch.prompt);
+    requireEqual(h2.random,     h2_batch.random);
+    requireEqual(h2.subtracted, h2_batch.subtracted);
+}
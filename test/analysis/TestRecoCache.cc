@@ -0,0 +1,164 @@
+#include "catch.hpp"
+#include "catch_config.h"
+#include "expconfig_helpers.h"
+
+#include "analysis/input/ant/AntReader.h"
+#include "analysis/input/ant/RecoCache.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+#include "unpacker/Unpacker.h"
+#include "reconstruct/Reconstruct.h"
+
+#include "base/WrapTFile.h"
+#include "base/tmpfile_t.h"
+#include "base/std_ext/system.h"
+
+#include "TTree.h"
+
+#include <fstream>
+#include <string>
+#include <tuple>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis;
+using namespace ant::analysis::input;
+
+void dotest_roundtrip();
+void dotest_incomplete();
+void dotest_filekey();
+
+TEST_CASE("RecoCache: Write and read", "[analysis]") {
+    test::EnsureSetup();
+    dotest_roundtrip();
+}
+
+TEST_CASE("RecoCache: Incomplete cache discarded", "[analysis]") {
+    test::EnsureSetup();
+    dotest_incomplete();
+}
+
+TEST_CASE("RecoCache: Raw file key", "[analysis]") {
+    dotest_filekey();
+}
+
+const string rawfile = string(TEST_BLOBS_DIRECTORY)+"/Acqu_oneevent-big.dat.xz";
+
+// what the physics classes see from the reconstructed event
+using summary_t = tuple<TID, size_t, size_t, size_t, size_t, double, double>;
+
+summary_t summarize(const TEvent& event) {
+    auto& recon = event.Reconstructed();
+    double clusterEnergy = 0;
+    for(auto& cluster : recon.Clusters)
+        clusterEnergy += cluster.Energy;
+    double candidateTheta = 0;
+    for(auto& cand : recon.Candidates)
+        candidateTheta += cand.Theta;
+    return summary_t{recon.ID, recon.Clusters.size(), recon.Candidates.size(),
+                     recon.TaggerHits.size(), recon.SlowControls.size(),
+                     clusterEnergy, candidateTheta};
+}
+
+unique_ptr<AntReader> makeReader() {
+    auto unpacker = Unpacker::Get(rawfile);
+    auto reconstruct = std_ext::make_unique<Reconstruct>();
+    return std_ext::make_unique<AntReader>(nullptr, move(unpacker), move(reconstruct));
+}
+
+void dotest_roundtrip() {
+    tmpfolder_t tmpfolder;
+    const auto cachefile = tmpfolder.foldername + "/cache.reco.root";
+    const string key = "Setup=Test Options=a;b;";
+
+    // first pass reconstructs and writes the cache
+    vector<summary_t> reconstructed;
+    {
+        auto reader = makeReader();
+        reader->WriteRecoCache(std_ext::make_unique<RecoCache>(cachefile, key));
+        while(true) {
+            event_t event;
+            if(!reader->ReadNextEvent(event))
+                break;
+            reconstructed.emplace_back(summarize(event));
+        }
+    }
+    REQUIRE(reconstructed.size() == 221);
+    REQUIRE(std_ext::system::path_exists(cachefile));
+    REQUIRE_FALSE(std_ext::system::path_exists(cachefile + ".tmp"));
+
+    // other key does not match
+    CHECK(RecoCache::Open(cachefile, key + "c;") == nullptr);
+    CHECK(RecoCache::Open(cachefile, "") == nullptr);
+
+    // same key gives the same events without unpacker and reconstruct
+    auto cachefiles = RecoCache::Open(cachefile, key);
+    REQUIRE(cachefiles != nullptr);
+    AntReader reader(cachefiles, nullptr, nullptr);
+    REQUIRE((reader.GetFlags() & reader_flag_t::IsSource));
+
+    vector<summary_t> cached;
+    unsigned nReadHits = 0;
+    while(true) {
+        event_t event;
+        if(!reader.ReadNextEvent(event))
+            break;
+        cached.emplace_back(summarize(event));
+        auto& recon = event.Reconstructed();
+        if(recon.SlowControls.empty())
+            CHECK(recon.DetectorReadHits.empty());
+        nReadHits += recon.DetectorReadHits.size();
+    }
+    CHECK(nReadHits > 0);
+    REQUIRE(cached.size() == reconstructed.size());
+    for(size_t i=0;i<cached.size();i++)
+        REQUIRE(cached[i] == reconstructed[i]);
+}
+
+void dotest_incomplete() {
+    tmpfolder_t tmpfolder;
+    const auto cachefile = tmpfolder.foldername + "/cache.reco.root";
+    const string key = "Setup=Test";
+
+    // interrupted pass over the raw file
+    {
+        auto reader = makeReader();
+        reader->WriteRecoCache(std_ext::make_unique<RecoCache>(cachefile, key));
+        for(int i=0;i<10;i++) {
+            event_t event;
+            REQUIRE(reader->ReadNextEvent(event));
+        }
+    }
+    CHECK_FALSE(std_ext::system::path_exists(cachefile));
+    CHECK_FALSE(std_ext::system::path_exists(cachefile + ".tmp"));
+    CHECK(RecoCache::Open(cachefile, key) == nullptr);
+
+    // a file without key, for example from a crashed writer, is not used
+    {
+        WrapTFileOutput out(cachefile);
+        out.CreateInside<TTree>("treeEvents","TEvent data");
+    }
+    CHECK(RecoCache::Open(cachefile, key) == nullptr);
+}
+
+void dotest_filekey() {
+    tmpfile_t rawfile;
+    {
+        ofstream f(rawfile.filename);
+        f << "some raw data";
+    }
+    const auto filekey = RecoCache::MakeFileKey(rawfile.filename);
+    CHECK_FALSE(filekey.empty());
+    CHECK(filekey == RecoCache::MakeFileKey(rawfile.filename));
+
+    // re-acquired file with the same name
+    {
+        ofstream f(rawfile.filename);
+        f << "some other raw data";
+    }
+    CHECK(filekey != RecoCache::MakeFileKey(rawfile.filename));
+
+    CHECK(RecoCache::MakeFileKey(rawfile.filename + ".doesnotexist").empty());
+}
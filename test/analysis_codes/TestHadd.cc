@@ -104,4 +104,51 @@ TEST_CASE("Hadd: Two simple hists", "[root-addons]") {
         }
     }
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Hadd: Parallel tree merge", "[root-addons]") {
+
+    // create some input files, more than open files per merge allowed
+    const unsigned nFiles = 7;
+    vector<tmpfile_t> in_files(nFiles);
+    vector<string> in_filenames;
+    for(unsigned i=0;i<nFiles;i++) {
+        WrapTFileOutput out(in_files[i].filename);
+        auto h = out.CreateInside<TH1D>("h","",10,0,10);
+        h->Fill(i, 1.0+i);
+        in_filenames.emplace_back(in_files[i].filename);
+    }
+
+    tmpfile_t tmp_outfile;
+    unsigned nPaths = 0;
+    REQUIRE_NOTHROW(hadd::MergeParallel(tmp_outfile.filename, in_filenames, 2, 3, nPaths));
+    REQUIRE_THROWS_AS(hadd::MergeParallel(tmp_outfile.filename, in_filenames, 2, 1, nPaths), std::runtime_error);
+
+    WrapTFileInput input(tmp_outfile.filename);
+    auto h = input.GetSharedHist<TH1D>("h");
+    CHECK(h->GetEntries() == Approx(nFiles));
+    for(unsigned i=0;i<nFiles;i++)
+        CHECK(h->GetBinContent(i+1) == Approx(1.0+i));
+}
+
+TEST_CASE("Hadd: Broken input file", "[root-addons]") {
+
+    tmpfile_t in_file;
+    {
+        WrapTFileOutput out(in_file.filename);
+        auto h = out.CreateInside<TH1D>("h","",10,0,10);
+        h->Fill(1.0, 2.0);
+    }
+    const vector<string> in_filenames{in_file.filename, in_file.filename + ".doesnotexist"};
+
+    tmpfile_t tmp_outfile;
+    unsigned nPaths = 0;
+    REQUIRE_THROWS_AS(hadd::MergeFiles(tmp_outfile.filename, in_filenames, nPaths), std::runtime_error);
+    REQUIRE_THROWS_AS(hadd::MergeParallel(tmp_outfile.filename, in_filenames, 2, 2, nPaths), std::runtime_error);
+
+    // explicitly skipping it gives the partial sum
+    REQUIRE_NOTHROW(hadd::MergeFiles(tmp_outfile.filename, in_filenames, nPaths, true));
+    WrapTFileInput input(tmp_outfile.filename);
+    auto h = input.GetSharedHist<TH1D>("h");
+    CHECK(h->GetBinContent(2) == Approx(2.0));
+}
@@ -0,0 +1,109 @@
+#include "catch.hpp"
+
+#include "root-addons/analysis_codes/ToyMC.h"
+
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TF1.h"
+#include "TRandom.h"
+
+#include <stdexcept>
+
+using namespace std;
+using namespace ant;
+using namespace ant::MC;
+
+void dotest_fill();
+void dotest_sampler();
+void dotest_exception();
+
+TEST_CASE("ToyMC: Deterministic fill", "[root-addons]") {
+    dotest_fill();
+}
+
+TEST_CASE("ToyMC: Sampler", "[root-addons]") {
+    dotest_sampler();
+}
+
+TEST_CASE("ToyMC: Exception in fill", "[root-addons]") {
+    dotest_exception();
+}
+
+void fillGaus(TH1* h, TRandom& rng, unsigned long long begin, unsigned long long end) {
+    for(auto i=begin;i<end;i++)
+        h->Fill(rng.Gaus(), rng.Uniform(10));
+}
+
+void dotest_fill() {
+    const unsigned long long n = 1000001; // not a multiple of the chunk size
+
+    TH2D h1("h1","",50,-5,5,10,0,10);
+    TH2D h4("h4","",50,-5,5,10,0,10);
+    TH2D h_other("h_other","",50,-5,5,10,0,10);
+    ToyMC::Fill(&h1, n, fillGaus, 7, 1);
+    ToyMC::Fill(&h4, n, fillGaus, 7, 4);
+    ToyMC::Fill(&h_other, n, fillGaus, 8, 4);
+
+    REQUIRE(h1.GetEntries() == Approx(n));
+    REQUIRE(h4.GetEntries() == Approx(n));
+    REQUIRE(h1.Integral(0, 51, 0, 11) == Approx(n));
+
+    // same seed gives the same histogram, independent of the number of threads
+    bool same = true;
+    bool same_other = true;
+    for(int bin=0;bin<h1.GetNcells();bin++) {
+        same &= h1.GetBinContent(bin) == h4.GetBinContent(bin);
+        same_other &= h1.GetBinContent(bin) == h_other.GetBinContent(bin);
+    }
+    CHECK(same);
+    CHECK_FALSE(same_other);
+    CHECK(h1.GetMean(1) == Approx(0).margin(0.01));
+    CHECK(h1.GetRMS(1) == Approx(1).epsilon(0.01));
+
+    // existing content is kept
+    ToyMC::Fill(&h4, n, fillGaus, 9, 3);
+    CHECK(h4.GetEntries() == Approx(2*n));
+
+    // nothing to do
+    TH1D h_empty("h_empty","",10,0,1);
+    ToyMC::Fill(&h_empty, 0, fillGaus);
+    CHECK(h_empty.GetEntries() == 0);
+}
+
+void dotest_sampler() {
+    TF1 f("f_sampler","gaus",0,100);
+    f.SetParameters(10, 40, 5);
+    const ToyMC::Sampler sampler(f, 0, 100, 1000);
+
+    TH1D h("h_sampler","",100,0,100);
+    ToyMC::Fill(&h, 1000000, [&sampler] (TH1* h, TRandom& rng, unsigned long long begin, unsigned long long end) {
+        for(auto i=begin;i<end;i++)
+            h->Fill(sampler(rng));
+    });
+    CHECK(h.GetMean() == Approx(40).epsilon(0.002));
+    CHECK(h.GetRMS() == Approx(5).epsilon(0.01));
+    CHECK(h.GetBinContent(0) == 0);
+    CHECK(h.GetBinContent(101) == 0);
+
+    // linear density, 1/4 of the samples below the center
+    TF1 lin("f_lin","x",0,1);
+    const ToyMC::Sampler linSampler(lin, 0, 1, 1);
+    TH1D h_lin("h_lin","",2,0,1);
+    ToyMC::Fill(&h_lin, 1000000, [&linSampler] (TH1* h, TRandom& rng, unsigned long long begin, unsigned long long end) {
+        for(auto i=begin;i<end;i++)
+            h->Fill(linSampler(rng));
+    });
+    CHECK(h_lin.GetBinContent(1)/h_lin.GetEntries() == Approx(0.25).epsilon(0.01));
+
+    TF1 zero("f_zero","0",0,1);
+    CHECK_THROWS_AS(ToyMC::Sampler(zero, 0, 1), invalid_argument);
+}
+
+void dotest_exception() {
+    TH1D h("h_exception","",10,0,1);
+    REQUIRE_THROWS_AS(ToyMC::Fill(&h, 1000000, [] (TH1*, TRandom&, unsigned long long begin, unsigned long long) {
+        if(begin > 0)
+            throw runtime_error("fill failed");
+    }, 1, 4), runtime_error);
+    CHECK_THROWS_AS(ToyMC::Fill(nullptr, 10, fillGaus), invalid_argument);
+}
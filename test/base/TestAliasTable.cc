@@ -0,0 +1,58 @@
+#include "catch.hpp"
+
+#include "base/AliasTable.h"
+
+#include <random>
+
+using namespace std;
+using namespace ant;
+
+
+TEST_CASE("AliasTable: Probabilities", "[base]") {
+    const vector<double> weights{1, 0, 3, 0.5, 10, 2.5};
+    AliasTable table(weights);
+    REQUIRE(table.size() == weights.size());
+
+    double sum = 0;
+    for(auto w : weights)
+        sum += w;
+    for(unsigned i=0;i<weights.size();i++) {
+        INFO(i);
+        REQUIRE(table.GetProbability(i) == Approx(weights[i]/sum));
+    }
+}
+
+TEST_CASE("AliasTable: Sampling", "[base]") {
+    const vector<double> weights{1, 0, 3, 0.5, 10, 2.5};
+    AliasTable table(weights);
+
+    // a fine grid of uniform numbers reproduces the probabilities
+    const unsigned n = 1000000;
+    vector<unsigned> counts(weights.size(), 0);
+    for(unsigned k=0;k<n;k++)
+        counts[table.Sample((k+0.5)/n)]++;
+
+    REQUIRE(counts[1] == 0);
+    for(unsigned i=0;i<weights.size();i++) {
+        INFO(i);
+        REQUIRE(double(counts[i])/n == Approx(table.GetProbability(i)).epsilon(1e-4));
+    }
+
+    // edges of the allowed range
+    REQUIRE(table.Sample(0) < weights.size());
+    REQUIRE(table.Sample(1) < weights.size());
+}
+
+TEST_CASE("AliasTable: Single weight", "[base]") {
+    AliasTable table({0, 0, 42, 0});
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> u(0, 1);
+    for(unsigned k=0;k<1000;k++)
+        REQUIRE(table.Sample(u(rng)) == 2);
+}
+
+TEST_CASE("AliasTable: Invalid weights", "[base]") {
+    REQUIRE_THROWS_AS(AliasTable({}), AliasTable::Exception);
+    REQUIRE_THROWS_AS(AliasTable({0, 0}), AliasTable::Exception);
+    REQUIRE_THROWS_AS(AliasTable({1, -1}), AliasTable::Exception);
+}
@@ -0,0 +1,75 @@
+#include "catch.hpp"
+
+#include "base/MemoryArena.h"
+#include "base/std_ext/shared_ptr_container.h"
+
+#include <vector>
+#include <thread>
+
+using namespace std;
+using namespace ant;
+
+struct ArenaDummy {
+    static unsigned n;
+    double data[8];
+    int value;
+    explicit ArenaDummy(int v) : value(v) { ++n; }
+    ~ArenaDummy() { --n; }
+};
+
+unsigned ArenaDummy::n = 0;
+
+TEST_CASE("MemoryArena: Allocate and release per event", "[base]") {
+    const auto nChunks = MemoryArena::GetTotalChunks();
+    for(int event=0; event<100; event++) {
+        vector<shared_ptr<ArenaDummy>> items;
+        for(int i=0;i<200;i++)
+            items.emplace_back(make_arena_shared<ArenaDummy>(i));
+        REQUIRE(ArenaDummy::n == 200);
+        for(int i=0;i<200;i++)
+            REQUIRE(items[i]->value == i);
+    }
+    CHECK(ArenaDummy::n == 0);
+    // memory of previous events is reused
+    CHECK(MemoryArena::GetTotalChunks() - nChunks <= 1);
+}
+
+TEST_CASE("MemoryArena: Long living objects", "[base]") {
+    auto survivor = make_arena_shared<ArenaDummy>(42);
+    const auto nChunks = MemoryArena::GetTotalChunks();
+    for(int event=0; event<100; event++) {
+        vector<shared_ptr<ArenaDummy>> items;
+        for(int i=0;i<2000;i++)
+            items.emplace_back(make_arena_shared<ArenaDummy>(i));
+    }
+    CHECK(survivor->value == 42);
+    // survivor keeps only its own chunk
+    CHECK(MemoryArena::GetTotalChunks() - nChunks <= 4);
+}
+
+TEST_CASE("MemoryArena: Release on other thread", "[base]") {
+    shared_ptr<ArenaDummy> item;
+    thread t([&item] () { item = make_arena_shared<ArenaDummy>(7); });
+    t.join();
+    REQUIRE(item);
+    CHECK(item->value == 7);
+    item = nullptr;
+    CHECK(ArenaDummy::n == 0);
+}
+
+TEST_CASE("MemoryArena: Large allocations", "[base]") {
+    vector<double, ArenaAllocator<double>> v(MemoryArena::ChunkSize, 1.0);
+    CHECK(v.size() == MemoryArena::ChunkSize);
+    CHECK(v.back() == 1.0);
+}
+
+TEST_CASE("MemoryArena: shared_ptr_container", "[base]") {
+    std_ext::shared_ptr_container<ArenaDummy> c;
+    c.emplace_back(3);
+    c.emplace_back(5);
+    REQUIRE(c.size() == 2);
+    CHECK(c.front().value == 3);
+    CHECK(c.back().value == 5);
+    c.clear();
+    CHECK(ArenaDummy::n == 0);
+}
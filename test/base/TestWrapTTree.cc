@@ -22,6 +22,9 @@ void dotest_chain();
 void dotest_opt_branches();
 void dotest_stdarray();
 void dotest_templating();
+void dotest_lazy();
+void dotest_shared();
+void dotest_readahead();
 
 
 TEST_CASE("WrapTTree: Basics", "[base]") {
@@ -52,6 +55,18 @@ TEST_CASE("WrapTTree: std::array", "[base]") {
     dotest_stdarray();
 }
 
+TEST_CASE("WrapTTree: Lazy loading", "[base]") {
+    dotest_lazy();
+}
+
+TEST_CASE("WrapTTree: Shared reading", "[base]") {
+    dotest_shared();
+}
+
+TEST_CASE("WrapTTree: Read ahead", "[base]") {
+    dotest_readahead();
+}
+
 TEST_CASE("WrapTTree: templating", "[base]") {
     dotest_templating();
 }
@@ -480,3 +495,190 @@ class MyClass {
 void dotest_templating() {
     MyClass<> test;
 }
+
+void dotest_lazy() {
+
+    struct tree_t : WrapTTree {
+        ADD_BRANCH_T(int, Cut)
+        ADD_BRANCH_T(std::vector<double>, Values)
+    };
+
+    auto make_treefile = [] (const std::string& filename, int offset) {
+        WrapTFileOutput outputfile(filename, true);
+        tree_t t;
+        t.CreateBranches(new TTree("tree","tree"));
+        for(auto entry=0;entry<10;entry++) {
+            t.Cut = offset+entry;
+            t.Values = std::vector<double>(entry % 3 + 1, offset+entry);
+            t.Tree->Fill();
+        }
+    };
+
+    tmpfile_t tmpfile1;
+    make_treefile(tmpfile1.filename, 0);
+    tmpfile_t tmpfile2;
+    make_treefile(tmpfile2.filename, 10);
+
+    auto chain = std_ext::make_unique<TChain>("tree");
+    REQUIRE(chain->AddFile(tmpfile1.filename.c_str()) == 1);
+    REQUIRE(chain->AddFile(tmpfile2.filename.c_str()) == 1);
+    REQUIRE(chain->GetEntries() == 20);
+
+    tree_t t;
+    REQUIRE_NOTHROW(t.LinkBranches(chain.get()));
+    REQUIRE_NOTHROW(t.EnableLazyLoading());
+
+    for(int entry=0;entry<chain->GetEntries();entry++) {
+        INFO("entry=" << entry);
+        REQUIRE(t.GetEntry(entry) == 1);
+        REQUIRE(t.Cut == entry);
+        // vector branch is not read if not accessed
+        if(entry % 2 == 0) {
+            REQUIRE(t.Tree->GetBranch("Values")->GetReadEntry() != entry % 10);
+            continue;
+        }
+        REQUIRE(t.Values().size() == unsigned(entry % 10 % 3 + 1));
+        REQUIRE(t.Values[0] == entry);
+    }
+
+    REQUIRE(t.GetEntry(chain->GetEntries()) == 0);
+}
+
+void dotest_shared() {
+
+    struct tree_t : WrapTTree {
+        ADD_BRANCH_T(int, Cut)
+        ADD_BRANCH_T(std::vector<double>, Values)
+    };
+
+    struct tree_cut_t : WrapTTree {
+        ADD_BRANCH_T(int, Cut)
+    };
+
+    tmpfile_t tmpfile;
+    {
+        WrapTFileOutput outputfile(tmpfile.filename, true);
+        tree_t t;
+        t.CreateBranches(new TTree("tree","tree"));
+        for(auto entry=0;entry<10;entry++) {
+            t.Cut = entry;
+            t.Values = std::vector<double>(entry % 3 + 1, entry);
+            t.Tree->Fill();
+        }
+    }
+
+    WrapTFileInput inputfile(tmpfile.filename);
+
+    tree_cut_t follower;
+    tree_t lazy_follower;
+    {
+        tree_t owner;
+        REQUIRE(inputfile.GetObject("tree", owner.Tree));
+        REQUIRE_NOTHROW(owner.LinkBranches());
+
+        // the file gives the same TTree again, so the branches are shared
+        REQUIRE(inputfile.GetObject("tree", follower.Tree));
+        REQUIRE(follower.Tree == owner.Tree);
+        REQUIRE_NOTHROW(follower.LinkBranches());
+        REQUIRE(inputfile.GetObject("tree", lazy_follower.Tree));
+        REQUIRE_NOTHROW(lazy_follower.LinkBranches());
+        REQUIRE_NOTHROW(lazy_follower.EnableLazyLoading());
+
+        struct tree_wrong_t : WrapTTree {
+            ADD_BRANCH_T(double, Cut)
+        };
+        tree_wrong_t wrong;
+        REQUIRE(inputfile.GetObject("tree", wrong.Tree));
+        REQUIRE_THROWS_AS(wrong.LinkBranches(), WrapTTree::Exception);
+
+        const auto sharedBefore = WrapTTree::GetReadStats().SharedEntries;
+        for(int entry=0;entry<10;entry++) {
+            INFO("entry=" << entry);
+            REQUIRE(owner.GetEntry(entry) > 0);
+            REQUIRE(follower.GetEntry(entry) > 0);
+            REQUIRE(lazy_follower.GetEntry(entry) == 1);
+            REQUIRE(owner.Cut == entry);
+            REQUIRE(follower.Cut == entry);
+            REQUIRE(lazy_follower.Cut == entry);
+            REQUIRE(lazy_follower.Values().size() == unsigned(entry % 3 + 1));
+            REQUIRE(lazy_follower.Values[0] == entry);
+        }
+        REQUIRE(WrapTTree::GetReadStats().SharedEntries - sharedBefore == 20);
+
+        // lazy instance first, the others need to read again
+        REQUIRE(lazy_follower.GetEntry(3) == 1);
+        REQUIRE(lazy_follower.Cut == 3);
+        REQUIRE(follower.GetEntry(3) > 0);
+        REQUIRE(follower.Cut == 3);
+        REQUIRE(owner.Values[0] == 3);
+    }
+
+    // the followers take over when the owner is gone
+    for(int entry=0;entry<10;entry++) {
+        INFO("entry=" << entry);
+        REQUIRE(follower.GetEntry(entry) > 0);
+        REQUIRE(lazy_follower.GetEntry(entry) == 1);
+        REQUIRE(follower.Cut == entry);
+        REQUIRE(lazy_follower.Cut == entry);
+        REQUIRE(lazy_follower.Values[0] == entry);
+    }
+}
+
+void dotest_readahead() {
+
+    struct tree_t : WrapTTree {
+        ADD_BRANCH_T(int, Cut)
+        ADD_BRANCH_T(std::vector<double>, Values)
+    };
+
+    const int nEntries = 1000;
+    tmpfile_t tmpfile;
+    {
+        WrapTFileOutput outputfile(tmpfile.filename, true);
+        tree_t t;
+        t.CreateBranches(new TTree("tree","tree"));
+        for(auto entry=0;entry<nEntries;entry++) {
+            t.Cut = entry;
+            t.Values = std::vector<double>(entry % 5 + 1, entry);
+            t.Tree->Fill();
+        }
+    }
+
+    // separate files give separate TTree objects, so nothing is shared
+    WrapTFileInput inputfile(tmpfile.filename);
+    tree_t t;
+    REQUIRE(inputfile.GetObject("tree", t.Tree));
+    REQUIRE_NOTHROW(t.LinkBranches());
+
+    WrapTFileInput inputfile_readahead(tmpfile.filename);
+    tree_t t_readahead;
+    REQUIRE(inputfile_readahead.GetObject("tree", t_readahead.Tree));
+    REQUIRE_NOTHROW(t_readahead.LinkBranches());
+    REQUIRE_NOTHROW(t_readahead.EnableReadAhead());
+    REQUIRE(t_readahead.Tree->GetCacheSize() > 0);
+
+    const auto statsBefore = WrapTTree::GetReadStats();
+    long long bytes = 0;
+    for(int entry=0;entry<nEntries;entry++) {
+        INFO("entry=" << entry);
+        const auto nbytes = t.GetEntry(entry);
+        const auto nbytes_readahead = t_readahead.GetEntry(entry);
+        REQUIRE(nbytes > 0);
+        REQUIRE(nbytes_readahead == nbytes);
+        REQUIRE(t_readahead.Cut == t.Cut);
+        REQUIRE(t_readahead.Values() == t.Values());
+        REQUIRE(t_readahead.Values().size() == unsigned(entry % 5 + 1));
+        bytes += nbytes + nbytes_readahead;
+    }
+    const auto statsAfter = WrapTTree::GetReadStats();
+
+    REQUIRE(statsAfter.Entries - statsBefore.Entries == 2*nEntries);
+    REQUIRE(statsAfter.SharedEntries == statsBefore.SharedEntries);
+    REQUIRE(statsAfter.Bytes - statsBefore.Bytes == bytes);
+    REQUIRE(statsAfter.Seconds > statsBefore.Seconds);
+
+    // entries beyond the tree read nothing, but are counted
+    REQUIRE(t_readahead.GetEntry(nEntries) == 0);
+    REQUIRE(WrapTTree::GetReadStats().Entries - statsAfter.Entries == 1);
+    REQUIRE(WrapTTree::GetReadStats().Bytes == statsAfter.Bytes);
+}
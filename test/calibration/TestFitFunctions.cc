@@ -0,0 +1,148 @@
+#include "catch.hpp"
+
+#include "calibration/fitfunctions/BaseFunctions.h"
+#include "calibration/fitfunctions/Estimates.h"
+#include "calibration/fitfunctions/FitGausPol1.h"
+
+#include "base/std_ext/math.h"
+#include "base/std_ext/memory.h"
+
+#include "TH1D.h"
+#include "TF1.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+using namespace std;
+using namespace ant;
+using namespace ant::calibration;
+
+void dotest_polynomial();
+void dotest_peak();
+void dotest_gradients();
+void dotest_fit();
+
+TEST_CASE("FitFunctions: Polynomial estimate", "[calibration]") {
+    dotest_polynomial();
+}
+
+TEST_CASE("FitFunctions: Peak estimate", "[calibration]") {
+    dotest_peak();
+}
+
+TEST_CASE("FitFunctions: Analytic gradients", "[calibration]") {
+    dotest_gradients();
+}
+
+TEST_CASE("FitFunctions: Fit with analytic gradient", "[calibration]") {
+    dotest_fit();
+}
+
+// peak at 135 with sigma 9 on quadratic background, Poisson distributed
+unique_ptr<TH1D> makePeak(unsigned seed) {
+    auto h = std_ext::make_unique<TH1D>("", "", 200, 0, 300);
+    h->SetDirectory(nullptr);
+    mt19937 rng(seed);
+    for(int bin=1;bin<=h->GetNbinsX();bin++) {
+        const auto x = h->GetXaxis()->GetBinCenter(bin);
+        const auto mu = 500*exp(-std_ext::sqr((x-135)/9)/2) + 100 + 0.3*x - 0.001*x*x;
+        const auto n = poisson_distribution<int>(mu)(rng);
+        h->SetBinContent(bin, n);
+        h->SetBinError(bin, sqrt(n));
+    }
+    return h;
+}
+
+void dotest_polynomial() {
+    TH1D h("", "", 50, -5, 20);
+    h.SetDirectory(nullptr);
+    for(int bin=1;bin<=h.GetNbinsX();bin++) {
+        const auto x = h.GetXaxis()->GetBinCenter(bin);
+        h.SetBinContent(bin, 3 - 2*x + 0.5*x*x + 0.01*x*x*x);
+        h.SetBinError(bin, 1);
+    }
+    const auto p = functions::estimate::polynomial(&h, {-5, 20}, 3);
+    REQUIRE(p.size() == 4);
+    CHECK(p[0] == Approx(3));
+    CHECK(p[1] == Approx(-2));
+    CHECK(p[2] == Approx(0.5));
+    CHECK(p[3] == Approx(0.01));
+
+    // too few bins left
+    CHECK(functions::estimate::polynomial(&h, {-5, 20}, 3, {-5, 19}).empty());
+
+    TH1D e("", "", 100, 0, 100);
+    e.SetDirectory(nullptr);
+    for(int bin=1;bin<=e.GetNbinsX();bin++) {
+        const auto x = e.GetXaxis()->GetBinCenter(bin);
+        e.SetBinContent(bin, exp(7 - 0.05*x));
+        e.SetBinError(bin, 1);
+    }
+    const auto expo = functions::estimate::polynomial(&e, {0, 100}, 1, {std_ext::NaN, std_ext::NaN}, true);
+    REQUIRE(expo.size() == 2);
+    CHECK(expo[0] == Approx(7));
+    CHECK(expo[1] == Approx(-0.05));
+}
+
+void dotest_peak() {
+    auto h = makePeak(1);
+    const auto estimate = functions::estimate::peakOnPolynomial(h.get(), {60, 250}, 2);
+    REQUIRE(estimate.Peak.IsValid());
+    CHECK(estimate.Peak.Position == Approx(135).epsilon(0.01));
+    CHECK(estimate.Peak.Sigma == Approx(9).epsilon(0.1));
+    CHECK(estimate.Peak.Height == Approx(500).epsilon(0.1));
+    REQUIRE(estimate.Background.size() == 3);
+    CHECK(functions::estimate::eval(estimate.Background, 135) == Approx(100 + 0.3*135 - 0.001*135*135).epsilon(0.1));
+
+    TH1D empty("", "", 10, 0, 1);
+    empty.SetDirectory(nullptr);
+    CHECK_FALSE(functions::estimate::peak(&empty, {0, 1}).IsValid());
+}
+
+template<typename F, typename G>
+void check_gradient(F f, G g, vector<double> p, const vector<double>& xs) {
+    for(auto x : xs) {
+        vector<double> grad(p.size());
+        g(&x, p.data(), grad.data());
+        for(size_t i=0;i<p.size();i++) {
+            auto p_up = p;
+            auto p_down = p;
+            const auto h = 1e-6*max(1.0, abs(p[i]));
+            p_up[i] += h;
+            p_down[i] -= h;
+            const auto numerical = (f(&x, p_up.data()) - f(&x, p_down.data()))/(2*h);
+            CHECK(grad[i] == Approx(numerical).epsilon(1e-5).margin(1e-8));
+        }
+    }
+}
+
+void dotest_gradients() {
+    using namespace functions;
+    check_gradient(gaus::fct, gaus::grad, {100, 135, 9}, {110, 130, 135, 150});
+    check_gradient(GausPol<3>::fct, GausPol<3>::grad, {100, 135, 9, 1, 0.1, 0.01, 0.001}, {110, 130, 135, 150});
+    check_gradient(timewalk::fct, timewalk::grad, {3, 50, 1.1, 1, 0.5, -0.1}, {1.5, 2, 3, 4});
+    check_gradient(vetoband::fct, vetoband::grad, {2, 1.0064, 101, 1}, {50, 100, 200, 400});
+}
+
+void dotest_fit() {
+    // analytic and numerical gradient find the same minimum
+    auto h = makePeak(2);
+    vector<double> results[2];
+    unsigned long calls[2];
+    for(auto analytic : {false, true}) {
+        gui::FitGausPol1 func;
+        func.SetAnalyticGradient(analytic);
+        func.SetRange({80, 190});
+        func.SetDefaults(h.get());
+        func.Fit(h.get());
+        results[analytic] = func.Save();
+        calls[analytic] = func.NCalls();
+        CHECK(func.GetPeakPosition() == Approx(135).epsilon(0.01));
+        CHECK(func.Chi2NDF() < 2);
+    }
+    for(size_t i=0;i<results[0].size();i++)
+        CHECK(results[1][i] == Approx(results[0][i]).epsilon(1e-2).margin(1e-3));
+    CHECK(calls[0] > 0);
+    CHECK(calls[1] > 0);
+}
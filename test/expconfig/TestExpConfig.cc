@@ -4,8 +4,15 @@
 
 #include "unpacker/Unpacker.h"
 #include "expconfig/ExpConfig.h"
+#include "expconfig/setups/SetupRegistry.h"
 
 #include "expconfig/detectors/CB.h"
+#include "expconfig/detectors/TAPS.h"
+
+#include "tree/TID.h"
+
+#include "base/interval.h"
+#include "base/std_ext/time.h"
 
 #include <iostream>
 
@@ -15,6 +22,8 @@ using namespace std;
 void getdetector();
 void getlastfound();
 void getall();
+void tapsrings();
+void setbytid();
 
 TEST_CASE("ExpConfig Get (all)", "[expconfig]") {
     getall();
@@ -25,6 +34,14 @@ TEST_CASE("ExpConfig GetDetector", "[expconfig]") {
     getdetector();
 }
 
+TEST_CASE("ExpConfig TAPS rings", "[expconfig]") {
+    tapsrings();
+}
+
+TEST_CASE("ExpConfig SetByTID", "[expconfig]") {
+    setbytid();
+}
+
 void getall() {
     auto setupnames = ExpConfig::Setup::GetNames();
     for(auto setupname : setupnames) {
@@ -48,3 +65,50 @@ void getdetector() {
     REQUIRE_THROWS_AS(ExpConfig::Setup::GetDetector(Detector_t::Type_t::Tagger), ExpConfig::Exception);
 }
 
+void tapsrings() {
+    // the hexagonal channels of one sector, ring by ring
+    const vector< interval<unsigned> > ringRanges = {
+        {0, 0}, {1, 2}, {3, 5}, {6, 9}, {10, 14}, {15, 20},
+        {21, 27}, {28, 35}, {36, 44}, {45, 54}, {55, 63}
+    };
+
+    expconfig::detector::TAPS_2013_11 taps(false, false, false);
+    expconfig::detector::TAPS_2007 taps_2007(false, false);
+    for(const expconfig::detector::TAPS* t : {
+        static_cast<const expconfig::detector::TAPS*>(&taps),
+        static_cast<const expconfig::detector::TAPS*>(&taps_2007)})
+    {
+        for(unsigned ch=0;ch<t->GetNChannels();ch++) {
+            const auto hex = t->GetHexChannel(ch) % 64;
+            unsigned ring = 0;
+            for(size_t i=0;i<ringRanges.size();i++)
+                if(ringRanges[i].Contains(hex))
+                    ring = i+1;
+            REQUIRE(t->GetRing(ch) == ring);
+        }
+    }
+}
+
+void setbytid() {
+    unsigned nTimeRanges = 0;
+    for(auto setupname : ExpConfig::Setup::GetNames()) {
+        const auto timerange = expconfig::SetupRegistry::GetTimeRange(setupname);
+        if(timerange.first.empty())
+            continue;
+        nTimeRanges++;
+
+        // the setup knows its registered time range
+        ExpConfig::Setup::SetByName(setupname);
+        REQUIRE(ExpConfig::Setup::Get().GetStartDate() == timerange.first);
+        REQUIRE(ExpConfig::Setup::Get().GetEndDate() == timerange.second);
+        ExpConfig::Setup::Cleanup();
+
+        const auto timestamp = std_ext::to_time_t(timerange.first, false) + 12*3600;
+        REQUIRE(expconfig::SetupRegistry::MayMatch(setupname, timestamp));
+        REQUIRE_FALSE(expconfig::SetupRegistry::MayMatch(setupname, timestamp - 2*24*3600));
+        REQUIRE_NOTHROW(ExpConfig::Setup::SetByTID(TID(timestamp, 0u)));
+        REQUIRE(ExpConfig::Setup::Get().GetName() == setupname);
+        ExpConfig::Setup::Cleanup();
+    }
+    REQUIRE(nTimeRanges > 0);
+}
@@ -12,18 +12,31 @@
 
 #include "unpacker/Unpacker.h"
 
+#include "expconfig/detectors/CB.h"
+#include "expconfig/detectors/PID.h"
+#include "expconfig/detectors/TAPS.h"
+#include "expconfig/detectors/TAPSVeto.h"
+
+#include <random>
+
 using namespace std;
 using namespace ant;
 using namespace ant::reconstruct;
 
 
 void dotest();
+void dotest_lookup();
 
 TEST_CASE("CandidateBuilder", "[reconstruct]") {
     test::EnsureSetup();
     dotest();
 }
 
+TEST_CASE("CandidateBuilder: Lookup matching same as brute force", "[reconstruct]") {
+    test::EnsureSetup();
+    dotest_lookup();
+}
+
 template<typename T>
 unsigned getTotalCount(const T& m) {
     unsigned total = 0;
@@ -149,3 +162,172 @@ void dotest() {
             break;
     }
 }
+
+// the straightforward matching of all cluster pairs,
+// as reference for the lookup table based implementation
+struct CandidateBuilderBruteForce : CandidateBuilder {
+
+    void BruteForce_PID_CB(sorted_clusters_t& sorted_clusters,
+                           candidates_t& candidates, clusters_t& all_clusters) const
+    {
+        auto& cb_clusters = sorted_clusters[Detector_t::Type_t::CB];
+        auto& pid_clusters = sorted_clusters[Detector_t::Type_t::PID];
+
+        auto it_pid_cluster = pid_clusters.begin();
+        while(it_pid_cluster != pid_clusters.end()) {
+            const auto pid_phi = it_pid_cluster->Position.Phi();
+            const auto dphi_max = pid->dPhi(it_pid_cluster->CentralElement) + config.PID_Phi_Epsilon;
+            bool matched = false;
+            auto it_cb_cluster = cb_clusters.begin();
+            while(it_cb_cluster != cb_clusters.end()) {
+                const auto dphi = fabs(vec2::Phi_mpi_pi(it_cb_cluster->Position.Phi() - pid_phi));
+                if(dphi < dphi_max) {
+                    candidates.emplace_back(
+                                Detector_t::Type_t::CB | Detector_t::Type_t::PID,
+                                it_cb_cluster->Energy, 0, 0, 0, 0, it_pid_cluster->Energy, 0,
+                                TClusterList{it_cb_cluster, it_pid_cluster});
+                    all_clusters.push_back(it_cb_cluster);
+                    it_cb_cluster = cb_clusters.erase(it_cb_cluster);
+                    matched = true;
+                }
+                else {
+                    ++it_cb_cluster;
+                }
+            }
+            if(matched) {
+                all_clusters.push_back(it_pid_cluster);
+                it_pid_cluster = pid_clusters.erase(it_pid_cluster);
+            }
+            else {
+                ++it_pid_cluster;
+            }
+        }
+    }
+
+    void BruteForce_TAPS_Veto(sorted_clusters_t& sorted_clusters,
+                              candidates_t& candidates, clusters_t& all_clusters) const
+    {
+        auto& taps_clusters = sorted_clusters[Detector_t::Type_t::TAPS];
+        auto& veto_clusters = sorted_clusters[Detector_t::Type_t::TAPSVeto];
+
+        auto it_taps_cluster = taps_clusters.begin();
+        while(it_taps_cluster != taps_clusters.end()) {
+            const auto center = taps->GetHexChannel(it_taps_cluster->CentralElement);
+            vector<unsigned> neighbours;
+            if(it_taps_cluster->Hits.size() > 1) {
+                for(auto neighbour : taps->GetClusterElement(it_taps_cluster->CentralElement)->Neighbours)
+                    neighbours.push_back(taps->GetHexChannel(neighbour));
+            }
+            auto matched_veto = veto_clusters.end();
+            for(auto it_veto_cluster = veto_clusters.begin(); it_veto_cluster != veto_clusters.end(); ++it_veto_cluster) {
+                if(it_veto_cluster->CentralElement == center)
+                    matched_veto = it_veto_cluster;
+                if(find(neighbours.begin(), neighbours.end(), it_veto_cluster->CentralElement) != neighbours.end()) {
+                    if(matched_veto == veto_clusters.end() || it_veto_cluster->Energy > matched_veto->Energy)
+                        matched_veto = it_veto_cluster;
+                }
+            }
+            if(matched_veto != veto_clusters.end()) {
+                candidates.emplace_back(
+                            Detector_t::Type_t::TAPS | Detector_t::Type_t::TAPSVeto,
+                            it_taps_cluster->Energy, 0, 0, 0, 0, matched_veto->Energy, 0,
+                            TClusterList{it_taps_cluster, matched_veto});
+                all_clusters.push_back(it_taps_cluster);
+                it_taps_cluster = taps_clusters.erase(it_taps_cluster);
+                all_clusters.push_back(matched_veto);
+                veto_clusters.erase(matched_veto);
+            }
+            else {
+                ++it_taps_cluster;
+            }
+        }
+    }
+
+    // shares the cluster instances with the given clusters
+    static sorted_clusters_t copy(sorted_clusters_t& clusters) {
+        sorted_clusters_t copied;
+        for(auto& item : clusters) {
+            auto& c = copied[item.first];
+            for(auto it = item.second.begin(); it != item.second.end(); ++it)
+                c.push_back(it);
+        }
+        return copied;
+    }
+
+    template<typename Det>
+    static void fill(TClusterList& clusters, const Det& det, unsigned n, std::mt19937& rng) {
+        std::uniform_int_distribution<unsigned> channel(0, det.GetNChannels()-1);
+        std::uniform_int_distribution<unsigned> nHits(1, 3);
+        std::uniform_real_distribution<double> energy(0, 100);
+        for(unsigned i=0;i<n;i++) {
+            const auto ch = channel(rng);
+            vector<TClusterHit> hits(nHits(rng), TClusterHit(ch, 1, 0));
+            clusters.emplace_back(det.GetPosition(ch), energy(rng), 0,
+                                  det.Type, ch, hits);
+        }
+    }
+
+    void test(unsigned nEvents) const {
+        REQUIRE(cb);
+        REQUIRE(pid);
+        REQUIRE(taps);
+        REQUIRE(tapsveto);
+
+        std::mt19937 rng(0);
+        std::uniform_int_distribution<unsigned> n(0, 30);
+        unsigned nCandidates = 0;
+
+        for(unsigned i=0;i<nEvents;i++) {
+            sorted_clusters_t clusters;
+            fill(clusters[Detector_t::Type_t::CB], *cb, n(rng), rng);
+            fill(clusters[Detector_t::Type_t::PID], *pid, n(rng)/3, rng);
+            fill(clusters[Detector_t::Type_t::TAPS], *taps, n(rng), rng);
+            // many veto clusters to get plenty of (ambiguous) matches
+            fill(clusters[Detector_t::Type_t::TAPSVeto], *tapsveto, 4*n(rng), rng);
+
+            auto sorted_lookup = copy(clusters);
+            candidates_t candidates_lookup;
+            clusters_t all_clusters_lookup;
+            Build_PID_CB(sorted_lookup, candidates_lookup, all_clusters_lookup);
+            Build_TAPS_Veto(sorted_lookup, candidates_lookup, all_clusters_lookup);
+
+            auto sorted_bruteforce = copy(clusters);
+            candidates_t candidates_bruteforce;
+            clusters_t all_clusters_bruteforce;
+            BruteForce_PID_CB(sorted_bruteforce, candidates_bruteforce, all_clusters_bruteforce);
+            BruteForce_TAPS_Veto(sorted_bruteforce, candidates_bruteforce, all_clusters_bruteforce);
+
+            REQUIRE(candidates_lookup.size() == candidates_bruteforce.size());
+            for(unsigned j=0;j<candidates_lookup.size();j++) {
+                const auto& c1 = candidates_lookup[j];
+                const auto& c2 = candidates_bruteforce[j];
+                REQUIRE(c1.Detector == c2.Detector);
+                REQUIRE(c1.CaloEnergy == c2.CaloEnergy);
+                REQUIRE(c1.VetoEnergy == c2.VetoEnergy);
+                REQUIRE(c1.Clusters.size() == c2.Clusters.size());
+                for(unsigned k=0;k<c1.Clusters.size();k++)
+                    REQUIRE(&c1.Clusters[k] == &c2.Clusters[k]);
+            }
+            nCandidates += candidates_lookup.size();
+
+            REQUIRE(all_clusters_lookup.size() == all_clusters_bruteforce.size());
+            for(unsigned j=0;j<all_clusters_lookup.size();j++)
+                REQUIRE(&all_clusters_lookup[j] == &all_clusters_bruteforce[j]);
+
+            for(auto& item : sorted_lookup) {
+                const auto& remaining = sorted_bruteforce[item.first];
+                REQUIRE(item.second.size() == remaining.size());
+                for(unsigned j=0;j<remaining.size();j++)
+                    REQUIRE(&item.second[j] == &remaining[j]);
+            }
+        }
+
+        // make sure the test actually matched something
+        REQUIRE(nCandidates > nEvents);
+    }
+};
+
+void dotest_lookup() {
+    CandidateBuilderBruteForce builder;
+    builder.test(1000);
+}
@@ -12,6 +12,10 @@
 
 #include "unpacker/Unpacker.h"
 
+#include "expconfig/TriggerSums.h"
+
+#include <limits>
+
 
 using namespace std;
 using namespace ant;
@@ -23,6 +27,8 @@ void dotest_ignoredelements_raw();
 void dotest_ignoredelements_raw_include();
 void dotest_ignoredelements_geant();
 void dotest_ignoredelements_geant_include();
+void dotest_triggersums();
+void dotest_triggersums_weights();
 
 
 TEST_CASE("Reconstruct: Chain sanity checks", "[reconstruct]") {
@@ -50,6 +56,15 @@ TEST_CASE("Reconstruct: Include ignored elements with geant", "[reconstruct]") {
     dotest_ignoredelements_geant_include();
 }
 
+TEST_CASE("Reconstruct: Trigger sums", "[reconstruct]") {
+    test::EnsureSetup();
+    dotest_triggersums();
+}
+
+TEST_CASE("Reconstruct: Trigger sums with weights and thresholds", "[reconstruct]") {
+    dotest_triggersums_weights();
+}
+
 template<typename T>
 unsigned getTotalCount(const T& m) {
     unsigned total = 0;
@@ -330,4 +345,62 @@ void dotest_ignoredelements_geant_include() {
     CHECK(clusterHits_after2[Detector_t::Type_t::PID] == 51);
     CHECK(clusterHits_after2[Detector_t::Type_t::TAPSVeto] == 133);
     CHECK(clusterHits_before[Detector_t::Type_t::EPT] == 100);
-}
\ No newline at end of file
+}
+
+void dotest_triggersums() {
+    // sums filled during reconstruction are the same as calculated later from the event
+    expconfig::TriggerSums triggersums(ExpConfig::Setup::Get().GetTriggerSimuConfig());
+    for(auto geant : {false, true}) {
+        auto unpacker = Unpacker::Get(geant ?  string(TEST_BLOBS_DIRECTORY)+"/Geant_with_TID.root" :
+                                               string(TEST_BLOBS_DIRECTORY)+"/Acqu_oneevent-big.dat.xz");
+        Reconstruct reconstruct;
+        unsigned nSums = 0;
+        while(auto event = unpacker->NextEvent()) {
+            auto& recon = event.Reconstructed();
+            REQUIRE_FALSE(recon.TriggerSums.IsSet);
+            reconstruct.DoReconstruct(recon);
+            if(recon.DetectorReadHits.empty())
+                continue;
+            REQUIRE(recon.TriggerSums.IsSet);
+            const auto expected = triggersums.Calculate(recon);
+            CHECK(recon.TriggerSums.CBEnergySum == Approx(expected.CBEnergySum));
+            if(isfinite(expected.CBTiming))
+                CHECK(recon.TriggerSums.CBTiming == Approx(expected.CBTiming));
+            else
+                CHECK_FALSE(isfinite(recon.TriggerSums.CBTiming));
+            nSums++;
+        }
+        CHECK(nSums > 0);
+    }
+}
+
+void dotest_triggersums_weights() {
+    expconfig::TriggerSums::config_t config;
+    config.CBESum_MissingElements = {1};
+    config.CBESum_Weights = {1.0, 1.0, 0.5};
+    config.CBESum_Thresholds = {10.0};
+    expconfig::TriggerSums triggersums(config);
+
+    auto makeHit = [] (Detector_t::Type_t detector, Channel_t::Type_t type, unsigned ch,
+                       std::initializer_list<double> energies) {
+        TDetectorReadHit readhit(LogicalChannel_t{detector, type, ch}, vector<uint8_t>{});
+        for(auto e : energies)
+            readhit.Values.emplace_back(e);
+        return readhit;
+    };
+
+    using det_t = Detector_t::Type_t;
+    using ch_t = Channel_t::Type_t;
+    vector<TDetectorReadHit> readhits;
+    readhits.emplace_back(makeHit(det_t::CB,   ch_t::Integral, 0, {5, 20})); // below threshold ignored
+    readhits.emplace_back(makeHit(det_t::CB,   ch_t::Integral, 1, {100}));   // missing element
+    readhits.emplace_back(makeHit(det_t::CB,   ch_t::Integral, 2, {30}));    // half weight
+    readhits.emplace_back(makeHit(det_t::CB,   ch_t::Integral, 700, {7}));   // beyond tables
+    readhits.emplace_back(makeHit(det_t::CB,   ch_t::Timing,   3, {50}));
+    readhits.emplace_back(makeHit(det_t::TAPS, ch_t::Integral, 0, {80}));
+    CHECK(triggersums.CBEnergySum(readhits) == Approx(20 + 15 + 7));
+
+    // without config, all CB energies count
+    expconfig::TriggerSums plain{expconfig::TriggerSums::config_t{}};
+    CHECK(plain.CBEnergySum(readhits) == Approx(5 + 20 + 100 + 30 + 7));
+}
@@ -20,6 +20,7 @@ enum class eCompress { NoCompress, XZ, GZ };
 
 void dotest(eCompress, streamsize, streamsize, streamsize);
 void doendianness();
+void doseek(eCompress);
 
 
 TEST_CASE("Test RawFileReader: nocompress, one chunk", "[unpacker]") {
@@ -58,6 +59,18 @@ TEST_CASE("Test RawFileReader: uint32_t endianness","[unpacker]") {
   doendianness();
 }
 
+TEST_CASE("Test RawFileReader: seek nocompress", "[unpacker]") {
+  doseek(eCompress::NoCompress);
+}
+
+TEST_CASE("Test RawFileReader: seek xz blocks", "[unpacker]") {
+  doseek(eCompress::XZ);
+}
+
+TEST_CASE("Test RawFileReader: seek gz access points", "[unpacker]") {
+  doseek(eCompress::GZ);
+}
+
 void doendianness() {
   ant::tmpfile_t f;
 
@@ -161,5 +174,64 @@ void dotest(eCompress compress,
   REQUIRE(inputEqualsOutput);
 }
 
+void doseek(eCompress compress) {
+  ant::tmpfile_t f;
+  // somewhat compressible data, such that deflate blocks don't end at byte boundaries
+  f.testdata.resize(1 << 20);
+  generate(f.testdata.begin(), f.testdata.end(), [] () { return rand() % 7; });
+  f.write_testdata();
 
+  if(compress == eCompress::XZ) {
+    // small blocks make the file seekable
+    const string& xz_cmd = string("xz --block-size=65536 ")+f.filename;
+    REQUIRE(system(xz_cmd.c_str()) == 0);
+    f.filename += ".xz";
+  } else if(compress == eCompress::GZ) {
+    const string& gz_cmd = string("gzip ")+f.filename;
+    REQUIRE(system(gz_cmd.c_str()) == 0);
+    f.filename += ".gz";
+  }
+
+  // read once sequentially, gz needs to record access points
+  vector<ant::RawFileReader::AccessPoint> points;
+  {
+    ant::RawFileReader reader;
+    REQUIRE_NOTHROW(reader.open(f.filename));
+    reader.EnableAccessPoints(1 << 16);
+    vector<uint8_t> indata(f.testdata.size());
+    REQUIRE_NOTHROW(reader.read((char*)indata.data(), indata.size()));
+    REQUIRE(indata == f.testdata);
+    points = reader.GetAccessPoints();
+    if(compress == eCompress::GZ)
+      REQUIRE(points.size() > 4);
+    else
+      REQUIRE(points.empty());
+  }
+
+  ant::RawFileReader reader;
+  REQUIRE_NOTHROW(reader.open(f.filename));
+  reader.SetAccessPoints(points);
+
+  // jump back and forth, always compare with original data
+  const streamsize chunkSize = 3000;
+  vector<uint8_t> chunk(chunkSize);
+  for(int i=0;i<200;i++) {
+    const streamsize pos = rand() % (f.testdata.size() - chunkSize);
+    REQUIRE_NOTHROW(reader.seek(pos));
+    REQUIRE(reader.tell() == pos);
+    REQUIRE_NOTHROW(reader.read((char*)chunk.data(), chunkSize));
+    REQUIRE(reader.gcount() == chunkSize);
+    REQUIRE(reader.tell() == pos + chunkSize);
+    REQUIRE(equal(chunk.begin(), chunk.end(), next(f.testdata.begin(), pos)));
+  }
 
+  // reading until the end still works after seeking
+  REQUIRE_NOTHROW(reader.seek(f.testdata.size() - 10));
+  REQUIRE_NOTHROW(reader.read((char*)chunk.data(), chunkSize));
+  REQUIRE(reader.gcount() == 10);
+  REQUIRE(reader.eof());
+
+  // seeking beyond the end is not possible for compressed files
+  if(compress != eCompress::NoCompress)
+    REQUIRE_THROWS_AS(reader.seek(f.testdata.size() + 10), ant::RawFileReader::Exception);
+}
@@ -0,0 +1,94 @@
+#include "catch.hpp"
+#include "catch_config.h"
+#include "expconfig_helpers.h"
+
+#include "Unpacker.h"
+#include "TIDIndex.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+#include "base/tmpfile_t.h"
+#include "base/std_ext/string.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+
+void dotest(const string& compress);
+
+TEST_CASE("Test UnpackerAcqu: TID index plain", "[unpacker]") {
+    test::EnsureSetup();
+    dotest("");
+}
+
+TEST_CASE("Test UnpackerAcqu: TID index xz", "[unpacker]") {
+    test::EnsureSetup();
+    dotest("xz");
+}
+
+TEST_CASE("Test UnpackerAcqu: TID index gz", "[unpacker]") {
+    test::EnsureSetup();
+    dotest("gz");
+}
+
+string event_to_string(TEvent& event) {
+    // messages like "Found proper end of file" depend on the reading order
+    event.Reconstructed().UnpackerMessages.clear();
+    return std_ext::formatter() << event;
+}
+
+void dotest(const string& compress) {
+    // index is written next to the raw file, so work on a copy
+    tmpfolder_t folder;
+    const string blob = string(TEST_BLOBS_DIRECTORY)+"/Acqu_scalerblock.dat.xz";
+    string filename = folder.foldername+"/scalerblock.dat";
+    REQUIRE(system(string("xz -dc "+blob+" > "+filename).c_str()) == 0);
+    if(!compress.empty()) {
+        const string gz_cmd = compress == "xz" ? "xz " : "gzip ";
+        REQUIRE(system(string(gz_cmd+filename).c_str()) == 0);
+        filename += "." + compress;
+    }
+
+    // sequential reading writes the index
+    map<TID, string> events;
+    {
+        auto unpacker = Unpacker::Get(filename);
+        REQUIRE(unpacker->WriteTIDIndex());
+        while(auto event = unpacker->NextEvent()) {
+            const TID id = event.Reconstructed().ID;
+            events[id] = event_to_string(event);
+        }
+    }
+    REQUIRE(events.size() > 100);
+
+    const auto index = TIDIndex::Load(TIDIndex::GetFilename(filename));
+    REQUIRE(index.Records.size() > 1);
+
+    // select some events, also in reverse order and from the end
+    vector<TID> tids;
+    unsigned n = 0;
+    for(auto it = events.rbegin(); it != events.rend(); ++it) {
+        if(n++ % 7 == 0)
+            tids.push_back(it->first);
+    }
+    tids.push_back(events.begin()->first);
+
+    auto unpacker = Unpacker::Get(filename);
+    REQUIRE(unpacker->SelectTIDs(tids));
+    REQUIRE_FALSE(unpacker->ProvidesSlowControl());
+
+    unsigned nSelected = 0;
+    while(auto event = unpacker->NextEvent()) {
+        const TID id = event.Reconstructed().ID;
+        REQUIRE(find(tids.begin(), tids.end(), id) != tids.end());
+        REQUIRE(events.at(id) == event_to_string(event));
+        nSelected++;
+    }
+    REQUIRE(nSelected == tids.size());
+}